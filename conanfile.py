@@ -6,6 +6,7 @@ class SiloRecipe(ConanFile):
     settings = "os", "compiler", "build_type", "arch"
 
     requires = [
+        "benchmark/1.8.3",
         "boost/1.82.0",
         "duckdb/0.8.1",
         "poco/1.12.4",
@@ -94,6 +95,7 @@ class SiloRecipe(ConanFile):
 
     def generate(self):
         deps = CMakeDeps(self)
+        deps.set_property("benchmark", "cmake_find_mode", "both")
         deps.set_property("boost", "cmake_find_mode", "both")
         deps.set_property("duckdb", "cmake_find_mode", "both")
         deps.set_property("fmt", "cmake_find_mode", "both")
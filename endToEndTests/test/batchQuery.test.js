@@ -0,0 +1,76 @@
+import { headerToHaveDataVersion, server } from './common.js';
+import { expect } from 'chai';
+import { describe, it } from 'node:test';
+import fs from 'fs';
+import { dirname } from 'node:path';
+import { fileURLToPath } from 'node:url';
+
+const __dirname = dirname(fileURLToPath(import.meta.url));
+
+const queriesPath = __dirname + '/queries';
+const queryTestFiles = fs.readdirSync(queriesPath);
+
+describe('The /batchQuery endpoint', () => {
+  const testCases = queryTestFiles.map(file => JSON.parse(fs.readFileSync(`${queriesPath}/${file}`)));
+
+  it('should return the same results as the /query endpoint for all test cases', async () => {
+    const response = await server
+      .post('/batchQuery')
+      .send({ queries: testCases.map(testCase => testCase.query) })
+      .expect(200)
+      .expect('Content-Type', 'application/json')
+      .expect(headerToHaveDataVersion);
+
+    expect(response.body.batchResults).to.have.length(testCases.length);
+    testCases.forEach((testCase, index) =>
+      expect(response.body.batchResults[index], testCase.testCaseName).to.deep.equal({
+        queryResult: testCase.expectedQueryResult,
+      })
+    );
+  });
+
+  it('should correctly evaluate filters that share subexpressions', async () => {
+    const switzerland = { type: 'StringEquals', column: 'country', value: 'Switzerland' };
+    const lineage = {
+      type: 'PangoLineage',
+      column: 'pango_lineage',
+      value: 'B.1.1.7',
+      includeSublineages: true,
+    };
+    const queries = [
+      { action: { type: 'Aggregated' }, filterExpression: switzerland },
+      {
+        action: { type: 'Aggregated' },
+        filterExpression: { type: 'And', children: [switzerland, lineage] },
+      },
+      {
+        action: { type: 'Aggregated' },
+        filterExpression: { type: 'And', children: [switzerland, { type: 'Not', child: lineage }] },
+      },
+    ];
+
+    const response = await server.post('/batchQuery').send({ queries }).expect(200);
+
+    const [total, withLineage, withoutLineage] = response.body.batchResults.map(
+      result => result.queryResult[0].count
+    );
+    expect(withLineage + withoutLineage).to.equal(total);
+
+    for (const [index, query] of queries.entries()) {
+      const singleResponse = await server.post('/query').send(query).expect(200);
+      expect(response.body.batchResults[index]).to.deep.equal(singleResponse.body);
+    }
+  });
+
+  it('should return a bad request response when the queries are missing', async () => {
+    await server
+      .post('/batchQuery')
+      .send({})
+      .expect(400)
+      .expect('Content-Type', 'application/json')
+      .expect({
+        error: 'Bad request',
+        message: 'Batch query json must contain the field queries, which must be an array.',
+      });
+  });
+});
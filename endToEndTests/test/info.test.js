@@ -9,7 +9,19 @@ describe('The /info endpoint', () => {
       .expect(200)
       .expect('Content-Type', 'application/json')
       .expect(headerToHaveDataVersion)
-      .expect({ nBitmapsSize: 3898, sequenceCount: 100, totalSize: 26335659 });
+      .expect(function (response) {
+        const returnedInfo = response.body;
+
+        expect(returnedInfo.nBitmapsSize).to.equal(3898);
+        expect(returnedInfo.sequenceCount).to.equal(100);
+        expect(returnedInfo.totalSize).to.equal(33731);
+
+        expect(returnedInfo.numaNodes).to.be.an('array').that.is.not.empty;
+        const sum = field => returnedInfo.numaNodes.reduce((total, node) => total + node[field], 0);
+        expect(sum('sequenceCount')).to.equal(returnedInfo.sequenceCount);
+        expect(sum('totalSize')).to.equal(returnedInfo.totalSize);
+        expect(sum('partitionCount')).to.equal(4);
+      });
   });
 
   it('should return detailed info about the current state of the database', { timeout: 5000 }, async () => {
@@ -26,15 +38,15 @@ describe('The /info endpoint', () => {
           'bitmapContainerSizeStatistic'
         );
         expect(returnedInfo.bitmapContainerSizePerGenomeSection.bitmapContainerSizeStatistic).to.deep.equal({
-          numberOfArrayContainers: 3065,
+          numberOfArrayContainers: 2712,
           numberOfBitsetContainers: 0,
-          numberOfRunContainers: 3,
-          numberOfValuesStoredInArrayContainers: 4377,
+          numberOfRunContainers: 179,
+          numberOfValuesStoredInArrayContainers: 4295,
           numberOfValuesStoredInBitsetContainers: 0,
-          numberOfValuesStoredInRunContainers: 9,
-          totalBitmapSizeArrayContainers: 8754,
+          numberOfValuesStoredInRunContainers: 1007,
+          totalBitmapSizeArrayContainers: 8590,
           totalBitmapSizeBitsetContainers: 0,
-          totalBitmapSizeRunContainers: 18,
+          totalBitmapSizeRunContainers: 1198,
         });
 
         expect(returnedInfo.bitmapContainerSizePerGenomeSection).to.have.property(
@@ -61,22 +73,22 @@ describe('The /info endpoint', () => {
 
         expect(returnedInfo).to.have.property('bitmapSizePerSymbol');
         expect(returnedInfo.bitmapSizePerSymbol).to.deep.equal({
-          '-': 2648220,
-          'A': 2635348,
-          'B': 2631464,
-          'C': 2634362,
-          'D': 2631464,
-          'G': 2633570,
-          'H': 2631464,
-          'K': 2631594,
-          'M': 2631554,
-          'N': 2631464,
-          'R': 2631514,
-          'S': 2631464,
-          'T': 2638765,
-          'V': 2631464,
-          'W': 2631514,
-          'Y': 2631494,
+          '-': 975805,
+          'A': 959733,
+          'B': 956896,
+          'C': 958733,
+          'D': 956896,
+          'G': 958199,
+          'H': 956896,
+          'K': 957026,
+          'M': 956986,
+          'N': 956896,
+          'R': 956946,
+          'S': 956896,
+          'T': 963323,
+          'V': 956896,
+          'W': 956946,
+          'Y': 956926,
         });
       })
       .expect(headerToHaveDataVersion);
@@ -57,6 +57,27 @@ describe('The /query endpoint', () => {
     );
   });
 
+  it('should return one result per action for a query with a list of actions', async () => {
+    const response = await server
+      .post('/query')
+      .send({
+        actions: [
+          { type: 'Aggregated' },
+          { type: 'Aggregated', groupByFields: ['region'], orderByFields: ['region'] },
+        ],
+        filterExpression: { type: 'StringEquals', column: 'country', value: 'Switzerland' },
+      })
+      .expect(200)
+      .expect('Content-Type', 'application/json')
+      .expect(headerToHaveDataVersion);
+
+    expect(response.body.queryResults).to.have.length(2);
+    const [totalCount, countsPerRegion] = response.body.queryResults;
+    expect(totalCount).to.have.length(1);
+    const summedCounts = countsPerRegion.reduce((sum, entry) => sum + entry.count, 0);
+    expect(summedCounts).to.equal(totalCount[0].count);
+  });
+
   it('should return a method not allowed response when sending a GET request', async () => {
     await server.get('/query').send().expect(405).expect('Content-Type', 'application/json').expect({
       error: 'Method not allowed',
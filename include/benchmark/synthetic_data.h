@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <roaring/roaring.hh>
+
+#include "silo/database.h"
+
+/// Generators of the data that the benchmarks run on. All generators are deterministic, such that
+/// the results of different releases can be compared.
+namespace silo::synthetic_data {
+
+/// A bitmap over row_count rows, of which a fraction of about density is set
+roaring::Roaring generateBitmap(uint32_t row_count, double density, uint32_t seed);
+
+/// Values that are uniformly distributed between 0 and max_value
+std::vector<int32_t> generateIntColumn(size_t row_count, int32_t max_value, uint32_t seed);
+
+std::string generateReference(size_t genome_length);
+
+/// Copies of the reference in which every symbol is replaced by a random symbol with probability
+/// mutation_rate, and by N (missing) with probability 0.01
+std::vector<std::optional<std::string>> generateGenomes(
+   const std::string& reference,
+   size_t sequence_count,
+   double mutation_rate,
+   uint32_t seed
+);
+
+/// Writes the input files of sequence_count sequences with the metadata columns key, date,
+/// country (indexed) and age to directory and preprocesses them
+Database generateDatabase(
+   size_t sequence_count,
+   size_t genome_length,
+   const std::filesystem::path& directory
+);
+
+}  // namespace silo::synthetic_data
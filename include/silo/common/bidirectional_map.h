@@ -2,6 +2,7 @@
 
 #include <cstdint>
 #include <functional>
+#include <mutex>
 #include <optional>
 #include <string>
 #include <unordered_map>
@@ -30,6 +31,7 @@ class BidirectionalMap {
 
    std::vector<V> id_to_value;
    std::unordered_map<V, Idx> value_to_id;
+   std::mutex mutex;
 
   public:
    BidirectionalMap();
@@ -39,6 +41,9 @@ class BidirectionalMap {
 
    [[maybe_unused]] [[nodiscard]] std::optional<Idx> getId(V value) const;
 
+   /// Looks existing values up without locking, only creating a value takes the lock. Values may
+   /// therefore only be created while no other thread reads the map, which is why the partitions
+   /// are filled concurrently only after all values were created by prefillDictionary
    [[nodiscard]] Idx getOrCreateId(V value);
 };
 
@@ -12,6 +12,8 @@ const Date NULL_DATE = 0;
 
 silo::common::Date stringToDate(const std::string& value);
 
+silo::common::Date dateFromYearMonthDay(uint32_t year, uint32_t month, uint32_t day);
+
 std::optional<std::string> dateToString(silo::common::Date date);
 
 }  // namespace silo::common
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace silo {
+
+struct FastaRecord {
+   std::string_view key;
+   std::string_view genome;
+};
+
+/// A run of complete FASTA records. The text either points into the memory-mapped input file or
+/// into the storage of the block
+struct FastaBlock {
+   std::string storage;
+   std::string_view text;
+};
+
+/// Reads a FASTA file (one line per genome, like FastaReader) in large blocks that end at record
+/// boundaries, so that the records of different blocks can be parsed and compressed in parallel.
+/// Plain files are memory-mapped and not copied, .zst files consisting of several frames with
+/// known content sizes are decompressed frame-parallel and .xz files with the multi-threaded
+/// decoder of liblzma. Any other .zst file is decompressed as a stream
+class FastaBlockReader {
+  public:
+   class Decoder;
+
+   static constexpr size_t DEFAULT_BLOCK_SIZE = size_t{8} << 20;
+
+  private:
+   std::unique_ptr<Decoder> decoder;
+   size_t block_size;
+   std::string carry_over;
+
+  public:
+   explicit FastaBlockReader(
+      const std::filesystem::path& in_file_name,
+      size_t block_size = DEFAULT_BLOCK_SIZE
+   );
+   ~FastaBlockReader();
+
+   FastaBlockReader(const FastaBlockReader& other) = delete;
+   FastaBlockReader& operator=(const FastaBlockReader& other) = delete;
+
+   /// Returns false once the input is exhausted
+   bool next(FastaBlock& block);
+
+   /// Appends the records of a block of complete records, throws a FastaFormatException for
+   /// malformed input
+   static void parse(std::string_view text, std::vector<FastaRecord>& records);
+};
+
+}  // namespace silo
@@ -7,6 +7,18 @@
 #include <boost/iostreams/filtering_stream.hpp>
 
 namespace silo {
+
+enum class InputCompression { NONE, ZSTD, XZ };
+
+struct ResolvedInputFile {
+   std::filesystem::path path;
+   InputCompression compression;
+};
+
+/// Finds the input file itself or its variant with the ending .zst or .xz, in this order of
+/// preference for the compressed variants
+ResolvedInputFile resolveInputFile(const std::filesystem::path& filename);
+
 struct InputStreamWrapper {
   private:
    std::ifstream file;
@@ -0,0 +1,124 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace silo {
+
+/// The label names and values that identify one time series of a metric
+using MetricLabels = std::vector<std::pair<std::string, std::string>>;
+
+/// Upper bounds of the buckets of query latencies in seconds, from one millisecond to one minute
+inline const std::vector<double> QUERY_DURATION_BUCKETS{
+   0.001, 0.0025, 0.005, 0.01, 0.025, 0.05, 0.1, 0.25, 0.5, 1, 2.5, 5, 10, 30, 60
+};
+
+/// Upper bounds of the buckets of database loads in seconds, from one second to one hour
+inline const std::vector<double> DATABASE_LOAD_DURATION_BUCKETS{
+   1, 5, 10, 30, 60, 120, 300, 600, 1800, 3600
+};
+
+/// Prometheus expects durations in seconds
+double microsecondsToSeconds(int64_t microseconds);
+
+/// A value that only increases, e.g. the number of rejected queries
+class MetricCounter {
+   std::atomic<double> value = 0;
+
+  public:
+   void increment(double amount = 1);
+
+   [[nodiscard]] double get() const;
+};
+
+struct MetricHistogramValues {
+   std::vector<double> upper_bounds;
+   /// The number of observations that are at most the upper bound of the same index, the last
+   /// entry is the number of all observations
+   std::vector<uint64_t> cumulative_counts;
+   double sum = 0;
+};
+
+/// Counts observations into buckets, like a Prometheus histogram. Observing does not lock
+class MetricHistogram {
+   std::vector<double> upper_bounds;
+   /// One more bucket than upper bounds, for the observations above the last bound
+   std::vector<std::atomic<uint64_t>> bucket_counts;
+   std::atomic<double> sum = 0;
+
+  public:
+   explicit MetricHistogram(std::vector<double> upper_bounds);
+
+   void observe(double value);
+
+   [[nodiscard]] MetricHistogramValues get() const;
+};
+
+/// Writes metric families in the Prometheus text exposition format (version 0.0.4)
+class PrometheusTextWriter {
+   std::ostream& out;
+
+  public:
+   static constexpr std::string_view CONTENT_TYPE = "text/plain; version=0.0.4; charset=utf-8";
+
+   explicit PrometheusTextWriter(std::ostream& out);
+
+   /// Starts a family, whose samples must follow before the next family starts
+   void writeFamily(std::string_view name, std::string_view help, std::string_view type);
+
+   void writeSample(std::string_view name, const MetricLabels& labels, double value);
+
+   /// The _bucket, _sum and _count samples of a histogram of the family name
+   void writeHistogram(
+      std::string_view name,
+      const MetricLabels& labels,
+      const MetricHistogramValues& values
+   );
+};
+
+/// Holds the counters and histograms that are updated while serving, by metric name and labels.
+/// Values that can be read off the current state, like memory usage, are not registered, the
+/// metrics endpoint writes them when it is scraped.
+class MetricRegistry {
+   template <typename Metric>
+   struct Family {
+      std::string help;
+      /// Metrics stay at their address, callers may keep the references
+      std::map<MetricLabels, std::unique_ptr<Metric>> metrics;
+   };
+
+   mutable std::mutex mutex;
+   std::map<std::string, Family<MetricCounter>, std::less<>> counters;
+   std::map<std::string, Family<MetricHistogram>, std::less<>> histograms;
+
+  public:
+   /// The registry of the process
+   static MetricRegistry& get();
+
+   /// The help text of a family is taken from its first registration
+   MetricCounter& counter(
+      std::string_view name,
+      std::string_view help,
+      const MetricLabels& labels = {}
+   );
+
+   /// The upper bounds are used if the histogram with these labels does not exist yet
+   MetricHistogram& histogram(
+      std::string_view name,
+      std::string_view help,
+      const MetricLabels& labels = {},
+      const std::vector<double>& upper_bounds = QUERY_DURATION_BUCKETS
+   );
+
+   void write(PrometheusTextWriter& writer) const;
+};
+
+}  // namespace silo
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace silo {
+
+/// The NUMA nodes of the machine as detected by hwloc. Every node with cores gets a task arena
+/// whose threads are bound to the cores of that node. Memory is placed by first touch, so data
+/// that is built or loaded by tasks of a node's arena is allocated on that node and later work on
+/// it should run in the same arena. Machines with a single node use the default task arena.
+class NumaNodes {
+   class Node;
+
+   struct Topology;
+
+   std::unique_ptr<Topology> topology;
+   std::vector<std::unique_ptr<Node>> nodes;
+
+   NumaNodes();
+
+  public:
+   ~NumaNodes();
+
+   NumaNodes(const NumaNodes& other) = delete;
+   NumaNodes& operator=(const NumaNodes& other) = delete;
+
+   static NumaNodes& get();
+
+   /// At least 1
+   [[nodiscard]] size_t count() const;
+
+   /// Assigns every item to one of node_count nodes, such that the nodes hold a similar size
+   static std::vector<uint32_t> assignNodes(const std::vector<uint64_t>& sizes, size_t node_count);
+
+   /// Calls function(node) for every node concurrently, each in the task arena of the node, and
+   /// waits for all of them. Rethrows the first exception after all nodes finished
+   void parallelForEachNode(const std::function<void(uint32_t)>& function) const;
+
+   /// Calls function(index) in parallel for every index of node_of_index, in the task arena of the
+   /// node node_of_index[index]
+   void parallelFor(
+      const std::vector<uint32_t>& node_of_index,
+      const std::function<void(size_t)>& function
+   ) const;
+};
+
+}  // namespace silo
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <fmt/format.h>
+#include <nlohmann/json_fwd.hpp>
+
+namespace silo {
+
+/// Hardware events counted by the performance monitoring unit of the CPU. The counts are scaled up
+/// for the time that the kernel multiplexed the counters away, and are therefore estimates.
+struct PerfCounterValues {
+   double cycles = 0;
+   double instructions = 0;
+   double llc_misses = 0;
+   double branch_misses = 0;
+
+   PerfCounterValues operator-(const PerfCounterValues& other) const;
+   PerfCounterValues& operator+=(const PerfCounterValues& other);
+
+   [[nodiscard]] double instructionsPerCycle() const;
+};
+
+// NOLINTNEXTLINE(readability-identifier-naming)
+void to_json(nlohmann::json& json, const PerfCounterValues& values);
+
+/// Sums the counts of the PerfCounterBlocks that record into it, which may run on any thread
+class PerfCounterAccumulator {
+   mutable std::mutex mutex;
+   PerfCounterValues values;
+
+  public:
+   void add(const PerfCounterValues& counted);
+
+   [[nodiscard]] PerfCounterValues get() const;
+};
+
+/// Optional instrumentation with the hardware performance counters of linux (perf_event_open,
+/// opened per thread like in the vendored PerfEvent). It is disabled by default, since opening the counters needs
+/// a permissive kernel.perf_event_paranoid, which containers often do not have.
+class PerfCounters {
+  public:
+   /// Returns false and stays disabled if the counters cannot be opened on this machine
+   static bool enable();
+
+   static bool isEnabled();
+
+   /// A process wide accumulator for a named stage, e.g. of the preprocessing. Stages that run
+   /// several times, also concurrently, sum the counts of all runs
+   static PerfCounterAccumulator& stage(std::string_view name);
+
+   /// The counts of all stages by name
+   static std::vector<std::pair<std::string, PerfCounterValues>> getStages();
+};
+
+/// Adds the events that this thread counts during the lifetime of the block to accumulator, like
+/// BlockTimer. Counters are per thread, so code that forks work passes current() on and opens a
+/// block in every forked task. A block does nothing if the counters are disabled, if accumulator
+/// is nullptr, or if an outer block is already counting this thread, which then includes it.
+class [[nodiscard]] PerfCounterBlock {
+   PerfCounterAccumulator* accumulator;
+   PerfCounterAccumulator* previous;
+   bool is_counting = false;
+   PerfCounterValues start;
+
+  public:
+   explicit PerfCounterBlock(PerfCounterAccumulator* accumulator);
+   ~PerfCounterBlock();
+
+   PerfCounterBlock(const PerfCounterBlock& other) = delete;
+   PerfCounterBlock& operator=(const PerfCounterBlock& other) = delete;
+
+   /// The accumulator of the innermost block on this thread, nullptr if there is none
+   static PerfCounterAccumulator* current();
+};
+
+}  // namespace silo
+
+template <>
+struct [[maybe_unused]] fmt::formatter<silo::PerfCounterValues> : fmt::formatter<std::string> {
+   [[maybe_unused]] static auto format(
+      const silo::PerfCounterValues& values,
+      format_context& ctx
+   ) -> decltype(ctx.out());
+};
@@ -41,7 +41,8 @@ class DatabaseSchema {
    std::optional<std::string> date_to_sort_by;
    std::optional<std::string> partition_by;
 
-   std::string getStrictOrderByClause() const;
+   /// The date to sort by, if any, followed by the primary key
+   std::vector<std::string> getStrictOrderByFields() const;
 };
 
 class DatabaseConfig {
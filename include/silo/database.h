@@ -1,6 +1,7 @@
 #pragma once
 
 #include <cstddef>
+#include <cstdint>
 #include <filesystem>
 #include <map>
 #include <optional>
@@ -11,6 +12,8 @@
 #include "silo/common/data_version.h"
 #include "silo/common/nucleotide_symbols.h"
 #include "silo/config/database_config.h"
+#include "silo/persistence/content_hashes.h"
+#include "silo/query_engine/query_profile.h"
 #include "silo/query_engine/query_result.h"
 #include "silo/storage/column_group.h"
 #include "silo/storage/database_partition.h"
@@ -22,6 +25,7 @@ namespace silo {
 class BitmapContainerSize;
 class BitmapSizePerSymbol;
 class DatabaseInfo;
+class DatabaseMemoryInfo;
 class DetailedDatabaseInfo;
 class ReferenceGenomes;
 }  // namespace silo
@@ -50,23 +54,46 @@ class Database {
   private:
    PangoLineageAliasLookup alias_key;
    DataVersion data_version_ = DataVersion{""};
+   std::optional<int64_t> warm_up_time_in_microseconds_;
+   std::optional<persistence::ContentHashes> content_hashes_;
 
   public:
    void validate() const;
 
    void saveDatabaseState(const std::filesystem::path& save_directory);
 
-   static Database loadDatabaseState(const std::filesystem::path& save_directory);
+   /// Partitions whose sequence data is unchanged compared to `previous_database` share their
+   /// sequence stores with it instead of deserializing them. Their columns are always loaded,
+   /// because the ids of the column values depend on the dictionaries of the data version
+   static Database loadDatabaseState(
+      const std::filesystem::path& save_directory,
+      const Database* previous_database = nullptr
+   );
 
    [[nodiscard]] virtual DatabaseInfo getDatabaseInfo() const;
 
    [[nodiscard]] virtual DetailedDatabaseInfo detailedDatabaseInfo() const;
 
+   [[nodiscard]] virtual DatabaseMemoryInfo getMemoryInfo() const;
+
    [[nodiscard]] const PangoLineageAliasLookup& getAliasKey() const;
 
+   /// Merges all delta partitions into the main partitions, each into the currently smallest one.
+   /// The unaligned sequence files of the deltas are moved, so the unaligned sequence stores must
+   /// not point to the folder of a data version that is being served.
+   void compactDeltaPartitions();
+
+   [[nodiscard]] size_t getDeltaPartitionCount() const;
+
+   /// The NUMA node of every partition, see NumaNodes::parallelFor
+   [[nodiscard]] std::vector<uint32_t> getPartitionNumaNodes() const;
+
    void setDataVersion(const DataVersion& data_version);
    virtual DataVersion getDataVersion() const;
 
+   /// The time it took to execute the warm-up queries before this database was published
+   void setWarmUpTime(int64_t warm_up_time_in_microseconds);
+
    template <typename SymbolType>
    std::optional<std::string> getDefaultSequenceName() const;
 
@@ -78,6 +105,15 @@ class Database {
 
    virtual query_engine::QueryResult executeQuery(const std::string& query) const;
 
+   /// Executes the query and discards the result, without recording it in the query metrics and
+   /// the performance log. Returns false if the query was skipped because it exports rows
+   bool warmUpQuery(const std::string& query) const;
+
+   virtual std::vector<query_engine::QueryResult> executeBatchQuery(const std::string& batch_query
+   ) const;
+
+   virtual query_engine::QueryProfile explainQuery(const std::string& query) const;
+
   private:
    std::map<std::string, std::vector<Nucleotide::Symbol>> getNucSequences() const;
 
@@ -85,6 +121,11 @@ class Database {
 
    void initializeColumns();
    void initializeColumn(config::ColumnType column_type, const std::string& name);
+   void initializeColumnPartition(
+      DatabasePartition& partition,
+      config::ColumnType column_type,
+      const std::string& name
+   );
    void initializeNucSequences(
       const std::map<std::string, std::vector<Nucleotide::Symbol>>& reference_sequences
    );
@@ -93,6 +134,21 @@ class Database {
    );
    void finalizeInsertionIndexes();
 
+   /// Points the sequence stores of a partition to those of a partition of another data version
+   /// with the same sequence data, without copying them
+   void shareSequenceData(
+      size_t partition_index,
+      const Database& other,
+      size_t other_partition_index
+   );
+
+   /// Distributes the partitions over the NUMA nodes by their number of sequences. Must be called
+   /// before the partition data is built or loaded, so that it is allocated on its node
+   void placePartitionsOnNumaNodes();
+
+   /// Adds an empty partition, which uses the existing dictionaries and reference sequences
+   DatabasePartition& appendDeltaPartition(uint32_t sequence_count);
+
    template <typename SymbolType>
    static BitmapSizePerSymbol calculateBitmapSizePerSymbol(
       const SequenceStore<SymbolType>& seq_store
@@ -2,6 +2,8 @@
 
 #include <cinttypes>
 #include <map>
+#include <optional>
+#include <string>
 #include <vector>
 
 #include "fmt/format.h"
@@ -11,10 +13,27 @@
 
 namespace silo {
 
+/// The partitions placed on one NUMA node
+struct NumaNodeInfo {
+   uint32_t partition_count;
+   uint32_t sequence_count;
+   uint64_t total_size;
+};
+
 struct DatabaseInfo {
    uint32_t sequence_count;
    uint64_t total_size;
    size_t n_bitmaps_size;
+   std::optional<int64_t> warm_up_time_in_microseconds;
+   std::vector<NumaNodeInfo> numa_nodes;
+};
+
+/// The memory held by each column and sequence store, summed over the partitions. Columns count
+/// their values, not their dictionaries or indexes. Sequence stores count their position bitmaps
+struct DatabaseMemoryInfo {
+   std::map<std::string, uint64_t> column_sizes;
+   std::map<std::string, uint64_t> nucleotide_sequence_sizes;
+   std::map<std::string, uint64_t> amino_acid_sequence_sizes;
 };
 
 }  // namespace silo
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <iosfwd>
+#include <vector>
+
+namespace boost::serialization {
+class access;
+}  // namespace boost::serialization
+
+namespace silo::persistence {
+
+/// Hashes of a saved database state. The sequence stores of a partition of a previously loaded
+/// database can be shared instead of being deserialized, if the reference sequences and the
+/// sequence data of the partition are unchanged. The columns are always loaded, because the ids
+/// of their values depend on the dictionaries of the whole data version.
+struct ContentHashes {
+   uint64_t reference_sequences_hash = 0;
+   /// Hash of the sequence data of each partition, see DatabasePartition::serializeSequenceData
+   std::vector<uint64_t> partition_hashes;
+
+   template <class Archive>
+   [[maybe_unused]] void serialize(Archive& archive, const uint32_t /* version */) {
+      // clang-format off
+      archive & reference_sequences_hash;
+      archive & partition_hashes;
+      // clang-format on
+   }
+};
+
+/// CRC-64 over the concatenated contents of the files
+uint64_t hashFileContents(const std::vector<std::filesystem::path>& files);
+
+/// CRC-64 over everything that write puts into the stream, without storing it
+uint64_t hashStreamContents(const std::function<void(std::ostream&)>& write);
+
+}  // namespace silo::persistence
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "silo/storage/sequence_store.h"
+
+namespace duckdb {
+class Connection;
+class MaterializedQueryResult;
+class DataChunk;
+}  // namespace duckdb
+
+namespace silo::preprocessing {
+
+/// Reads sequences that are given as lists of mutations and missing ranges instead of full aligned
+/// strings. The table must provide the columns `key`, `mutations` (a list of mutations such as
+/// 'C241T', 'C241-' or '241T' with 1-based positions) and `missing` (a list of 1-based, inclusive
+/// [start, end] ranges). A row in which both lists are NULL is a sequence that is missing entirely
+template <typename SymbolType>
+class MutationListTableReader {
+  private:
+   duckdb::Connection& connection;
+   std::string table_name;
+   std::vector<typename SymbolType::Symbol> reference_sequence;
+   std::string where_clause;
+   std::string order_by_clause;
+   std::unique_ptr<duckdb::MaterializedQueryResult> query_result;
+   std::unique_ptr<duckdb::DataChunk> current_chunk;
+   size_t current_row = 0;
+
+   std::string getTableQuery() const;
+
+   void advanceRow();
+
+  public:
+   explicit MutationListTableReader(
+      duckdb::Connection& connection,
+      std::string_view table_name,
+      std::string_view reference_sequence,
+      std::string_view where_clause,
+      std::string_view order_by_clause
+   );
+
+   std::optional<std::string> next(std::optional<SequenceDifferences<SymbolType>>& differences);
+
+   void loadTable();
+
+   /// Parses a mutation such as 'C241T' into its 0-based position and its symbol
+   static std::pair<uint32_t, typename SymbolType::Symbol> parseMutation(
+      std::string_view mutation,
+      const std::vector<typename SymbolType::Symbol>& reference_sequence
+   );
+
+   /// Converts a 1-based, inclusive range into a 0-based, half-open range
+   static std::pair<uint32_t, uint32_t> parseMissingRange(
+      int64_t start,
+      int64_t end,
+      size_t genome_length
+   );
+
+   /// Rejects sequences that would get two symbols at one position, i.e. two substitutions at the
+   /// same position or a substitution within a missing range
+   static void validateDifferences(
+      const SequenceDifferences<SymbolType>& differences,
+      std::string_view key
+   );
+};
+
+}  // namespace silo::preprocessing
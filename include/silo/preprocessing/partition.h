@@ -52,6 +52,32 @@ class Partition {
    [[nodiscard]] const std::vector<PartitionChunk>& getPartitionChunks() const;
 };
 
+/// The number of rows of a partition key and the estimated cost of building their sequence stores
+struct PartitionKeyStatistics {
+   uint64_t row_count;
+   uint64_t cost;
+};
+
+/// One of the pieces into which the rows of a partition key are split, stored as a chunk of a
+/// partition
+struct PartitionKeyPiece {
+   size_t key_index;
+   uint32_t piece_count;
+   uint32_t piece;
+   uint32_t partition;
+   uint32_t chunk;
+
+   bool operator==(const PartitionKeyPiece& other) const;
+};
+
+/// Distributes the partition keys, given in their sort order, over at most partition_count
+/// partitions of similar cost. Consecutive keys become consecutive chunks of the same partition,
+/// a key that costs more than an average partition is split into several pieces
+std::vector<PartitionKeyPiece> assignPartitionKeys(
+   const std::vector<PartitionKeyStatistics>& keys,
+   size_t partition_count
+);
+
 class Partitions {
    std::vector<Partition> partitions;
 
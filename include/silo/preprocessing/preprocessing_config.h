@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
 #include <filesystem>
 #include <optional>
@@ -67,11 +68,37 @@ struct GenePrefix {
 };
 const GenePrefix DEFAULT_GENE_PREFIX = {"gene_"};
 
+struct DeltaBaseDirectory {
+   std::optional<std::string> directory;
+};
+const DeltaBaseDirectory DEFAULT_DELTA_BASE_DIRECTORY = {std::nullopt};
+
 struct ReferenceGenomeFilename {
    std::string filename;
 };
 const ReferenceGenomeFilename DEFAULT_REFERENCE_GENOME_FILENAME = {"reference_genomes.json"};
 
+struct SequenceBufferSize {
+   size_t size;
+};
+const SequenceBufferSize DEFAULT_SEQUENCE_BUFFER_SIZE = {1024};
+
+struct SequenceTileSize {
+   size_t size;
+};
+const SequenceTileSize DEFAULT_SEQUENCE_TILE_SIZE = {64};
+
+struct OptimizeRowOrder {
+   bool enabled;
+};
+const OptimizeRowOrder DEFAULT_OPTIMIZE_ROW_ORDER = {false};
+
+/// 0 stands for the number of hardware threads
+struct PartitionCount {
+   size_t count;
+};
+const PartitionCount DEFAULT_PARTITION_COUNT = {0};
+
 class PreprocessingConfig {
    friend class fmt::formatter<silo::preprocessing::PreprocessingConfig>;
 
@@ -87,6 +114,11 @@ class PreprocessingConfig {
    std::string nucleotide_sequence_prefix;
    std::string unaligned_nucleotide_sequence_prefix;
    std::string gene_prefix;
+   std::optional<std::filesystem::path> delta_base_directory;
+   size_t sequence_buffer_size = DEFAULT_SEQUENCE_BUFFER_SIZE.size;
+   size_t sequence_tile_size = DEFAULT_SEQUENCE_TILE_SIZE.size;
+   bool optimize_row_order = DEFAULT_OPTIMIZE_ROW_ORDER.enabled;
+   size_t partition_count = DEFAULT_PARTITION_COUNT.count;
 
   public:
    explicit PreprocessingConfig();
@@ -102,7 +134,12 @@ class PreprocessingConfig {
       const ReferenceGenomeFilename& reference_genome_filename_,
       const NucleotideSequencePrefix& nucleotide_sequence_prefix_,
       const UnalignedNucleotideSequencePrefix& unaligned_nucleotide_sequence_prefix_,
-      const GenePrefix& gene_prefix_
+      const GenePrefix& gene_prefix_,
+      const DeltaBaseDirectory& delta_base_directory_,
+      const SequenceBufferSize& sequence_buffer_size_,
+      const SequenceTileSize& sequence_tile_size_,
+      const OptimizeRowOrder& optimize_row_order_,
+      const PartitionCount& partition_count_
    );
 
    [[nodiscard]] std::filesystem::path getOutputDirectory() const;
@@ -119,6 +156,18 @@ class PreprocessingConfig {
 
    [[nodiscard]] std::filesystem::path getMetadataInputFilename() const;
 
+   [[nodiscard]] std::optional<std::filesystem::path> getDeltaBaseDirectory() const;
+
+   [[nodiscard]] size_t getSequenceBufferSize() const;
+
+   [[nodiscard]] size_t getSequenceTileSize() const;
+
+   [[nodiscard]] bool getOptimizeRowOrder() const;
+
+   /// The number of partitions that the input is distributed over, resolved to the number of
+   /// hardware threads if it is not configured
+   [[nodiscard]] size_t getPartitionCount() const;
+
    [[nodiscard]] std::filesystem::path getNucFilenameNoExtension(std::string_view nuc_name) const;
 
    [[nodiscard]] std::filesystem::path getUnalignedNucFilenameNoExtension(std::string_view nuc_name
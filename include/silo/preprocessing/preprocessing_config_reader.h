@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstddef>
 #include <filesystem>
 #include <optional>
 #include <string>
@@ -55,6 +56,30 @@ struct OptionalPreprocessingConfig {
     * Prefix that SILO expects for gene sequence files
     */
    std::optional<std::string> gene_prefix;
+   /**
+    * A directory containing a saved data version. If specified, the input is appended to that
+    * data version as a delta partition instead of building a new database from scratch.
+    */
+   std::optional<std::filesystem::path> delta_base_directory;
+   /**
+    * The number of aligned sequences that are buffered before they are added to the bitmaps
+    */
+   std::optional<size_t> sequence_buffer_size;
+   /**
+    * The number of positions that are transposed at once when aligned sequences are added to the
+    * bitmaps
+    */
+   std::optional<size_t> sequence_tile_size;
+   /**
+    * Whether the rows of each partition are reordered to cluster similar genomes, which shrinks
+    * the sequence bitmaps
+    */
+   std::optional<bool> optimize_row_order;
+   /**
+    * The number of partitions that the input is distributed over, 0 for the number of hardware
+    * threads
+    */
+   std::optional<size_t> partition_count;
 
    PreprocessingConfig mergeValuesFromOrDefault(const OptionalPreprocessingConfig& other) const;
 };
@@ -12,6 +12,7 @@ namespace silo {
 class ZstdFastaTable;
 class ReferenceGenomes;
 class CompressSequence;
+class MutationSignature;
 
 namespace preprocessing {
 
@@ -21,6 +22,7 @@ class PreprocessingDatabase {
   public:
    std::unique_ptr<CompressSequence> compress_nucleotide_function;
    std::unique_ptr<CompressSequence> compress_amino_acid_function;
+   std::unique_ptr<MutationSignature> nucleotide_mutation_signature_function;
 
   private:
    duckdb::DuckDB duck_db;
@@ -34,6 +36,9 @@ class PreprocessingDatabase {
 
    duckdb::Connection& getConnection();
 
+   /// An additional connection to the same database, so that several threads can query it at once
+   duckdb::Connection createConnection();
+
    void refreshConnection();
 
    Partitions getPartitionDescriptor();
@@ -1,5 +1,11 @@
 #pragma once
 
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <vector>
+
 #include "silo/config/database_config.h"
 #include "silo/preprocessing/preprocessing_config.h"
 #include "silo/preprocessing/preprocessing_database.h"
@@ -8,16 +14,19 @@
 namespace silo {
 class Database;
 class PangoLineageAliasLookup;
+template <typename SymbolType>
+class SequenceStorePartition;
 
 namespace preprocessing {
 
-class SequenceInfo;
-
 class Preprocessor {
    PreprocessingConfig preprocessing_config;
    config::DatabaseConfig database_config;
    PreprocessingDatabase preprocessing_db;
    ReferenceGenomes reference_genomes_;
+   std::optional<uint32_t> delta_partition_id;
+   /// Whether the aligned sequences of the input are given as mutation lists
+   bool mutation_list_input = false;
 
   public:
    Preprocessor(
@@ -29,39 +38,55 @@ class Preprocessor {
    Database preprocess();
 
   private:
+   Database preprocessDelta(const std::filesystem::path& delta_base_directory);
+
+   void buildInputTables();
+   /// Reads the ndjson input in a single pass into the table ndjson_table, from which the
+   /// metadata table and all partitioned sequence tables are derived
    void buildTablesFromNdjsonInput(const std::filesystem::path& file_name);
    void buildMetadataTableFromFile(const std::filesystem::path& metadata_filename);
 
+   /// Assigns every row a partition and a chunk within it in the table row_partitioning, from
+   /// which the table partitioning and the view partitioned_metadata are derived
    void buildPartitioningTable();
-   void buildPartitioningTableByColumn(const std::string& partition_by_field);
-   void buildEmptyPartitioning();
+   /// Distributes the partition keys over the configured number of partitions, balancing the
+   /// estimated cost of their sequence stores. Without a partition key, all rows form one key
+   void buildBalancedPartitioning(const std::optional<std::string>& partition_by_field);
+   void buildDeltaPartitioning(uint32_t partition_id);
+   /// Selects the compressed size of the first nucleotide sequence of every row as
+   /// (key, bytes), the estimate for the cost of a row in the sequence stores
+   [[nodiscard]] std::string getSequenceSizeSelect() const;
 
-   void createPartitionedSequenceTablesFromNdjson(const std::filesystem::path& file_name);
+   /// Replaces ndjson_table by partitioned_ndjson_table, which additionally holds the partition,
+   /// the chunk and the rank of every row, and creates the sequence views and files from it
+   void createPartitionedSequenceTablesFromNdjson();
 
-   void createAlignedPartitionedSequenceViews(
-      const std::filesystem::path& file_name,
-      const SequenceInfo& sequence_info,
-      const std::string& partition_by_select,
-      const std::string& partition_by_where
-   );
-   void createUnalignedPartitionedSequenceFiles(
-      const std::filesystem::path& file_name,
-      const std::string& partition_by_select,
-      const std::string& partition_by_where
-   );
+   void createAlignedPartitionedSequenceViews();
+   void createUnalignedPartitionedSequenceFiles();
    void createUnalignedPartitionedSequenceFile(
       const std::string& seq_name,
       const std::string& table_sql
    );
 
+   /// Reads the aligned sequence files into the compressed tables raw_nuc_* and raw_gene_*
+   void buildSequenceTablesFromSequenceFiles();
    void createPartitionedSequenceTablesFromSequenceFiles();
    void createPartitionedTableForSequence(
       const std::string& sequence_name,
-      const std::string& reference_sequence,
-      const std::filesystem::path& filename,
       const std::string& table_prefix
    );
 
+   /// Creates the table row_order, which assigns each primary key its rank in the partition
+   void createRowOrderTable();
+   /// Ranks the rows by date, lineage and a MinHash signature of the mutations of the first
+   /// nucleotide sequence, so that similar genomes are stored next to each other. Without
+   /// nucleotide sequences, every row is still ranked by date and lineage
+   void optimizeRowOrder();
+   /// Builds one partition of the given sequence in the strict and in the optimized row order and
+   /// logs the bitmap container statistics of both
+   void logRowOrderEffect(const std::string& sequence_name);
+   [[nodiscard]] std::string getOrderByClause(bool optimize_row_order) const;
+
    Database buildDatabase(
       const preprocessing::Partitions& partition_descriptor,
       const std::string& order_by_clause,
@@ -69,19 +94,33 @@ class Preprocessor {
       const std::filesystem::path& intermediate_results_directory
    );
 
-   void buildMetadataStore(
+   void buildDeltaPartition(
       Database& database,
-      const preprocessing::Partitions& partition_descriptor,
+      uint32_t partition_id,
       const std::string& order_by_clause
    );
-   void buildNucleotideSequenceStore(
+
+   void buildMetadataStore(
       Database& database,
       const preprocessing::Partitions& partition_descriptor,
       const std::string& order_by_clause
    );
-   void buildAminoAcidSequenceStore(
+   /// Builds the stores of all nucleotide sequences and genes for the given partitions as one flat
+   /// set of tasks, one per sequence and partition. Each worker thread queries through its own
+   /// connection
+   void buildSequenceStores(
       Database& database,
-      const preprocessing::Partitions& partition_descriptor,
+      const std::vector<uint32_t>& partition_ids,
+      const std::string& order_by_clause
+   );
+
+   template <typename SymbolType>
+   void fillSequenceStorePartition(
+      duckdb::Connection& connection,
+      SequenceStorePartition<SymbolType>& sequence_store_partition,
+      const std::string& table_name,
+      const std::string& reference_sequence,
+      uint32_t partition_id,
       const std::string& order_by_clause
    );
 };
@@ -29,6 +29,16 @@ class SequenceInfo {
       const PreprocessingDatabase& preprocessing_db
    ) const;
 
+   /// Selects the columns nuc_<name>_mutations, nuc_<name>_missing, gene_<name>_mutations and
+   /// gene_<name>_missing from the fields nucleotideMutations and aminoAcidMutations
+   [[nodiscard]] std::vector<std::string> getMutationListSelects() const;
+
+   /// Whether the input file gives its aligned sequences as mutation lists
+   static bool containsMutationLists(
+      duckdb::Connection& connection,
+      const std::filesystem::path& input_filename
+   );
+
    static std::string getNucleotideSequenceSelect(
       const std::string& seq_name,
       const PreprocessingDatabase& preprocessing_db
@@ -1,8 +1,11 @@
 #pragma once
 
+#include <cstdint>
 #include <filesystem>
+#include <map>
 #include <optional>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 
 #include <duckdb.hpp>
@@ -10,6 +13,7 @@
 #include <oneapi/tbb/enumerable_thread_specific.h>
 #include "silo/storage/pango_lineage_alias.h"
 #include "silo/zstdfasta/zstd_compressor.h"
+#include "silo/zstdfasta/zstd_decompressor.h"
 
 namespace silo {
 
@@ -44,4 +48,38 @@ class CompressSequence : public CustomSqlFunction {
       compressors;
 };
 
+/// Computes a locality-sensitive signature of the mutations of a compressed sequence: the
+/// MinHashes of the set of (position, symbol) pairs that differ from the reference for several
+/// hash functions, packed into one integer. Sequences with similar mutations are likely to have
+/// equal or close signatures, so sorting by it clusters them. Missing symbols ('N') are ignored
+class MutationSignature : public CustomSqlFunction {
+  public:
+   MutationSignature(
+      const std::string& sequence_name,
+      const std::map<std::string, std::string>& reference
+   );
+
+   void addToConnection(duckdb::Connection& connection) const override;
+
+   std::string generateSqlStatement(
+      const std::string& column_name_in_data,
+      const std::string& sequence_name
+   ) const;
+
+   /// A signature of the same kind computed by SQL from a list of mutations (e.g. 'A123T'). The
+   /// mutations are reduced to position and symbol, so 'A123T' and '123T' hash alike, and
+   /// missing symbols are ignored. It uses the hash function of DuckDB, therefore its values
+   /// cannot be compared with those of computeSignature
+   static std::string generateSqlStatementForMutationList(const std::string& column_name_in_data);
+
+   static uint64_t computeSignature(std::string_view sequence, std::string_view reference);
+
+  private:
+   std::map<std::string, std::string, std::less<>> references;
+   mutable std::unordered_map<
+      std::string_view,
+      tbb::enumerable_thread_specific<silo::ZstdDecompressor>>
+      decompressors;
+};
+
 }  // namespace silo
\ No newline at end of file
@@ -24,6 +24,9 @@ struct OrderByField {
 };
 
 class Action {
+   /// The type of the action in the query, e.g. "Aggregated"
+   std::string type;
+
   protected:
    std::vector<OrderByField> order_by_fields;
    std::optional<uint32_t> limit;
@@ -43,6 +46,10 @@ class Action {
    Action();
    virtual ~Action() = default;
 
+   void setType(const std::string& type);
+
+   [[nodiscard]] const std::string& getType() const;
+
    void setOrdering(
       const std::vector<OrderByField>& order_by_fields,
       std::optional<uint32_t> limit,
@@ -44,30 +44,39 @@ class Mutations : public Action {
          full_bitmaps;
    };
 
-   static std::unordered_map<std::string, Mutations<SymbolType>::PrefilteredBitmaps>
+   /// The bitmaps of every sequence, grouped by the NUMA node of their partition
+   static std::unordered_map<std::string, std::vector<Mutations<SymbolType>::PrefilteredBitmaps>>
    preFilterBitmaps(const silo::Database& database, std::vector<OperatorResult>& bitmap_filter);
 
-   static void addPositionToMutationCountsForMixedBitmaps(
-      uint32_t position,
-      const PrefilteredBitmaps& bitmaps_to_evaluate,
+   /// Counts the symbols at the positions [begin, end) of the filtered sequences of a partition.
+   /// Only the materialized positions are looked up, the others hold the reference symbol
+   static void addMutationCountsForMixedBitmap(
+      uint32_t begin,
+      uint32_t end,
+      const OperatorResult& filter,
+      const SequenceStorePartition<SymbolType>& sequence_store_partition,
       SymbolMap<SymbolType, std::vector<uint32_t>>& count_of_mutations_per_position
    );
 
-   static void addPositionToMutationCountsForFullBitmaps(
-      uint32_t position,
-      const PrefilteredBitmaps& bitmaps_to_evaluate,
+   /// Like addMutationCountsForMixedBitmap for a filter that contains the whole partition
+   static void addMutationCountsForFullBitmap(
+      uint32_t begin,
+      uint32_t end,
+      const SequenceStorePartition<SymbolType>& sequence_store_partition,
       SymbolMap<SymbolType, std::vector<uint32_t>>& count_of_mutations_per_position
    );
 
+   /// The partitions of every NUMA node are counted by the threads of that node, the counts of
+   /// the nodes are summed up afterwards
    static SymbolMap<SymbolType, std::vector<uint32_t>> calculateMutationsPerPosition(
       const SequenceStore<SymbolType>& sequence_store,
-      const PrefilteredBitmaps& bitmap_filter
+      const std::vector<PrefilteredBitmaps>& bitmap_filter_per_numa_node
    );
 
    void addMutationsToOutput(
       const std::string& sequence_name,
       const SequenceStore<SymbolType>& sequence_store,
-      const PrefilteredBitmaps& bitmap_filter,
+      const std::vector<PrefilteredBitmaps>& bitmap_filter_per_numa_node,
       std::vector<QueryResultEntry>& output
    ) const;
 
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <functional>
 #include <memory>
 #include <string>
 
@@ -25,8 +26,17 @@ struct Expression {
    Expression();
    virtual ~Expression() = default;
 
+   /// The normalized JSON that the expression was parsed from. It identifies the expression when
+   /// common subexpressions are shared, because unlike toString it keeps the type and the exact
+   /// values. Expressions that were not parsed from JSON leave it empty and are never shared
+   std::string canonical_json;
+
    virtual std::string toString(const silo::Database& database) const = 0;
 
+   /// Calls the visitor on all direct child expressions, which it may replace.
+   /// Leaf expressions have no children, therefore the default does nothing.
+   virtual void visitChildren(const std::function<void(std::unique_ptr<Expression>&)>& visitor);
+
    [[nodiscard]] virtual std::unique_ptr<silo::query_engine::operators::Operator> compile(
       const Database& database,
       const DatabasePartition& database_partition,
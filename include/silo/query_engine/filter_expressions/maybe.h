@@ -1,5 +1,6 @@
 #pragma once
 
+#include <functional>
 #include <memory>
 #include <string>
 
@@ -24,6 +25,8 @@ struct Maybe : public Expression {
 
    std::string toString(const Database& database) const override;
 
+   void visitChildren(const std::function<void(std::unique_ptr<Expression>&)>& visitor) override;
+
    [[nodiscard]] std::unique_ptr<silo::query_engine::operators::Operator> compile(
       const Database& database,
       const DatabasePartition& database_partition,
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <functional>
 #include <memory>
 #include <string>
 #include <tuple>
@@ -53,6 +54,8 @@ struct NOf : public Expression {
 
    std::string toString(const Database& database) const override;
 
+   void visitChildren(const std::function<void(std::unique_ptr<Expression>&)>& visitor) override;
+
    [[nodiscard]] std::unique_ptr<silo::query_engine::operators::Operator> compile(
       const Database& database,
       const DatabasePartition& database_partition,
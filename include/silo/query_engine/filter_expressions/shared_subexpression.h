@@ -0,0 +1,68 @@
+#pragma once
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+
+#include "silo/query_engine/filter_expressions/expression.h"
+#include "silo/query_engine/operator_result.h"
+
+namespace silo {
+namespace query_engine::operators {
+class Operator;
+}  // namespace query_engine::operators
+struct Database;
+class DatabasePartition;
+}  // namespace silo
+
+namespace silo::query_engine::filter_expressions {
+
+/// Holds the evaluated bitmaps of a subexpression that occurs in several queries of a batch,
+/// such that it is only evaluated once per partition and ambiguity mode
+class SubexpressionCache {
+   struct Entry {
+      std::once_flag evaluated;
+      std::unique_ptr<operators::Operator> compiled;
+      OperatorResult result;
+   };
+
+   std::mutex mutex;
+   std::map<std::pair<const DatabasePartition*, Expression::AmbiguityMode>, Entry> entries;
+
+  public:
+   std::unique_ptr<operators::Operator> compile(
+      const Expression& expression,
+      const Database& database,
+      const DatabasePartition& database_partition,
+      Expression::AmbiguityMode mode
+   );
+};
+
+/// Not part of the query language. Replaces subexpressions that are shared between the queries
+/// of a batch. The shared cache is filled by whichever query is evaluated first.
+class SharedSubexpression : public Expression {
+  private:
+   std::unique_ptr<Expression> child;
+   std::shared_ptr<SubexpressionCache> cache;
+
+  public:
+   explicit SharedSubexpression(
+      std::unique_ptr<Expression> child,
+      std::shared_ptr<SubexpressionCache> cache
+   );
+
+   std::string toString(const Database& database) const override;
+
+   void visitChildren(const std::function<void(std::unique_ptr<Expression>&)>& visitor) override;
+
+   [[nodiscard]] std::unique_ptr<silo::query_engine::operators::Operator> compile(
+      const Database& database,
+      const DatabasePartition& database_partition,
+      AmbiguityMode mode
+   ) const override;
+};
+
+}  // namespace silo::query_engine::filter_expressions
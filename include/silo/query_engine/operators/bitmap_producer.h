@@ -22,7 +22,7 @@ class BitmapProducer : public Operator {
 
    [[nodiscard]] virtual Type type() const override;
 
-   virtual OperatorResult evaluate() const override;
+   OperatorResult evaluateImpl() const override;
 
    virtual std::string toString() const override;
 
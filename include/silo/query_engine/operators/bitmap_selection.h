@@ -35,7 +35,7 @@ class BitmapSelection : public Operator {
 
    [[nodiscard]] virtual Type type() const override;
 
-   virtual OperatorResult evaluate() const override;
+   OperatorResult evaluateImpl() const override;
 
    virtual std::string toString() const override;
 
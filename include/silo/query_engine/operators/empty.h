@@ -20,7 +20,7 @@ class Empty : public Operator {
 
    [[nodiscard]] Type type() const override;
 
-   OperatorResult evaluate() const override;
+   OperatorResult evaluateImpl() const override;
 
    virtual std::string toString() const override;
 
@@ -19,7 +19,7 @@ class Full : public Operator {
 
    [[nodiscard]] Type type() const override;
 
-   OperatorResult evaluate() const override;
+   OperatorResult evaluateImpl() const override;
 
    virtual std::string toString() const override;
 
@@ -32,7 +32,7 @@ class Intersection : public Operator {
 
    [[nodiscard]] Type type() const override;
 
-   virtual OperatorResult evaluate() const override;
+   OperatorResult evaluateImpl() const override;
 
    virtual std::string toString() const override;
 
@@ -21,7 +21,12 @@ enum Type {
    BITMAP_PRODUCER
 };
 
+std::string typeName(Type type);
+
 class Operator {
+  protected:
+   virtual OperatorResult evaluateImpl() const = 0;
+
   public:
    Operator();
 
@@ -29,7 +34,9 @@ class Operator {
 
    [[nodiscard]] virtual Type type() const = 0;
 
-   virtual OperatorResult evaluate() const = 0;
+   /// Evaluates the operator and, if an OperatorProfileScope is installed on this thread, adds
+   /// its profile to the profile of that scope
+   OperatorResult evaluate() const;
 
    virtual std::string toString() const = 0;
 
@@ -26,7 +26,7 @@ class Union : public Operator {
 
    [[nodiscard]] Type type() const override;
 
-   virtual OperatorResult evaluate() const override;
+   OperatorResult evaluateImpl() const override;
 
    virtual std::string toString() const override;
 
@@ -2,6 +2,9 @@
 
 #include <memory>
 #include <string>
+#include <vector>
+
+#include <nlohmann/json_fwd.hpp>
 
 #include "silo/query_engine/actions/action.h"
 #include "silo/query_engine/filter_expressions/expression.h"
@@ -10,9 +13,22 @@ namespace silo::query_engine {
 
 struct Query {
    std::unique_ptr<filter_expressions::Expression> filter;
-   std::unique_ptr<actions::Action> action;
+   /// Either the single "action" of the query or all entries of its "actions" list.
+   /// All actions are executed on the same evaluated filter.
+   std::vector<std::unique_ptr<actions::Action>> actions;
+   bool is_multi_action = false;
 
    explicit Query(const std::string& query_string);
+
+   explicit Query(const nlohmann::json& query_json);
+};
+
+/// Several independent queries that are sent in one request. Subexpressions that occur in
+/// the filters of multiple queries are only evaluated once.
+struct BatchQuery {
+   std::vector<Query> queries;
+
+   explicit BatchQuery(const std::string& batch_query_string);
 };
 
 }  // namespace silo::query_engine
@@ -0,0 +1,12 @@
+#pragma once
+
+#include <stdexcept>
+#include <string>
+
+namespace silo {
+
+class QueryCancelledException : public std::runtime_error {
+  public:
+   explicit QueryCancelledException(const std::string& error_message);
+};
+}  // namespace silo
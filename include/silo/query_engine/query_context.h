@@ -0,0 +1,92 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <optional>
+
+namespace silo::query_engine {
+
+enum class CancellationReason : uint8_t {
+   NONE,
+   CANCELLED,
+   DEADLINE_EXCEEDED,
+   CLIENT_DISCONNECTED
+};
+
+/// Deadline and cancellation state of a single query. The query engine polls it at operator
+/// boundaries and in its long loops and stops the query with a QueryCancelledException.
+///
+/// The context that a thread works for is installed with a Scope. Code that forks work to other
+/// threads passes current() on and installs it again in the forked tasks. Without a scope, the
+/// checks do nothing, such that the query engine can be used without contexts.
+class QueryContext {
+  public:
+   using Clock = std::chrono::steady_clock;
+
+   /// How often the connection of the client is probed at most
+   static constexpr std::chrono::milliseconds DISCONNECT_CHECK_INTERVAL{100};
+
+   /// Loops over rows check for cancellation once per this many rows
+   static constexpr uint32_t ROWS_PER_CANCELLATION_CHECK = 1U << 16;
+
+   class Scope {
+      const QueryContext* previous;
+
+     public:
+      explicit Scope(const QueryContext* context);
+      ~Scope();
+
+      Scope(const Scope& other) = delete;
+      Scope& operator=(const Scope& other) = delete;
+   };
+
+  private:
+   std::optional<std::chrono::milliseconds> timeout;
+   std::optional<Clock::time_point> deadline;
+   std::function<bool()> is_client_disconnected;
+   mutable std::atomic<CancellationReason> reason{CancellationReason::NONE};
+   mutable std::atomic<Clock::rep> next_disconnect_check{0};
+
+   void setReason(CancellationReason new_reason) const;
+
+  public:
+   QueryContext() = default;
+
+   /// The deadline is timeout after now, no deadline without timeout
+   explicit QueryContext(std::optional<std::chrono::milliseconds> timeout);
+
+   QueryContext(const QueryContext& other) = delete;
+   QueryContext& operator=(const QueryContext& other) = delete;
+
+   /// is_client_disconnected is called from the threads working on the query, but at most once per
+   /// DISCONNECT_CHECK_INTERVAL. Must be set before the query starts
+   void setClientDisconnectCheck(std::function<bool()> is_client_disconnected);
+
+   void cancel() const;
+
+   [[nodiscard]] std::optional<Clock::time_point> getDeadline() const;
+
+   [[nodiscard]] bool isCancelled() const;
+
+   [[nodiscard]] CancellationReason getCancellationReason() const;
+
+   /// Throws QueryCancelledException if the query is cancelled
+   void checkCancellation() const;
+
+   /// The context installed on this thread, nullptr if there is none
+   static const QueryContext* current();
+
+   /// Throws QueryCancelledException if the query that this thread works for is cancelled
+   static void checkCurrent();
+
+   /// For loops over rows, checks the current context on every ROWS_PER_CANCELLATION_CHECK-th call
+   static void checkCurrentPeriodically(uint32_t& row_counter) {
+      if (++row_counter % ROWS_PER_CANCELLATION_CHECK == 0) {
+         checkCurrent();
+      }
+   }
+};
+
+}  // namespace silo::query_engine
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <string>
+#include <vector>
 
 namespace silo {
 class Database;
@@ -8,16 +9,46 @@ class Database;
 
 namespace silo::query_engine {
 
+struct ActionProfile;
+struct OperatorResult;
+struct Query;
+struct QueryProfile;
 struct QueryResult;
 
 class QueryEngine {
   private:
    const silo::Database& database;
 
+   /// Adds the profiles of the actions to action_profiles, unless it is nullptr
+   QueryResult executeActions(
+      const Query& query,
+      std::vector<OperatorResult> partition_filters,
+      std::vector<ActionProfile>* action_profiles
+   ) const;
+
+   /// Records where the time of the query went in profile, unless it is nullptr. Queries that are
+   /// not recorded are left out of the metrics and the performance log
+   QueryResult runQuery(
+      const std::string& query_string,
+      QueryProfile* profile,
+      bool is_recorded
+   ) const;
+
   public:
    explicit QueryEngine(const silo::Database& database);
 
    virtual QueryResult executeQuery(const std::string& query) const;
+
+   /// Executes the query without recording it, such that warming up a new database does not
+   /// show up as served queries. Returns false without executing queries with an action that
+   /// exports rows (Details, Fasta, FastaAligned), which are too expensive to warm up with
+   bool warmUpQuery(const std::string& query) const;
+
+   /// Executes the query and returns the evaluated operators of each partition and the phases of
+   /// the actions with their timings instead of the result
+   QueryProfile explainQuery(const std::string& query) const;
+
+   std::vector<QueryResult> executeBatchQuery(const std::string& batch_query) const;
 };
 
 QueryResult executeQuery(const Database& database, const std::string& query);
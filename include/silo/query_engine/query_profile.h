@@ -0,0 +1,108 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <nlohmann/json_fwd.hpp>
+
+#include "silo/common/perf_counters.h"
+
+namespace silo::query_engine {
+
+/// An evaluated operator of a compiled filter. The evaluation time includes the time of the
+/// children. The expression is only set for leaves, since it contains the whole subtree.
+struct OperatorProfile {
+   std::string type;
+   std::string expression;
+   int64_t evaluation_time_in_microseconds = 0;
+   uint64_t cardinality = 0;
+   bool is_mutable = false;
+   std::vector<OperatorProfile> children;
+};
+
+struct PartitionProfile {
+   uint32_t partition_index = 0;
+   uint32_t sequence_count = 0;
+   int64_t compilation_time_in_microseconds = 0;
+   OperatorProfile filter;
+};
+
+struct ActionPhaseProfile {
+   std::string name;
+   int64_t time_in_microseconds = 0;
+};
+
+struct ActionProfile {
+   std::string type;
+   int64_t time_in_microseconds = 0;
+   std::vector<ActionPhaseProfile> phases;
+   uint64_t result_row_count = 0;
+};
+
+/// Where the time of a query went, the response of explained queries
+struct QueryProfile {
+   std::string filter;
+   int64_t filter_time_in_microseconds = 0;
+   int64_t action_time_in_microseconds = 0;
+   /// Only counted if the hardware performance counters are enabled
+   std::optional<PerfCounterValues> filter_perf_counters;
+   std::optional<PerfCounterValues> action_perf_counters;
+   std::vector<PartitionProfile> partitions;
+   std::vector<ActionProfile> actions;
+};
+
+/// Installs the profile that the operators evaluated on this thread are added to as children.
+/// Operators do not profile themselves if no scope is installed.
+class OperatorProfileScope {
+   OperatorProfile* previous;
+
+  public:
+   explicit OperatorProfileScope(OperatorProfile* parent);
+   ~OperatorProfileScope();
+
+   OperatorProfileScope(const OperatorProfileScope& other) = delete;
+   OperatorProfileScope& operator=(const OperatorProfileScope& other) = delete;
+
+   static OperatorProfile* current();
+};
+
+/// Installs the profile that the phases of the action executed on this thread are added to
+class ActionProfileScope {
+   ActionProfile* previous;
+
+  public:
+   explicit ActionProfileScope(ActionProfile* profile);
+   ~ActionProfileScope();
+
+   ActionProfileScope(const ActionProfileScope& other) = delete;
+   ActionProfileScope& operator=(const ActionProfileScope& other) = delete;
+
+   static ActionProfile* current();
+};
+
+/// Adds the time until its destruction as a phase to the action profile of this thread, if any
+class [[nodiscard]] ActionPhaseTimer {
+   ActionProfile* profile;
+   const char* name;
+   std::chrono::steady_clock::time_point start;
+
+  public:
+   explicit ActionPhaseTimer(const char* name);
+   ~ActionPhaseTimer();
+
+   ActionPhaseTimer(const ActionPhaseTimer& other) = delete;
+   ActionPhaseTimer& operator=(const ActionPhaseTimer& other) = delete;
+};
+
+// NOLINTBEGIN(readability-identifier-naming)
+void to_json(nlohmann::json& json, const OperatorProfile& profile);
+void to_json(nlohmann::json& json, const PartitionProfile& profile);
+void to_json(nlohmann::json& json, const ActionPhaseProfile& profile);
+void to_json(nlohmann::json& json, const ActionProfile& profile);
+void to_json(nlohmann::json& json, const QueryProfile& profile);
+// NOLINTEND(readability-identifier-naming)
+
+}  // namespace silo::query_engine
@@ -17,6 +17,9 @@ struct QueryResultEntry {
 
 struct QueryResult {
    std::vector<QueryResultEntry> query_result;
+   /// Set instead of query_result for queries with an "actions" list,
+   /// containing the result of each action in the order of that list
+   std::optional<std::vector<std::vector<QueryResultEntry>>> query_results_per_action;
 };
 
 // NOLINTBEGIN(readability-identifier-naming)
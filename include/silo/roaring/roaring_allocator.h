@@ -0,0 +1,30 @@
+#pragma once
+
+#include <cstdint>
+
+namespace silo {
+
+struct RoaringAllocationStatistics {
+   uint64_t allocation_count;
+   uint64_t allocated_bytes;
+
+   RoaringAllocationStatistics operator-(const RoaringAllocationStatistics& other) const;
+};
+
+/// Routes all memory allocations of CRoaring to the scalable allocator of oneTBB, which serves
+/// them from per-thread pools of size-segregated blocks instead of a shared heap. Query evaluation
+/// creates and drops many short-lived containers on all threads, which would otherwise contend
+/// for the heap and fragment it over the lifetime of the server. Must be called before the first
+/// bitmap allocates memory, because memory must be freed by the allocator that allocated it.
+void installRoaringAllocator();
+
+[[nodiscard]] bool isRoaringAllocatorInstalled();
+
+/// The allocations made by CRoaring since the allocator was installed, summed over all threads
+[[nodiscard]] RoaringAllocationStatistics getRoaringAllocationStatistics();
+
+/// Returns the memory cached in the pools of the calling thread to the allocator, e.g. after a
+/// query has dropped its intermediate bitmaps
+void releaseThreadRoaringMemory();
+
+}  // namespace silo
@@ -38,6 +38,10 @@ class DateColumnPartition {
 
    void reserve(size_t row_count);
 
+   /// The appended values must be sorted on their own if this partition is sorted. They then
+   /// form a new sorted chunk of the partition
+   void append(const DateColumnPartition& other);
+
    [[nodiscard]] const std::vector<silo::common::Date>& getValues() const;
 };
 
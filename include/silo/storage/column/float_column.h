@@ -31,9 +31,13 @@ class FloatColumnPartition {
 
    void insert(const std::string& value);
 
+   void insert(double value);
+
    void insertNull();
 
    void reserve(size_t row_count);
+
+   void append(const FloatColumnPartition& other);
 };
 
 class FloatColumn {
@@ -38,6 +38,9 @@ class IndexedStringColumnPartition {
   public:
    explicit IndexedStringColumnPartition(common::BidirectionalMap<std::string>& lookup);
 
+   /// Appends the values of another partition, whose column uses the same lookup
+   void append(const IndexedStringColumnPartition& other);
+
    [[nodiscard]] std::optional<const roaring::Roaring*> filter(const std::string& value) const;
 
    void insert(const std::string& value);
@@ -68,6 +71,11 @@ class IndexedStringColumn {
    IndexedStringColumn();
 
    IndexedStringColumnPartition& createPartition();
+
+   /// Assigns dictionary ids to the given values in their order, before the partitions are
+   /// filled concurrently, so that the ids do not depend on the order of the partitions. An empty
+   /// optional stands for a null value
+   void prefillDictionary(const std::vector<std::optional<std::string>>& values);
 };
 
 }  // namespace silo::storage::column
@@ -50,6 +50,10 @@ class InsertionColumnPartition {
       const std::optional<std::string> default_sequence_name
    );
 
+   /// Appends the values of another partition, whose column uses the same lookup. The insertion
+   /// indexes need to be rebuilt with buildInsertionIndexes afterwards
+   void append(const InsertionColumnPartition<SymbolType>& other);
+
    void insert(const std::string& value);
 
    void insertNull();
@@ -93,6 +97,11 @@ class InsertionColumn {
    InsertionColumn(std::optional<std::string> default_sequence_name);
 
    InsertionColumnPartition<SymbolType>& createPartition();
+
+   /// Assigns dictionary ids to the given values in their order, before the partitions are
+   /// filled concurrently, so that the ids do not depend on the order of the partitions. An empty
+   /// optional stands for a null value
+   void prefillDictionary(const std::vector<std::optional<std::string>>& values);
 };
 
 }  // namespace silo::storage::column
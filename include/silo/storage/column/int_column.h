@@ -31,9 +31,13 @@ class IntColumnPartition {
 
    void insert(const std::string& value);
 
+   void insert(int32_t value);
+
    void insertNull();
 
    void reserve(size_t row_count);
+
+   void append(const IntColumnPartition& other);
 };
 
 class IntColumn {
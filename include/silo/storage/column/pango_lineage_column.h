@@ -4,7 +4,9 @@
 #include <cstdint>
 #include <deque>
 #include <memory>
+#include <mutex>
 #include <optional>
+#include <string>
 #include <unordered_map>
 #include <vector>
 
@@ -41,16 +43,27 @@ class PangoLineageColumnPartition {
    silo::PangoLineageAliasLookup& alias_key;
    silo::common::BidirectionalMap<common::UnaliasedPangoLineage>& lookup_unaliased;
    silo::common::BidirectionalMap<common::AliasedPangoLineage>& lookup_aliased;
+   std::mutex& lookup_mutex;
 
+   /// The id of the lineage, after creating the ids of the lineage and of its parents in both
+   /// lookups if they do not exist yet. Only creating them takes the lock, which prefilled
+   /// lookups never need
+   Idx getOrCreateIds(const common::UnaliasedPangoLineage& lineage);
+
+   /// The ids of the parent lineages must exist already
    void insertSublineageValues(const common::UnaliasedPangoLineage& value, size_t row_number);
 
   public:
    explicit PangoLineageColumnPartition(
       silo::PangoLineageAliasLookup& alias_key,
       common::BidirectionalMap<common::UnaliasedPangoLineage>& lookup_unaliased,
-      common::BidirectionalMap<common::AliasedPangoLineage>& lookup_aliased
+      common::BidirectionalMap<common::AliasedPangoLineage>& lookup_aliased,
+      std::mutex& lookup_mutex
    );
 
+   /// Appends the values of another partition, whose column uses the same lookups
+   void append(const PangoLineageColumnPartition& other);
+
    void insert(const common::RawPangoLineage& value);
 
    void insertNull();
@@ -84,12 +97,19 @@ class PangoLineageColumn {
    std::unique_ptr<silo::common::BidirectionalMap<common::UnaliasedPangoLineage>> lookup_unaliased;
    std::unique_ptr<silo::common::BidirectionalMap<common::AliasedPangoLineage>> lookup_aliased;
    std::unique_ptr<silo::PangoLineageAliasLookup> alias_key;
+   /// Keeps the ids of both lookups in step when lineages are added to them
+   std::unique_ptr<std::mutex> lookup_mutex;
    std::deque<PangoLineageColumnPartition> partitions;
 
   public:
    explicit PangoLineageColumn(silo::PangoLineageAliasLookup alias_key);
 
    PangoLineageColumnPartition& createPartition();
+
+   /// Assigns dictionary ids to the given values in their order, before the partitions are
+   /// filled concurrently, so that the ids do not depend on the order of the partitions. An empty
+   /// optional stands for a null value
+   void prefillDictionary(const std::vector<std::optional<std::string>>& values);
 };
 
 }  // namespace silo::storage::column
@@ -32,6 +32,9 @@ class StringColumnPartition {
   public:
    explicit StringColumnPartition(silo::common::BidirectionalMap<std::string>& lookup);
 
+   /// Appends the values of another partition, whose column uses the same lookup
+   void append(const StringColumnPartition& other);
+
    [[nodiscard]] const std::vector<common::String<silo::common::STRING_SIZE>>& getValues() const;
 
    void insert(const std::string& value);
@@ -69,6 +72,11 @@ class StringColumn {
 
    StringColumnPartition& createPartition();
 
+   /// Assigns dictionary ids to the given values in their order, before the partitions are
+   /// filled concurrently, so that the ids do not depend on the order of the partitions. An empty
+   /// optional stands for a null value
+   void prefillDictionary(const std::vector<std::optional<std::string>>& values);
+
    [[nodiscard]] std::optional<common::String<silo::common::STRING_SIZE>> embedString(
       const std::string& string
    ) const;
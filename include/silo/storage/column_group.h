@@ -24,7 +24,7 @@ class access;
 
 namespace duckdb {
 class Connection;
-class Value;
+class Vector;
 }  // namespace duckdb
 
 namespace silo {
@@ -96,10 +96,13 @@ class ColumnPartitionGroup {
       const silo::config::DatabaseConfig& database_config
    );
 
-   void addValueToColumn(
+   /// Appends the first row_count entries of a DataChunk column, which must have the physical
+   /// type that fill selects for column_type
+   void addColumnValues(
       const std::string& column_name,
       config::ColumnType column_type,
-      const duckdb::Value& value
+      duckdb::Vector& values,
+      size_t row_count
    );
 
    void reserveSpaceInColumn(
@@ -167,6 +170,14 @@ class ColumnGroup {
    std::map<std::string, storage::column::InsertionColumn<Nucleotide>> nuc_insertion_columns;
    std::map<std::string, storage::column::InsertionColumn<AminoAcid>> aa_insertion_columns;
 
+   /// Assigns the dictionary ids of all columns with dictionaries in the sorted order of the
+   /// distinct values in partitioned_metadata. Afterwards, filling the partitions concurrently
+   /// yields the same ids as any other order
+   void prefillDictionaries(
+      duckdb::Connection& connection,
+      const silo::config::DatabaseConfig& database_config
+   );
+
    template <typename SymbolType>
    const std::map<std::string, storage::column::InsertionColumn<SymbolType>>& getInsertionColumns(
    ) const;
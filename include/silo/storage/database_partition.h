@@ -5,6 +5,8 @@
 #include <string>
 #include <vector>
 
+#include <boost/serialization/version.hpp>
+
 #include "silo/preprocessing/partition.h"
 #include "silo/storage/column_group.h"
 
@@ -40,9 +42,12 @@ class DatabasePartition {
    friend class boost::serialization::access;
 
    template <class Archive>
-   void serialize(Archive& archive, [[maybe_unused]] const uint32_t version) {
+   void serialize(Archive& archive, const uint32_t version) {
       // clang-format off
       archive & chunks;
+      if (version >= 1) {
+         archive & is_delta;
+      }
       // clang-format on
    }
 
@@ -63,8 +68,33 @@ class DatabasePartition {
       // clang-format on
    }
 
+   /// Reads only the columns of a partition serialized by serializeData. Used for partitions
+   /// whose sequence stores are shared with a previous data version
+   template <class Archive>
+   void serializeColumns(Archive& archive) {
+      // clang-format off
+      archive & columns;
+      // clang-format on
+   }
+
+   /// Unlike the columns, the sequence stores do not depend on the ids that the dictionaries of
+   /// the columns assign. Their serialization identifies partitions with the same sequence data
+   template <class Archive>
+   void serializeSequenceData(Archive& archive) {
+      // clang-format off
+      archive & sequence_count;
+      for(auto& [name, store] : nuc_sequences){
+         archive & store;
+      }
+      for(auto& [name, store] : aa_sequences){
+         archive & store;
+      }
+      // clang-format on
+   }
+
   private:
    std::vector<silo::preprocessing::PartitionChunk> chunks;
+   bool is_delta = false;
 
   public:
    storage::ColumnPartitionGroup columns;
@@ -72,6 +102,9 @@ class DatabasePartition {
    std::map<std::string, UnalignedSequenceStorePartition&> unaligned_nuc_sequences;
    std::map<std::string, SequenceStorePartition<AminoAcid>&> aa_sequences;
    uint32_t sequence_count = 0;
+   /// The NUMA node whose task arena builds, loads and queries this partition. Not persisted,
+   /// because the placement depends on the machine that loads the database
+   uint32_t numa_node = 0;
 
   private:
    DatabasePartition() = default;
@@ -83,12 +116,23 @@ class DatabasePartition {
    void validateMetadataColumns() const;
 
   public:
-   explicit DatabasePartition(std::vector<silo::preprocessing::PartitionChunk> chunks);
+   explicit DatabasePartition(
+      std::vector<silo::preprocessing::PartitionChunk> chunks,
+      bool is_delta = false
+   );
 
    void validate() const;
 
    [[nodiscard]] const std::vector<preprocessing::PartitionChunk>& getChunks() const;
 
+   /// Delta partitions contain sequences that were appended to an existing data version without
+   /// rebuilding it. They are merged into the main partitions by a compaction.
+   [[nodiscard]] bool isDelta() const;
+
+   /// Appends all column and sequence data of a partition with the same schema. The chunks of the
+   /// other partition are added as new chunks of this partition.
+   void append(const DatabasePartition& other);
+
    void insertColumn(const std::string& name, storage::column::StringColumnPartition& column);
    void insertColumn(
       const std::string& name,
@@ -112,3 +156,5 @@ class DatabasePartition {
 };
 
 }  // namespace silo
+
+BOOST_CLASS_VERSION(silo::DatabasePartition, 1)
@@ -6,6 +6,7 @@
 #include <utility>
 #include <vector>
 
+#include <boost/serialization/version.hpp>
 #include <fmt/core.h>
 #include <roaring/roaring.hh>
 
@@ -24,20 +25,46 @@ class Position {
    friend class boost::serialization::access;
 
    template <class Archive>
-   void serialize(Archive& archive, [[maybe_unused]] const uint32_t version) {
+   void serialize(Archive& archive, const uint32_t version) {
+      if (version == 0) {
+         // Version 0 stored one bitmap for every symbol, most of them empty
+         SymbolMap<SymbolType, roaring::Roaring> legacy_bitmaps;
+         // clang-format off
+         archive & legacy_bitmaps;
+         // clang-format on
+         bitmaps.clear();
+         for (const auto symbol : SymbolType::SYMBOLS) {
+            if (!legacy_bitmaps.at(symbol).isEmpty()) {
+               bitmaps.emplace_back(symbol, std::move(legacy_bitmaps[symbol]));
+            }
+         }
+      } else {
+         // clang-format off
+         archive & bitmaps;
+         // clang-format on
+      }
       // clang-format off
-      archive & bitmaps;
       archive & symbol_whose_bitmap_is_flipped;
       archive & symbol_whose_bitmap_is_deleted;
       // clang-format on
    }
 
-   SymbolMap<SymbolType, roaring::Roaring> bitmaps;
+   /// Only the non-empty bitmaps of this position, sorted by symbol. Most positions hold
+   /// one or two entries, so a short sorted vector beats a full SymbolMap of mostly empty
+   /// bitmaps both in memory and in cache behavior. A position where every sequence has
+   /// the deleted symbol holds no entry at all.
+   std::vector<std::pair<typename SymbolType::Symbol, roaring::Roaring>> bitmaps;
    std::optional<typename SymbolType::Symbol> symbol_whose_bitmap_is_flipped;
    std::optional<typename SymbolType::Symbol> symbol_whose_bitmap_is_deleted;
 
    std::optional<typename SymbolType::Symbol> getHighestCardinalitySymbol(uint32_t sequence_count);
 
+   roaring::Roaring* findBitmap(typename SymbolType::Symbol symbol);
+   const roaring::Roaring* findBitmap(typename SymbolType::Symbol symbol) const;
+   roaring::Roaring& getOrCreateBitmap(typename SymbolType::Symbol symbol);
+   void eraseBitmapIfEmpty(typename SymbolType::Symbol symbol);
+   void flipBitmap(typename SymbolType::Symbol symbol, uint32_t sequence_count);
+
   public:
    Position() = default;
 
@@ -55,6 +82,9 @@ class Position {
 
    std::optional<typename SymbolType::Symbol> deleteMostNumerousBitmap(uint32_t sequence_count);
 
+   /// Run-optimizes and shrinks all stored bitmaps without changing their meaning
+   void optimizeStoredBitmaps();
+
    size_t computeSize() const;
 
    bool isSymbolFlipped(typename SymbolType::Symbol) const;
@@ -62,7 +92,13 @@ class Position {
    bool isSymbolDeleted(typename SymbolType::Symbol) const;
    std::optional<typename SymbolType::Symbol> getDeletedSymbol() const;
 
+   /// Returns an empty bitmap for symbols that have no stored bitmap at this position
    const roaring::Roaring* getBitmap(typename SymbolType::Symbol symbol) const;
+
+   size_t storedBitmapCount() const;
 };
 
-}  // namespace silo
\ No newline at end of file
+}  // namespace silo
+
+BOOST_CLASS_VERSION(silo::Position<silo::Nucleotide>, 1)
+BOOST_CLASS_VERSION(silo::Position<silo::AminoAcid>, 1)
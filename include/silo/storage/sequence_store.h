@@ -3,11 +3,14 @@
 #include <cstddef>
 #include <cstdint>
 #include <deque>
+#include <map>
+#include <memory>
 #include <optional>
 #include <string>
 #include <utility>
 #include <vector>
 
+#include <boost/serialization/version.hpp>
 #include <fmt/core.h>
 #include <roaring/roaring.hh>
 
@@ -24,6 +27,10 @@ namespace silo {
 template <typename SymbolType>
 class Position;
 class ZstdFastaTableReader;
+namespace preprocessing {
+template <typename SymbolType>
+class MutationListTableReader;
+}  // namespace preprocessing
 
 struct SequenceStoreInfo {
    uint32_t sequence_count;
@@ -31,32 +38,89 @@ struct SequenceStoreInfo {
    size_t n_bitmaps_size;
 };
 
+/// DENSE stores hold one Position for every reference position. SPARSE stores only materialize
+/// positions at which some sequence differs from the reference, every other position reads as
+/// the reference symbol. SPARSE is meant for megabase-scale references
+enum class SequenceStoreLayout : uint8_t { DENSE, SPARSE };
+
+/// Reference sequences of at least this length are stored sparsely by default
+constexpr size_t SPARSE_LAYOUT_MIN_REFERENCE_LENGTH = 1'000'000;
+
+SequenceStoreLayout defaultSequenceStoreLayout(size_t reference_length);
+
+/// Tuning of the ingestion of aligned sequences into a sequence store
+struct SequenceIngestionOptions {
+   /// Number of sequences that are read before they are added to the bitmaps
+   size_t buffer_size = 1024;
+   /// Number of positions that are transposed into one contiguous tile of symbols, the tile of
+   /// tile_size * buffer_size bytes should fit into the L2 cache
+   size_t tile_size = 64;
+};
+
+/// The differences of a single sequence to the reference sequence
+template <typename SymbolType>
+struct SequenceDifferences {
+   /// Pairs of position and symbol, a deletion is a substitution by the gap symbol
+   std::vector<std::pair<uint32_t, typename SymbolType::Symbol>> substitutions;
+   /// Half-open ranges [start, end) of positions at which the symbol is missing
+   std::vector<std::pair<uint32_t, uint32_t>> missing_ranges;
+};
+
 template <typename SymbolType>
 class SequenceStorePartition {
    friend class boost::serialization::access;
 
    template <class Archive>
-   void serialize(Archive& archive, [[maybe_unused]] const uint32_t version) {
+   void serialize(Archive& archive, const uint32_t version) {
+      // Before version 1, the layout was inferred from the length of the reference sequence
+      if (version >= 1) {
+         SequenceStoreLayout serialized_layout = layout;
+         // clang-format off
+         archive & serialized_layout;
+         // clang-format on
+         if (serialized_layout != layout) {
+            initializeLayout(serialized_layout);
+         }
+      }
       // clang-format off
       archive & indexing_differences_to_reference_sequence;
-      for(auto& position : positions){
+      if (layout == SequenceStoreLayout::DENSE) {
+         for(auto& position : positions){
             archive & position;
+         }
+      } else {
+         archive & sparse_positions;
       }
       archive & missing_symbol_bitmaps;
       archive & sequence_count;
       // clang-format on
    }
 
+   /// Keeps the reference sequence alive while the partition is shared with a later data version
+   std::shared_ptr<const std::vector<typename SymbolType::Symbol>> shared_reference_sequence;
+
   public:
    const std::vector<typename SymbolType::Symbol>& reference_sequence;
    std::vector<std::pair<size_t, typename SymbolType::Symbol>>
       indexing_differences_to_reference_sequence;
-   std::vector<Position<SymbolType>> positions;
    std::vector<roaring::Roaring> missing_symbol_bitmaps;
    uint32_t sequence_count = 0;
 
   private:
-   void fillIndexes(const std::vector<std::optional<std::string>>& genomes);
+   SequenceStoreLayout layout;
+   /// One position per reference position, only used by DENSE stores
+   std::vector<Position<SymbolType>> positions;
+   /// Positions with variation by position index, only used by SPARSE stores
+   std::map<size_t, Position<SymbolType>> sparse_positions;
+   /// Stands in for positions of SPARSE stores that were not materialized, null for DENSE stores
+   std::unique_ptr<SymbolMap<SymbolType, Position<SymbolType>>> unmaterialized_positions;
+
+   /// Sets up the positions of an empty partition for the given layout
+   void initializeLayout(SequenceStoreLayout new_layout);
+
+   Position<SymbolType>& materializePosition(size_t position);
+
+   void fillIndexes(const std::vector<std::optional<std::string>>& genomes, size_t tile_size);
 
    void addSymbolsToPositions(
       const size_t& position,
@@ -68,13 +132,53 @@ class SequenceStorePartition {
 
    void optimizeBitmaps();
 
+   void appendSparse(const SequenceStorePartition<SymbolType>& other);
+
+   SequenceDifferences<SymbolType> computeDifferences(const std::string& genome) const;
+
   public:
    explicit SequenceStorePartition(
-      const std::vector<typename SymbolType::Symbol>& reference_sequence
+      std::shared_ptr<const std::vector<typename SymbolType::Symbol>> reference_sequence,
+      SequenceStoreLayout layout = SequenceStoreLayout::DENSE
    );
 
+   /// Appends the sequences of another partition of a sequence store with the same reference
+   /// sequence. The bitmaps of this partition keep their deleted symbols, symbols that are only
+   /// implicit in the other partition are materialized
+   void append(const SequenceStorePartition<SymbolType>& other);
+
    [[nodiscard]] size_t computeSize() const;
 
+   [[nodiscard]] SequenceStoreLayout getLayout() const;
+
+   /// In SPARSE stores, the number of positions with variation
+   [[nodiscard]] size_t getMaterializedPositionCount() const;
+
+   [[nodiscard]] const Position<SymbolType>& getPosition(size_t position) const;
+
+   /// Calls function(position_index, position) for every materialized position in ascending
+   /// order. Positions that SPARSE stores did not materialize hold no bitmaps and are skipped
+   template <typename Function>
+   void forEachMaterializedPosition(Function function) const {
+      forEachMaterializedPositionInRange(0, reference_sequence.size(), function);
+   }
+
+   /// Like forEachMaterializedPosition, restricted to the positions in [begin, end)
+   template <typename Function>
+   void forEachMaterializedPositionInRange(size_t begin, size_t end, Function function) const {
+      if (layout == SequenceStoreLayout::DENSE) {
+         for (size_t position = begin; position < end; ++position) {
+            function(position, positions[position]);
+         }
+      } else {
+         for (auto materialized_position = sparse_positions.lower_bound(begin);
+              materialized_position != sparse_positions.end() && materialized_position->first < end;
+              ++materialized_position) {
+            function(materialized_position->first, materialized_position->second);
+         }
+      }
+   }
+
    [[nodiscard]] const roaring::Roaring* getBitmap(
       size_t position,
       typename SymbolType::Symbol symbol
@@ -82,24 +186,62 @@ class SequenceStorePartition {
 
    [[nodiscard]] SequenceStoreInfo getInfo() const;
 
-   size_t fill(silo::ZstdFastaTableReader& input);
+   size_t fill(
+      silo::ZstdFastaTableReader& input,
+      const SequenceIngestionOptions& options = SequenceIngestionOptions{}
+   );
+
+   size_t fill(
+      preprocessing::MutationListTableReader<SymbolType>& input,
+      const SequenceIngestionOptions& options = SequenceIngestionOptions{}
+   );
+
+   void interpret(
+      const std::vector<std::optional<std::string>>& genomes,
+      const SequenceIngestionOptions& options = SequenceIngestionOptions{}
+   );
 
-   void interpret(const std::vector<std::optional<std::string>>& genomes);
+   /// Adds sequences given by their differences to the reference sequence. An empty optional
+   /// adds a sequence that is missing entirely
+   void interpretDifferences(
+      const std::vector<std::optional<SequenceDifferences<SymbolType>>>& sequences
+   );
 };
 
 template <typename SymbolType>
 class SequenceStore {
+   std::shared_ptr<const std::vector<typename SymbolType::Symbol>> shared_reference_sequence;
+
   public:
-   std::vector<typename SymbolType::Symbol> reference_sequence;
-   std::deque<SequenceStorePartition<SymbolType>> partitions;
+   const std::vector<typename SymbolType::Symbol>& reference_sequence;
+   SequenceStoreLayout layout;
+   /// Partitions can be shared with the store of another data version, see sharePartition
+   std::deque<std::shared_ptr<SequenceStorePartition<SymbolType>>> partitions;
 
    explicit SequenceStore(std::vector<typename SymbolType::Symbol> reference_sequence);
 
+   SequenceStore(
+      std::vector<typename SymbolType::Symbol> reference_sequence,
+      SequenceStoreLayout layout
+   );
+
    SequenceStorePartition<SymbolType>& createPartition();
+
+   /// Replaces the partition at partition_index by the partition at other_partition_index of a
+   /// store with the same reference sequence. Both stores then point to the same data, which
+   /// therefore must not be modified anymore
+   SequenceStorePartition<SymbolType>& sharePartition(
+      size_t partition_index,
+      const SequenceStore<SymbolType>& other,
+      size_t other_partition_index
+   );
 };
 
 }  // namespace silo
 
+BOOST_CLASS_VERSION(silo::SequenceStorePartition<silo::Nucleotide>, 1)
+BOOST_CLASS_VERSION(silo::SequenceStorePartition<silo::AminoAcid>, 1)
+
 template <>
 struct [[maybe_unused]] fmt::formatter<silo::SequenceStoreInfo> : fmt::formatter<std::string> {
    [[maybe_unused]] static auto format(
@@ -14,6 +14,7 @@ class ZstdFastaTableReader;
 
 class UnalignedSequenceStorePartition {
    friend class boost::serialization::access;
+   friend class UnalignedSequenceStore;
 
    std::string sql_for_reading_file;
 
@@ -46,6 +47,16 @@ class UnalignedSequenceStore {
    );
 
    UnalignedSequenceStorePartition& createPartition();
+
+   /// Hard links the files of this store into a new folder, which is used from then on. This allows
+   /// to add or merge partitions without modifying the folder of a data version that is being
+   /// served, without copying its files: files are never modified in place, new partitions are
+   /// written to new files and merging partitions only renames the links in the new folder.
+   void relocateFolder(const std::filesystem::path& new_folder_path);
+
+   /// Moves the files of the last partition to the partition with id `target_partition_id` and
+   /// removes the last partition
+   void mergeLastPartitionInto(size_t target_partition_id);
 };
 
 }  // namespace silo
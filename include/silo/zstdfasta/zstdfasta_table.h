@@ -10,6 +10,7 @@ namespace silo {
 class ZstdFastaReader;
 class ZstdFastaTableReader;
 class FastaReader;
+class FastaBlockReader;
 
 class ZstdFastaTable {
    duckdb::Connection& connection;
@@ -38,6 +39,15 @@ class ZstdFastaTable {
       FastaReader& file_reader,
       std::string_view reference_sequence
    );
+
+   /// Parses and compresses several blocks of the input in parallel, the rows are appended in the
+   /// order of the input
+   static ZstdFastaTable generate(
+      duckdb::Connection& connection,
+      const std::string& table_name,
+      FastaBlockReader& file_reader,
+      std::string_view reference_sequence
+   );
 };
 
 }  // namespace silo
@@ -25,6 +25,7 @@ class ZstdFastaTableReader {
    std::string sequence_column;
    std::string where_clause;
    std::string order_by_clause;
+   std::string compression_dict;
    std::unique_ptr<duckdb::MaterializedQueryResult> query_result;
    std::unique_ptr<duckdb::DataChunk> current_chunk;
    std::unique_ptr<ZstdDecompressor> decompressor;
@@ -52,6 +53,9 @@ class ZstdFastaTableReader {
 
    std::optional<std::string> nextCompressed(std::optional<std::string>& compressed_genome);
 
+   /// The dictionary that the genomes are compressed with, for decompressing them on other threads
+   [[nodiscard]] const std::string& getCompressionDict() const;
+
    void loadTable();
 
    void copyTableTo(std::string_view file_name);
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <Poco/Net/HTTPServerRequest.h>
+#include <Poco/Net/HTTPServerResponse.h>
+
+#include "silo_api/rest_resource.h"
+
+namespace silo_api {
+class DatabaseMutex;
+class QueryScheduler;
+}
+
+namespace silo_api {
+class BatchQueryHandler : public RestResource {
+  private:
+   silo_api::DatabaseMutex& database_mutex;
+   silo_api::QueryScheduler& query_scheduler;
+
+  public:
+   BatchQueryHandler(
+      silo_api::DatabaseMutex& database,
+      silo_api::QueryScheduler& query_scheduler
+   );
+
+   void post(Poco::Net::HTTPServerRequest& request, Poco::Net::HTTPServerResponse& response)
+      override;
+};
+}  // namespace silo_api
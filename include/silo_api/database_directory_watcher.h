@@ -4,8 +4,13 @@
 
 #include <Poco/Timer.h>
 
+namespace silo {
+class Database;
+}  // namespace silo
+
 namespace silo_api {
 class DatabaseMutex;
+class HotQueries;
 }
 
 namespace silo_api {
@@ -13,10 +18,19 @@ namespace silo_api {
 class DatabaseDirectoryWatcher {
    std::filesystem::path path;
    DatabaseMutex& database_mutex;
+   const HotQueries& hot_queries;
    Poco::Timer timer;
 
+   /// Executes the most frequent recent queries on a freshly loaded database before it is
+   /// published, such that its memory is paged in before the first real query arrives
+   void warmUp(silo::Database& database) const;
+
   public:
-   DatabaseDirectoryWatcher(std::filesystem::path path, DatabaseMutex& database_mutex);
+   DatabaseDirectoryWatcher(
+      std::filesystem::path path,
+      DatabaseMutex& database_mutex,
+      const HotQueries& hot_queries
+   );
 
    void checkDirectoryForData(Poco::Timer& timer);
 };
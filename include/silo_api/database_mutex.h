@@ -1,29 +1,45 @@
 #pragma once
 
-#include <shared_mutex>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
 
 #include "silo/database.h"
 
 namespace silo_api {
 
+/// A snapshot of the database that stays valid as long as this object lives,
+/// even if a new database has been published in the meantime
 class FixedDatabase {
-   std::shared_lock<std::shared_mutex> lock;
+   std::shared_ptr<const silo::Database> snapshot;
 
   public:
-   FixedDatabase(const silo::Database& database, std::shared_lock<std::shared_mutex>&& mutex);
+   explicit FixedDatabase(std::shared_ptr<const silo::Database> snapshot);
 
    const silo::Database& database;
 };
 
+/// Publishes the currently served database. Readers pin a snapshot without taking a lock,
+/// therefore replacing the database never waits for running queries. Replaced databases are
+/// retired and freed by releaseRetiredDatabases once their last reader has finished.
 class DatabaseMutex {
-   std::shared_mutex mutex;
-   silo::Database database;
+   std::atomic<std::shared_ptr<const silo::Database>> database;
+
+   std::mutex retired_databases_mutex;
+   std::vector<std::shared_ptr<const silo::Database>> retired_databases;
 
   public:
-   DatabaseMutex() = default;
+   DatabaseMutex();
+
+   virtual ~DatabaseMutex() = default;
 
    void setDatabase(silo::Database&& new_database);
 
+   /// Frees all retired databases that are no longer referenced by any query.
+   /// Returns the number of databases that are still in use.
+   size_t releaseRetiredDatabases();
+
    virtual FixedDatabase getDatabase();
 };
 }  // namespace silo_api
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace silo_api {
+
+/// Keeps a rolling sample of the most recently received query bodies and how often each of them
+/// was received. Older queries lose weight as new ones are recorded.
+class HotQueries {
+   static constexpr size_t MAX_DISTINCT_QUERIES = 1000;
+   static constexpr uint64_t DECAY_INTERVAL = 10000;
+
+   mutable std::mutex mutex;
+   std::unordered_map<std::string, uint64_t> frequencies;
+   uint64_t recorded_since_decay = 0;
+
+   void decay();
+
+   /// Makes room for a new query, such that the sample keeps following the recent queries
+   void evictLeastFrequent();
+
+  public:
+   void record(const std::string& query);
+
+   /// Returns up to `count` query bodies, the most frequent first
+   [[nodiscard]] std::vector<std::string> getMostFrequent(size_t count) const;
+};
+
+}  // namespace silo_api
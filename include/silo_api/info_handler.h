@@ -7,13 +7,15 @@
 
 namespace silo_api {
 class DatabaseMutex;
+class QueryScheduler;
 
 class InfoHandler : public RestResource {
   private:
    DatabaseMutex& database;
+   const QueryScheduler& query_scheduler;
 
   public:
-   explicit InfoHandler(DatabaseMutex& database);
+   InfoHandler(DatabaseMutex& database, const QueryScheduler& query_scheduler);
 
    void get(Poco::Net::HTTPServerRequest& request, Poco::Net::HTTPServerResponse& response)
       override;
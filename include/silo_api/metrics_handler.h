@@ -0,0 +1,25 @@
+#pragma once
+
+#include <Poco/Net/HTTPServerRequest.h>
+#include <Poco/Net/HTTPServerResponse.h>
+
+#include "silo_api/rest_resource.h"
+
+namespace silo_api {
+class DatabaseMutex;
+class QueryScheduler;
+
+/// Serves the metrics of the MetricRegistry in the Prometheus text format, together with gauges
+/// of the query scheduler and of the served database that are read when scraped
+class MetricsHandler : public RestResource {
+  private:
+   DatabaseMutex& database;
+   const QueryScheduler& query_scheduler;
+
+  public:
+   MetricsHandler(DatabaseMutex& database, const QueryScheduler& query_scheduler);
+
+   void get(Poco::Net::HTTPServerRequest& request, Poco::Net::HTTPServerResponse& response)
+      override;
+};
+}  // namespace silo_api
@@ -7,15 +7,23 @@
 
 namespace silo_api {
 class DatabaseMutex;
+class HotQueries;
+class QueryScheduler;
 }
 
 namespace silo_api {
 class QueryHandler : public RestResource {
   private:
    silo_api::DatabaseMutex& database_mutex;
+   silo_api::HotQueries& hot_queries;
+   silo_api::QueryScheduler& query_scheduler;
 
   public:
-   explicit QueryHandler(silo_api::DatabaseMutex& database);
+   QueryHandler(
+      silo_api::DatabaseMutex& database,
+      silo_api::HotQueries& hot_queries,
+      silo_api::QueryScheduler& query_scheduler
+   );
 
    void post(Poco::Net::HTTPServerRequest& request, Poco::Net::HTTPServerResponse& response)
       override;
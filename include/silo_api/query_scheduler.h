@@ -0,0 +1,151 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+#include <oneapi/tbb/task_arena.h>
+#include <nlohmann/json_fwd.hpp>
+
+#include "silo/query_engine/query_cancelled_exception.h"
+#include "silo/query_engine/query_context.h"
+
+namespace silo_api {
+
+/// Queries are admitted in the order of their cost class, cheaper classes first
+enum class QueryCostClass : uint8_t { LIGHT = 0, MEDIUM = 1, HEAVY = 2 };
+
+constexpr size_t QUERY_COST_CLASS_COUNT = 3;
+
+std::string toString(QueryCostClass cost_class);
+
+struct QuerySchedulerConfig {
+   uint32_t max_concurrent_queries = 8;
+   uint32_t max_concurrent_heavy_queries = 2;
+   /// Queries that arrive while this many queries are waiting are rejected
+   uint32_t max_queued_queries = 64;
+   /// Maximum concurrency of the task arena for heavy queries, 0 uses half of the hardware threads
+   uint32_t heavy_query_threads = 0;
+   /// Timeout of queries that do not request one, including the time spent waiting
+   std::optional<std::chrono::milliseconds> default_query_timeout;
+};
+
+class QueryQueueFullException : public std::runtime_error {
+  public:
+   explicit QueryQueueFullException(const std::string& message);
+};
+
+struct QueryCostClassStatistics {
+   uint64_t queued_queries = 0;
+   uint64_t running_queries = 0;
+   uint64_t admitted_queries = 0;
+   uint64_t rejected_queries = 0;
+   uint64_t cancelled_queries = 0;
+   uint64_t total_wait_time_in_microseconds = 0;
+   uint64_t max_wait_time_in_microseconds = 0;
+};
+
+struct QuerySchedulerInfo {
+   uint32_t max_concurrent_queries;
+   uint32_t max_queued_queries;
+   std::array<QueryCostClassStatistics, QUERY_COST_CLASS_COUNT> cost_classes;
+};
+
+/// Admits at most max_concurrent_queries queries at a time and keeps the others waiting in one
+/// FIFO queue per cost class. A free slot goes to the oldest waiting query of the cheapest class,
+/// so that cheap queries are not stuck behind exports. Heavy queries are additionally limited to
+/// max_concurrent_heavy_queries and run in a separate low priority task arena, such that they
+/// cannot occupy all worker threads.
+class QueryScheduler {
+   struct Ticket {
+      bool admitted = false;
+   };
+
+   class Admission {
+      QueryScheduler& scheduler;
+      QueryCostClass cost_class;
+
+     public:
+      Admission(
+         QueryScheduler& scheduler,
+         QueryCostClass cost_class,
+         const silo::query_engine::QueryContext& context
+      );
+      ~Admission();
+
+      Admission(const Admission& other) = delete;
+      Admission& operator=(const Admission& other) = delete;
+   };
+
+   QuerySchedulerConfig config;
+   tbb::task_arena heavy_arena;
+
+   mutable std::mutex mutex;
+   std::condition_variable admitted_condition;
+   std::array<std::deque<Ticket*>, QUERY_COST_CLASS_COUNT> waiting;
+   uint32_t running_queries = 0;
+   std::array<QueryCostClassStatistics, QUERY_COST_CLASS_COUNT> statistics;
+
+   void admit(QueryCostClass cost_class, const silo::query_engine::QueryContext& context);
+
+   void countCancellation(QueryCostClass cost_class);
+
+   void release(QueryCostClass cost_class);
+
+   /// Hands free slots to waiting queries, must be called with the mutex held
+   void dispatch();
+
+   [[nodiscard]] size_t waitingQueries() const;
+
+  public:
+   explicit QueryScheduler(const QuerySchedulerConfig& config);
+
+   /// Estimates the cost class of a query from its actions and the size of its filter. Invalid
+   /// queries are light, since they fail while parsing
+   static QueryCostClass estimateCostClass(const std::string& query);
+
+   /// The most expensive class of the queries of a batch query
+   static QueryCostClass estimateBatchCostClass(const std::string& batch_query);
+
+   static QueryCostClass estimateCostClass(const nlohmann::json& query);
+
+   [[nodiscard]] std::optional<std::chrono::milliseconds> getDefaultQueryTimeout() const;
+
+   /// Waits until the query is admitted and runs function with the context installed, heavy
+   /// queries in the heavy task arena. Throws QueryQueueFullException if the query cannot start
+   /// immediately and the queue is full, and QueryCancelledException if the context is cancelled
+   /// while the query waits or runs
+   template <typename Function>
+   std::invoke_result_t<Function&> run(
+      QueryCostClass cost_class,
+      const silo::query_engine::QueryContext& context,
+      Function function
+   ) {
+      const Admission admission(*this, cost_class, context);
+      const auto run_in_context = [&]() {
+         const silo::query_engine::QueryContext::Scope scope(&context);
+         return function();
+      };
+      try {
+         if (cost_class == QueryCostClass::HEAVY) {
+            return heavy_arena.execute(run_in_context);
+         }
+         return run_in_context();
+      } catch (const silo::QueryCancelledException&) {
+         countCancellation(cost_class);
+         throw;
+      }
+   }
+
+   [[nodiscard]] QuerySchedulerInfo getInfo() const;
+};
+
+}  // namespace silo_api
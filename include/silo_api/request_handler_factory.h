@@ -6,6 +6,8 @@
 
 namespace silo_api {
 class DatabaseMutex;
+class HotQueries;
+class QueryScheduler;
 }  // namespace silo_api
 
 namespace silo_api {
@@ -13,9 +15,15 @@ namespace silo_api {
 class SiloRequestHandlerFactory : public Poco::Net::HTTPRequestHandlerFactory {
   private:
    silo_api::DatabaseMutex& database;
+   silo_api::HotQueries& hot_queries;
+   silo_api::QueryScheduler& query_scheduler;
 
   public:
-   SiloRequestHandlerFactory(silo_api::DatabaseMutex& database);
+   SiloRequestHandlerFactory(
+      silo_api::DatabaseMutex& database,
+      silo_api::HotQueries& hot_queries,
+      silo_api::QueryScheduler& query_scheduler
+   );
 
    Poco::Net::HTTPRequestHandler* createRequestHandler(const Poco::Net::HTTPServerRequest& request);
 
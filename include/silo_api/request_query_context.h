@@ -0,0 +1,24 @@
+#pragma once
+
+#include <chrono>
+#include <memory>
+#include <optional>
+
+#include <Poco/Net/HTTPServerRequest.h>
+
+#include "silo/query_engine/query_context.h"
+
+namespace silo_api {
+
+/// Clients can bound the runtime of their query with this header, in milliseconds
+constexpr auto QUERY_TIMEOUT_HEADER = "query-timeout";
+
+/// Creates the context of the query sent with the request. The deadline is taken from the
+/// query-timeout header or from default_timeout. The query is cancelled when the client closes the
+/// connection. Throws QueryParseException for an invalid query-timeout header
+std::unique_ptr<silo::query_engine::QueryContext> createQueryContext(
+   Poco::Net::HTTPServerRequest& request,
+   std::optional<std::chrono::milliseconds> default_timeout
+);
+
+}  // namespace silo_api
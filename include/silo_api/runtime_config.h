@@ -1,12 +1,19 @@
 #pragma once
 
+#include <cstdint>
 #include <filesystem>
 #include <optional>
 
+#include "silo_api/query_scheduler.h"
+
 namespace silo_api {
 
 struct RuntimeConfig {
+   static constexpr uint16_t DEFAULT_PORT = 8081;
+
    std::optional<std::filesystem::path> data_directory;
+   uint16_t port = DEFAULT_PORT;
+   QuerySchedulerConfig query_scheduler;
 
    static RuntimeConfig readFromFile(const std::filesystem::path& config_path);
 };
@@ -0,0 +1,19 @@
+#include <benchmark/benchmark.h>
+#include <spdlog/sinks/null_sink.h>
+#include <spdlog/spdlog.h>
+
+#include "silo/common/log.h"
+#include "silo/roaring/roaring_allocator.h"
+
+int main(int argc, char* argv[]) {
+   silo::installRoaringAllocator();
+   spdlog::set_level(spdlog::level::warn);
+   spdlog::null_logger_mt(silo::PERFORMANCE_LOGGER_NAME);
+   benchmark::Initialize(&argc, argv);
+   if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+      return 1;
+   }
+   benchmark::RunSpecifiedBenchmarks();
+   benchmark::Shutdown();
+   return 0;
+}
@@ -0,0 +1,133 @@
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+#include <roaring/roaring.hh>
+
+#include "benchmark/synthetic_data.h"
+#include "silo/query_engine/operators/index_scan.h"
+#include "silo/query_engine/operators/intersection.h"
+#include "silo/query_engine/operators/operator.h"
+#include "silo/query_engine/operators/selection.h"
+#include "silo/query_engine/operators/threshold.h"
+#include "silo/query_engine/operators/union.h"
+
+using silo::query_engine::operators::Comparator;
+using silo::query_engine::operators::CompareToValueSelection;
+using silo::query_engine::operators::IndexScan;
+using silo::query_engine::operators::Intersection;
+using silo::query_engine::operators::Operator;
+using silo::query_engine::operators::Selection;
+using silo::query_engine::operators::Threshold;
+using silo::query_engine::operators::Union;
+
+namespace {
+
+using OperatorVector = std::vector<std::unique_ptr<Operator>>;
+
+constexpr double PERMILLE = 1000.0;
+
+double densityArgument(const benchmark::State& state) {
+   return static_cast<double>(state.range(1)) / PERMILLE;
+}
+
+/// The children of the benchmarked operator, the scanned bitmaps must outlive the operator
+struct Children {
+   std::vector<roaring::Roaring> bitmaps;
+
+   Children(uint32_t row_count, double density, int64_t count) {
+      for (int64_t child = 0; child < count; ++child) {
+         bitmaps.push_back(
+            silo::synthetic_data::generateBitmap(row_count, density, static_cast<uint32_t>(child))
+         );
+      }
+   }
+
+   OperatorVector scans(uint32_t row_count) const {
+      OperatorVector scans;
+      for (const auto& bitmap : bitmaps) {
+         scans.push_back(std::make_unique<IndexScan>(&bitmap, row_count));
+      }
+      return scans;
+   }
+};
+
+/// Rows are processed per evaluation, the throughput is reported as items per second
+void runOperator(benchmark::State& state, const Operator& under_test, uint32_t row_count) {
+   for (auto _ : state) {
+      auto result = under_test.evaluate();
+      benchmark::DoNotOptimize(result);
+   }
+   state.SetItemsProcessed(state.iterations() * row_count);
+}
+
+/// Arguments: rows, density of the children in permille, number of children
+void operatorIntersection(benchmark::State& state) {
+   const auto row_count = static_cast<uint32_t>(state.range(0));
+   const Children children(row_count, densityArgument(state), state.range(2));
+   const Intersection under_test(children.scans(row_count), OperatorVector(), row_count);
+   runOperator(state, under_test, row_count);
+}
+
+void operatorUnion(benchmark::State& state) {
+   const auto row_count = static_cast<uint32_t>(state.range(0));
+   const Children children(row_count, densityArgument(state), state.range(2));
+   const Union under_test(children.scans(row_count), row_count);
+   runOperator(state, under_test, row_count);
+}
+
+/// Matches rows that are set in at least half of the children
+void operatorThreshold(benchmark::State& state) {
+   const auto row_count = static_cast<uint32_t>(state.range(0));
+   const Children children(row_count, densityArgument(state), state.range(2));
+   const Threshold under_test(
+      children.scans(row_count),
+      OperatorVector(),
+      static_cast<uint32_t>(state.range(2) / 2),
+      false,
+      row_count
+   );
+   runOperator(state, under_test, row_count);
+}
+
+/// Arguments: rows, selectivity of the predicate in permille
+void operatorSelection(benchmark::State& state) {
+   const auto row_count = static_cast<uint32_t>(state.range(0));
+   const int32_t max_value = 1000;
+   const auto column = silo::synthetic_data::generateIntColumn(row_count, max_value - 1, 0);
+   const Selection under_test(
+      std::make_unique<CompareToValueSelection<int32_t>>(
+         column, Comparator::LESS, static_cast<int32_t>(state.range(1))
+      ),
+      row_count
+   );
+   runOperator(state, under_test, row_count);
+}
+
+void bitmapArguments(benchmark::internal::Benchmark* benchmark) {
+   benchmark->ArgNames({"rows", "density_permille", "children"});
+   for (const int64_t row_count : {1 << 16, 1 << 20}) {
+      for (const int64_t density : {1, 10, 100, 500}) {
+         for (const int64_t child_count : {2, 8, 32}) {
+            benchmark->Args({row_count, density, child_count});
+         }
+      }
+   }
+}
+
+void selectionArguments(benchmark::internal::Benchmark* benchmark) {
+   benchmark->ArgNames({"rows", "selectivity_permille"});
+   for (const int64_t row_count : {1 << 16, 1 << 20}) {
+      for (const int64_t selectivity : {1, 10, 100, 500}) {
+         benchmark->Args({row_count, selectivity});
+      }
+   }
+}
+
+}  // namespace
+
+BENCHMARK(operatorIntersection)->Apply(bitmapArguments)->Unit(benchmark::kMicrosecond);
+BENCHMARK(operatorUnion)->Apply(bitmapArguments)->Unit(benchmark::kMicrosecond);
+BENCHMARK(operatorThreshold)->Apply(bitmapArguments)->Unit(benchmark::kMicrosecond);
+BENCHMARK(operatorSelection)->Apply(selectionArguments)->Unit(benchmark::kMicrosecond);
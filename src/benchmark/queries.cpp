@@ -0,0 +1,95 @@
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+#include <fmt/format.h>
+
+#include "benchmark/synthetic_data.h"
+#include "silo/database.h"
+
+namespace {
+
+constexpr size_t GENOME_LENGTH = 30'000;
+
+const std::vector<int64_t> SEQUENCE_COUNTS{1'000, 10'000};
+
+/// Queries by name. They cover the actions on a full filter and the filter operators with an
+/// action that does little work
+const std::vector<std::pair<std::string, std::string>> QUERIES{
+   {"Aggregated",
+    R"({"action":{"type":"Aggregated"},"filterExpression":{"type":"True"}})"},
+   {"AggregatedByCountry",
+    R"({"action":{"type":"Aggregated","groupByFields":["country"]},)"
+    R"("filterExpression":{"type":"True"}})"},
+   {"Mutations",
+    R"({"action":{"type":"Mutations","minProportion":0.05},"filterExpression":{"type":"True"}})"},
+   {"Details",
+    R"({"action":{"type":"Details","fields":["key","date","country","age"]},)"
+    R"("filterExpression":{"type":"True"}})"},
+   {"DetailsOrderedByDate",
+    R"({"action":{"type":"Details","fields":["key","date"],"orderByFields":["date"],"limit":100},)"
+    R"("filterExpression":{"type":"True"}})"},
+   {"FilterAndOfStringAndInt",
+    R"({"action":{"type":"Aggregated"},"filterExpression":{"type":"And","children":[)"
+    R"({"type":"StringEquals","column":"country","value":"Switzerland"},)"
+    R"({"type":"IntBetween","column":"age","from":20,"to":60}]}})"},
+   {"FilterOrOfNucleotides",
+    R"({"action":{"type":"Aggregated"},"filterExpression":{"type":"Or","children":[)"
+    R"({"type":"NucleotideEquals","position":100,"symbol":"N"},)"
+    R"({"type":"NucleotideEquals","position":200,"symbol":"N"},)"
+    R"({"type":"NucleotideEquals","position":300,"symbol":"N"}]}})"},
+   {"FilterNOfNucleotides",
+    R"({"action":{"type":"Aggregated"},"filterExpression":{"type":"N-Of","numberOfMatchers":2,)"
+    R"("matchExactly":false,"children":[)"
+    R"({"type":"NucleotideEquals","position":100,"symbol":"N"},)"
+    R"({"type":"NucleotideEquals","position":200,"symbol":"N"},)"
+    R"({"type":"NucleotideEquals","position":300,"symbol":"N"},)"
+    R"({"type":"NucleotideEquals","position":400,"symbol":"N"}]}})"},
+};
+
+/// The databases are generated once per size, on first use
+const silo::Database& generatedDatabase(size_t sequence_count) {
+   static std::map<size_t, std::unique_ptr<silo::Database>> databases;
+   auto& database = databases[sequence_count];
+   if (database == nullptr) {
+      const auto directory = std::filesystem::temp_directory_path() / "silo_benchmark" /
+                             fmt::format("{}_sequences", sequence_count);
+      // Removes the files of previous runs. The directory is kept afterwards, the unaligned
+      // sequences of the database are read from it
+      std::filesystem::remove_all(directory);
+      database = std::make_unique<silo::Database>(
+         silo::synthetic_data::generateDatabase(sequence_count, GENOME_LENGTH, directory)
+      );
+   }
+   return *database;
+}
+
+/// Argument: number of sequences of the database, the throughput is reported as sequences
+/// per second
+void query(benchmark::State& state, const std::string& query_string) {
+   const auto sequence_count = static_cast<size_t>(state.range(0));
+   const silo::Database& under_test = generatedDatabase(sequence_count);
+   for (auto _ : state) {
+      auto result = under_test.executeQuery(query_string);
+      benchmark::DoNotOptimize(result);
+   }
+   state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(sequence_count));
+}
+
+[[maybe_unused]] const bool REGISTERED = []() {
+   for (const auto& [name, query_string] : QUERIES) {
+      benchmark::RegisterBenchmark(fmt::format("query/{}", name).c_str(), query, query_string)
+         ->ArgName("sequences")
+         ->ArgsProduct({SEQUENCE_COUNTS})
+         ->Unit(benchmark::kMillisecond);
+   }
+   return true;
+}();
+
+}  // namespace
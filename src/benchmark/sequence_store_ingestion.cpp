@@ -0,0 +1,71 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "benchmark/synthetic_data.h"
+#include "silo/common/nucleotide_symbols.h"
+#include "silo/storage/sequence_store.h"
+
+namespace {
+
+constexpr size_t SEQUENCE_COUNT = 2'000;
+constexpr size_t GENOME_LENGTH = 30'000;
+constexpr uint32_t SEED = 42;
+constexpr double PERMILLE = 1000.0;
+
+/// Arguments: buffer size, tile size, mutation rate in permille. Measures how fast aligned
+/// sequences are added to a dense sequence store, the throughput is reported in bytes of
+/// sequences per second
+void sequenceStoreIngestion(benchmark::State& state) {
+   const silo::SequenceIngestionOptions options{
+      static_cast<size_t>(state.range(0)), static_cast<size_t>(state.range(1))
+   };
+   const double mutation_rate = static_cast<double>(state.range(2)) / PERMILLE;
+
+   const std::string reference_string = silo::synthetic_data::generateReference(GENOME_LENGTH);
+   const auto reference = silo::Nucleotide::stringToSymbolVector(reference_string).value();
+   const auto genomes = silo::synthetic_data::generateGenomes(
+      reference_string, SEQUENCE_COUNT, mutation_rate, SEED
+   );
+
+   std::vector<std::vector<std::optional<std::string>>> buffers;
+   for (size_t offset = 0; offset < genomes.size(); offset += options.buffer_size) {
+      const auto end = std::min(genomes.size(), offset + options.buffer_size);
+      buffers.emplace_back(
+         genomes.begin() + static_cast<std::ptrdiff_t>(offset),
+         genomes.begin() + static_cast<std::ptrdiff_t>(end)
+      );
+   }
+
+   for (auto _ : state) {
+      state.PauseTiming();
+      auto store = std::make_unique<silo::SequenceStore<silo::Nucleotide>>(
+         reference, silo::SequenceStoreLayout::DENSE
+      );
+      auto& partition = store->createPartition();
+      state.ResumeTiming();
+      for (const auto& buffer : buffers) {
+         partition.interpret(buffer, options);
+      }
+      benchmark::DoNotOptimize(partition);
+      state.PauseTiming();
+      store.reset();
+      state.ResumeTiming();
+   }
+   state.SetBytesProcessed(
+      state.iterations() * static_cast<int64_t>(SEQUENCE_COUNT * GENOME_LENGTH)
+   );
+}
+
+}  // namespace
+
+BENCHMARK(sequenceStoreIngestion)
+   ->ArgNames({"buffer_size", "tile_size", "mutation_permille"})
+   ->ArgsProduct({{256, 1024, 4096}, {16, 64, 256}, {1, 10}})
+   ->Unit(benchmark::kMillisecond);
@@ -0,0 +1,176 @@
+#include "benchmark/synthetic_data.h"
+
+#include <fstream>
+#include <map>
+#include <random>
+#include <string_view>
+#include <utility>
+
+#include <fmt/format.h>
+
+#include "silo/config/config_repository.h"
+#include "silo/preprocessing/preprocessing_config.h"
+#include "silo/preprocessing/preprocessing_config_reader.h"
+#include "silo/preprocessing/preprocessor.h"
+#include "silo/preprocessing/sql_function.h"
+#include "silo/storage/reference_genomes.h"
+
+namespace silo::synthetic_data {
+
+namespace {
+
+constexpr double MISSING_RATE = 0.01;
+constexpr uint32_t REFERENCE_SEED = 42;
+constexpr uint32_t DATABASE_SEED = 7;
+constexpr double DATABASE_MUTATION_RATE = 0.001;
+constexpr int32_t MAX_AGE = 100;
+constexpr int DAYS_PER_MONTH = 28;
+
+const std::vector<std::string> COUNTRIES{
+   "Switzerland", "Germany", "France", "Italy", "Austria", "Spain", "Denmark", "Sweden"
+};
+
+constexpr std::string_view DATABASE_CONFIG = R"(schema:
+  instanceName: benchmark
+  metadata:
+    - name: key
+      type: string
+    - name: date
+      type: date
+    - name: country
+      type: string
+      generateIndex: true
+    - name: age
+      type: int
+  primaryKey: key
+  dateToSortBy: date
+)";
+
+void writeFasta(
+   const std::filesystem::path& filename,
+   const std::vector<std::optional<std::string>>& genomes
+) {
+   std::ofstream file(filename);
+   for (size_t row = 0; row < genomes.size(); ++row) {
+      file << ">key_" << row << '\n' << *genomes[row] << '\n';
+   }
+}
+
+}  // namespace
+
+roaring::Roaring generateBitmap(uint32_t row_count, double density, uint32_t seed) {
+   std::mt19937 generator(seed);
+   std::bernoulli_distribution is_set(density);
+   roaring::Roaring bitmap;
+   for (uint32_t row = 0; row < row_count; ++row) {
+      if (is_set(generator)) {
+         bitmap.add(row);
+      }
+   }
+   bitmap.runOptimize();
+   return bitmap;
+}
+
+std::vector<int32_t> generateIntColumn(size_t row_count, int32_t max_value, uint32_t seed) {
+   std::mt19937 generator(seed);
+   std::uniform_int_distribution<int32_t> value(0, max_value);
+   std::vector<int32_t> column(row_count);
+   for (int32_t& entry : column) {
+      entry = value(generator);
+   }
+   return column;
+}
+
+std::string generateReference(size_t genome_length) {
+   std::mt19937 generator(REFERENCE_SEED);
+   std::uniform_int_distribution<size_t> reference_character(0, 3);
+   std::string reference(genome_length, 'A');
+   for (char& character : reference) {
+      character = "ACGT"[reference_character(generator)];
+   }
+   return reference;
+}
+
+std::vector<std::optional<std::string>> generateGenomes(
+   const std::string& reference,
+   size_t sequence_count,
+   double mutation_rate,
+   uint32_t seed
+) {
+   static constexpr std::string_view MUTATION_CHARACTERS = "ACGT-";
+   std::mt19937 generator(seed);
+   std::uniform_real_distribution<double> probability(0.0, 1.0);
+   std::uniform_int_distribution<size_t> mutation_character(0, MUTATION_CHARACTERS.size() - 1);
+
+   std::vector<std::optional<std::string>> genomes;
+   genomes.reserve(sequence_count);
+   for (size_t sequence = 0; sequence < sequence_count; ++sequence) {
+      std::string genome = reference;
+      for (char& character : genome) {
+         const double draw = probability(generator);
+         if (draw < MISSING_RATE) {
+            character = 'N';
+         } else if (draw < MISSING_RATE + mutation_rate) {
+            character = MUTATION_CHARACTERS[mutation_character(generator)];
+         }
+      }
+      genomes.emplace_back(std::move(genome));
+   }
+   return genomes;
+}
+
+Database generateDatabase(
+   size_t sequence_count,
+   size_t genome_length,
+   const std::filesystem::path& directory
+) {
+   std::filesystem::create_directories(directory);
+
+   const std::string reference = generateReference(genome_length);
+   ReferenceGenomes({{"main", reference}}, {}).writeToFile(directory / "reference_genomes.json");
+
+   const auto genomes =
+      generateGenomes(reference, sequence_count, DATABASE_MUTATION_RATE, DATABASE_SEED);
+   writeFasta(directory / "nuc_main.fasta", genomes);
+   writeFasta(directory / "unaligned_main.fasta", genomes);
+
+   std::mt19937 generator(DATABASE_SEED);
+   std::uniform_int_distribution<size_t> country(0, COUNTRIES.size() - 1);
+   std::uniform_int_distribution<int> month(1, 12);
+   std::uniform_int_distribution<int> day(1, DAYS_PER_MONTH);
+   std::uniform_int_distribution<int32_t> age(0, MAX_AGE);
+   std::ofstream metadata(directory / "metadata.tsv");
+   metadata << "key\tdate\tcountry\tage\n";
+   for (size_t row = 0; row < sequence_count; ++row) {
+      // The order of evaluation of function arguments is unspecified, draw in a fixed order
+      const int row_month = month(generator);
+      const int row_day = day(generator);
+      const std::string& row_country = COUNTRIES[country(generator)];
+      const int32_t row_age = age(generator);
+      metadata << fmt::format(
+         "key_{}\t2023-{:02}-{:02}\t{}\t{}\n", row, row_month, row_day, row_country, row_age
+      );
+   }
+   metadata.close();
+
+   std::ofstream(directory / "database_config.yaml") << DATABASE_CONFIG;
+
+   preprocessing::OptionalPreprocessingConfig optional_config;
+   optional_config.input_directory = directory;
+   optional_config.output_directory = directory / "output";
+   optional_config.intermediate_results_directory = directory / "temp";
+   const auto preprocessing_config =
+      optional_config.mergeValuesFromOrDefault(preprocessing::OptionalPreprocessingConfig());
+
+   const auto database_config =
+      config::ConfigRepository().getValidatedConfig(directory / "database_config.yaml");
+   const auto reference_genomes =
+      ReferenceGenomes::readFromFile(preprocessing_config.getReferenceGenomeFilename());
+
+   preprocessing::Preprocessor preprocessor(
+      preprocessing_config, database_config, reference_genomes
+   );
+   return preprocessor.preprocess();
+}
+
+}  // namespace silo::synthetic_data
@@ -4,8 +4,10 @@
 #include <spdlog/spdlog.h>
 
 #include "silo/common/log.h"
+#include "silo/roaring/roaring_allocator.h"
 
 int main(int argc, char* argv[]) {
+   silo::installRoaringAllocator();
    spdlog::set_level(spdlog::level::info);
    spdlog::null_logger_mt(silo::PERFORMANCE_LOGGER_NAME);
    ::testing::InitGoogleMock(&argc, argv);
@@ -1,5 +1,6 @@
 #include "silo/common/bidirectional_map.h"
 
+#include <mutex>
 #include <optional>
 #include <string>
 
@@ -19,16 +20,21 @@ V BidirectionalMap<V>::getValue(Idx idx) const {
 
 template <typename V>
 std::optional<Idx> BidirectionalMap<V>::getId(V value) const {
-   if (value_to_id.contains(value)) {
-      return value_to_id.at(value);
+   const auto iterator = value_to_id.find(value);
+   if (iterator != value_to_id.end()) {
+      return iterator->second;
    }
    return std::nullopt;
 }
 
 template <typename V>
 Idx BidirectionalMap<V>::getOrCreateId(V value) {
-   if (value_to_id.contains(value)) {
-      return value_to_id.at(value);
+   if (const auto existing_id = getId(value)) {
+      return *existing_id;
+   }
+   const std::lock_guard<std::mutex> lock(mutex);
+   if (const auto existing_id = getId(value)) {
+      return *existing_id;
    }
    const Idx identifier = id_to_value.size();
    id_to_value.push_back(value);
@@ -46,10 +46,7 @@ silo::common::Date silo::common::stringToDate(const std::string& value) {
          SPDLOG_WARN("Month is not in [1,{}]: {} \nIgnoring date", NUMBER_OF_DAYS, value);
          return NULL_DATE;
       }
-      // Date is stored with the year in the upper 16 bits, month in bits [12,16), and day [0,12)
-      const uint32_t date_value =
-         (year << (BYTES_FOR_MONTHS + BYTES_FOR_DAYS)) + (month << BYTES_FOR_DAYS) + day;
-      return Date{date_value};
+      return dateFromYearMonthDay(year, month, day);
    } catch (const std::invalid_argument& ex) {
       SPDLOG_WARN(
          "Parsing of date failed: " + value + "\nWith exception: " + ex.what() + "\nIgnoring date"
@@ -63,6 +60,15 @@ silo::common::Date silo::common::stringToDate(const std::string& value) {
    }
 }
 
+silo::common::Date silo::common::dateFromYearMonthDay(
+   uint32_t year,
+   uint32_t month,
+   uint32_t day
+) {
+   // Date is stored with the year in the upper 16 bits, month in bits [12,16), and day [0,12)
+   return Date{(year << (BYTES_FOR_MONTHS + BYTES_FOR_DAYS)) + (month << BYTES_FOR_DAYS) + day};
+}
+
 std::optional<std::string> silo::common::dateToString(silo::common::Date date) {
    if (date == 0) {
       return std::nullopt;
@@ -0,0 +1,330 @@
+#include "silo/common/fasta_block_reader.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <optional>
+#include <utility>
+
+#include <fmt/format.h>
+#include <lzma.h>
+#include <oneapi/tbb/blocked_range.h>
+#include <oneapi/tbb/parallel_for.h>
+#include <zstd.h>
+#include <boost/iostreams/device/mapped_file.hpp>
+
+#include "silo/common/fasta_format_exception.h"
+#include "silo/common/input_stream_wrapper.h"
+#include "silo/preprocessing/preprocessing_exception.h"
+
+namespace silo {
+
+class FastaBlockReader::Decoder {
+  public:
+   virtual ~Decoder() = default;
+
+   virtual bool next(FastaBlock& block, size_t block_size, std::string& carry_over) = 0;
+};
+
+}  // namespace silo
+
+namespace {
+
+using silo::FastaBlock;
+using silo::preprocessing::PreprocessingException;
+
+/// Every record starts with '>' at the beginning of a line and genomes never contain '>'
+size_t findLastRecordStart(std::string_view text) {
+   const size_t newline = text.rfind("\n>");
+   return newline == std::string_view::npos ? std::string_view::npos : newline + 1;
+}
+
+boost::iostreams::mapped_file_source mapFile(const std::filesystem::path& path) {
+   boost::iostreams::mapped_file_source file;
+   // Empty files cannot be mapped
+   if (std::filesystem::file_size(path) > 0) {
+      file.open(path.string());
+   }
+   return file;
+}
+
+std::string_view mappedView(const boost::iostreams::mapped_file_source& file) {
+   if (!file.is_open()) {
+      return {};
+   }
+   return {file.data(), file.size()};
+}
+
+class MappedFileDecoder : public silo::FastaBlockReader::Decoder {
+   boost::iostreams::mapped_file_source file;
+   std::string_view input;
+   size_t position = 0;
+
+  public:
+   explicit MappedFileDecoder(const std::filesystem::path& path)
+       : file(mapFile(path)),
+         input(mappedView(file)) {}
+
+   bool next(FastaBlock& block, size_t block_size, std::string& /*carry_over*/) override {
+      if (position == input.size()) {
+         return false;
+      }
+      size_t end = std::min(input.size(), position + block_size);
+      if (end < input.size()) {
+         const size_t record_start = findLastRecordStart(input.substr(position, end - position));
+         if (record_start != std::string_view::npos) {
+            end = position + record_start;
+         } else {
+            const size_t next_record = input.find("\n>", end);
+            end = next_record == std::string_view::npos ? input.size() : next_record + 1;
+         }
+      }
+      block.storage.clear();
+      block.text = input.substr(position, end - position);
+      position = end;
+      return true;
+   }
+};
+
+/// Decoders that produce the input as a stream of decompressed bytes. Records that are cut at the
+/// end of a block are carried over to the next block
+class StreamingDecoder : public silo::FastaBlockReader::Decoder {
+   bool more_input = true;
+
+  protected:
+   /// Appends up to count decompressed bytes, returns false once the end of the input is reached
+   virtual bool append(std::string& out, size_t count) = 0;
+
+  public:
+   bool next(FastaBlock& block, size_t block_size, std::string& carry_over) final {
+      block.storage = std::move(carry_over);
+      carry_over.clear();
+      size_t record_end = std::string::npos;
+      while (more_input && record_end == std::string::npos) {
+         more_input = append(block.storage, block_size);
+         record_end = findLastRecordStart(block.storage);
+      }
+      if (!more_input) {
+         record_end = block.storage.size();
+      }
+      carry_over.assign(block.storage, record_end);
+      block.storage.resize(record_end);
+      block.text = block.storage;
+      return !block.storage.empty();
+   }
+};
+
+class StreamDecoder : public StreamingDecoder {
+   silo::InputStreamWrapper input;
+
+  protected:
+   bool append(std::string& out, size_t count) override {
+      const size_t old_size = out.size();
+      out.resize(old_size + count);
+      input.getInputStream().read(out.data() + old_size, static_cast<std::streamsize>(count));
+      const auto read_count = static_cast<size_t>(input.getInputStream().gcount());
+      out.resize(old_size + read_count);
+      return read_count == count;
+   }
+
+  public:
+   explicit StreamDecoder(const std::filesystem::path& path)
+       : input(path) {}
+};
+
+struct ZstdFrame {
+   size_t offset;
+   size_t compressed_size;
+   size_t content_size;
+};
+
+/// Returns std::nullopt if the size of any frame is not stored in its header
+std::optional<std::vector<ZstdFrame>> findFramesWithKnownSize(std::string_view input) {
+   std::vector<ZstdFrame> frames;
+   size_t offset = 0;
+   while (offset < input.size()) {
+      const char* frame = input.data() + offset;
+      const size_t remaining = input.size() - offset;
+      const size_t compressed_size = ZSTD_findFrameCompressedSize(frame, remaining);
+      if (ZSTD_isError(compressed_size)) {
+         throw PreprocessingException(fmt::format(
+            "Invalid zstd frame at byte {}: {}", offset, ZSTD_getErrorName(compressed_size)
+         ));
+      }
+      const auto content_size = ZSTD_getFrameContentSize(frame, remaining);
+      if (content_size == ZSTD_CONTENTSIZE_UNKNOWN || content_size == ZSTD_CONTENTSIZE_ERROR) {
+         return std::nullopt;
+      }
+      frames.push_back({offset, compressed_size, static_cast<size_t>(content_size)});
+      offset += compressed_size;
+   }
+   return frames;
+}
+
+class ZstdFramesDecoder : public StreamingDecoder {
+   boost::iostreams::mapped_file_source file;
+   std::vector<ZstdFrame> frames;
+   size_t next_frame = 0;
+
+  protected:
+   bool append(std::string& out, size_t count) override {
+      const size_t first_frame = next_frame;
+      std::vector<size_t> output_offsets;
+      size_t output_offset = out.size();
+      size_t appended = 0;
+      while (next_frame < frames.size() && appended < count) {
+         output_offsets.push_back(output_offset);
+         output_offset += frames[next_frame].content_size;
+         appended += frames[next_frame].content_size;
+         ++next_frame;
+      }
+      out.resize(output_offset);
+
+      const std::string_view input = mappedView(file);
+      tbb::parallel_for(
+         tbb::blocked_range<size_t>(first_frame, next_frame, 1),
+         [&](const auto& local) {
+            for (size_t frame_index = local.begin(); frame_index != local.end(); ++frame_index) {
+               const auto& frame = frames[frame_index];
+               const size_t result = ZSTD_decompress(
+                  out.data() + output_offsets[frame_index - first_frame],
+                  frame.content_size,
+                  input.data() + frame.offset,
+                  frame.compressed_size
+               );
+               if (ZSTD_isError(result) || result != frame.content_size) {
+                  throw PreprocessingException(fmt::format(
+                     "Could not decompress the zstd frame at byte {}", frame.offset
+                  ));
+               }
+            }
+         }
+      );
+      return next_frame < frames.size();
+   }
+
+  public:
+   ZstdFramesDecoder(boost::iostreams::mapped_file_source file, std::vector<ZstdFrame> frames)
+       : file(std::move(file)),
+         frames(std::move(frames)) {}
+};
+
+class XzDecoder : public StreamingDecoder {
+   boost::iostreams::mapped_file_source file;
+   lzma_stream stream = LZMA_STREAM_INIT;
+   bool finished = false;
+
+  protected:
+   bool append(std::string& out, size_t count) override {
+      if (finished) {
+         return false;
+      }
+      const size_t old_size = out.size();
+      out.resize(old_size + count);
+      stream.next_out = reinterpret_cast<uint8_t*>(out.data() + old_size);
+      stream.avail_out = count;
+      while (stream.avail_out > 0) {
+         const lzma_ret result = lzma_code(&stream, LZMA_FINISH);
+         if (result == LZMA_STREAM_END) {
+            finished = true;
+            break;
+         }
+         if (result != LZMA_OK) {
+            throw PreprocessingException(
+               fmt::format("liblzma failed with error {}", static_cast<int>(result))
+            );
+         }
+      }
+      out.resize(old_size + count - stream.avail_out);
+      return !finished;
+   }
+
+  public:
+   explicit XzDecoder(const std::filesystem::path& path)
+       : file(mapFile(path)) {
+#if LZMA_VERSION >= 50040002
+      lzma_mt options{};
+      options.flags = LZMA_CONCATENATED;
+      options.threads = std::max<uint32_t>(1, lzma_cputhreads());
+      options.memlimit_threading = lzma_physmem() / 4;
+      options.memlimit_stop = UINT64_MAX;
+      const lzma_ret result = lzma_stream_decoder_mt(&stream, &options);
+#else
+      const lzma_ret result = lzma_stream_decoder(&stream, UINT64_MAX, LZMA_CONCATENATED);
+#endif
+      if (result != LZMA_OK) {
+         throw PreprocessingException(fmt::format(
+            "Could not initialize the xz decoder for {}, error {}",
+            path.string(),
+            static_cast<int>(result)
+         ));
+      }
+      const std::string_view input = mappedView(file);
+      stream.next_in = reinterpret_cast<const uint8_t*>(input.data());
+      stream.avail_in = input.size();
+   }
+
+   ~XzDecoder() override { lzma_end(&stream); }
+
+   XzDecoder(const XzDecoder& other) = delete;
+   XzDecoder& operator=(const XzDecoder& other) = delete;
+};
+
+std::unique_ptr<silo::FastaBlockReader::Decoder> createDecoder(const std::filesystem::path& path) {
+   const auto [resolved_path, compression] = silo::resolveInputFile(path);
+   switch (compression) {
+      case silo::InputCompression::NONE:
+         return std::make_unique<MappedFileDecoder>(resolved_path);
+      case silo::InputCompression::XZ:
+         return std::make_unique<XzDecoder>(resolved_path);
+      case silo::InputCompression::ZSTD: {
+         auto file = mapFile(resolved_path);
+         auto frames = findFramesWithKnownSize(mappedView(file));
+         if (frames.has_value() && frames->size() > 1) {
+            return std::make_unique<ZstdFramesDecoder>(std::move(file), std::move(*frames));
+         }
+         return std::make_unique<StreamDecoder>(resolved_path);
+      }
+   }
+   throw std::logic_error("Unhandled input compression");
+}
+
+}  // namespace
+
+namespace silo {
+
+FastaBlockReader::FastaBlockReader(const std::filesystem::path& in_file_name, size_t block_size)
+    : decoder(createDecoder(in_file_name)),
+      block_size(block_size) {}
+
+FastaBlockReader::~FastaBlockReader() = default;
+
+bool FastaBlockReader::next(FastaBlock& block) {
+   return decoder->next(block, block_size, carry_over);
+}
+
+void FastaBlockReader::parse(std::string_view text, std::vector<FastaRecord>& records) {
+   size_t position = 0;
+   while (position < text.size()) {
+      // string_view::find compiles to memchr, which scans for the line ends with SIMD
+      const size_t key_end = std::min(text.find('\n', position), text.size());
+      const std::string_view key_line = text.substr(position, key_end - position);
+      if (key_line.empty() || key_line.front() != '>') {
+         throw FastaFormatException(
+            "Fasta key prefix '>' missing for key: " + std::string(key_line)
+         );
+      }
+      if (key_end + 1 >= text.size()) {
+         throw FastaFormatException(
+            "Missing genome sequence in line following key: " + std::string(key_line.substr(1))
+         );
+      }
+      const size_t genome_begin = key_end + 1;
+      const size_t genome_end = std::min(text.find('\n', genome_begin), text.size());
+      records.push_back(
+         {key_line.substr(1), text.substr(genome_begin, genome_end - genome_begin)}
+      );
+      position = genome_end + 1;
+   }
+}
+
+}  // namespace silo
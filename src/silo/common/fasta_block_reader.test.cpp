@@ -0,0 +1,102 @@
+#include "silo/common/fasta_block_reader.h"
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <zstd.h>
+
+#include "silo/common/fasta_format_exception.h"
+#include "silo/common/fasta_reader.h"
+
+using silo::FastaBlock;
+using silo::FastaBlockReader;
+using silo::FastaRecord;
+
+namespace {
+
+std::vector<std::pair<std::string, std::string>> readAllRecords(FastaBlockReader& reader) {
+   std::vector<std::pair<std::string, std::string>> result;
+   FastaBlock block;
+   while (reader.next(block)) {
+      std::vector<FastaRecord> records;
+      FastaBlockReader::parse(block.text, records);
+      for (const auto& record : records) {
+         result.emplace_back(record.key, record.genome);
+      }
+   }
+   return result;
+}
+
+std::vector<std::pair<std::string, std::string>> readAllRecords(silo::FastaReader& reader) {
+   std::vector<std::pair<std::string, std::string>> result;
+   std::string genome;
+   while (auto key = reader.next(genome)) {
+      result.emplace_back(*key, genome);
+   }
+   return result;
+}
+
+}  // namespace
+
+TEST(FastaBlockReader, shouldReadFastaFileForAnyBlockSize) {
+   const std::vector<std::pair<std::string, std::string>> expected{
+      {"Key1", "ACGT"}, {"Key2", "CGTA"}
+   };
+   for (const size_t block_size : {1, 5, 11, 1024}) {
+      FastaBlockReader under_test("testBaseData/fastaFiles/test.fasta", block_size);
+      EXPECT_EQ(readAllRecords(under_test), expected);
+   }
+}
+
+TEST(FastaBlockReader, shouldReadFastaFileWithoutNewLineAtEnd) {
+   FastaBlockReader under_test("testBaseData/fastaFiles/no_end_new_line.fasta");
+
+   const std::vector<std::pair<std::string, std::string>> expected{{"Key", "ACGT"}};
+   EXPECT_EQ(readAllRecords(under_test), expected);
+}
+
+TEST(FastaBlockReader, shouldThrowForMalformedInput) {
+   FastaBlockReader missing_genome("testBaseData/fastaFiles/missing_genome.fasta");
+   EXPECT_THROW(readAllRecords(missing_genome), silo::FastaFormatException);
+
+   FastaBlockReader wrong_format("testBaseData/fastaFiles/wrong_format.fasta");
+   EXPECT_THROW(readAllRecords(wrong_format), silo::FastaFormatException);
+}
+
+TEST(FastaBlockReader, shouldReadCompressedFilesLikeFastaReader) {
+   for (const std::string file : {
+           "testBaseData/exampleDataset/nuc_main.fasta.zst",
+           "testBaseData/exampleDataset/gene_S.fasta.xz",
+        }) {
+      silo::FastaReader reference_reader(file);
+      FastaBlockReader under_test(file, 4096);
+      EXPECT_EQ(readAllRecords(under_test), readAllRecords(reference_reader));
+   }
+}
+
+TEST(FastaBlockReader, shouldReadZstdFileWithSeveralFrames) {
+   const std::vector<std::string> frame_contents{">Key1\nACGT\n>Ke", "y2\nCGTA\n", ">Key3\nAAAA\n"};
+   const std::filesystem::path file_name =
+      std::filesystem::temp_directory_path() / "fasta_block_reader_frames.fasta.zst";
+   {
+      std::ofstream file(file_name, std::ios::binary);
+      for (const auto& content : frame_contents) {
+         std::string frame(ZSTD_compressBound(content.size()), '\0');
+         const size_t frame_size =
+            ZSTD_compress(frame.data(), frame.size(), content.data(), content.size(), 1);
+         file.write(frame.data(), static_cast<std::streamsize>(frame_size));
+      }
+   }
+
+   FastaBlockReader under_test(file_name, 1);
+
+   const std::vector<std::pair<std::string, std::string>> expected{
+      {"Key1", "ACGT"}, {"Key2", "CGTA"}, {"Key3", "AAAA"}
+   };
+   EXPECT_EQ(readAllRecords(under_test), expected);
+   std::filesystem::remove(file_name);
+}
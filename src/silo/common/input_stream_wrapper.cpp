@@ -23,23 +23,38 @@ std::filesystem::path withZSTending(const std::filesystem::path& filename) {
 }  // namespace
 
 namespace silo {
-InputStreamWrapper::InputStreamWrapper(const std::filesystem::path& filename)
-    : input_stream(std::make_unique<boost::iostreams::filtering_istream>()) {
+
+ResolvedInputFile resolveInputFile(const std::filesystem::path& filename) {
    if (std::filesystem::is_regular_file(withZSTending(filename))) {
       SPDLOG_INFO("Detected file-ending .zst for input file " + filename.string());
-      file = std::ifstream(withZSTending(filename), std::ios::binary);
-      input_stream->push(boost::iostreams::zstd_decompressor());
-   } else if (std::filesystem::is_regular_file(withXZending(filename))) {
+      return {withZSTending(filename), InputCompression::ZSTD};
+   }
+   if (std::filesystem::is_regular_file(withXZending(filename))) {
       SPDLOG_INFO("Detected file-ending .xz for input file " + filename.string());
-      file = std::ifstream(withXZending(filename), std::ios::binary);
-      input_stream->push(boost::iostreams::lzma_decompressor());
-   } else if (std::filesystem::is_regular_file(filename)) {
+      return {withXZending(filename), InputCompression::XZ};
+   }
+   if (std::filesystem::is_regular_file(filename)) {
       SPDLOG_INFO("Detected file without specialized ending, processing raw: " + filename.string());
-      file = std::ifstream(filename, std::ios::binary);
-   } else {
-      throw silo::preprocessing::PreprocessingException(
-         "Cannot find file with name or associated endings (.xz, .zst): " + filename.string()
-      );
+      return {filename, InputCompression::NONE};
+   }
+   throw silo::preprocessing::PreprocessingException(
+      "Cannot find file with name or associated endings (.xz, .zst): " + filename.string()
+   );
+}
+
+InputStreamWrapper::InputStreamWrapper(const std::filesystem::path& filename)
+    : input_stream(std::make_unique<boost::iostreams::filtering_istream>()) {
+   const auto [path, compression] = resolveInputFile(filename);
+   file = std::ifstream(path, std::ios::binary);
+   switch (compression) {
+      case InputCompression::ZSTD:
+         input_stream->push(boost::iostreams::zstd_decompressor());
+         break;
+      case InputCompression::XZ:
+         input_stream->push(boost::iostreams::lzma_decompressor());
+         break;
+      case InputCompression::NONE:
+         break;
    }
    input_stream->push(file);
 }
@@ -0,0 +1,191 @@
+#include "silo/common/metrics.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include <fmt/format.h>
+
+namespace silo {
+
+double microsecondsToSeconds(int64_t microseconds) {
+   return static_cast<double>(microseconds) / 1'000'000;
+}
+
+void MetricCounter::increment(double amount) {
+   value.fetch_add(amount, std::memory_order_relaxed);
+}
+
+double MetricCounter::get() const {
+   return value.load(std::memory_order_relaxed);
+}
+
+MetricHistogram::MetricHistogram(std::vector<double> upper_bounds)
+    : upper_bounds(std::move(upper_bounds)),
+      bucket_counts(this->upper_bounds.size() + 1) {
+   std::sort(this->upper_bounds.begin(), this->upper_bounds.end());
+}
+
+void MetricHistogram::observe(double value) {
+   const auto bucket =
+      std::lower_bound(upper_bounds.begin(), upper_bounds.end(), value) - upper_bounds.begin();
+   bucket_counts[bucket].fetch_add(1, std::memory_order_relaxed);
+   sum.fetch_add(value, std::memory_order_relaxed);
+}
+
+MetricHistogramValues MetricHistogram::get() const {
+   MetricHistogramValues values;
+   values.upper_bounds = upper_bounds;
+   values.cumulative_counts.reserve(bucket_counts.size());
+   uint64_t cumulative_count = 0;
+   for (const auto& bucket_count : bucket_counts) {
+      cumulative_count += bucket_count.load(std::memory_order_relaxed);
+      values.cumulative_counts.push_back(cumulative_count);
+   }
+   values.sum = sum.load(std::memory_order_relaxed);
+   return values;
+}
+
+namespace {
+
+std::string formatValue(double value) {
+   if (std::isnan(value)) {
+      return "NaN";
+   }
+   if (std::isinf(value)) {
+      return value > 0 ? "+Inf" : "-Inf";
+   }
+   return fmt::format("{}", value);
+}
+
+std::string escape(std::string_view text, bool escape_quotes) {
+   std::string escaped;
+   escaped.reserve(text.size());
+   for (const char character : text) {
+      if (character == '\\') {
+         escaped += "\\\\";
+      } else if (character == '\n') {
+         escaped += "\\n";
+      } else if (character == '"' && escape_quotes) {
+         escaped += "\\\"";
+      } else {
+         escaped += character;
+      }
+   }
+   return escaped;
+}
+
+}  // namespace
+
+PrometheusTextWriter::PrometheusTextWriter(std::ostream& out)
+    : out(out) {}
+
+void PrometheusTextWriter::writeFamily(
+   std::string_view name,
+   std::string_view help,
+   std::string_view type
+) {
+   out << "# HELP " << name << ' ' << escape(help, false) << '\n';
+   out << "# TYPE " << name << ' ' << type << '\n';
+}
+
+void PrometheusTextWriter::writeSample(
+   std::string_view name,
+   const MetricLabels& labels,
+   double value
+) {
+   out << name;
+   if (!labels.empty()) {
+      out << '{';
+      for (size_t index = 0; index < labels.size(); ++index) {
+         if (index > 0) {
+            out << ',';
+         }
+         out << labels[index].first << "=\"" << escape(labels[index].second, true) << '"';
+      }
+      out << '}';
+   }
+   out << ' ' << formatValue(value) << '\n';
+}
+
+void PrometheusTextWriter::writeHistogram(
+   std::string_view name,
+   const MetricLabels& labels,
+   const MetricHistogramValues& values
+) {
+   const std::string bucket_name = fmt::format("{}_bucket", name);
+   MetricLabels bucket_labels = labels;
+   bucket_labels.emplace_back("le", "");
+   for (size_t index = 0; index < values.cumulative_counts.size(); ++index) {
+      bucket_labels.back().second = index < values.upper_bounds.size()
+                                       ? formatValue(values.upper_bounds[index])
+                                       : "+Inf";
+      writeSample(bucket_name, bucket_labels, static_cast<double>(values.cumulative_counts[index]));
+   }
+   writeSample(fmt::format("{}_sum", name), labels, values.sum);
+   writeSample(
+      fmt::format("{}_count", name),
+      labels,
+      static_cast<double>(values.cumulative_counts.empty() ? 0 : values.cumulative_counts.back())
+   );
+}
+
+MetricRegistry& MetricRegistry::get() {
+   static MetricRegistry registry;
+   return registry;
+}
+
+MetricCounter& MetricRegistry::counter(
+   std::string_view name,
+   std::string_view help,
+   const MetricLabels& labels
+) {
+   const std::lock_guard lock(mutex);
+   auto family = counters.find(name);
+   if (family == counters.end()) {
+      family = counters.emplace(std::string(name), Family<MetricCounter>{std::string(help), {}})
+                  .first;
+   }
+   auto& metric = family->second.metrics[labels];
+   if (metric == nullptr) {
+      metric = std::make_unique<MetricCounter>();
+   }
+   return *metric;
+}
+
+MetricHistogram& MetricRegistry::histogram(
+   std::string_view name,
+   std::string_view help,
+   const MetricLabels& labels,
+   const std::vector<double>& upper_bounds
+) {
+   const std::lock_guard lock(mutex);
+   auto family = histograms.find(name);
+   if (family == histograms.end()) {
+      family =
+         histograms.emplace(std::string(name), Family<MetricHistogram>{std::string(help), {}})
+            .first;
+   }
+   auto& metric = family->second.metrics[labels];
+   if (metric == nullptr) {
+      metric = std::make_unique<MetricHistogram>(upper_bounds);
+   }
+   return *metric;
+}
+
+void MetricRegistry::write(PrometheusTextWriter& writer) const {
+   const std::lock_guard lock(mutex);
+   for (const auto& [name, family] : counters) {
+      writer.writeFamily(name, family.help, "counter");
+      for (const auto& [labels, metric] : family.metrics) {
+         writer.writeSample(name, labels, metric->get());
+      }
+   }
+   for (const auto& [name, family] : histograms) {
+      writer.writeFamily(name, family.help, "histogram");
+      for (const auto& [labels, metric] : family.metrics) {
+         writer.writeHistogram(name, labels, metric->get());
+      }
+   }
+}
+
+}  // namespace silo
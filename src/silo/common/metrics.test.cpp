@@ -0,0 +1,63 @@
+#include "silo/common/metrics.h"
+
+#include <cstdint>
+#include <sstream>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using silo::MetricHistogram;
+using silo::MetricRegistry;
+using silo::PrometheusTextWriter;
+
+TEST(MetricHistogram, countsObservationsIntoCumulativeBuckets) {
+   MetricHistogram under_test({1, 10});
+   under_test.observe(0.5);
+   under_test.observe(1);
+   under_test.observe(5);
+   under_test.observe(100);
+
+   const auto values = under_test.get();
+   EXPECT_EQ(values.cumulative_counts, (std::vector<uint64_t>{2, 3, 4}));
+   EXPECT_DOUBLE_EQ(values.sum, 106.5);
+}
+
+TEST(MetricRegistry, returnsTheSameMetricForTheSameLabels) {
+   MetricRegistry under_test;
+   auto& counter = under_test.counter("test_total", "help", {{"action", "Details"}});
+
+   EXPECT_EQ(&under_test.counter("test_total", "other help", {{"action", "Details"}}), &counter);
+   EXPECT_NE(&under_test.counter("test_total", "help", {{"action", "Aggregated"}}), &counter);
+}
+
+TEST(MetricRegistry, writesThePrometheusTextFormat) {
+   MetricRegistry under_test;
+   under_test.counter("rows_total", "Rows returned", {{"action", "Details"}}).increment(3);
+   under_test.histogram("duration_seconds", "Query duration", {}, {0.1, 1}).observe(0.5);
+
+   std::ostringstream out;
+   PrometheusTextWriter writer(out);
+   under_test.write(writer);
+
+   EXPECT_EQ(
+      out.str(),
+      "# HELP rows_total Rows returned\n"
+      "# TYPE rows_total counter\n"
+      "rows_total{action=\"Details\"} 3\n"
+      "# HELP duration_seconds Query duration\n"
+      "# TYPE duration_seconds histogram\n"
+      "duration_seconds_bucket{le=\"0.1\"} 0\n"
+      "duration_seconds_bucket{le=\"1\"} 1\n"
+      "duration_seconds_bucket{le=\"+Inf\"} 1\n"
+      "duration_seconds_sum 0.5\n"
+      "duration_seconds_count 1\n"
+   );
+}
+
+TEST(PrometheusTextWriter, escapesLabelValues) {
+   std::ostringstream out;
+   PrometheusTextWriter under_test(out);
+   under_test.writeSample("version_info", {{"version", "a\"b\\c\nd"}}, 1);
+
+   EXPECT_EQ(out.str(), "version_info{version=\"a\\\"b\\\\c\\nd\"} 1\n");
+}
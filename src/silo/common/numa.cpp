@@ -0,0 +1,197 @@
+#include "silo/common/numa.h"
+
+#include <algorithm>
+#include <exception>
+#include <numeric>
+
+#include <hwloc.h>
+#include <oneapi/tbb/blocked_range.h>
+#include <oneapi/tbb/parallel_for.h>
+#include <oneapi/tbb/task_arena.h>
+#include <oneapi/tbb/task_group.h>
+#include <oneapi/tbb/task_scheduler_observer.h>
+#include <spdlog/spdlog.h>
+
+namespace silo {
+
+struct NumaNodes::Topology {
+   hwloc_topology_t handle = nullptr;
+
+   Topology() {
+      if (hwloc_topology_init(&handle) != 0) {
+         handle = nullptr;
+         return;
+      }
+      if (hwloc_topology_load(handle) != 0) {
+         hwloc_topology_destroy(handle);
+         handle = nullptr;
+      }
+   }
+
+   ~Topology() {
+      if (handle != nullptr) {
+         hwloc_topology_destroy(handle);
+      }
+   }
+
+   Topology(const Topology& other) = delete;
+   Topology& operator=(const Topology& other) = delete;
+};
+
+namespace {
+
+/// Binds every thread that enters the arena to the cores of the node and releases it on exit, so
+/// that threads shared with other arenas and the calling threads are not pinned permanently
+class ThreadBinder : public tbb::task_scheduler_observer {
+   hwloc_topology_t topology;
+   hwloc_const_cpuset_t cpuset;
+
+  public:
+   ThreadBinder(tbb::task_arena& arena, hwloc_topology_t topology, hwloc_const_cpuset_t cpuset)
+       : tbb::task_scheduler_observer(arena),
+         topology(topology),
+         cpuset(cpuset) {
+      observe(true);
+   }
+
+   ~ThreadBinder() override { observe(false); }
+
+   ThreadBinder(const ThreadBinder& other) = delete;
+   ThreadBinder& operator=(const ThreadBinder& other) = delete;
+
+   void on_scheduler_entry(bool /*is_worker*/) override {
+      if (hwloc_set_cpubind(topology, cpuset, HWLOC_CPUBIND_THREAD) != 0) {
+         SPDLOG_DEBUG("Could not bind a thread to the cores of its NUMA node");
+      }
+   }
+
+   void on_scheduler_exit(bool /*is_worker*/) override {
+      (void)hwloc_set_cpubind(
+         topology, hwloc_topology_get_complete_cpuset(topology), HWLOC_CPUBIND_THREAD
+      );
+   }
+};
+
+}  // namespace
+
+class NumaNodes::Node {
+  public:
+   tbb::task_arena arena;
+
+  private:
+   ThreadBinder thread_binder;
+
+  public:
+   Node(hwloc_topology_t topology, hwloc_const_cpuset_t cpuset)
+       : arena(hwloc_bitmap_weight(cpuset)),
+         thread_binder(arena, topology, cpuset) {}
+};
+
+NumaNodes::NumaNodes()
+    : topology(std::make_unique<Topology>()) {
+   if (topology->handle == nullptr) {
+      SPDLOG_WARN("Could not detect the NUMA topology, using a single node");
+      return;
+   }
+   const int node_count = hwloc_get_nbobjs_by_type(topology->handle, HWLOC_OBJ_NUMANODE);
+   if (node_count <= 1) {
+      SPDLOG_INFO("Detected a single NUMA node");
+      return;
+   }
+   for (int node_index = 0; node_index < node_count; ++node_index) {
+      const hwloc_obj_t node =
+         hwloc_get_obj_by_type(topology->handle, HWLOC_OBJ_NUMANODE, node_index);
+      // Memory-only nodes (e.g. high-bandwidth or CXL memory) have no cores to run tasks on
+      if (node->cpuset == nullptr || hwloc_bitmap_iszero(node->cpuset)) {
+         continue;
+      }
+      nodes.push_back(std::make_unique<Node>(topology->handle, node->cpuset));
+   }
+   if (nodes.size() <= 1) {
+      nodes.clear();
+   }
+   SPDLOG_INFO(
+      "Detected {} NUMA nodes, running per-partition work on {} of them", node_count, count()
+   );
+}
+
+NumaNodes::~NumaNodes() = default;
+
+NumaNodes& NumaNodes::get() {
+   static NumaNodes instance;
+   return instance;
+}
+
+size_t NumaNodes::count() const {
+   return std::max<size_t>(nodes.size(), 1);
+}
+
+std::vector<uint32_t> NumaNodes::assignNodes(
+   const std::vector<uint64_t>& sizes,
+   size_t node_count
+) {
+   std::vector<size_t> largest_first(sizes.size());
+   std::iota(largest_first.begin(), largest_first.end(), 0);
+   std::stable_sort(largest_first.begin(), largest_first.end(), [&](size_t left, size_t right) {
+      return sizes[left] > sizes[right];
+   });
+
+   std::vector<uint64_t> node_sizes(std::max<size_t>(node_count, 1), 0);
+   std::vector<uint32_t> node_of_item(sizes.size(), 0);
+   for (const size_t item : largest_first) {
+      const auto smallest_node = static_cast<uint32_t>(
+         std::min_element(node_sizes.begin(), node_sizes.end()) - node_sizes.begin()
+      );
+      node_of_item[item] = smallest_node;
+      node_sizes[smallest_node] += sizes[item];
+   }
+   return node_of_item;
+}
+
+void NumaNodes::parallelForEachNode(const std::function<void(uint32_t)>& function) const {
+   if (nodes.empty()) {
+      function(0);
+      return;
+   }
+   std::vector<tbb::task_group> task_groups(nodes.size());
+   for (uint32_t node = 0; node < nodes.size(); ++node) {
+      nodes[node]->arena.execute([&, node]() {
+         task_groups[node].run([&, node]() { function(node); });
+      });
+   }
+   std::exception_ptr first_exception;
+   for (uint32_t node = 0; node < nodes.size(); ++node) {
+      nodes[node]->arena.execute([&, node]() {
+         try {
+            task_groups[node].wait();
+         } catch (...) {
+            if (first_exception == nullptr) {
+               first_exception = std::current_exception();
+            }
+         }
+      });
+   }
+   if (first_exception != nullptr) {
+      std::rethrow_exception(first_exception);
+   }
+}
+
+void NumaNodes::parallelFor(
+   const std::vector<uint32_t>& node_of_index,
+   const std::function<void(size_t)>& function
+) const {
+   std::vector<std::vector<size_t>> indexes_per_node(count());
+   for (size_t index = 0; index < node_of_index.size(); ++index) {
+      indexes_per_node[std::min<size_t>(node_of_index[index], count() - 1)].push_back(index);
+   }
+   parallelForEachNode([&](uint32_t node) {
+      const auto& indexes = indexes_per_node[node];
+      tbb::parallel_for(tbb::blocked_range<size_t>(0, indexes.size()), [&](const auto& local) {
+         for (size_t position = local.begin(); position != local.end(); ++position) {
+            function(indexes[position]);
+         }
+      });
+   });
+}
+
+}  // namespace silo
@@ -0,0 +1,54 @@
+#include "silo/common/numa.h"
+
+#include <atomic>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using silo::NumaNodes;
+
+TEST(NumaNodes, assignsItemsSuchThatNodesHoldSimilarSizes) {
+   const std::vector<uint64_t> sizes{5, 1, 4, 2, 3, 3};
+
+   const auto node_of_item = NumaNodes::assignNodes(sizes, 2);
+
+   ASSERT_EQ(node_of_item.size(), sizes.size());
+   std::vector<uint64_t> node_sizes(2, 0);
+   for (size_t item = 0; item < sizes.size(); ++item) {
+      ASSERT_LT(node_of_item[item], 2);
+      node_sizes[node_of_item[item]] += sizes[item];
+   }
+   EXPECT_EQ(node_sizes, std::vector<uint64_t>({9, 9}));
+}
+
+TEST(NumaNodes, assignsAllItemsToTheOnlyNode) {
+   EXPECT_EQ(NumaNodes::assignNodes({3, 1, 2}, 1), std::vector<uint32_t>({0, 0, 0}));
+   EXPECT_EQ(NumaNodes::assignNodes({3, 1, 2}, 0), std::vector<uint32_t>({0, 0, 0}));
+   EXPECT_TRUE(NumaNodes::assignNodes({}, 2).empty());
+}
+
+TEST(NumaNodes, parallelForVisitsEveryIndexOnce) {
+   const auto& numa_nodes = NumaNodes::get();
+   ASSERT_GE(numa_nodes.count(), 1);
+
+   std::vector<uint64_t> sizes(100, 1);
+   const auto node_of_index = NumaNodes::assignNodes(sizes, numa_nodes.count());
+   std::vector<std::atomic<uint32_t>> visits(sizes.size());
+
+   numa_nodes.parallelFor(node_of_index, [&](size_t index) { ++visits[index]; });
+
+   for (const auto& visit_count : visits) {
+      EXPECT_EQ(visit_count, 1);
+   }
+}
+
+TEST(NumaNodes, parallelForEachNodeRethrowsExceptions) {
+   EXPECT_THROW(
+      NumaNodes::get().parallelForEachNode([](uint32_t /*node*/) {
+         throw std::runtime_error("failure");
+      }),
+      std::runtime_error
+   );
+}
@@ -0,0 +1,267 @@
+#include "silo/common/perf_counters.h"
+
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <vector>
+
+#include <spdlog/spdlog.h>
+#include <nlohmann/json.hpp>
+
+#if defined(__linux__)
+#include <asm/unistd.h>
+#include <linux/perf_event.h>
+#include <unistd.h>
+#endif
+
+namespace silo {
+
+PerfCounterValues PerfCounterValues::operator-(const PerfCounterValues& other) const {
+   return {
+      cycles - other.cycles,
+      instructions - other.instructions,
+      llc_misses - other.llc_misses,
+      branch_misses - other.branch_misses
+   };
+}
+
+PerfCounterValues& PerfCounterValues::operator+=(const PerfCounterValues& other) {
+   cycles += other.cycles;
+   instructions += other.instructions;
+   llc_misses += other.llc_misses;
+   branch_misses += other.branch_misses;
+   return *this;
+}
+
+double PerfCounterValues::instructionsPerCycle() const {
+   return cycles > 0 ? instructions / cycles : 0;
+}
+
+// NOLINTNEXTLINE(readability-identifier-naming)
+void to_json(nlohmann::json& json, const PerfCounterValues& values) {
+   json = nlohmann::json{
+      {"cycles", values.cycles},
+      {"instructions", values.instructions},
+      {"instructionsPerCycle", values.instructionsPerCycle()},
+      {"llcMisses", values.llc_misses},
+      {"branchMisses", values.branch_misses},
+   };
+}
+
+void PerfCounterAccumulator::add(const PerfCounterValues& counted) {
+   const std::lock_guard lock(mutex);
+   values += counted;
+}
+
+PerfCounterValues PerfCounterAccumulator::get() const {
+   const std::lock_guard lock(mutex);
+   return values;
+}
+
+namespace {
+
+std::atomic<bool> enabled = false;
+
+thread_local PerfCounterAccumulator* current_accumulator = nullptr;
+thread_local bool is_thread_counting = false;
+
+std::mutex stages_mutex;
+
+/// The accumulators must stay at their address, PerfCounters::stage hands out references
+std::map<std::string, std::unique_ptr<PerfCounterAccumulator>, std::less<>>& stages() {
+   static std::map<std::string, std::unique_ptr<PerfCounterAccumulator>, std::less<>> stages;
+   return stages;
+}
+
+#if defined(__linux__)
+
+/// The hardware counters of a single thread, opened like in the vendored PerfEvent but with
+/// inherit disabled. Inherited counters would also count the threads that are spawned later, so
+/// the blocks of the main thread would count the work of the TBB and Poco workers once more.
+/// Unlike PerfEvent, it does not write to std::cerr if the counters cannot be opened.
+class ThreadCounters {
+   struct ReadFormat {
+      uint64_t value = 0;
+      uint64_t time_enabled = 0;
+      uint64_t time_running = 0;
+   };
+
+   struct Counter {
+      int file_descriptor;
+      ReadFormat opened;
+   };
+
+   std::vector<Counter> counters;
+
+   bool open(uint32_t type, uint64_t config) {
+      perf_event_attr attributes{};
+      attributes.type = type;
+      attributes.size = sizeof(perf_event_attr);
+      attributes.config = config;
+      attributes.inherit = 0;
+      attributes.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+      const int file_descriptor =
+         static_cast<int>(syscall(__NR_perf_event_open, &attributes, 0, -1, -1, 0));
+      if (file_descriptor < 0) {
+         return false;
+      }
+      Counter counter{file_descriptor, {}};
+      if (::read(file_descriptor, &counter.opened, sizeof(ReadFormat)) != sizeof(ReadFormat)) {
+         close(file_descriptor);
+         return false;
+      }
+      counters.push_back(counter);
+      return true;
+   }
+
+  public:
+   ThreadCounters() {
+      const bool is_open =
+         open(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES) &&
+         open(PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS) &&
+         open(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES) &&
+         open(PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES);
+      if (!is_open) {
+         for (const Counter& counter : counters) {
+            close(counter.file_descriptor);
+         }
+         counters.clear();
+      }
+   }
+
+   ~ThreadCounters() {
+      for (const Counter& counter : counters) {
+         close(counter.file_descriptor);
+      }
+   }
+
+   ThreadCounters(const ThreadCounters& other) = delete;
+   ThreadCounters& operator=(const ThreadCounters& other) = delete;
+
+   [[nodiscard]] bool isOpen() const { return !counters.empty(); }
+
+   /// The events since the counters were opened, in the order in which they were opened
+   [[nodiscard]] double read(size_t index) const {
+      if (index >= counters.size()) {
+         return 0;
+      }
+      const Counter& counter = counters[index];
+      ReadFormat data;
+      if (::read(counter.file_descriptor, &data, sizeof(ReadFormat)) != sizeof(ReadFormat) ||
+          data.time_running <= counter.opened.time_running) {
+         return 0;
+      }
+      const double multiplexing_correction =
+         static_cast<double>(data.time_enabled - counter.opened.time_enabled) /
+         static_cast<double>(data.time_running - counter.opened.time_running);
+      return static_cast<double>(data.value - counter.opened.value) * multiplexing_correction;
+   }
+};
+
+/// The counters of the calling thread, opened on first use. Not open if they cannot be opened
+const ThreadCounters& threadCounters() {
+   thread_local const ThreadCounters counters;
+   return counters;
+}
+
+/// The events of the calling thread since its counters were opened
+PerfCounterValues readThreadCounters() {
+   const ThreadCounters& counters = threadCounters();
+   return {counters.read(0), counters.read(1), counters.read(2), counters.read(3)};
+}
+
+bool canCountThread() {
+   return threadCounters().isOpen();
+}
+
+#else
+
+PerfCounterValues readThreadCounters() {
+   return {};
+}
+
+bool canCountThread() {
+   return false;
+}
+
+#endif
+
+}  // namespace
+
+bool PerfCounters::enable() {
+   if (!canCountThread()) {
+      SPDLOG_WARN(
+         "Hardware performance counters are not available, check kernel.perf_event_paranoid"
+      );
+      return false;
+   }
+   enabled = true;
+   SPDLOG_INFO("Hardware performance counters are enabled");
+   return true;
+}
+
+bool PerfCounters::isEnabled() {
+   return enabled;
+}
+
+PerfCounterAccumulator& PerfCounters::stage(std::string_view name) {
+   const std::lock_guard lock(stages_mutex);
+   auto& accumulator = stages()[std::string(name)];
+   if (accumulator == nullptr) {
+      accumulator = std::make_unique<PerfCounterAccumulator>();
+   }
+   return *accumulator;
+}
+
+std::vector<std::pair<std::string, PerfCounterValues>> PerfCounters::getStages() {
+   const std::lock_guard lock(stages_mutex);
+   std::vector<std::pair<std::string, PerfCounterValues>> result;
+   for (const auto& [name, accumulator] : stages()) {
+      result.emplace_back(name, accumulator->get());
+   }
+   return result;
+}
+
+PerfCounterBlock::PerfCounterBlock(PerfCounterAccumulator* accumulator)
+    : accumulator(accumulator),
+      previous(current_accumulator) {
+   current_accumulator = accumulator;
+   if (!enabled || accumulator == nullptr || is_thread_counting || !canCountThread()) {
+      return;
+   }
+   is_counting = true;
+   is_thread_counting = true;
+   start = readThreadCounters();
+}
+
+PerfCounterBlock::~PerfCounterBlock() {
+   current_accumulator = previous;
+   if (!is_counting) {
+      return;
+   }
+   is_thread_counting = false;
+   accumulator->add(readThreadCounters() - start);
+}
+
+PerfCounterAccumulator* PerfCounterBlock::current() {
+   return current_accumulator;
+}
+
+}  // namespace silo
+
+[[maybe_unused]] auto fmt::formatter<silo::PerfCounterValues>::format(
+   const silo::PerfCounterValues& values,
+   fmt::format_context& ctx
+) -> decltype(ctx.out()) {
+   return format_to(
+      ctx.out(),
+      "{:.0f} cycles, {:.0f} instructions ({:.2f} per cycle), {:.0f} LLC misses, {:.0f} branch "
+      "misses",
+      values.cycles,
+      values.instructions,
+      values.instructionsPerCycle(),
+      values.llc_misses,
+      values.branch_misses
+   );
+}
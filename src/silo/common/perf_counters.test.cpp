@@ -0,0 +1,85 @@
+#include "silo/common/perf_counters.h"
+
+#include <gtest/gtest.h>
+
+using silo::PerfCounterAccumulator;
+using silo::PerfCounterBlock;
+using silo::PerfCounters;
+using silo::PerfCounterValues;
+
+TEST(PerfCounterValues, subtractsAndAddsAllCounters) {
+   const PerfCounterValues end{100, 250, 4, 2};
+   const PerfCounterValues start{50, 50, 1, 1};
+
+   PerfCounterValues under_test = end - start;
+   EXPECT_EQ(under_test.cycles, 50);
+   EXPECT_EQ(under_test.instructions, 200);
+   EXPECT_EQ(under_test.llc_misses, 3);
+   EXPECT_EQ(under_test.branch_misses, 1);
+   EXPECT_EQ(under_test.instructionsPerCycle(), 4);
+
+   under_test += start;
+   EXPECT_EQ(under_test.cycles, 100);
+   EXPECT_EQ(under_test.instructions, 250);
+}
+
+TEST(PerfCounterValues, hasNoInstructionsPerCycleWithoutCycles) {
+   EXPECT_EQ(PerfCounterValues{}.instructionsPerCycle(), 0);
+}
+
+TEST(PerfCounterAccumulator, sumsTheAddedCounts) {
+   PerfCounterAccumulator under_test;
+   under_test.add({1, 2, 3, 4});
+   under_test.add({1, 2, 3, 4});
+
+   const auto values = under_test.get();
+   EXPECT_EQ(values.cycles, 2);
+   EXPECT_EQ(values.instructions, 4);
+   EXPECT_EQ(values.llc_misses, 6);
+   EXPECT_EQ(values.branch_misses, 8);
+}
+
+TEST(PerfCounterBlock, installsTheAccumulatorForForkedWork) {
+   PerfCounterAccumulator outer;
+   PerfCounterAccumulator inner;
+
+   EXPECT_EQ(PerfCounterBlock::current(), nullptr);
+   {
+      const PerfCounterBlock outer_block(&outer);
+      EXPECT_EQ(PerfCounterBlock::current(), &outer);
+      {
+         const PerfCounterBlock inner_block(&inner);
+         EXPECT_EQ(PerfCounterBlock::current(), &inner);
+      }
+      EXPECT_EQ(PerfCounterBlock::current(), &outer);
+   }
+   EXPECT_EQ(PerfCounterBlock::current(), nullptr);
+}
+
+TEST(PerfCounterBlock, countsNothingWhileTheCountersAreDisabled) {
+   if (PerfCounters::isEnabled()) {
+      GTEST_SKIP();
+   }
+   PerfCounterAccumulator accumulator;
+   {
+      const PerfCounterBlock block(&accumulator);
+   }
+
+   EXPECT_EQ(accumulator.get().cycles, 0);
+   EXPECT_EQ(accumulator.get().instructions, 0);
+}
+
+TEST(PerfCounters, returnsTheSameAccumulatorForAStage) {
+   PerfCounterAccumulator& under_test = PerfCounters::stage("testStage");
+   under_test.add({1, 1, 1, 1});
+
+   EXPECT_EQ(&PerfCounters::stage("testStage"), &under_test);
+   bool found = false;
+   for (const auto& [name, values] : PerfCounters::getStages()) {
+      if (name == "testStage") {
+         found = true;
+         EXPECT_EQ(values.cycles, 1);
+      }
+   }
+   EXPECT_TRUE(found);
+}
@@ -1,7 +1,9 @@
 #include "silo/database.h"
 
+#include <algorithm>
 #include <array>
 #include <atomic>
+#include <cstddef>
 #include <cstdint>
 #include <deque>
 #include <filesystem>
@@ -31,6 +33,7 @@
 #include <boost/serialization/optional.hpp>
 #include <boost/serialization/string.hpp>
 #include <boost/serialization/tracking_enum.hpp>
+#include <boost/serialization/utility.hpp>
 #include <boost/serialization/vector.hpp>
 #include <duckdb.hpp>
 #include <roaring/roaring.hh>
@@ -40,13 +43,16 @@
 #include "silo/common/fasta_reader.h"
 #include "silo/common/format_number.h"
 #include "silo/common/nucleotide_symbols.h"
+#include "silo/common/numa.h"
 #include "silo/config/database_config.h"
 #include "silo/database_info.h"
+#include "silo/persistence/content_hashes.h"
 #include "silo/persistence/exception.h"
 #include "silo/preprocessing/metadata_info.h"
 #include "silo/preprocessing/preprocessing_config.h"
 #include "silo/preprocessing/preprocessing_exception.h"
 #include "silo/query_engine/query_engine.h"
+#include "silo/query_engine/query_profile.h"
 #include "silo/query_engine/query_result.h"
 #include "silo/roaring/roaring_serialize.h"
 #include "silo/storage/column/date_column.h"
@@ -123,26 +129,98 @@ DatabaseInfo Database::getDatabaseInfo() const {
    std::atomic<uint32_t> sequence_count = 0;
    std::atomic<uint64_t> total_size = 0;
    std::atomic<size_t> nucleotide_symbol_n_bitmaps_size = 0;
-
-   tbb::parallel_for_each(
-      partitions.begin(),
-      partitions.end(),
-      [&](const DatabasePartition& database_partition) {
-         uint64_t local_total_size = 0;
-         size_t local_nucleotide_symbol_n_bitmaps_size = 0;
-         for (const auto& [_, seq_store] : database_partition.nuc_sequences) {
-            local_total_size += seq_store.computeSize();
-            for (const auto& bitmap : seq_store.missing_symbol_bitmaps) {
-               local_nucleotide_symbol_n_bitmaps_size += bitmap.getSizeInBytes(false);
-            }
+   std::vector<uint64_t> total_size_per_partition(partitions.size());
+
+   NumaNodes::get().parallelFor(getPartitionNumaNodes(), [&](size_t partition_index) {
+      const DatabasePartition& database_partition = partitions[partition_index];
+      uint64_t local_total_size = 0;
+      size_t local_nucleotide_symbol_n_bitmaps_size = 0;
+      for (const auto& [_, seq_store] : database_partition.nuc_sequences) {
+         local_total_size += seq_store.computeSize();
+         for (const auto& bitmap : seq_store.missing_symbol_bitmaps) {
+            local_nucleotide_symbol_n_bitmaps_size += bitmap.getSizeInBytes(false);
          }
-         sequence_count += database_partition.sequence_count;
-         total_size += local_total_size;
-         nucleotide_symbol_n_bitmaps_size += local_nucleotide_symbol_n_bitmaps_size;
       }
-   );
+      sequence_count += database_partition.sequence_count;
+      total_size += local_total_size;
+      nucleotide_symbol_n_bitmaps_size += local_nucleotide_symbol_n_bitmaps_size;
+      total_size_per_partition[partition_index] = local_total_size;
+   });
+
+   std::vector<NumaNodeInfo> numa_nodes(NumaNodes::get().count(), NumaNodeInfo{0, 0, 0});
+   for (size_t partition_index = 0; partition_index < partitions.size(); ++partition_index) {
+      const auto& partition = partitions[partition_index];
+      auto& node_info = numa_nodes.at(partition.numa_node);
+      ++node_info.partition_count;
+      node_info.sequence_count += partition.sequence_count;
+      node_info.total_size += total_size_per_partition[partition_index];
+   }
 
-   return DatabaseInfo{sequence_count, total_size, nucleotide_symbol_n_bitmaps_size};
+   return DatabaseInfo{
+      sequence_count,
+      total_size,
+      nucleotide_symbol_n_bitmaps_size,
+      warm_up_time_in_microseconds_,
+      std::move(numa_nodes)
+   };
+}
+
+namespace {
+
+template <typename ColumnPartitions>
+void addColumnSizes(
+   const ColumnPartitions& columns,
+   std::map<std::string, uint64_t>& column_sizes
+) {
+   for (const auto& [name, column] : columns) {
+      const auto& values = column.getValues();
+      column_sizes[name] += values.size() * sizeof(values.front());
+   }
+}
+
+template <typename SequenceStorePartitions>
+void addSequenceStoreSizes(
+   const SequenceStorePartitions& sequence_stores,
+   std::map<std::string, uint64_t>& sequence_store_sizes
+) {
+   for (const auto& [name, sequence_store] : sequence_stores) {
+      sequence_store_sizes[name] += sequence_store.computeSize();
+   }
+}
+
+}  // namespace
+
+DatabaseMemoryInfo Database::getMemoryInfo() const {
+   std::vector<DatabaseMemoryInfo> memory_info_per_partition(partitions.size());
+   NumaNodes::get().parallelFor(getPartitionNumaNodes(), [&](size_t partition_index) {
+      const DatabasePartition& partition = partitions[partition_index];
+      auto& memory_info = memory_info_per_partition[partition_index];
+      const auto& columns = partition.columns;
+      addColumnSizes(columns.string_columns, memory_info.column_sizes);
+      addColumnSizes(columns.indexed_string_columns, memory_info.column_sizes);
+      addColumnSizes(columns.int_columns, memory_info.column_sizes);
+      addColumnSizes(columns.float_columns, memory_info.column_sizes);
+      addColumnSizes(columns.date_columns, memory_info.column_sizes);
+      addColumnSizes(columns.pango_lineage_columns, memory_info.column_sizes);
+      addColumnSizes(columns.nuc_insertion_columns, memory_info.column_sizes);
+      addColumnSizes(columns.aa_insertion_columns, memory_info.column_sizes);
+      addSequenceStoreSizes(partition.nuc_sequences, memory_info.nucleotide_sequence_sizes);
+      addSequenceStoreSizes(partition.aa_sequences, memory_info.amino_acid_sequence_sizes);
+   });
+
+   DatabaseMemoryInfo memory_info;
+   for (const auto& partition_memory_info : memory_info_per_partition) {
+      for (const auto& [name, size] : partition_memory_info.column_sizes) {
+         memory_info.column_sizes[name] += size;
+      }
+      for (const auto& [name, size] : partition_memory_info.nucleotide_sequence_sizes) {
+         memory_info.nucleotide_sequence_sizes[name] += size;
+      }
+      for (const auto& [name, size] : partition_memory_info.amino_acid_sequence_sizes) {
+         memory_info.amino_acid_sequence_sizes[name] += size;
+      }
+   }
+   return memory_info;
 }
 
 BitmapContainerSize::BitmapContainerSize(size_t genome_length, size_t section_length)
@@ -221,12 +299,12 @@ BitmapSizePerSymbol Database::calculateBitmapSizePerSymbol(
    tbb::parallel_for_each(Nucleotide::SYMBOLS, [&](Nucleotide::Symbol symbol) {
       BitmapSizePerSymbol bitmap_size_per_symbol;
 
-      for (const SequenceStorePartition<SymbolType>& seq_store_partition : seq_store.partitions) {
-         for (const auto& position : seq_store_partition.positions) {
+      for (const auto& seq_store_partition : seq_store.partitions) {
+         seq_store_partition->forEachMaterializedPosition([&](size_t, const auto& position) {
             assert(bitmap_size_per_symbol.size_in_bytes.contains(symbol));
             bitmap_size_per_symbol.size_in_bytes[symbol] +=
                position.getBitmap(symbol)->getSizeInBytes();
-         }
+         });
       }
       lock.lock();
       global_bitmap_size_per_symbol += bitmap_size_per_symbol;
@@ -265,45 +343,50 @@ BitmapContainerSize Database::calculateBitmapContainerSizePerGenomeSection(
 
    BitmapContainerSize bitmap_container_size_per_genome_section(genome_length, section_length);
 
-   for (size_t position_index = 0; position_index < genome_length; position_index++) {
+   const auto add_position_statistics = [&](size_t position_index, const auto& position) {
       RoaringStatistics statistic;
-      for (const auto& seq_store_partition : seq_store.partitions) {
-         const auto& position = seq_store_partition.positions[position_index];
-         for (const auto& genome_symbol : Nucleotide::SYMBOLS) {
-            const auto& bitmap = *position.getBitmap(genome_symbol);
-
-            roaring_bitmap_statistics(&bitmap.roaring, &statistic);
-            addStatisticToBitmapContainerSize(
-               statistic, bitmap_container_size_per_genome_section.bitmap_container_size_statistic
-            );
-
-            bitmap_container_size_per_genome_section.total_bitmap_size_computed +=
-               bitmap.getSizeInBytes();
-            bitmap_container_size_per_genome_section.total_bitmap_size_frozen +=
-               bitmap.getFrozenSizeInBytes();
-
-            if (statistic.n_bitset_containers > 0) {
-               if (genome_symbol == Nucleotide::SYMBOL_MISSING) {
-                  bitmap_container_size_per_genome_section.size_per_genome_symbol_and_section
-                     .at("N")
-                     .at(position_index / section_length) += statistic.n_bitset_containers;
-               } else if (genome_symbol == Nucleotide::Symbol::GAP) {
-                  bitmap_container_size_per_genome_section.size_per_genome_symbol_and_section
-                     .at("GAP")
-                     .at(position_index / section_length) += statistic.n_bitset_containers;
-               } else {
-                  bitmap_container_size_per_genome_section.size_per_genome_symbol_and_section
-                     .at("NOT_N_NOT_GAP")
-                     .at(position_index / section_length) += statistic.n_bitset_containers;
-               }
+      for (const auto& genome_symbol : Nucleotide::SYMBOLS) {
+         const auto& bitmap = *position.getBitmap(genome_symbol);
+
+         roaring_bitmap_statistics(&bitmap.roaring, &statistic);
+         addStatisticToBitmapContainerSize(
+            statistic, bitmap_container_size_per_genome_section.bitmap_container_size_statistic
+         );
+
+         bitmap_container_size_per_genome_section.total_bitmap_size_computed +=
+            bitmap.getSizeInBytes();
+         bitmap_container_size_per_genome_section.total_bitmap_size_frozen +=
+            bitmap.getFrozenSizeInBytes();
+
+         if (statistic.n_bitset_containers > 0) {
+            if (genome_symbol == Nucleotide::SYMBOL_MISSING) {
+               bitmap_container_size_per_genome_section.size_per_genome_symbol_and_section
+                  .at("N")
+                  .at(position_index / section_length) += statistic.n_bitset_containers;
+            } else if (genome_symbol == Nucleotide::Symbol::GAP) {
+               bitmap_container_size_per_genome_section.size_per_genome_symbol_and_section
+                  .at("GAP")
+                  .at(position_index / section_length) += statistic.n_bitset_containers;
+            } else {
+               bitmap_container_size_per_genome_section.size_per_genome_symbol_and_section
+                  .at("NOT_N_NOT_GAP")
+                  .at(position_index / section_length) += statistic.n_bitset_containers;
             }
          }
       }
+   };
+   for (const auto& seq_store_partition : seq_store.partitions) {
+      seq_store_partition->forEachMaterializedPosition(add_position_statistics);
    }
 
    return bitmap_container_size_per_genome_section;
 }
 
+template BitmapContainerSize Database::calculateBitmapContainerSizePerGenomeSection<Nucleotide>(
+   const SequenceStore<Nucleotide>& seq_store,
+   size_t section_length
+);
+
 DetailedDatabaseInfo Database::detailedDatabaseInfo() const {
    SPDLOG_TRACE("detailedDatabaseInfo");
    constexpr uint32_t DEFAULT_SECTION_LENGTH = 500;
@@ -358,6 +441,96 @@ std::ofstream openOutputFileOrThrow(const std::string& path) {
    return file;
 }
 
+/// Stores take the layout that their partitions were saved with, so that partitions that are
+/// added later, such as deltas, use the same layout
+template <typename SymbolType>
+void adoptSerializedLayouts(std::map<std::string, SequenceStore<SymbolType>>& stores) {
+   for (auto& [_, store] : stores) {
+      if (!store.partitions.empty()) {
+         store.layout = store.partitions.front()->getLayout();
+      }
+   }
+}
+
+std::vector<std::filesystem::path> referenceSequenceFiles(
+   const std::filesystem::path& save_directory
+) {
+   return {save_directory / "nuc_sequences.silo", save_directory / "aa_sequences.silo"};
+}
+
+std::filesystem::path partitionFile(const std::filesystem::path& save_directory, size_t index) {
+   return save_directory / ("P" + std::to_string(index) + ".silo");
+}
+
+void saveContentHashes(
+   const std::filesystem::path& save_directory,
+   std::vector<DatabasePartition>& partitions
+) {
+   persistence::ContentHashes content_hashes;
+   content_hashes.reference_sequences_hash =
+      persistence::hashFileContents(referenceSequenceFiles(save_directory));
+   content_hashes.partition_hashes.resize(partitions.size());
+   tbb::parallel_for(tbb::blocked_range<size_t>(0, partitions.size()), [&](const auto& local) {
+      for (size_t partition_index = local.begin(); partition_index != local.end();
+           ++partition_index) {
+         content_hashes.partition_hashes[partition_index] =
+            persistence::hashStreamContents([&](std::ostream& stream) {
+               ::boost::archive::binary_oarchive archive(stream, ::boost::archive::no_header);
+               partitions[partition_index].serializeSequenceData(archive);
+            });
+      }
+   });
+
+   std::ofstream content_hashes_file =
+      openOutputFileOrThrow(save_directory / "content_hashes.silo");
+   ::boost::archive::binary_oarchive content_hashes_archive(content_hashes_file);
+   content_hashes_archive << content_hashes;
+}
+
+/// States that were saved before content hashes were introduced do not contain them
+std::optional<persistence::ContentHashes> loadContentHashes(
+   const std::filesystem::path& save_directory
+) {
+   const auto content_hashes_filename = save_directory / "content_hashes.silo";
+   if (!std::filesystem::is_regular_file(content_hashes_filename)) {
+      SPDLOG_INFO("No content hashes found in {}", save_directory.string());
+      return std::nullopt;
+   }
+   std::ifstream content_hashes_file = openInputFileOrThrow(content_hashes_filename);
+   ::boost::archive::binary_iarchive content_hashes_archive(content_hashes_file);
+   persistence::ContentHashes content_hashes;
+   content_hashes_archive >> content_hashes;
+   return content_hashes;
+}
+
+/// For each partition of the new state, the index of a partition of the previous database with
+/// the same sequence data, if there is one
+std::vector<std::optional<size_t>> findReusablePartitions(
+   const std::optional<persistence::ContentHashes>& content_hashes,
+   const std::optional<persistence::ContentHashes>& previous_content_hashes,
+   size_t partition_count
+) {
+   std::vector<std::optional<size_t>> reusable_partitions(partition_count);
+   if (!content_hashes.has_value() || !previous_content_hashes.has_value() ||
+       content_hashes->reference_sequences_hash !=
+          previous_content_hashes->reference_sequences_hash ||
+       content_hashes->partition_hashes.size() != partition_count) {
+      return reusable_partitions;
+   }
+   std::unordered_map<uint64_t, size_t> previous_partition_by_hash;
+   for (size_t i = 0; i < previous_content_hashes->partition_hashes.size(); ++i) {
+      previous_partition_by_hash.emplace(previous_content_hashes->partition_hashes[i], i);
+   }
+   for (size_t i = 0; i < partition_count; ++i) {
+      const auto previous_partition =
+         previous_partition_by_hash.find(content_hashes->partition_hashes[i]);
+      if (previous_partition != previous_partition_by_hash.end()) {
+         reusable_partitions[i] = previous_partition->second;
+      }
+   }
+   return reusable_partitions;
+}
+
 }  // namespace
 
 void saveDataVersion(const Database& database, const std::filesystem::path& save_directory) {
@@ -436,8 +609,7 @@ void Database::saveDatabaseState(const std::filesystem::path& save_directory) {
 
    std::vector<std::ofstream> partition_archives;
    for (uint32_t i = 0; i < partitions.size(); ++i) {
-      const auto& partition_archive =
-         versioned_save_directory / ("P" + std::to_string(i) + ".silo");
+      const auto& partition_archive = partitionFile(versioned_save_directory, i);
       partition_archives.emplace_back(openOutputFileOrThrow(partition_archive));
 
       if (!partition_archives.back()) {
@@ -448,15 +620,15 @@ void Database::saveDatabaseState(const std::filesystem::path& save_directory) {
    }
 
    SPDLOG_INFO("Saving {} partitions...", partitions.size());
-   tbb::parallel_for(tbb::blocked_range<size_t>(0, partitions.size()), [&](const auto& local) {
-      for (size_t partition_index = local.begin(); partition_index != local.end();
-           partition_index++) {
-         ::boost::archive::binary_oarchive output_archive(partition_archives[partition_index]);
-         partitions[partition_index].serializeData(output_archive, 0);
-      }
+   NumaNodes::get().parallelFor(getPartitionNumaNodes(), [&](size_t partition_index) {
+      ::boost::archive::binary_oarchive output_archive(partition_archives[partition_index]);
+      partitions[partition_index].serializeData(output_archive, 0);
    });
    SPDLOG_INFO("Finished saving partitions", partitions.size());
 
+   SPDLOG_INFO("Saving content hashes");
+   saveContentHashes(versioned_save_directory, partitions);
+
    saveDataVersion(*this, versioned_save_directory);
 }
 
@@ -477,7 +649,10 @@ DataVersion loadDataVersion(const std::filesystem::path& filename) {
    return data_version.value();
 }
 
-Database Database::loadDatabaseState(const std::filesystem::path& save_directory) {
+Database Database::loadDatabaseState(
+   const std::filesystem::path& save_directory,
+   const Database* previous_database
+) {
    Database database;
    const auto database_config_filename = save_directory / "database_config.yaml";
    database.database_config =
@@ -525,30 +700,54 @@ Database Database::loadDatabaseState(const std::filesystem::path& save_directory
    database.initializeNucSequences(nuc_sequences_map);
    database.initializeAASequences(aa_sequences_map);
 
+   database.content_hashes_ = loadContentHashes(save_directory);
+   const auto reusable_partitions = findReusablePartitions(
+      database.content_hashes_,
+      previous_database != nullptr ? previous_database->content_hashes_ : std::nullopt,
+      database.partitions.size()
+   );
+   const auto reused_partition_count = std::count_if(
+      reusable_partitions.begin(),
+      reusable_partitions.end(),
+      [](const auto& reusable_partition) { return reusable_partition.has_value(); }
+   );
+
    SPDLOG_DEBUG("Loading partition data");
-   std::vector<std::ifstream> file_vec;
+   std::vector<std::ifstream> file_vec(database.partitions.size());
    for (uint32_t i = 0; i < database.partitions.size(); ++i) {
-      const auto& partition_file = save_directory / ("P" + std::to_string(i) + ".silo");
-      file_vec.emplace_back(openInputFileOrThrow(partition_file));
+      const auto& partition_file = partitionFile(save_directory, i);
+      file_vec[i] = openInputFileOrThrow(partition_file);
 
-      if (!file_vec.back()) {
+      if (!file_vec[i]) {
          throw persistence::SaveDatabaseException(
             "Cannot open partition input file " + partition_file.string() + " for loading"
          );
       }
    }
 
-   tbb::parallel_for(
-      tbb::blocked_range<size_t>(0, database.partitions.size()),
-      [&](const auto& local) {
-         for (size_t partition_index = local.begin(); partition_index != local.end();
-              ++partition_index) {
-            ::boost::archive::binary_iarchive input_archive(file_vec[partition_index]);
-            database.partitions[partition_index].serializeData(input_archive, 0);
-         }
+   // The data of a partition is first touched by the threads of its NUMA node, which places it in
+   // the memory of that node. Shared sequence stores stay where the previous database put them
+   database.placePartitionsOnNumaNodes();
+   NumaNodes::get().parallelFor(database.getPartitionNumaNodes(), [&](size_t partition_index) {
+      ::boost::archive::binary_iarchive input_archive(file_vec[partition_index]);
+      const auto& reusable_partition = reusable_partitions[partition_index];
+      if (!reusable_partition.has_value()) {
+         database.partitions[partition_index].serializeData(input_archive, 0);
+         return;
       }
+      database.partitions[partition_index].serializeColumns(input_archive);
+      database.shareSequenceData(
+         partition_index, *previous_database, reusable_partition.value()
+      );
+   });
+   SPDLOG_INFO(
+      "Finished loading partition data, shared the sequences of {} of {} partitions with the "
+      "previous database",
+      reused_partition_count,
+      database.partitions.size()
    );
-   SPDLOG_INFO("Finished loading partition data");
+   adoptSerializedLayouts(database.nuc_sequences);
+   adoptSerializedLayouts(database.aa_sequences);
 
    database.setDataVersion(loadDataVersion(save_directory / "data_version.silo"));
    SPDLOG_INFO(
@@ -565,69 +764,74 @@ void Database::initializeColumn(config::ColumnType column_type, const std::strin
    switch (column_type) {
       case config::ColumnType::STRING:
          columns.string_columns.emplace(name, storage::column::StringColumn());
-         for (auto& partition : partitions) {
-            partition.columns.metadata.push_back({name, column_type});
-            partition.insertColumn(name, columns.string_columns.at(name).createPartition());
-         }
          break;
       case config::ColumnType::INDEXED_STRING: {
          auto column = storage::column::IndexedStringColumn();
          columns.indexed_string_columns.emplace(name, std::move(column));
-         for (auto& partition : partitions) {
-            partition.columns.metadata.push_back({name, column_type});
-            partition.insertColumn(name, columns.indexed_string_columns.at(name).createPartition());
-         }
       } break;
       case config::ColumnType::INDEXED_PANGOLINEAGE:
          columns.pango_lineage_columns.emplace(
             name, storage::column::PangoLineageColumn(alias_key)
          );
-         for (auto& partition : partitions) {
-            partition.columns.metadata.push_back({name, column_type});
-            partition.insertColumn(name, columns.pango_lineage_columns.at(name).createPartition());
-         }
          break;
       case config::ColumnType::DATE: {
          auto column = name == database_config.schema.date_to_sort_by
                           ? storage::column::DateColumn(true)
                           : storage::column::DateColumn(false);
          columns.date_columns.emplace(name, std::move(column));
-         for (auto& partition : partitions) {
-            partition.columns.metadata.push_back({name, column_type});
-            partition.insertColumn(name, columns.date_columns.at(name).createPartition());
-         }
       } break;
       case config::ColumnType::INT:
          columns.int_columns.emplace(name, storage::column::IntColumn());
-         for (auto& partition : partitions) {
-            partition.columns.metadata.push_back({name, column_type});
-            partition.insertColumn(name, columns.int_columns.at(name).createPartition());
-         }
          break;
       case config::ColumnType::FLOAT:
          columns.float_columns.emplace(name, storage::column::FloatColumn());
-         for (auto& partition : partitions) {
-            partition.columns.metadata.push_back({name, column_type});
-            partition.insertColumn(name, columns.float_columns.at(name).createPartition());
-         }
          break;
       case config::ColumnType::NUC_INSERTION:
          columns.nuc_insertion_columns.emplace(
             name, storage::column::InsertionColumn<Nucleotide>(getDefaultSequenceName<Nucleotide>())
          );
-         for (auto& partition : partitions) {
-            partition.columns.metadata.push_back({name, column_type});
-            partition.insertColumn(name, columns.nuc_insertion_columns.at(name).createPartition());
-         }
          break;
       case config::ColumnType::AA_INSERTION:
          columns.aa_insertion_columns.emplace(
             name, storage::column::InsertionColumn<AminoAcid>(getDefaultSequenceName<AminoAcid>())
          );
-         for (auto& partition : partitions) {
-            partition.columns.metadata.push_back({name, column_type});
-            partition.insertColumn(name, columns.aa_insertion_columns.at(name).createPartition());
-         }
+         break;
+   }
+   for (auto& partition : partitions) {
+      initializeColumnPartition(partition, column_type, name);
+   }
+}
+
+void Database::initializeColumnPartition(
+   DatabasePartition& partition,
+   config::ColumnType column_type,
+   const std::string& name
+) {
+   partition.columns.metadata.push_back({name, column_type});
+   switch (column_type) {
+      case config::ColumnType::STRING:
+         partition.insertColumn(name, columns.string_columns.at(name).createPartition());
+         break;
+      case config::ColumnType::INDEXED_STRING:
+         partition.insertColumn(name, columns.indexed_string_columns.at(name).createPartition());
+         break;
+      case config::ColumnType::INDEXED_PANGOLINEAGE:
+         partition.insertColumn(name, columns.pango_lineage_columns.at(name).createPartition());
+         break;
+      case config::ColumnType::DATE:
+         partition.insertColumn(name, columns.date_columns.at(name).createPartition());
+         break;
+      case config::ColumnType::INT:
+         partition.insertColumn(name, columns.int_columns.at(name).createPartition());
+         break;
+      case config::ColumnType::FLOAT:
+         partition.insertColumn(name, columns.float_columns.at(name).createPartition());
+         break;
+      case config::ColumnType::NUC_INSERTION:
+         partition.insertColumn(name, columns.nuc_insertion_columns.at(name).createPartition());
+         break;
+      case config::ColumnType::AA_INSERTION:
+         partition.insertColumn(name, columns.aa_insertion_columns.at(name).createPartition());
          break;
    }
 }
@@ -687,8 +891,30 @@ void Database::initializeAASequences(
    }
 }
 
+void Database::shareSequenceData(
+   size_t partition_index,
+   const Database& other,
+   size_t other_partition_index
+) {
+   auto& partition = partitions[partition_index];
+   for (auto& [name, store] : nuc_sequences) {
+      auto& shared_partition =
+         store.sharePartition(partition_index, other.nuc_sequences.at(name), other_partition_index);
+      partition.nuc_sequences.erase(name);
+      partition.nuc_sequences.insert({name, shared_partition});
+   }
+   for (auto& [name, store] : aa_sequences) {
+      auto& shared_partition =
+         store.sharePartition(partition_index, other.aa_sequences.at(name), other_partition_index);
+      partition.aa_sequences.erase(name);
+      partition.aa_sequences.insert({name, shared_partition});
+   }
+   partition.sequence_count = other.partitions[other_partition_index].sequence_count;
+}
+
 void Database::finalizeInsertionIndexes() {
-   tbb::parallel_for_each(partitions.begin(), partitions.end(), [](auto& partition) {
+   NumaNodes::get().parallelFor(getPartitionNumaNodes(), [&](size_t partition_index) {
+      auto& partition = partitions[partition_index];
       for (auto& insertion_column : partition.columns.nuc_insertion_columns) {
          insertion_column.second.buildInsertionIndexes();
       }
@@ -698,6 +924,112 @@ void Database::finalizeInsertionIndexes() {
    });
 }
 
+void Database::placePartitionsOnNumaNodes() {
+   std::vector<uint64_t> sequence_counts;
+   sequence_counts.reserve(partitions.size());
+   for (const auto& partition : partitions) {
+      uint64_t sequence_count = 0;
+      for (const auto& chunk : partition.getChunks()) {
+         sequence_count += chunk.size;
+      }
+      sequence_counts.push_back(sequence_count);
+   }
+   const auto numa_nodes = NumaNodes::assignNodes(sequence_counts, NumaNodes::get().count());
+   for (size_t partition_index = 0; partition_index < partitions.size(); ++partition_index) {
+      partitions[partition_index].numa_node = numa_nodes[partition_index];
+   }
+}
+
+DatabasePartition& Database::appendDeltaPartition(uint32_t sequence_count) {
+   const auto partition_id = static_cast<uint32_t>(partitions.size());
+   SPDLOG_DEBUG("Appending delta partition {} for {} sequences", partition_id, sequence_count);
+   auto& partition = partitions.emplace_back(
+      std::vector<preprocessing::PartitionChunk>{{partition_id, 0, sequence_count, 0}}, true
+   );
+   for (const auto& item : database_config.schema.metadata) {
+      initializeColumnPartition(partition, item.getColumnType(), item.name);
+   }
+   for (auto& [nuc_name, store] : nuc_sequences) {
+      partition.nuc_sequences.insert({nuc_name, store.createPartition()});
+   }
+   for (auto& [nuc_name, store] : unaligned_nuc_sequences) {
+      partition.unaligned_nuc_sequences.insert({nuc_name, store.createPartition()});
+   }
+   for (auto& [aa_name, store] : aa_sequences) {
+      partition.aa_sequences.insert({aa_name, store.createPartition()});
+   }
+   return partition;
+}
+
+size_t Database::getDeltaPartitionCount() const {
+   return static_cast<size_t>(
+      std::count_if(partitions.begin(), partitions.end(), [](const auto& partition) {
+         return partition.isDelta();
+      })
+   );
+}
+
+std::vector<uint32_t> Database::getPartitionNumaNodes() const {
+   std::vector<uint32_t> numa_nodes;
+   numa_nodes.reserve(partitions.size());
+   for (const auto& partition : partitions) {
+      numa_nodes.push_back(partition.numa_node);
+   }
+   return numa_nodes;
+}
+
+void Database::compactDeltaPartitions() {
+   const auto first_delta_partition =
+      std::find_if(partitions.begin(), partitions.end(), [](const auto& partition) {
+         return partition.isDelta();
+      });
+   const auto main_partition_count =
+      static_cast<size_t>(std::distance(partitions.begin(), first_delta_partition));
+   if (main_partition_count == 0 || main_partition_count == partitions.size()) {
+      return;
+   }
+
+   SPDLOG_INFO(
+      "Compacting {} delta partitions into {} partitions",
+      partitions.size() - main_partition_count,
+      main_partition_count
+   );
+   // Deltas are always the last partitions. They are merged starting from the back, so that the
+   // partitions of the sequence stores can be removed from the back as well
+   while (partitions.size() > main_partition_count) {
+      const auto target_partition = std::min_element(
+         partitions.begin(),
+         partitions.begin() + static_cast<std::ptrdiff_t>(main_partition_count),
+         [](const auto& left, const auto& right) {
+            return left.sequence_count < right.sequence_count;
+         }
+      );
+      const auto target_partition_id =
+         static_cast<size_t>(std::distance(partitions.begin(), target_partition));
+      SPDLOG_DEBUG(
+         "Merging delta partition {} with {} sequences into partition {}",
+         partitions.size() - 1,
+         partitions.back().sequence_count,
+         target_partition_id
+      );
+
+      target_partition->append(partitions.back());
+      partitions.pop_back();
+
+      for (auto& [_, store] : nuc_sequences) {
+         store.partitions.pop_back();
+      }
+      for (auto& [_, store] : unaligned_nuc_sequences) {
+         store.mergeLastPartitionInto(target_partition_id);
+      }
+      for (auto& [_, store] : aa_sequences) {
+         store.partitions.pop_back();
+      }
+   }
+
+   finalizeInsertionIndexes();
+}
+
 void Database::setDataVersion(const DataVersion& data_version) {
    SPDLOG_DEBUG("Set data version to {}", data_version.toString());
    data_version_ = data_version;
@@ -707,10 +1039,33 @@ DataVersion Database::getDataVersion() const {
    return data_version_;
 }
 
+void Database::setWarmUpTime(int64_t warm_up_time_in_microseconds) {
+   warm_up_time_in_microseconds_ = warm_up_time_in_microseconds;
+}
+
 query_engine::QueryResult Database::executeQuery(const std::string& query) const {
    const silo::query_engine::QueryEngine query_engine(*this);
 
    return query_engine.executeQuery(query);
 }
 
+bool Database::warmUpQuery(const std::string& query) const {
+   const silo::query_engine::QueryEngine query_engine(*this);
+
+   return query_engine.warmUpQuery(query);
+}
+
+std::vector<query_engine::QueryResult> Database::executeBatchQuery(const std::string& batch_query
+) const {
+   const silo::query_engine::QueryEngine query_engine(*this);
+
+   return query_engine.executeBatchQuery(batch_query);
+}
+
+query_engine::QueryProfile Database::explainQuery(const std::string& query) const {
+   const silo::query_engine::QueryEngine query_engine(*this);
+
+   return query_engine.explainQuery(query);
+}
+
 }  // namespace silo
@@ -1,8 +1,17 @@
 #include "silo/database.h"
 
 #include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <optional>
+#include <string>
+#include <utility>
+#include <variant>
+#include <vector>
 
+#include <boost/algorithm/string/join.hpp>
 #include <gtest/gtest.h>
+#include <nlohmann/json.hpp>
 
 #include "silo/common/nucleotide_symbols.h"
 #include "silo/config/config_repository.h"
@@ -14,12 +23,19 @@
 #include "silo/query_engine/query_engine.h"
 #include "silo/storage/reference_genomes.h"
 
+/// The sizes of the position bitmaps depend on the partitioning, which must therefore not follow
+/// the number of hardware threads
+constexpr size_t TEST_PARTITION_COUNT = 4;
+
 silo::Database buildTestDatabase() {
    const silo::preprocessing::InputDirectory input_directory{"./testBaseData/exampleDataset/"};
 
-   auto config = silo::preprocessing::PreprocessingConfigReader()
-                    .readConfig("./testBaseData/test_preprocessing_config.yaml")
-                    .mergeValuesFromOrDefault(silo::preprocessing::OptionalPreprocessingConfig());
+   auto optional_config = silo::preprocessing::PreprocessingConfigReader().readConfig(
+      "./testBaseData/test_preprocessing_config.yaml"
+   );
+   optional_config.partition_count = TEST_PARTITION_COUNT;
+   const auto config =
+      optional_config.mergeValuesFromOrDefault(silo::preprocessing::OptionalPreprocessingConfig());
 
    const auto database_config = silo::config::ConfigRepository().getValidatedConfig(
       input_directory.directory + "database_config.yaml"
@@ -72,10 +88,10 @@ TEST(DatabaseTest, shouldReturnCorrectDatabaseInfo) {
    const auto simple_info = database.getDatabaseInfo();
 
    EXPECT_EQ(
-      detailed_info.bitmap_size_per_symbol.size_in_bytes.at(silo::Nucleotide::Symbol::A), 2635348
+      detailed_info.bitmap_size_per_symbol.size_in_bytes.at(silo::Nucleotide::Symbol::A), 959733
    );
    EXPECT_EQ(
-      detailed_info.bitmap_size_per_symbol.size_in_bytes.at(silo::Nucleotide::Symbol::GAP), 2648220
+      detailed_info.bitmap_size_per_symbol.size_in_bytes.at(silo::Nucleotide::Symbol::GAP), 975805
    );
 
    EXPECT_EQ(
@@ -86,7 +102,7 @@ TEST(DatabaseTest, shouldReturnCorrectDatabaseInfo) {
    EXPECT_EQ(
       detailed_info.bitmap_container_size_per_genome_section.bitmap_container_size_statistic
          .number_of_values_stored_in_run_containers,
-      9
+      1007
    );
    EXPECT_EQ(
       detailed_info.bitmap_container_size_per_genome_section.bitmap_container_size_statistic
@@ -95,22 +111,54 @@ TEST(DatabaseTest, shouldReturnCorrectDatabaseInfo) {
    );
 
    EXPECT_EQ(
-      detailed_info.bitmap_container_size_per_genome_section.total_bitmap_size_computed, 42136719
+      detailed_info.bitmap_container_size_per_genome_section.total_bitmap_size_computed, 15341999
    );
    EXPECT_EQ(
-      detailed_info.bitmap_container_size_per_genome_section.total_bitmap_size_frozen, 21075818
+      detailed_info.bitmap_container_size_per_genome_section.total_bitmap_size_frozen, 7679053
    );
    EXPECT_EQ(
       detailed_info.bitmap_container_size_per_genome_section.bitmap_container_size_statistic
          .total_bitmap_size_array_containers,
-      8754
+      8590
    );
 
-   EXPECT_EQ(simple_info.total_size, 26335659);
+   EXPECT_EQ(simple_info.total_size, 33731);
    EXPECT_EQ(simple_info.sequence_count, 100);
    EXPECT_EQ(simple_info.n_bitmaps_size, 3898);
 }
 
+TEST(DatabaseTest, shouldDistributeSequencesOverTheConfiguredNumberOfPartitions) {
+   auto optional_config = silo::preprocessing::PreprocessingConfigReader().readConfig(
+      "./testBaseData/test_preprocessing_config.yaml"
+   );
+   optional_config.partition_count = 4;
+   const auto config =
+      optional_config.mergeValuesFromOrDefault(silo::preprocessing::OptionalPreprocessingConfig());
+
+   const auto database_config = silo::config::ConfigRepository().getValidatedConfig(
+      "./testBaseData/exampleDataset/database_config.yaml"
+   );
+   const auto reference_genomes =
+      silo::ReferenceGenomes::readFromFile(config.getReferenceGenomeFilename());
+
+   silo::preprocessing::Preprocessor preprocessor(config, database_config, reference_genomes);
+   const auto database = preprocessor.preprocess();
+
+   EXPECT_GT(database.partitions.size(), 1);
+   EXPECT_LE(database.partitions.size(), 4);
+   uint32_t sequence_count = 0;
+   for (const auto& partition : database.partitions) {
+      uint32_t offset = 0;
+      for (const auto& chunk : partition.getChunks()) {
+         EXPECT_EQ(chunk.offset, offset);
+         offset += chunk.size;
+      }
+      EXPECT_EQ(offset, partition.sequence_count);
+      sequence_count += partition.sequence_count;
+   }
+   EXPECT_EQ(sequence_count, 100);
+}
+
 TEST(DatabaseTest, shouldSaveAndReloadDatabaseWithoutErrors) {
    auto first_database = buildTestDatabase();
 
@@ -132,3 +180,291 @@ TEST(DatabaseTest, shouldSaveAndReloadDatabaseWithoutErrors) {
    EXPECT_EQ(simple_database_info.sequence_count, 100);
    EXPECT_GT(simple_database_info.n_bitmaps_size, 0);
 }
+
+TEST(DatabaseTest, shouldReloadDatabaseReusingUnchangedPartitions) {
+   auto first_database = buildTestDatabase();
+
+   const std::filesystem::path directory = "output/test_serialized_state_reuse/";
+   if (std::filesystem::exists(directory)) {
+      std::filesystem::remove_all(directory);
+   }
+   std::filesystem::create_directories(directory);
+
+   const silo::DataVersion data_version = first_database.getDataVersion();
+
+   first_database.saveDatabaseState(directory);
+
+   const auto previous_database =
+      silo::Database::loadDatabaseState(directory / data_version.toString());
+   const auto database =
+      silo::Database::loadDatabaseState(directory / data_version.toString(), &previous_database);
+
+   const auto previous_info = previous_database.getDatabaseInfo();
+   const auto info = database.getDatabaseInfo();
+   EXPECT_EQ(info.total_size, previous_info.total_size);
+   EXPECT_EQ(info.sequence_count, previous_info.sequence_count);
+   EXPECT_EQ(info.n_bitmaps_size, previous_info.n_bitmaps_size);
+   EXPECT_EQ(
+      database.detailedDatabaseInfo()
+         .sequences.at("main")
+         .bitmap_container_size_per_genome_section.total_bitmap_size_computed,
+      previous_database.detailedDatabaseInfo()
+         .sequences.at("main")
+         .bitmap_container_size_per_genome_section.total_bitmap_size_computed
+   );
+}
+
+TEST(DatabaseTest, shouldNotShareEqualRangesOnDifferentColumnsInBatchQueries) {
+   const auto database = buildTestDatabase();
+
+   const std::string action = R"({"type": "Details", "fields": ["gisaid_epi_isl"]})";
+   const std::string date_range = R"("from": "2021-01-01", "to": "2021-03-31")";
+   const std::string on_date = R"({"type": "DateBetween", "column": "date", )" + date_range + "}";
+   const std::string on_unsorted_date =
+      R"({"type": "DateBetween", "column": "unsorted_date", )" + date_range + "}";
+   const std::vector<std::string> queries = {
+      R"({"action": )" + action + R"(, "filterExpression": )" + on_date + "}",
+      R"({"action": )" + action + R"(, "filterExpression": )" + on_unsorted_date + "}",
+      R"({"action": )" + action + R"(, "filterExpression": {"type": "And", "children": [)" +
+         on_date + R"(, {"type": "Negation", "child": )" + on_unsorted_date + "}]}}"
+   };
+   const auto results =
+      database.executeBatchQuery(R"({"queries": [)" + boost::algorithm::join(queries, ",") + "]}");
+
+   ASSERT_EQ(results.size(), queries.size());
+   for (size_t index = 0; index < queries.size(); ++index) {
+      EXPECT_EQ(
+         nlohmann::json(results[index]), nlohmann::json(database.executeQuery(queries[index]))
+      ) << queries[index];
+   }
+   EXPECT_NE(nlohmann::json(results[0]), nlohmann::json(results[1]));
+}
+
+/// Each pair renders the same toString, but the filters differ in type or value
+TEST(DatabaseTest, shouldNotShareFiltersWithEqualStringsInBatchQueries) {
+   const auto database = buildTestDatabase();
+
+   const std::vector<std::pair<std::string, std::string>> colliding_filters = {
+      {R"({"type": "NucleotideEquals", "position": 123, "symbol": "A"})",
+       R"({"type": "HasNucleotideMutation", "position": 12366})"},
+      {R"({"type": "AminoAcidEquals", "sequenceName": "S", "position": 12, "symbol": "A"})",
+       R"({"type": "HasAminoAcidMutation", "sequenceName": "S", "position": 1266})"},
+      {R"({"type": "FloatEquals", "column": "qc_value", "value": 0.98})",
+       R"({"type": "FloatEquals", "column": "qc_value", "value": 0.9800001})"},
+      {R"({"type": "FloatBetween", "column": "qc_value", "from": 0.97, "to": 0.98})",
+       R"({"type": "FloatBetween", "column": "qc_value", "from": 0.97, "to": 0.9799999})"},
+      {R"({"type": "IntEquals", "column": "age", "value": 4})",
+       R"({"type": "StringEquals", "column": "age", "value": "4"})"},
+   };
+   const std::string action = R"({"type": "Details", "fields": ["gisaid_epi_isl"]})";
+   for (const auto& [first_filter, second_filter] : colliding_filters) {
+      const std::vector<std::string> queries = {
+         R"({"action": )" + action + R"(, "filterExpression": )" + first_filter + "}",
+         R"({"action": )" + action + R"(, "filterExpression": )" + second_filter + "}"
+      };
+      const auto results = database.executeBatchQuery(
+         R"({"queries": [)" + boost::algorithm::join(queries, ",") + "]}"
+      );
+
+      ASSERT_EQ(results.size(), queries.size());
+      for (size_t index = 0; index < queries.size(); ++index) {
+         EXPECT_EQ(
+            nlohmann::json(results[index]), nlohmann::json(database.executeQuery(queries[index]))
+         ) << queries[index];
+      }
+   }
+}
+
+namespace {
+int64_t countOf(const silo::Database& database, const std::string& filter_expression) {
+   const auto result = database.executeQuery(
+      R"({"action": {"type": "Aggregated"}, "filterExpression": )" + filter_expression + "}"
+   );
+   return std::get<int32_t>(result.query_result.at(0).fields.at("count").value());
+}
+
+/// Appends the example dataset once more as a delta partition to the saved base database
+silo::Database buildDeltaDatabase(const std::filesystem::path& base_directory) {
+   auto optional_config = silo::preprocessing::PreprocessingConfigReader().readConfig(
+      "./testBaseData/test_preprocessing_config.yaml"
+   );
+   optional_config.delta_base_directory = base_directory;
+   const auto config =
+      optional_config.mergeValuesFromOrDefault(silo::preprocessing::OptionalPreprocessingConfig());
+   const auto database_config = silo::config::ConfigRepository().getValidatedConfig(
+      "./testBaseData/exampleDataset/database_config.yaml"
+   );
+   const auto reference_genomes =
+      silo::ReferenceGenomes::readFromFile(config.getReferenceGenomeFilename());
+
+   silo::preprocessing::Preprocessor preprocessor(config, database_config, reference_genomes);
+   return preprocessor.preprocess();
+}
+}  // namespace
+
+// NOLINTNEXTLINE(readability-function-cognitive-complexity)
+TEST(DatabaseTest, shouldAppendDeltaPartitionAndCompactIt) {
+   auto base_database = buildTestDatabase();
+
+   const std::filesystem::path directory = "output/test_serialized_state_delta/";
+   if (std::filesystem::exists(directory)) {
+      std::filesystem::remove_all(directory);
+   }
+   std::filesystem::create_directories(directory);
+   base_database.saveDatabaseState(directory);
+
+   auto database = buildDeltaDatabase(directory / base_database.getDataVersion().toString());
+
+   ASSERT_EQ(database.partitions.size(), base_database.partitions.size() + 1);
+   EXPECT_TRUE(database.partitions.back().isDelta());
+   EXPECT_EQ(database.getDeltaPartitionCount(), 1);
+   EXPECT_EQ(database.getDatabaseInfo().sequence_count, 200);
+
+   const std::vector<std::string> filter_expressions = {
+      R"({"type": "True"})",
+      R"({"type": "DateBetween", "column": "date", "from": "2021-03-18", "to": "2021-03-18"})",
+      R"({"type": "HasAminoAcidMutation", "position": 28, "sequenceName": "S"})",
+      R"({"type": "HasNucleotideMutation", "position": 241})",
+      R"({"type": "InsertionContains", "column": "nucleotideInsertions", "position": 25701,
+          "value": "CCC"})",
+      R"({"type": "PangoLineage", "column": "pango_lineage", "value": "B.1.1.7",
+          "includeSublineages": true})"
+   };
+   const std::string mutations_query =
+      R"({"action": {"type": "Mutations", "minProportion": 0.05},
+          "filterExpression": {"type": "True"}})";
+
+   for (const auto& filter_expression : filter_expressions) {
+      EXPECT_EQ(
+         countOf(database, filter_expression), 2 * countOf(base_database, filter_expression)
+      ) << filter_expression;
+   }
+   const nlohmann::json mutations_before_compaction = database.executeQuery(mutations_query);
+
+   database.compactDeltaPartitions();
+
+   EXPECT_EQ(database.partitions.size(), base_database.partitions.size());
+   EXPECT_EQ(database.getDeltaPartitionCount(), 0);
+   EXPECT_EQ(database.getDatabaseInfo().sequence_count, 200);
+   for (const auto& filter_expression : filter_expressions) {
+      EXPECT_EQ(
+         countOf(database, filter_expression), 2 * countOf(base_database, filter_expression)
+      ) << filter_expression;
+   }
+   EXPECT_EQ(nlohmann::json(database.executeQuery(mutations_query)), mutations_before_compaction);
+}
+
+// NOLINTNEXTLINE(readability-function-cognitive-complexity)
+TEST(DatabaseTest, shouldShareSequencesOfUnchangedPartitionsWhenDictionariesChange) {
+   const std::filesystem::path input_directory = "output/test_new_dictionary_value_input/";
+   const std::filesystem::path directory = "output/test_serialized_state_new_dictionary_value/";
+   for (const auto& path : {input_directory, directory}) {
+      if (std::filesystem::exists(path)) {
+         std::filesystem::remove_all(path);
+      }
+   }
+   std::filesystem::copy(
+      "./testBaseData/exampleDataset/", input_directory, std::filesystem::copy_options::recursive
+   );
+
+   const auto metadata_file = input_directory / "small_metadata_set.tsv";
+   std::string metadata;
+   {
+      std::ifstream file(metadata_file);
+      metadata.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+   }
+   const std::string first_row = "EPI_ISL_1408408\tB.1.1.7\t2021-03-18\tEurope\t";
+   const std::string old_country = "Switzerland";
+   const auto country_position = metadata.find(first_row + old_country);
+   ASSERT_NE(country_position, std::string::npos);
+   metadata.replace(country_position + first_row.size(), old_country.size(), "Atlantis");
+   std::ofstream(metadata_file) << metadata;
+
+   auto optional_config = silo::preprocessing::PreprocessingConfigReader().readConfig(
+      "./testBaseData/test_preprocessing_config.yaml"
+   );
+   optional_config.input_directory = input_directory;
+   const auto config =
+      optional_config.mergeValuesFromOrDefault(silo::preprocessing::OptionalPreprocessingConfig());
+   const auto database_config = silo::config::ConfigRepository().getValidatedConfig(
+      input_directory / "database_config.yaml"
+   );
+   const auto reference_genomes =
+      silo::ReferenceGenomes::readFromFile(config.getReferenceGenomeFilename());
+   silo::preprocessing::Preprocessor preprocessor(config, database_config, reference_genomes);
+   auto updated_database = preprocessor.preprocess();
+
+   auto first_database = buildTestDatabase();
+   std::filesystem::create_directories(directory / "first");
+   std::filesystem::create_directories(directory / "updated");
+   first_database.saveDatabaseState(directory / "first");
+   updated_database.saveDatabaseState(directory / "updated");
+
+   std::optional<silo::Database> previous_database = silo::Database::loadDatabaseState(
+      directory / "first" / first_database.getDataVersion().toString()
+   );
+   const auto database = silo::Database::loadDatabaseState(
+      directory / "updated" / updated_database.getDataVersion().toString(), &*previous_database
+   );
+
+   ASSERT_EQ(database.partitions.size(), previous_database->partitions.size());
+   for (size_t partition_index = 0; partition_index < database.partitions.size();
+        ++partition_index) {
+      EXPECT_EQ(
+         &database.partitions[partition_index].nuc_sequences.at("main"),
+         &previous_database->partitions[partition_index].nuc_sequences.at("main")
+      ) << partition_index;
+      EXPECT_EQ(
+         &database.partitions[partition_index].aa_sequences.at("S"),
+         &previous_database->partitions[partition_index].aa_sequences.at("S")
+      ) << partition_index;
+   }
+
+   const std::string new_country_filter =
+      R"({"type": "StringEquals", "column": "country", "value": "Atlantis"})";
+   EXPECT_EQ(countOf(database, new_country_filter), 1);
+   EXPECT_EQ(countOf(*previous_database, new_country_filter), 0);
+
+   const std::string mutations_query =
+      R"({"action": {"type": "Mutations", "minProportion": 0.05},
+          "filterExpression": {"type": "True"}})";
+   const nlohmann::json mutations = database.executeQuery(mutations_query);
+   previous_database.reset();
+   EXPECT_EQ(nlohmann::json(database.executeQuery(mutations_query)), mutations);
+}
+
+TEST(DatabaseTest, shouldShareSequencesOfMainPartitionsWhenLoadingAnAppendedDelta) {
+   auto base_database = buildTestDatabase();
+
+   const std::filesystem::path directory = "output/test_serialized_state_delta_reload/";
+   if (std::filesystem::exists(directory)) {
+      std::filesystem::remove_all(directory);
+   }
+   std::filesystem::create_directories(directory / "base");
+   std::filesystem::create_directories(directory / "delta");
+   base_database.saveDatabaseState(directory / "base");
+   const auto base_directory = directory / "base" / base_database.getDataVersion().toString();
+
+   auto delta_database = buildDeltaDatabase(base_directory);
+   delta_database.saveDatabaseState(directory / "delta");
+
+   const auto previous_database = silo::Database::loadDatabaseState(base_directory);
+   const auto database = silo::Database::loadDatabaseState(
+      directory / "delta" / delta_database.getDataVersion().toString(), &previous_database
+   );
+
+   ASSERT_EQ(database.partitions.size(), previous_database.partitions.size() + 1);
+   for (size_t partition_index = 0; partition_index < previous_database.partitions.size();
+        ++partition_index) {
+      EXPECT_EQ(
+         &database.partitions[partition_index].nuc_sequences.at("main"),
+         &previous_database.partitions[partition_index].nuc_sequences.at("main")
+      ) << partition_index;
+   }
+   EXPECT_TRUE(database.partitions.back().isDelta());
+   EXPECT_EQ(database.getDatabaseInfo().sequence_count, 200);
+   const std::string filter_expression = R"({"type": "HasNucleotideMutation", "position": 241})";
+   EXPECT_EQ(
+      countOf(database, filter_expression), 2 * countOf(previous_database, filter_expression)
+   );
+}
@@ -0,0 +1,68 @@
+#include "silo/persistence/content_hashes.h"
+
+#include <fstream>
+#include <ostream>
+#include <streambuf>
+#include <vector>
+
+#include <boost/crc.hpp>
+
+#include "silo/persistence/exception.h"
+
+namespace silo::persistence {
+
+namespace {
+// CRC-64/XZ
+using Crc64 = boost::crc_optimal<64, 0x42F0E1EBA9EA3693, ~0ULL, ~0ULL, true, true>;
+
+constexpr size_t READ_BUFFER_SIZE = 1 << 20;
+
+/// Feeds everything that is written to it into the CRC instead of storing it
+class HashingStreamBuffer : public std::streambuf {
+   Crc64& crc;
+
+  public:
+   explicit HashingStreamBuffer(Crc64& crc)
+       : crc(crc) {}
+
+  protected:
+   int_type overflow(int_type character) override {
+      if (!traits_type::eq_int_type(character, traits_type::eof())) {
+         crc.process_byte(static_cast<unsigned char>(traits_type::to_char_type(character)));
+      }
+      return traits_type::not_eof(character);
+   }
+
+   std::streamsize xsputn(const char* data, std::streamsize count) override {
+      crc.process_bytes(data, static_cast<size_t>(count));
+      return count;
+   }
+};
+}  // namespace
+
+uint64_t hashFileContents(const std::vector<std::filesystem::path>& files) {
+   Crc64 crc;
+   std::vector<char> buffer(READ_BUFFER_SIZE);
+   for (const auto& file : files) {
+      std::ifstream input(file, std::ios::binary);
+      if (!input) {
+         throw LoadDatabaseException("Could not open " + file.string() + " for hashing");
+      }
+      while (input) {
+         input.read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+         crc.process_bytes(buffer.data(), static_cast<size_t>(input.gcount()));
+      }
+   }
+   return crc.checksum();
+}
+
+uint64_t hashStreamContents(const std::function<void(std::ostream&)>& write) {
+   Crc64 crc;
+   HashingStreamBuffer buffer(crc);
+   std::ostream stream(&buffer);
+   write(stream);
+   stream.flush();
+   return crc.checksum();
+}
+
+}  // namespace silo::persistence
@@ -0,0 +1,239 @@
+#include "silo/preprocessing/mutation_list_table_reader.h"
+
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <vector>
+
+#include <fmt/format.h>
+#include <spdlog/spdlog.h>
+#include <duckdb.hpp>
+
+#include "silo/common/aa_symbols.h"
+#include "silo/common/nucleotide_symbols.h"
+#include "silo/preprocessing/preprocessing_exception.h"
+
+namespace silo::preprocessing {
+
+template <typename SymbolType>
+MutationListTableReader<SymbolType>::MutationListTableReader(
+   duckdb::Connection& connection,
+   std::string_view table_name,
+   std::string_view reference_sequence,
+   std::string_view where_clause,
+   std::string_view order_by_clause
+)
+    : connection(connection),
+      table_name(table_name),
+      where_clause(where_clause),
+      order_by_clause(order_by_clause) {
+   SPDLOG_TRACE("Initializing MutationListTableReader for table {}", table_name);
+   auto reference_symbols = SymbolType::stringToSymbolVector(std::string(reference_sequence));
+   if (!reference_symbols.has_value()) {
+      throw PreprocessingException(
+         fmt::format("The reference sequence of table {} contains illegal symbols", table_name)
+      );
+   }
+   this->reference_sequence = std::move(*reference_symbols);
+}
+
+template <typename SymbolType>
+std::pair<uint32_t, typename SymbolType::Symbol> MutationListTableReader<SymbolType>::parseMutation(
+   std::string_view mutation,
+   const std::vector<typename SymbolType::Symbol>& reference_sequence
+) {
+   if (mutation.size() < 2) {
+      throw PreprocessingException(fmt::format("Mutation '{}' is too short", mutation));
+   }
+   const auto symbol = SymbolType::charToSymbol(mutation.back());
+   if (!symbol.has_value()) {
+      throw PreprocessingException(
+         fmt::format("Mutation '{}' contains the illegal symbol '{}'", mutation, mutation.back())
+      );
+   }
+
+   std::string_view position_string = mutation.substr(0, mutation.size() - 1);
+   std::optional<char> reference_character;
+   if (std::isdigit(static_cast<unsigned char>(position_string.front())) == 0) {
+      reference_character = position_string.front();
+      position_string.remove_prefix(1);
+   }
+
+   uint32_t position = 0;
+   const auto* const position_end = position_string.data() + position_string.size();
+   const auto [parsed_until, error] =
+      std::from_chars(position_string.data(), position_end, position);
+   if (error != std::errc{} || parsed_until != position_end || position == 0
+       || position > reference_sequence.size()) {
+      throw PreprocessingException(fmt::format(
+         "Mutation '{}' does not contain a position between 1 and the reference length {}",
+         mutation,
+         reference_sequence.size()
+      ));
+   }
+
+   const auto reference_symbol = reference_sequence.at(position - 1);
+   if (reference_character.has_value()
+       && SymbolType::charToSymbol(*reference_character) != reference_symbol) {
+      throw PreprocessingException(fmt::format(
+         "Mutation '{}' does not match the reference symbol '{}' at position {}",
+         mutation,
+         SymbolType::symbolToChar(reference_symbol),
+         position
+      ));
+   }
+   return {position - 1, *symbol};
+}
+
+template <typename SymbolType>
+std::pair<uint32_t, uint32_t> MutationListTableReader<SymbolType>::parseMissingRange(
+   int64_t start,
+   int64_t end,
+   size_t genome_length
+) {
+   if (start < 1 || start > end || static_cast<size_t>(end) > genome_length) {
+      throw PreprocessingException(fmt::format(
+         "Missing range [{}, {}] must lie within the reference positions 1 to {}",
+         start,
+         end,
+         genome_length
+      ));
+   }
+   return {static_cast<uint32_t>(start - 1), static_cast<uint32_t>(end)};
+}
+
+template <typename SymbolType>
+void MutationListTableReader<SymbolType>::validateDifferences(
+   const SequenceDifferences<SymbolType>& differences,
+   std::string_view key
+) {
+   std::vector<uint32_t> positions;
+   positions.reserve(differences.substitutions.size());
+   for (const auto& [position, _] : differences.substitutions) {
+      positions.push_back(position);
+   }
+   std::sort(positions.begin(), positions.end());
+   const auto duplicate = std::adjacent_find(positions.begin(), positions.end());
+   if (duplicate != positions.end()) {
+      throw PreprocessingException(fmt::format(
+         "Sequence {} contains more than one mutation at position {}", key, *duplicate + 1
+      ));
+   }
+
+   auto missing_ranges = differences.missing_ranges;
+   std::sort(missing_ranges.begin(), missing_ranges.end());
+   auto missing_range = missing_ranges.begin();
+   uint32_t covered_until = 0;
+   for (const uint32_t position : positions) {
+      while (missing_range != missing_ranges.end() && missing_range->first <= position) {
+         covered_until = std::max(covered_until, missing_range->second);
+         ++missing_range;
+      }
+      if (position < covered_until) {
+         throw PreprocessingException(fmt::format(
+            "Sequence {} contains a mutation at position {}, which lies in a missing range",
+            key,
+            position + 1
+         ));
+      }
+   }
+}
+
+template <typename SymbolType>
+std::optional<std::string> MutationListTableReader<SymbolType>::next(
+   std::optional<SequenceDifferences<SymbolType>>& differences
+) {
+   if (!current_chunk) {
+      return std::nullopt;
+   }
+
+   auto key = current_chunk->GetValue(0, current_row).GetValue<std::string>();
+   const auto mutations = current_chunk->GetValue(1, current_row);
+   const auto missing_ranges = current_chunk->GetValue(2, current_row);
+
+   if (mutations.IsNull() && missing_ranges.IsNull()) {
+      differences = std::nullopt;
+   } else {
+      differences = SequenceDifferences<SymbolType>{};
+      if (!mutations.IsNull()) {
+         for (const auto& mutation : duckdb::ListValue::GetChildren(mutations)) {
+            differences->substitutions.emplace_back(
+               parseMutation(mutation.GetValue<std::string>(), reference_sequence)
+            );
+         }
+      }
+      if (!missing_ranges.IsNull()) {
+         for (const auto& range : duckdb::ListValue::GetChildren(missing_ranges)) {
+            const auto& bounds = duckdb::ListValue::GetChildren(range);
+            if (bounds.size() != 2) {
+               throw PreprocessingException(fmt::format(
+                  "Missing range {} of sequence {} must consist of a start and an end",
+                  range.ToString(),
+                  key
+               ));
+            }
+            differences->missing_ranges.emplace_back(parseMissingRange(
+               bounds[0].GetValue<int64_t>(),
+               bounds[1].GetValue<int64_t>(),
+               reference_sequence.size()
+            ));
+         }
+      }
+      validateDifferences(*differences, key);
+   }
+
+   advanceRow();
+   return key;
+}
+
+template <typename SymbolType>
+std::string MutationListTableReader<SymbolType>::getTableQuery() const {
+   return fmt::format(
+      "SELECT key, mutations, missing FROM {} WHERE {} {}",
+      table_name,
+      where_clause,
+      order_by_clause
+   );
+}
+
+template <typename SymbolType>
+void MutationListTableReader<SymbolType>::loadTable() {
+   try {
+      query_result = connection.Query(getTableQuery());
+   } catch (const std::exception& e) {
+      SPDLOG_ERROR("Error when executing SQL {}", e.what());
+      throw PreprocessingException(fmt::format(
+         "SQL for loading the results that the MutationListTableReader reads:{}\n"
+         "Resulting Error:\n{}",
+         getTableQuery(),
+         std::string(e.what())
+      ));
+   }
+   if (query_result->HasError()) {
+      SPDLOG_ERROR("Error when executing SQL " + query_result->GetError());
+      throw PreprocessingException("Error when executing SQL " + query_result->GetError());
+   }
+   current_chunk = query_result->Fetch();
+   current_row = 0;
+
+   while (current_chunk && current_chunk->size() == 0) {
+      current_chunk = query_result->Fetch();
+   }
+}
+
+template <typename SymbolType>
+void MutationListTableReader<SymbolType>::advanceRow() {
+   current_row++;
+   if (current_row == current_chunk->size()) {
+      current_row = 0;
+      current_chunk = query_result->Fetch();
+      while (current_chunk && current_chunk->size() == 0) {
+         current_chunk = query_result->Fetch();
+      }
+   }
+}
+
+template class MutationListTableReader<Nucleotide>;
+template class MutationListTableReader<AminoAcid>;
+
+}  // namespace silo::preprocessing
@@ -0,0 +1,90 @@
+#include "silo/preprocessing/mutation_list_table_reader.h"
+
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "silo/common/nucleotide_symbols.h"
+#include "silo/preprocessing/preprocessing_exception.h"
+
+using silo::Nucleotide;
+using silo::preprocessing::MutationListTableReader;
+using silo::preprocessing::PreprocessingException;
+
+namespace {
+const std::vector<Nucleotide::Symbol> REFERENCE = Nucleotide::stringToSymbolVector("ACGT").value();
+}  // namespace
+
+TEST(MutationListTableReader, parsesMutationsWithAndWithoutReferenceSymbol) {
+   EXPECT_EQ(
+      MutationListTableReader<Nucleotide>::parseMutation("C2T", REFERENCE),
+      std::make_pair(uint32_t{1}, Nucleotide::Symbol::T)
+   );
+   EXPECT_EQ(
+      MutationListTableReader<Nucleotide>::parseMutation("4-", REFERENCE),
+      std::make_pair(uint32_t{3}, Nucleotide::Symbol::GAP)
+   );
+}
+
+TEST(MutationListTableReader, rejectsInvalidMutations) {
+   EXPECT_THROW(
+      MutationListTableReader<Nucleotide>::parseMutation("A2T", REFERENCE), PreprocessingException
+   );
+   EXPECT_THROW(
+      MutationListTableReader<Nucleotide>::parseMutation("A0T", REFERENCE), PreprocessingException
+   );
+   EXPECT_THROW(
+      MutationListTableReader<Nucleotide>::parseMutation("5T", REFERENCE), PreprocessingException
+   );
+   EXPECT_THROW(
+      MutationListTableReader<Nucleotide>::parseMutation("A1?", REFERENCE), PreprocessingException
+   );
+   EXPECT_THROW(
+      MutationListTableReader<Nucleotide>::parseMutation("T", REFERENCE), PreprocessingException
+   );
+}
+
+TEST(MutationListTableReader, convertsMissingRangesToHalfOpenRanges) {
+   EXPECT_EQ(
+      MutationListTableReader<Nucleotide>::parseMissingRange(1, 4, REFERENCE.size()),
+      std::make_pair(uint32_t{0}, uint32_t{4})
+   );
+   EXPECT_EQ(
+      MutationListTableReader<Nucleotide>::parseMissingRange(2, 2, REFERENCE.size()),
+      std::make_pair(uint32_t{1}, uint32_t{2})
+   );
+   EXPECT_THROW(
+      MutationListTableReader<Nucleotide>::parseMissingRange(3, 2, REFERENCE.size()),
+      PreprocessingException
+   );
+   EXPECT_THROW(
+      MutationListTableReader<Nucleotide>::parseMissingRange(1, 5, REFERENCE.size()),
+      PreprocessingException
+   );
+}
+
+TEST(MutationListTableReader, rejectsTwoMutationsAtTheSamePosition) {
+   silo::SequenceDifferences<Nucleotide> differences;
+   differences.substitutions = {{1, Nucleotide::Symbol::T}, {3, Nucleotide::Symbol::A}};
+   EXPECT_NO_THROW(MutationListTableReader<Nucleotide>::validateDifferences(differences, "key"));
+
+   differences.substitutions.emplace_back(1, Nucleotide::Symbol::GAP);
+   EXPECT_THROW(
+      MutationListTableReader<Nucleotide>::validateDifferences(differences, "key"),
+      PreprocessingException
+   );
+}
+
+TEST(MutationListTableReader, rejectsMutationsWithinMissingRanges) {
+   silo::SequenceDifferences<Nucleotide> differences;
+   differences.substitutions = {{0, Nucleotide::Symbol::T}, {3, Nucleotide::Symbol::A}};
+   differences.missing_ranges = {{1, 3}};
+   EXPECT_NO_THROW(MutationListTableReader<Nucleotide>::validateDifferences(differences, "key"));
+
+   differences.substitutions.emplace_back(2, Nucleotide::Symbol::C);
+   EXPECT_THROW(
+      MutationListTableReader<Nucleotide>::validateDifferences(differences, "key"),
+      PreprocessingException
+   );
+}
@@ -1,7 +1,10 @@
 #include "silo/preprocessing/partition.h"
 
+#include <algorithm>
+#include <cmath>
 #include <istream>
 #include <list>
+#include <numeric>
 #include <stdexcept>
 #include <utility>
 
@@ -44,6 +47,58 @@ bool PartitionChunk::operator==(const PartitionChunk& other) const {
    return partition == other.partition && chunk == other.chunk && size == other.size;
 }
 
+bool PartitionKeyPiece::operator==(const PartitionKeyPiece& other) const {
+   return key_index == other.key_index && piece_count == other.piece_count &&
+          piece == other.piece && partition == other.partition && chunk == other.chunk;
+}
+
+std::vector<PartitionKeyPiece> assignPartitionKeys(
+   const std::vector<PartitionKeyStatistics>& keys,
+   size_t partition_count
+) {
+   partition_count = std::max<size_t>(partition_count, 1);
+   const auto total_cost = static_cast<double>(std::accumulate(
+      keys.begin(),
+      keys.end(),
+      uint64_t{0},
+      [](uint64_t sum, const PartitionKeyStatistics& key) { return sum + key.cost; }
+   ));
+   const double average_cost = total_cost / static_cast<double>(partition_count);
+
+   std::vector<PartitionKeyPiece> pieces;
+   double remaining_cost = total_cost;
+   double target_cost = average_cost;
+   double partition_cost = 0;
+   uint32_t partition = 0;
+   uint32_t chunk = 0;
+   for (size_t key_index = 0; key_index < keys.size(); ++key_index) {
+      const auto& key = keys[key_index];
+      const auto piece_count = static_cast<uint32_t>(std::clamp<double>(
+         std::ceil(static_cast<double>(key.cost) / average_cost),
+         1,
+         static_cast<double>(std::max<uint64_t>(key.row_count, 1))
+      ));
+      const double piece_cost = static_cast<double>(key.cost) / piece_count;
+      for (uint32_t piece = 0; piece < piece_count; ++piece) {
+         // Close the partition if adding the piece would miss the target by more than stopping
+         const bool overshoots =
+            partition_cost + piece_cost - target_cost > target_cost - partition_cost;
+         if (chunk > 0 && overshoots && partition + 1 < partition_count) {
+            ++partition;
+            chunk = 0;
+            // Rebalance the target, so that the deviations do not add up in the last partition
+            target_cost = remaining_cost / static_cast<double>(partition_count - partition);
+            partition_cost = 0;
+         }
+         pieces.push_back({key_index, piece_count, piece, partition, chunk});
+         ++chunk;
+         partition_cost += piece_cost;
+         remaining_cost -= piece_cost;
+      }
+   }
+   return pieces;
+}
+
 }  // namespace silo::preprocessing
 
 std::size_t std::hash<silo::preprocessing::PartitionChunk>::operator()(
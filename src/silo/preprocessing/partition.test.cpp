@@ -0,0 +1,78 @@
+#include "silo/preprocessing/partition.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using silo::preprocessing::assignPartitionKeys;
+using silo::preprocessing::PartitionKeyPiece;
+using silo::preprocessing::PartitionKeyStatistics;
+
+namespace {
+
+std::vector<uint64_t> costPerPartition(
+   const std::vector<PartitionKeyStatistics>& keys,
+   const std::vector<PartitionKeyPiece>& pieces
+) {
+   std::vector<uint64_t> costs;
+   for (const auto& piece : pieces) {
+      costs.resize(std::max<size_t>(costs.size(), piece.partition + 1));
+      costs[piece.partition] += keys[piece.key_index].cost / piece.piece_count;
+   }
+   return costs;
+}
+
+}  // namespace
+
+TEST(AssignPartitionKeys, groupsConsecutiveKeysIntoChunksOfBalancedPartitions) {
+   const std::vector<PartitionKeyStatistics> keys{{1, 10}, {1, 10}, {1, 10}, {1, 10}};
+
+   const auto pieces = assignPartitionKeys(keys, 2);
+
+   const std::vector<PartitionKeyPiece> expected{
+      {0, 1, 0, 0, 0}, {1, 1, 0, 0, 1}, {2, 1, 0, 1, 0}, {3, 1, 0, 1, 1}
+   };
+   EXPECT_EQ(pieces, expected);
+}
+
+TEST(AssignPartitionKeys, splitsKeysThatCostMoreThanAPartition) {
+   const std::vector<PartitionKeyStatistics> keys{{100, 300}, {10, 100}};
+
+   const auto pieces = assignPartitionKeys(keys, 4);
+
+   ASSERT_EQ(pieces.size(), 4);
+   for (uint32_t piece = 0; piece < 3; ++piece) {
+      EXPECT_EQ(pieces[piece], (PartitionKeyPiece{0, 3, piece, piece, 0}));
+   }
+   EXPECT_EQ(pieces[3], (PartitionKeyPiece{1, 1, 0, 3, 0}));
+}
+
+TEST(AssignPartitionKeys, neverSplitsAKeyIntoMorePiecesThanRows) {
+   const std::vector<PartitionKeyStatistics> keys{{2, 1000}};
+
+   const auto pieces = assignPartitionKeys(keys, 8);
+
+   ASSERT_EQ(pieces.size(), 2);
+   EXPECT_EQ(pieces[0].piece_count, 2);
+   EXPECT_EQ(pieces[1].partition, 1);
+}
+
+TEST(AssignPartitionKeys, doesNotExceedThePartitionCount) {
+   std::vector<PartitionKeyStatistics> keys;
+   for (uint64_t key = 0; key < 1000; ++key) {
+      keys.push_back({key % 7 + 1, (key * 37) % 101 + 1});
+   }
+
+   const auto pieces = assignPartitionKeys(keys, 16);
+
+   const auto costs = costPerPartition(keys, pieces);
+   ASSERT_EQ(costs.size(), 16);
+   const auto [min, max] = std::minmax_element(costs.begin(), costs.end());
+   EXPECT_LT(*max - *min, 101 * 2);
+}
+
+TEST(AssignPartitionKeys, returnsNoPiecesForNoKeys) {
+   EXPECT_TRUE(assignPartitionKeys({}, 4).empty());
+}
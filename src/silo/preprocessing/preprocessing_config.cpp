@@ -1,7 +1,11 @@
 #include "silo/preprocessing/preprocessing_config.h"
 
+#include <algorithm>
 #include <filesystem>
 #include <system_error>
+#include <thread>
+
+#include "silo/preprocessing/preprocessing_exception.h"
 
 namespace silo::preprocessing {
 
@@ -18,7 +22,12 @@ PreprocessingConfig::PreprocessingConfig(
    const ReferenceGenomeFilename& reference_genome_filename_,
    const NucleotideSequencePrefix& nucleotide_sequence_prefix_,
    const UnalignedNucleotideSequencePrefix& unaligned_nucleotide_sequence_prefix_,
-   const GenePrefix& gene_prefix_
+   const GenePrefix& gene_prefix_,
+   const DeltaBaseDirectory& delta_base_directory_,
+   const SequenceBufferSize& sequence_buffer_size_,
+   const SequenceTileSize& sequence_tile_size_,
+   const OptimizeRowOrder& optimize_row_order_,
+   const PartitionCount& partition_count_
 ) {
    preprocessing_database_location = preprocessing_database_location_.filename;
    input_directory = input_directory_.directory;
@@ -57,6 +66,23 @@ PreprocessingConfig::PreprocessingConfig(
    nucleotide_sequence_prefix = nucleotide_sequence_prefix_.prefix;
    unaligned_nucleotide_sequence_prefix = unaligned_nucleotide_sequence_prefix_.prefix;
    gene_prefix = gene_prefix_.prefix;
+
+   if (delta_base_directory_.directory.has_value()) {
+      delta_base_directory = delta_base_directory_.directory.value();
+      if (!std::filesystem::is_directory(delta_base_directory.value())) {
+         throw std::filesystem::filesystem_error(
+            delta_base_directory->string() + " does not exist", std::error_code()
+         );
+      }
+   }
+
+   if (sequence_buffer_size_.size == 0 || sequence_tile_size_.size == 0) {
+      throw PreprocessingException("sequenceBufferSize and sequenceTileSize must be positive");
+   }
+   sequence_buffer_size = sequence_buffer_size_.size;
+   sequence_tile_size = sequence_tile_size_.size;
+   optimize_row_order = optimize_row_order_.enabled;
+   partition_count = partition_count_.count;
 }
 
 std::filesystem::path PreprocessingConfig::getOutputDirectory() const {
@@ -88,6 +114,29 @@ std::optional<std::filesystem::path> PreprocessingConfig::getNdjsonInputFilename
    return ndjson_input_filename;
 }
 
+std::optional<std::filesystem::path> PreprocessingConfig::getDeltaBaseDirectory() const {
+   return delta_base_directory;
+}
+
+size_t PreprocessingConfig::getSequenceBufferSize() const {
+   return sequence_buffer_size;
+}
+
+size_t PreprocessingConfig::getSequenceTileSize() const {
+   return sequence_tile_size;
+}
+
+bool PreprocessingConfig::getOptimizeRowOrder() const {
+   return optimize_row_order;
+}
+
+size_t PreprocessingConfig::getPartitionCount() const {
+   if (partition_count == 0) {
+      return std::max<size_t>(std::thread::hardware_concurrency(), 1);
+   }
+   return partition_count;
+}
+
 std::filesystem::path PreprocessingConfig::getNucFilenameNoExtension(std::string_view nuc_name
 ) const {
    std::filesystem::path filename = sequences_folder;
@@ -124,7 +173,9 @@ std::filesystem::path PreprocessingConfig::getGeneFilenameNoExtension(std::strin
       "{{ input directory: '{}', pango_lineage_definition_file: {}, output_directory: '{}', "
       "metadata_file: '{}', reference_genome_file: '{}',  gene_file_prefix: '{}',  "
       "nucleotide_sequence_file_prefix: '{}', ndjson_filename: {}, "
-      "preprocessing_database_location: {} }}",
+      "preprocessing_database_location: {}, delta_base_directory: {}, "
+      "sequence_buffer_size: {}, sequence_tile_size: {}, optimize_row_order: {}, "
+      "partition_count: {} }}",
       preprocessing_config.input_directory.string(),
       preprocessing_config.output_directory.string(),
       preprocessing_config.pango_lineage_definition_file.has_value()
@@ -140,6 +191,13 @@ std::filesystem::path PreprocessingConfig::getGeneFilenameNoExtension(std::strin
          : "none",
       preprocessing_config.preprocessing_database_location.has_value()
          ? "'" + preprocessing_config.preprocessing_database_location->string() + "'"
-         : "none"
+         : "none",
+      preprocessing_config.delta_base_directory.has_value()
+         ? "'" + preprocessing_config.delta_base_directory->string() + "'"
+         : "none",
+      preprocessing_config.sequence_buffer_size,
+      preprocessing_config.sequence_tile_size,
+      preprocessing_config.optimize_row_order,
+      preprocessing_config.partition_count
    );
 }
@@ -20,6 +20,20 @@ std::optional<std::string> extractStringIfPresent(const Node& node, const std::s
    return std::nullopt;
 }
 
+std::optional<size_t> extractSizeIfPresent(const Node& node, const std::string& key) {
+   if (node[key]) {
+      return node[key].as<size_t>();
+   }
+   return std::nullopt;
+}
+
+std::optional<bool> extractBoolIfPresent(const Node& node, const std::string& key) {
+   if (node[key]) {
+      return node[key].as<bool>();
+   }
+   return std::nullopt;
+}
+
 template <>
 struct convert<OptionalPreprocessingConfig> {
    static bool decode(const Node& node, OptionalPreprocessingConfig& config) {
@@ -34,7 +48,12 @@ struct convert<OptionalPreprocessingConfig> {
          extractStringIfPresent(node, "referenceGenomeFilename"),
          extractStringIfPresent(node, "nucleotideSequencePrefix"),
          extractStringIfPresent(node, "unalignedNucleotideSequencePrefix"),
-         extractStringIfPresent(node, "genePrefix")
+         extractStringIfPresent(node, "genePrefix"),
+         extractStringIfPresent(node, "deltaBaseDirectory"),
+         extractSizeIfPresent(node, "sequenceBufferSize"),
+         extractSizeIfPresent(node, "sequenceTileSize"),
+         extractBoolIfPresent(node, "optimizeRowOrder"),
+         extractSizeIfPresent(node, "partitionCount")
       };
 
       return true;
@@ -111,6 +130,21 @@ PreprocessingConfig OptionalPreprocessingConfig::mergeValuesFromOrDefault(
       )},
       GenePrefix{gene_prefix.value_or(
          other.gene_prefix.value_or(silo::preprocessing::DEFAULT_GENE_PREFIX.prefix)
+      )},
+      DeltaBaseDirectory{
+         delta_base_directory.has_value() ? delta_base_directory : other.delta_base_directory
+      },
+      SequenceBufferSize{sequence_buffer_size.value_or(other.sequence_buffer_size.value_or(
+         silo::preprocessing::DEFAULT_SEQUENCE_BUFFER_SIZE.size
+      ))},
+      SequenceTileSize{sequence_tile_size.value_or(
+         other.sequence_tile_size.value_or(silo::preprocessing::DEFAULT_SEQUENCE_TILE_SIZE.size)
+      )},
+      OptimizeRowOrder{optimize_row_order.value_or(other.optimize_row_order.value_or(
+         silo::preprocessing::DEFAULT_OPTIMIZE_ROW_ORDER.enabled
+      ))},
+      PartitionCount{partition_count.value_or(
+         other.partition_count.value_or(silo::preprocessing::DEFAULT_PARTITION_COUNT.count)
       )}
    );
 }
@@ -23,6 +23,10 @@ TEST(PreprocessingConfigReader, shouldReadConfigWithCorrectParametersAndDefaults
    ASSERT_EQ(
       config.getPangoLineageDefinitionFilename(), input_directory + "pangolineage_alias.json"
    );
+   ASSERT_EQ(config.getSequenceBufferSize(), 1024);
+   ASSERT_EQ(config.getSequenceTileSize(), 64);
+   ASSERT_FALSE(config.getOptimizeRowOrder());
+   ASSERT_EQ(config.getPartitionCount(), 4);
 }
 
 TEST(PreprocessingConfigReader, shouldThrowExceptionWhenConfigFileDoesNotExist) {
@@ -50,6 +54,10 @@ TEST(PreprocessingConfigReader, shouldReadConfigWithOverriddenDefaults) {
 
    ASSERT_EQ(config.getNucFilenameNoExtension("aligned"), input_directory + "aligned");
    ASSERT_EQ(config.getOutputDirectory(), "./output/custom/");
+   ASSERT_EQ(config.getSequenceBufferSize(), 2048);
+   ASSERT_EQ(config.getSequenceTileSize(), 32);
+   ASSERT_TRUE(config.getOptimizeRowOrder());
+   ASSERT_EQ(config.getPartitionCount(), 4);
 }
 
 TEST(OptionalPreprocessingConfig, givenLeftHandSideHasValueThenMergeTakesLeftHandSideValue) {
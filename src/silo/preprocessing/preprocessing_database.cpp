@@ -9,7 +9,7 @@
 #include <spdlog/spdlog.h>
 #include <duckdb.hpp>
 
-#include "silo/common/fasta_reader.h"
+#include "silo/common/fasta_block_reader.h"
 #include "silo/preprocessing/partition.h"
 #include "silo/preprocessing/preprocessing_exception.h"
 #include "silo/preprocessing/sql_function.h"
@@ -36,6 +36,9 @@ PreprocessingDatabase::PreprocessingDatabase(
       compress_amino_acid_function(
          std::make_unique<CompressSequence>("aa", reference_genomes.raw_aa_sequences)
       ),
+      nucleotide_mutation_signature_function(std::make_unique<MutationSignature>(
+         "nuc", reference_genomes.raw_nucleotide_sequences
+      )),
       duck_db(backing_file.value_or(":memory:")),
       connection(duck_db) {
    query("PRAGMA default_null_order='NULLS FIRST';");
@@ -44,6 +47,7 @@ PreprocessingDatabase::PreprocessingDatabase(
 
    compress_nucleotide_function->addToConnection(connection);
    compress_amino_acid_function->addToConnection(connection);
+   nucleotide_mutation_signature_function->addToConnection(connection);
 }
 
 std::unique_ptr<MaterializedQueryResult> PreprocessingDatabase::query(std::string sql_query) {
@@ -60,47 +64,70 @@ duckdb::Connection& PreprocessingDatabase::getConnection() {
    return connection;
 }
 
+duckdb::Connection PreprocessingDatabase::createConnection() {
+   return duckdb::Connection{duck_db};
+}
+
 void PreprocessingDatabase::refreshConnection() {
    connection = duckdb::Connection{duck_db};
 }
 
 preprocessing::Partitions PreprocessingDatabase::getPartitionDescriptor() {
-   auto partition_descriptor_from_sql =
-      connection.Query("SELECT partition_id, count FROM partitioning ORDER BY partition_id");
+   auto partition_descriptor_from_sql = connection.Query(
+      "SELECT partition_id, chunk, count FROM partitioning ORDER BY partition_id, chunk"
+   );
 
    std::vector<preprocessing::Partition> partitions;
+   std::vector<preprocessing::PartitionChunk> chunks;
+   uint64_t partition_size = 0;
 
-   uint32_t check_partition_id_sorted_and_contiguous = 0;
+   const auto finish_partition = [&]() {
+      partitions.emplace_back(std::move(chunks));
+      chunks.clear();
+      partition_size = 0;
+   };
 
    for (auto it = partition_descriptor_from_sql->begin();
         it != partition_descriptor_from_sql->end();
         ++it) {
       const auto db_partition_id = it.current_row.GetValue<Value>(0);
       const uint32_t partition_id = BigIntValue::Get(db_partition_id);
-      if (partition_id != check_partition_id_sorted_and_contiguous) {
+      if (partition_id == partitions.size() + 1 && !chunks.empty()) {
+         finish_partition();
+      }
+      if (partition_id != partitions.size()) {
          throw PreprocessingException(
             "The partition IDs produced by the preprocessing are not sorted, not starting from 0 "
             "or not contiguous."
          );
       }
-      check_partition_id_sorted_and_contiguous++;
 
-      const auto db_partition_size = it.current_row.GetValue<Value>(1);
-      const int64_t partition_size_bigint = BigIntValue::Get(db_partition_size);
-      if (partition_size_bigint <= 0) {
+      const auto db_chunk = it.current_row.GetValue<Value>(1);
+      const uint32_t chunk = BigIntValue::Get(db_chunk);
+      if (chunk != chunks.size()) {
+         throw PreprocessingException(
+            "The chunks produced by the preprocessing are not sorted, not starting from 0 or not "
+            "contiguous."
+         );
+      }
+
+      const auto db_chunk_size = it.current_row.GetValue<Value>(2);
+      const int64_t chunk_size_bigint = BigIntValue::Get(db_chunk_size);
+      if (chunk_size_bigint <= 0) {
          throw PreprocessingException("Non-positive partition size encountered.");
       }
-      if (partition_size_bigint > UINT32_MAX) {
+      if (partition_size + static_cast<uint64_t>(chunk_size_bigint) > UINT32_MAX) {
          throw PreprocessingException(
             fmt::format("Overflow of limit UINT32_MAX ({}) for number of sequences.", UINT32_MAX)
          );
       }
 
-      const auto partition_size = static_cast<uint32_t>(partition_size_bigint);
-
-      partitions.emplace_back(
-         std::vector<preprocessing::PartitionChunk>{{partition_id, 0, partition_size, 0}}
-      );
+      const auto chunk_size = static_cast<uint32_t>(chunk_size_bigint);
+      chunks.push_back({partition_id, chunk, chunk_size, static_cast<uint32_t>(partition_size)});
+      partition_size += chunk_size;
+   }
+   if (!chunks.empty()) {
+      finish_partition();
    }
 
    return preprocessing::Partitions(partitions);
@@ -111,7 +138,7 @@ ZstdFastaTable PreprocessingDatabase::generateSequenceTableFromFasta(
    const std::string& reference_sequence,
    const std::string& filename
 ) {
-   silo::FastaReader fasta_reader(filename);
+   silo::FastaBlockReader fasta_reader(filename);
    return ZstdFastaTable::generate(connection, table_name, fasta_reader, reference_sequence);
 }
 
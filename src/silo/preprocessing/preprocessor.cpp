@@ -1,28 +1,59 @@
 #include "silo/preprocessing/preprocessor.h"
 
-#include <oneapi/tbb/blocked_range.h>
-#include <oneapi/tbb/parallel_for.h>
+#include <chrono>
+#include <filesystem>
+#include <functional>
+#include <numeric>
+#include <optional>
+#include <vector>
+
+#include <oneapi/tbb/enumerable_thread_specific.h>
+#include <oneapi/tbb/task_group.h>
 #include <silo/zstdfasta/zstdfasta_table_reader.h>
 #include <spdlog/spdlog.h>
 #include <boost/algorithm/string/join.hpp>
 
 #include "silo/common/block_timer.h"
 #include "silo/common/fasta_reader.h"
+#include "silo/common/log.h"
+#include "silo/common/nucleotide_symbols.h"
+#include "silo/common/numa.h"
+#include "silo/common/perf_counters.h"
 #include "silo/database.h"
 #include "silo/database_info.h"
 #include "silo/preprocessing/metadata_info.h"
+#include "silo/preprocessing/mutation_list_table_reader.h"
+#include "silo/preprocessing/partition.h"
 #include "silo/preprocessing/preprocessing_config.h"
 #include "silo/preprocessing/preprocessing_database.h"
 #include "silo/preprocessing/preprocessing_exception.h"
 #include "silo/preprocessing/sequence_info.h"
 #include "silo/preprocessing/sql_function.h"
 #include "silo/storage/reference_genomes.h"
+#include "silo/storage/sequence_store.h"
 #include "silo/storage/unaligned_sequence_store.h"
 #include "silo/zstdfasta/zstd_decompressor.h"
 #include "silo/zstdfasta/zstdfasta_table.h"
 
 namespace silo::preprocessing {
 
+namespace {
+
+/// Once an appended delta exceeds this number of delta partitions, all deltas are merged into the
+/// main partitions
+constexpr size_t MAX_DELTA_PARTITIONS = 8;
+
+/// Section length of the bitmap container statistics that report the effect of the row order
+constexpr size_t ROW_ORDER_STATISTICS_SECTION_LENGTH = 500;
+
+/// The estimated cost of a row for the partitioning, in bytes of compressed sequence. Accounts
+/// for the work per row that does not depend on its mutations
+constexpr size_t ROW_BASE_COST = 64;
+/// The estimated cost of a mutation of a mutation list, in bytes of compressed sequence
+constexpr size_t MUTATION_COST = 4;
+
+}  // namespace
+
 Preprocessor::Preprocessor(
    preprocessing::PreprocessingConfig preprocessing_config_,
    config::DatabaseConfig database_config_,
@@ -34,6 +65,11 @@ Preprocessor::Preprocessor(
       reference_genomes_(reference_genomes) {}
 
 Database Preprocessor::preprocess() {
+   const auto delta_base_directory = preprocessing_config.getDeltaBaseDirectory();
+   if (delta_base_directory.has_value()) {
+      return preprocessDelta(delta_base_directory.value());
+   }
+
    SPDLOG_INFO("preprocessing - building alias key");
    const auto pango_lineage_definition_filename =
       preprocessing_config.getPangoLineageDefinitionFilename();
@@ -42,6 +78,91 @@ Database Preprocessor::preprocess() {
       alias_key = PangoLineageAliasLookup::readFromFile(pango_lineage_definition_filename.value());
    }
 
+   buildInputTables();
+
+   const auto partition_descriptor = preprocessing_db.getPartitionDescriptor();
+
+   const std::string order_by_clause =
+      getOrderByClause(preprocessing_config.getOptimizeRowOrder());
+   SPDLOG_INFO("preprocessing - order by clause is {}", order_by_clause);
+
+   SPDLOG_INFO("preprocessing - building database");
+
+   preprocessing_db.refreshConnection();
+   return buildDatabase(
+      partition_descriptor,
+      order_by_clause,
+      alias_key,
+      preprocessing_config.getIntermediateResultsDirectory()
+   );
+}
+
+Database Preprocessor::preprocessDelta(const std::filesystem::path& delta_base_directory) {
+   SPDLOG_INFO(
+      "preprocessing - appending input as delta partition to the data version in '{}'",
+      delta_base_directory.string()
+   );
+   Database database = Database::loadDatabaseState(delta_base_directory);
+   if (database.getNucSequences() != reference_genomes_.nucleotide_sequences ||
+       database.getAASequences() != reference_genomes_.aa_sequences) {
+      throw PreprocessingException(fmt::format(
+         "The reference genomes do not match the reference genomes of the data version in '{}'",
+         delta_base_directory.string()
+      ));
+   }
+   // The delta uses the dictionaries of the base, so the schema of the base takes precedence
+   database_config = database.database_config;
+   delta_partition_id = static_cast<uint32_t>(database.partitions.size());
+
+   // The unaligned sequences of the delta are added next to hard links of the base's files, whose
+   // folder must not be modified while the base is served
+   database.intermediate_results_directory = preprocessing_config.getIntermediateResultsDirectory();
+   for (auto& [name, store] : database.unaligned_nuc_sequences) {
+      store.relocateFolder(database.intermediate_results_directory / ("unaligned_nuc_" + name));
+   }
+
+   buildInputTables();
+
+   const auto delta_count_result =
+      preprocessing_db.query("SELECT count(*) FROM row_partitioning;");
+   const auto delta_sequence_count =
+      static_cast<uint32_t>(duckdb::BigIntValue::Get(delta_count_result->GetValue(0, 0)));
+   if (delta_sequence_count == 0) {
+      throw PreprocessingException("The input does not contain any sequences to append");
+   }
+
+   const std::string order_by_clause =
+      getOrderByClause(preprocessing_config.getOptimizeRowOrder());
+   SPDLOG_INFO("preprocessing - order by clause is {}", order_by_clause);
+
+   preprocessing_db.refreshConnection();
+   int64_t micros = 0;
+   {
+      const BlockTimer timer(micros);
+      database.appendDeltaPartition(delta_sequence_count);
+      buildDeltaPartition(database, delta_partition_id.value(), order_by_clause);
+
+      SPDLOG_INFO("build - finalizing insertion indexes");
+      database.finalizeInsertionIndexes();
+
+      if (database.getDeltaPartitionCount() > MAX_DELTA_PARTITIONS) {
+         database.compactDeltaPartitions();
+      }
+   }
+   SPDLOG_INFO("Build of delta partition took {} ms", micros);
+
+   const DataVersion& data_version = DataVersion::mineDataVersion();
+   SPDLOG_INFO("preprocessing - mining data data_version: {}", data_version.toString());
+   database.setDataVersion(data_version);
+
+   SPDLOG_INFO("database info: {}", database.getDatabaseInfo());
+
+   database.validate();
+
+   return database;
+}
+
+void Preprocessor::buildInputTables() {
    const auto& ndjson_input_filename = preprocessing_config.getNdjsonInputFilename();
    if (ndjson_input_filename.has_value()) {
       SPDLOG_INFO("preprocessing - ndjson pipeline chosen");
@@ -50,10 +171,11 @@ Database Preprocessor::preprocess() {
          ndjson_input_filename.value().string()
       );
       buildTablesFromNdjsonInput(ndjson_input_filename.value());
+      createRowOrderTable();
       SPDLOG_DEBUG("preprocessing - building partitioning tables");
       buildPartitioningTable();
       SPDLOG_DEBUG("preprocessing - creating compressed sequence views for building SILO");
-      createPartitionedSequenceTablesFromNdjson(ndjson_input_filename.value());
+      createPartitionedSequenceTablesFromNdjson();
    } else {
       SPDLOG_INFO("preprocessing - classic metadata file pipeline chosen");
       SPDLOG_DEBUG(
@@ -61,6 +183,9 @@ Database Preprocessor::preprocess() {
          preprocessing_config.getMetadataInputFilename().string()
       );
       buildMetadataTableFromFile(preprocessing_config.getMetadataInputFilename());
+      createRowOrderTable();
+      SPDLOG_DEBUG("preprocessing - reading the aligned sequence files");
+      buildSequenceTablesFromSequenceFiles();
       SPDLOG_DEBUG("preprocessing - building partitioning tables");
       buildPartitioningTable();
       SPDLOG_DEBUG("preprocessing - creating partitioned sequence tables for building SILO");
@@ -68,20 +193,9 @@ Database Preprocessor::preprocess() {
    }
    SPDLOG_INFO("preprocessing - finished initial loading of data");
 
-   const auto partition_descriptor = preprocessing_db.getPartitionDescriptor();
-
-   std::string order_by_clause = database_config.schema.getStrictOrderByClause();
-   SPDLOG_INFO("preprocessing - order by clause is {}", order_by_clause);
-
-   SPDLOG_INFO("preprocessing - building database");
-
-   preprocessing_db.refreshConnection();
-   return buildDatabase(
-      partition_descriptor,
-      order_by_clause,
-      alias_key,
-      preprocessing_config.getIntermediateResultsDirectory()
-   );
+   if (preprocessing_config.getOptimizeRowOrder()) {
+      optimizeRowOrder();
+   }
 }
 
 void Preprocessor::buildTablesFromNdjsonInput(const std::filesystem::path& file_name) {
@@ -99,16 +213,45 @@ void Preprocessor::buildTablesFromNdjsonInput(const std::filesystem::path& file_
    SPDLOG_DEBUG("build - validating metadata file '{}' with config", file_name.string());
    const auto metadata_info = MetadataInfo::validateFromNdjsonFile(file_name, database_config);
 
+   const SequenceInfo sequence_info(reference_genomes_);
+   sequence_info.validate(preprocessing_db.getConnection(), file_name);
+   mutation_list_input =
+      SequenceInfo::containsMutationLists(preprocessing_db.getConnection(), file_name);
+   if (mutation_list_input) {
+      SPDLOG_INFO("preprocessing - aligned sequences are given as mutation lists");
+   }
+
+   std::vector<std::string> selects = metadata_info.getMetadataSelects();
+   const auto aligned_sequence_selects =
+      mutation_list_input ? sequence_info.getMutationListSelects()
+                          : sequence_info.getAlignedSequenceSelects(preprocessing_db);
+   selects.insert(selects.end(), aligned_sequence_selects.begin(), aligned_sequence_selects.end());
+   for (const auto& [seq_name, _] : reference_genomes_.raw_nucleotide_sequences) {
+      selects.push_back(SequenceInfo::getUnalignedSequenceSelect(seq_name, preprocessing_db));
+   }
+
+   // The input is parsed exactly once, in parallel chunks of lines. The metadata, aligned and
+   // unaligned sequences are all read from this table afterwards
+   SPDLOG_DEBUG("build - reading the ndjson file '{}' in a single pass", file_name.string());
    (void)preprocessing_db.query(fmt::format(
       R"-(
-         CREATE OR REPLACE TABLE metadata_table AS
+         CREATE OR REPLACE TABLE ndjson_table AS
          SELECT {}
-         FROM '{}';
+         FROM read_ndjson_auto('{}');
       )-",
-      boost::join(metadata_info.getMetadataSelects(), ","),
+      boost::join(selects, ","),
       file_name.string()
    ));
 
+   (void)preprocessing_db.query(fmt::format(
+      R"-(
+         CREATE OR REPLACE TABLE metadata_table AS
+         SELECT {}
+         FROM ndjson_table;
+      )-",
+      boost::join(metadata_info.getMetadataFields(), ",")
+   ));
+
    auto null_primary_key_result = preprocessing_db.query(fmt::format(
       R"-(
          SELECT {0} FROM metadata_table
@@ -144,210 +287,226 @@ void Preprocessor::buildMetadataTableFromFile(const std::filesystem::path& metad
 }
 
 void Preprocessor::buildPartitioningTable() {
-   if (database_config.schema.partition_by.has_value()) {
-      SPDLOG_DEBUG(
-         "preprocessing - partitioning input by metadata key '{}'",
-         database_config.schema.partition_by.value()
-      );
-      buildPartitioningTableByColumn(database_config.schema.partition_by.value());
+   if (delta_partition_id.has_value()) {
+      buildDeltaPartitioning(delta_partition_id.value());
    } else {
-      SPDLOG_DEBUG("preprocessing - no metadata key for partitioning provided");
-      buildEmptyPartitioning();
+      if (database_config.schema.partition_by.has_value()) {
+         SPDLOG_DEBUG(
+            "preprocessing - partitioning input by metadata key '{}'",
+            database_config.schema.partition_by.value()
+         );
+      } else {
+         SPDLOG_DEBUG("preprocessing - no metadata key for partitioning provided");
+      }
+      buildBalancedPartitioning(database_config.schema.partition_by);
    }
-}
 
-void Preprocessor::buildPartitioningTableByColumn(const std::string& partition_by_field) {
-   SPDLOG_INFO("preprocessing - calculating partitions");
-
-   (void)preprocessing_db.query(fmt::format(
-      R"-(
-CREATE OR REPLACE TABLE partition_keys AS
-SELECT row_number() OVER () - 1 AS id, partition_key, count
-FROM (SELECT {} AS partition_key, COUNT(*) AS count
-      FROM metadata_table
-      GROUP BY partition_key
-      ORDER BY partition_key);
-)-",
-      partition_by_field
-   ));
-
-   // create Recursive Hierarchical Partitioning By Partition Field
    (void)preprocessing_db.query(
       R"-(
 CREATE OR REPLACE TABLE partitioning AS
-WITH RECURSIVE
-          allowed_count(allowed_count) AS (SELECT sum(count) / 32 FROM partition_keys),
-          grouped_partition_keys(from_id, to_id, count) AS
-              (SELECT id, id, count
-               FROM partition_keys
-               WHERE id = 0
-               UNION ALL
-               SELECT CASE WHEN l1.count <= allowed_count THEN l1.from_id ELSE l2.id END,
-                      l2.id,
-                      CASE WHEN l1.count <= allowed_count
-                           THEN l1.count + l2.count
-                           ELSE l2.count END
-               FROM grouped_partition_keys l1,
-                    partition_keys l2,
-                    allowed_count
-WHERE l1.to_id + 1 = l2.id)
-SELECT row_number() OVER () - 1 AS partition_id, from_id, to_id, count
-FROM (SELECT from_id, MAX(to_id) AS to_id, MAX(count) AS count
-      FROM grouped_partition_keys
-      GROUP BY from_id)
-)-"
-   );
-
-   (void)preprocessing_db.query(
-      R"-(
-CREATE OR REPLACE TABLE partition_key_to_partition AS
-SELECT partition_keys.partition_key AS partition_key,
-  partitioning.partition_id AS partition_id
-FROM partition_keys,
-     partitioning
-WHERE partition_keys.id >= partitioning.from_id
-  AND partition_keys.id <= partitioning.to_id;
+SELECT partition_id, chunk, count(*) AS count
+FROM row_partitioning
+GROUP BY partition_id, chunk;
 )-"
    );
 
    (void)preprocessing_db.query(fmt::format(
       R"-(
 CREATE OR REPLACE VIEW partitioned_metadata AS
-SELECT partitioning.partition_id AS partition_id, metadata_table.*
-FROM partition_keys,
-     partitioning,
-     metadata_table
-WHERE (metadata_table.{0} = partition_keys.partition_key OR (metadata_table.{0} IS NULL
-AND partition_keys.partition_key IS NULL))
-  AND partition_keys.id >= partitioning.from_id
-  AND partition_keys.id <= partitioning.to_id;
+SELECT row_partitioning.partition_id AS partition_id,
+       row_partitioning.chunk AS silo_chunk,
+       metadata_table.*,
+       row_order.rank AS silo_row_rank
+FROM metadata_table JOIN row_partitioning ON metadata_table."{0}" = row_partitioning.key
+     LEFT JOIN row_order ON metadata_table."{0}" = row_order.key;
 )-",
-      partition_by_field
+      database_config.schema.primary_key
    ));
 }
 
-void Preprocessor::buildEmptyPartitioning() {
-   SPDLOG_INFO(
-      "preprocessing - skip partition merging because no partition_by key was provided, instead "
-      "putting all sequences into the same partition"
-   );
+void Preprocessor::buildBalancedPartitioning(const std::optional<std::string>& partition_by_field
+) {
+   const size_t partition_count = preprocessing_config.getPartitionCount();
+   SPDLOG_INFO("preprocessing - calculating {} partitions of similar cost", partition_count);
 
-   (void)preprocessing_db.query(
+   const std::string partition_key_select =
+      partition_by_field.has_value()
+         ? fmt::format("metadata_table.\"{}\"", partition_by_field.value())
+         : "NULL";
+   const std::string primary_key = database_config.schema.primary_key;
+
+   (void)preprocessing_db.query(fmt::format(
       R"-(
-CREATE OR REPLACE TABLE partitioning AS
-SELECT 0::bigint AS partition_id, 0::bigint AS from_id, 0::bigint AS to_id, count(*) AS count
-FROM metadata_table;
-)-"
-   );
+CREATE OR REPLACE TABLE partition_keys AS
+SELECT row_number() OVER (ORDER BY partition_key) - 1 AS id, partition_key, count, cost
+FROM (SELECT {0} AS partition_key,
+             COUNT(*) AS count,
+             SUM({1} + coalesce(sequence_sizes.bytes, 0))::BIGINT AS cost
+      FROM metadata_table LEFT JOIN ({2}) AS sequence_sizes
+      ON metadata_table."{3}" = sequence_sizes.key
+      GROUP BY partition_key);
+)-",
+      partition_key_select,
+      ROW_BASE_COST,
+      getSequenceSizeSelect(),
+      primary_key
+   ));
 
-   (void)preprocessing_db.query(
-      "CREATE OR REPLACE TABLE partition_key_to_partition AS\n"
-      "SELECT 0::bigint AS partition_key, 0::bigint AS partition_id;"
-   );
+   const auto key_result =
+      preprocessing_db.query("SELECT count, cost FROM partition_keys ORDER BY id;");
+   std::vector<PartitionKeyStatistics> keys;
+   keys.reserve(key_result->RowCount());
+   for (size_t row = 0; row < key_result->RowCount(); ++row) {
+      keys.push_back(
+         {static_cast<uint64_t>(key_result->GetValue<int64_t>(0, row)),
+          static_cast<uint64_t>(key_result->GetValue<int64_t>(1, row))}
+      );
+   }
 
    (void)preprocessing_db.query(
-      "CREATE OR REPLACE VIEW partitioned_metadata AS\n"
-      "SELECT 0::bigint AS partition_id, metadata_table.*\n"
-      "FROM metadata_table;"
+      "CREATE OR REPLACE TABLE partition_key_pieces "
+      "(key_id BIGINT, piece_count BIGINT, piece BIGINT, partition_id BIGINT, chunk BIGINT);"
    );
+   {
+      duckdb::Appender appender(preprocessing_db.getConnection(), "partition_key_pieces");
+      for (const auto& piece : assignPartitionKeys(keys, partition_count)) {
+         appender.AppendRow(
+            static_cast<int64_t>(piece.key_index),
+            static_cast<int64_t>(piece.piece_count),
+            static_cast<int64_t>(piece.piece),
+            static_cast<int64_t>(piece.partition),
+            static_cast<int64_t>(piece.chunk)
+         );
+      }
+      appender.Close();
+   }
+
+   // The rows of a key are split into its pieces in date order, so that every chunk is sorted
+   std::vector<std::string> order_within_key;
+   for (const auto& field : database_config.schema.getStrictOrderByFields()) {
+      order_within_key.push_back(fmt::format("metadata_table.\"{}\"", field));
+   }
+   (void)preprocessing_db.query(fmt::format(
+      R"-(
+CREATE OR REPLACE TABLE row_partitioning AS
+SELECT keyed_rows.key AS key, pieces.partition_id AS partition_id, pieces.chunk AS chunk
+FROM (SELECT metadata_table."{0}" AS key,
+             partition_keys.id AS key_id,
+             partition_keys.count AS count,
+             row_number() OVER (PARTITION BY partition_keys.id ORDER BY {1}) - 1 AS row_in_key
+      FROM metadata_table JOIN partition_keys
+      ON {2} IS NOT DISTINCT FROM partition_keys.partition_key) AS keyed_rows
+     JOIN partition_key_pieces AS pieces
+     ON keyed_rows.key_id = pieces.key_id
+        AND keyed_rows.row_in_key * pieces.piece_count // keyed_rows.count = pieces.piece;
+)-",
+      primary_key,
+      boost::join(order_within_key, ", "),
+      partition_key_select
+   ));
 }
 
-void Preprocessor::createPartitionedSequenceTablesFromNdjson(const std::filesystem::path& file_name
-) {
-   const SequenceInfo sequence_info(reference_genomes_);
-   sequence_info.validate(preprocessing_db.getConnection(), file_name);
+void Preprocessor::buildDeltaPartitioning(uint32_t partition_id) {
+   SPDLOG_INFO("preprocessing - putting all sequences into the delta partition {}", partition_id);
 
-   std::string partition_by_select;
-   std::string partition_by_where;
-   if (database_config.schema.partition_by.has_value()) {
-      partition_by_select = "partition_key_to_partition.partition_id AS partition_id";
-      partition_by_where = fmt::format(
-         "WHERE (metadata.\"{0}\" = partition_key_to_partition.partition_key) OR "
-         "(metadata.\"{0}\" IS NULL AND "
-         "partition_key_to_partition.partition_key IS NULL)",
-         database_config.schema.partition_by.value()
+   (void)preprocessing_db.query(fmt::format(
+      "CREATE OR REPLACE TABLE row_partitioning AS\n"
+      "SELECT \"{}\" AS key, {}::bigint AS partition_id, 0::bigint AS chunk\n"
+      "FROM metadata_table;",
+      database_config.schema.primary_key,
+      partition_id
+   ));
+}
+
+std::string Preprocessor::getSequenceSizeSelect() const {
+   // The compressed size of the first nucleotide sequence grows with its number of mutations,
+   // which dominate the cost of the sequence stores
+   if (reference_genomes_.raw_nucleotide_sequences.empty()) {
+      return fmt::format(
+         "SELECT \"{}\" AS key, 0 AS bytes FROM metadata_table LIMIT 0",
+         database_config.schema.primary_key
+      );
+   }
+   const std::string& sequence_name = reference_genomes_.raw_nucleotide_sequences.begin()->first;
+   if (!preprocessing_config.getNdjsonInputFilename().has_value()) {
+      return fmt::format(
+         "SELECT key, octet_length(sequence) AS bytes FROM raw_nuc_{}", sequence_name
       );
-   } else {
-      partition_by_select = "0 AS partition_id";
-      partition_by_where = "";
    }
+   if (mutation_list_input) {
+      return fmt::format(
+         "SELECT \"{}\" AS key, len(nuc_{}_mutations) * {} AS bytes FROM ndjson_table",
+         database_config.schema.primary_key,
+         sequence_name,
+         MUTATION_COST
+      );
+   }
+   return fmt::format(
+      "SELECT \"{}\" AS key, octet_length(nuc_{}) AS bytes FROM ndjson_table",
+      database_config.schema.primary_key,
+      sequence_name
+   );
+}
 
-   createUnalignedPartitionedSequenceFiles(file_name, partition_by_select, partition_by_where);
+void Preprocessor::createPartitionedSequenceTablesFromNdjson() {
+   // The partition, chunk and rank of every row are joined to the input only once. The sequence
+   // stores then filter this table by partition, and as it is sorted by the partition, the
+   // filter skips the row groups of all other partitions
+   (void)preprocessing_db.query(fmt::format(
+      "CREATE OR REPLACE TABLE partitioned_ndjson_table AS\n"
+      "SELECT ndjson_table.*, row_partitioning.partition_id AS partition_id, "
+      "row_partitioning.chunk AS silo_chunk, row_order.rank AS silo_row_rank\n"
+      "FROM ndjson_table JOIN row_partitioning ON ndjson_table.\"{0}\" = row_partitioning.key "
+      "LEFT JOIN row_order ON ndjson_table.\"{0}\" = row_order.key\n"
+      "ORDER BY row_partitioning.partition_id;",
+      database_config.schema.primary_key
+   ));
+   (void)preprocessing_db.query("DROP TABLE ndjson_table;");
 
-   createAlignedPartitionedSequenceViews(
-      file_name, sequence_info, partition_by_select, partition_by_where
-   );
+   createUnalignedPartitionedSequenceFiles();
+
+   createAlignedPartitionedSequenceViews();
 }
 
-void Preprocessor::createAlignedPartitionedSequenceViews(
-   const std::filesystem::path& file_name,
-   const SequenceInfo& sequence_info,
-   const std::string& partition_by_select,
-   const std::string& partition_by_where
-) {
-   std::string order_by_select = ", metadata.\"" + database_config.schema.primary_key + "\" AS \"" +
-                                 database_config.schema.primary_key + "\"";
-   std::string order_by_fields = ", \"" + database_config.schema.primary_key + "\"";
+void Preprocessor::createAlignedPartitionedSequenceViews() {
+   std::string order_by_select = ", \"" + database_config.schema.primary_key + "\"";
    if (database_config.schema.date_to_sort_by.has_value()) {
-      order_by_select += ", metadata.\"" + database_config.schema.date_to_sort_by.value() +
-                         "\" AS \"" + database_config.schema.date_to_sort_by.value() + "\"";
-      order_by_fields += ", \"" + database_config.schema.date_to_sort_by.value() + "\"";
+      order_by_select += ", \"" + database_config.schema.date_to_sort_by.value() + "\"";
    }
+   order_by_select += ", silo_chunk, silo_row_rank";
 
-   (void)preprocessing_db.query(fmt::format(
-      "CREATE OR REPLACE TABLE sequence_table AS\n"
-      "SELECT metadata.{} AS key, {},"
-      "{}"
-      "{} \n"
-      "FROM '{}', partition_key_to_partition "
-      "{};",
-      database_config.schema.primary_key,
-      boost::join(sequence_info.getAlignedSequenceSelects(preprocessing_db), ","),
-      partition_by_select,
-      order_by_select,
-      file_name.string(),
-      partition_by_where
-   ));
+   // The readers expect the columns (key, sequence) or (key, mutations, missing)
+   const std::string sequence_columns = mutation_list_input
+                                           ? "{0}_mutations AS mutations, {0}_missing AS missing"
+                                           : "{0} AS sequence";
 
-   for (const auto& [seq_name, _] : reference_genomes_.raw_nucleotide_sequences) {
+   const auto create_view = [&](const std::string& view_name) {
       (void)preprocessing_db.query(fmt::format(
-         "CREATE OR REPLACE VIEW nuc_{0} AS\n"
-         "SELECT key, nuc_{0} AS sequence, partition_id"
-         "{1}"
-         "FROM sequence_table;",
-         seq_name,
-         order_by_fields
+         "CREATE OR REPLACE VIEW {0} AS\n"
+         "SELECT \"{1}\" AS key, {2}, partition_id"
+         "{3} \n"
+         "FROM partitioned_ndjson_table;",
+         view_name,
+         database_config.schema.primary_key,
+         fmt::format(fmt::runtime(sequence_columns), view_name),
+         order_by_select
       ));
+   };
+   for (const auto& [seq_name, _] : reference_genomes_.raw_nucleotide_sequences) {
+      create_view("nuc_" + seq_name);
    }
-
    for (const auto& [seq_name, _] : reference_genomes_.raw_aa_sequences) {
-      (void)preprocessing_db.query(fmt::format(
-         "CREATE OR REPLACE VIEW gene_{0} AS\n"
-         "SELECT key, gene_{0} AS sequence, partition_id"
-         "{1}"
-         "FROM sequence_table;",
-         seq_name,
-         order_by_fields
-      ));
+      create_view("gene_" + seq_name);
    }
 }
 
-void Preprocessor::createUnalignedPartitionedSequenceFiles(
-   const std::filesystem::path& file_name,
-   const std::string& partition_by_select,
-   const std::string& partition_by_where
-) {
+void Preprocessor::createUnalignedPartitionedSequenceFiles() {
    for (const auto& [seq_name, _] : reference_genomes_.raw_nucleotide_sequences) {
       const std::string table_sql = fmt::format(
-         "SELECT metadata.\"{}\" AS key, {},"
-         "{} \n"
-         "FROM '{}', partition_key_to_partition "
-         "{}",
+         "SELECT \"{}\" AS key, unaligned_nuc_{}, partition_id \n"
+         "FROM partitioned_ndjson_table",
          database_config.schema.primary_key,
-         SequenceInfo::getUnalignedSequenceSelect(seq_name, preprocessing_db),
-         partition_by_select,
-         file_name.string(),
-         partition_by_where
+         seq_name
       );
       createUnalignedPartitionedSequenceFile(seq_name, table_sql);
    }
@@ -359,6 +518,11 @@ void Preprocessor::createUnalignedPartitionedSequenceFile(
 ) {
    const std::filesystem::path save_location =
       preprocessing_config.getIntermediateResultsDirectory() / ("unaligned_nuc_" + seq_name);
+   // A previous delta may have left hard links to the files of a served data version there, which
+   // DuckDB would overwrite in place. A delta only writes the new folder of its own partition
+   if (!delta_partition_id.has_value()) {
+      std::filesystem::remove_all(save_location);
+   }
    preprocessing_db.query(fmt::format(
       "COPY ({}) TO '{}' (FORMAT PARQUET, PARTITION_BY ({}), OVERWRITE_OR_IGNORE);",
       table_sql,
@@ -368,16 +532,30 @@ void Preprocessor::createUnalignedPartitionedSequenceFile(
    preprocessing_db.query("VACUUM;");
 }
 
-void Preprocessor::createPartitionedSequenceTablesFromSequenceFiles() {
+void Preprocessor::buildSequenceTablesFromSequenceFiles() {
    for (const auto& [sequence_name, reference_sequence] :
         reference_genomes_.raw_nucleotide_sequences) {
-      createPartitionedTableForSequence(
-         sequence_name,
+      preprocessing_db.generateSequenceTableFromFasta(
+         "raw_nuc_" + sequence_name,
          reference_sequence,
          preprocessing_config.getNucFilenameNoExtension(sequence_name)
-            .replace_extension(silo::preprocessing::FASTA_EXTENSION),
-         "nuc_"
+            .replace_extension(silo::preprocessing::FASTA_EXTENSION)
+      );
+   }
+   for (const auto& [sequence_name, reference_sequence] : reference_genomes_.raw_aa_sequences) {
+      preprocessing_db.generateSequenceTableFromFasta(
+         "raw_gene_" + sequence_name,
+         reference_sequence,
+         preprocessing_config.getGeneFilenameNoExtension(sequence_name)
+            .replace_extension(silo::preprocessing::FASTA_EXTENSION)
       );
+   }
+}
+
+void Preprocessor::createPartitionedSequenceTablesFromSequenceFiles() {
+   for (const auto& [sequence_name, reference_sequence] :
+        reference_genomes_.raw_nucleotide_sequences) {
+      createPartitionedTableForSequence(sequence_name, "nuc_");
 
       preprocessing_db.generateSequenceTableFromFasta(
          "unaligned_tmp",
@@ -399,21 +577,13 @@ void Preprocessor::createPartitionedSequenceTablesFromSequenceFiles() {
       preprocessing_db.query("DROP TABLE IF EXISTS unaligned_tmp;");
    }
 
-   for (const auto& [sequence_name, reference_sequence] : reference_genomes_.raw_aa_sequences) {
-      createPartitionedTableForSequence(
-         sequence_name,
-         reference_sequence,
-         preprocessing_config.getGeneFilenameNoExtension(sequence_name)
-            .replace_extension(silo::preprocessing::FASTA_EXTENSION),
-         "gene_"
-      );
+   for (const auto& [sequence_name, _] : reference_genomes_.raw_aa_sequences) {
+      createPartitionedTableForSequence(sequence_name, "gene_");
    }
 }
 
 void Preprocessor::createPartitionedTableForSequence(
    const std::string& sequence_name,
-   const std::string& reference_sequence,
-   const std::filesystem::path& filename,
    const std::string& table_prefix
 ) {
    std::string order_by_select = ", raw.key AS " + database_config.schema.primary_key;
@@ -422,12 +592,13 @@ void Preprocessor::createPartitionedTableForSequence(
                          database_config.schema.date_to_sort_by.value() + " AS " +
                          database_config.schema.date_to_sort_by.value();
    }
+   order_by_select +=
+      ", partitioned_metadata.silo_chunk AS silo_chunk"
+      ", partitioned_metadata.silo_row_rank AS silo_row_rank";
 
    const std::string raw_table_name = "raw_" + table_prefix + sequence_name;
    const std::string table_name = table_prefix + sequence_name;
 
-   preprocessing_db.generateSequenceTableFromFasta(raw_table_name, reference_sequence, filename);
-
    (void)preprocessing_db.query(fmt::format(
       R"-(
          CREATE OR REPLACE VIEW {} AS
@@ -444,6 +615,141 @@ void Preprocessor::createPartitionedTableForSequence(
    ));
 }
 
+void Preprocessor::createRowOrderTable() {
+   // Holds the rank of every row when the row order is optimized and stays empty otherwise
+   (void)preprocessing_db.query(fmt::format(
+      "CREATE OR REPLACE TABLE row_order AS\n"
+      "SELECT \"{}\" AS key, 0::BIGINT AS rank FROM metadata_table LIMIT 0;",
+      database_config.schema.primary_key
+   ));
+}
+
+void Preprocessor::optimizeRowOrder() {
+   // Rows keep their date order, so that the date runs stay intact. Within a run, genomes of the
+   // same lineage and then genomes with similar mutations end up next to each other, which turns
+   // many array containers of the position bitmaps into run containers
+   std::vector<std::string> order_by_fields;
+   if (database_config.schema.date_to_sort_by.has_value()) {
+      order_by_fields.push_back(
+         fmt::format("metadata_table.\"{}\"", database_config.schema.date_to_sort_by.value())
+      );
+   }
+   for (const auto& metadata : database_config.schema.metadata) {
+      if (metadata.getColumnType() == config::ColumnType::INDEXED_PANGOLINEAGE) {
+         order_by_fields.push_back(fmt::format("metadata_table.\"{}\"", metadata.name));
+         break;
+      }
+   }
+
+   // Every row needs a rank, because getOrderByClause orders by the rank alone
+   std::optional<std::string> sequence_name;
+   std::string signature_join;
+   if (reference_genomes_.raw_nucleotide_sequences.empty()) {
+      SPDLOG_INFO(
+         "preprocessing - no nucleotide sequences, optimizing the row order by date and lineage"
+      );
+   } else {
+      sequence_name = reference_genomes_.raw_nucleotide_sequences.begin()->first;
+      SPDLOG_INFO(
+         "preprocessing - optimizing the row order by the mutations of nucleotide sequence '{}'",
+         *sequence_name
+      );
+
+      const std::string signature_select =
+         mutation_list_input
+            ? MutationSignature::generateSqlStatementForMutationList("mutations")
+            : preprocessing_db.nucleotide_mutation_signature_function->generateSqlStatement(
+                 "sequence", *sequence_name
+              );
+      (void)preprocessing_db.query(fmt::format(
+         "CREATE OR REPLACE TEMP TABLE row_signature AS\n"
+         "SELECT key, {} AS signature FROM nuc_{} WHERE key IS NOT NULL;",
+         signature_select,
+         *sequence_name
+      ));
+      order_by_fields.emplace_back("row_signature.signature");
+      signature_join = fmt::format(
+         " LEFT JOIN row_signature ON metadata_table.\"{}\" = row_signature.key",
+         database_config.schema.primary_key
+      );
+   }
+   order_by_fields.push_back(
+      fmt::format("metadata_table.\"{}\"", database_config.schema.primary_key)
+   );
+
+   (void)preprocessing_db.query("DELETE FROM row_order;");
+   (void)preprocessing_db.query(fmt::format(
+      "INSERT INTO row_order\n"
+      "SELECT metadata_table.\"{}\", row_number() OVER (ORDER BY {})\n"
+      "FROM metadata_table{};",
+      database_config.schema.primary_key,
+      boost::join(order_by_fields, ", "),
+      signature_join
+   ));
+   if (preprocessing_config.getNdjsonInputFilename().has_value()) {
+      // The ndjson pipeline materialized the ranks with the partitions, before they were computed
+      (void)preprocessing_db.query(fmt::format(
+         "UPDATE partitioned_ndjson_table SET silo_row_rank = row_order.rank\n"
+         "FROM row_order WHERE partitioned_ndjson_table.\"{}\" = row_order.key;",
+         database_config.schema.primary_key
+      ));
+   }
+
+   if (sequence_name.has_value()) {
+      (void)preprocessing_db.query("DROP TABLE row_signature;");
+      logRowOrderEffect(*sequence_name);
+   }
+}
+
+void Preprocessor::logRowOrderEffect(const std::string& sequence_name) {
+   const uint32_t partition_id = delta_partition_id.value_or(0);
+   const auto measure = [&](const std::string& order_by_clause) {
+      SequenceStore<Nucleotide> store(reference_genomes_.nucleotide_sequences.at(sequence_name));
+      fillSequenceStorePartition(
+         preprocessing_db.getConnection(),
+         store.createPartition(),
+         "nuc_" + sequence_name,
+         reference_genomes_.raw_nucleotide_sequences.at(sequence_name),
+         partition_id,
+         order_by_clause
+      );
+      return Database::calculateBitmapContainerSizePerGenomeSection(
+         store, ROW_ORDER_STATISTICS_SECTION_LENGTH
+      );
+   };
+   const auto before = measure(getOrderByClause(false));
+   const auto after = measure(getOrderByClause(true));
+
+   SPDLOG_INFO(
+      "preprocessing - row order of partition {} of '{}': bitmap size {} -> {} bytes, "
+      "run containers {} -> {}, array containers {} -> {}, bitset containers {} -> {}",
+      partition_id,
+      sequence_name,
+      before.total_bitmap_size_computed,
+      after.total_bitmap_size_computed,
+      before.bitmap_container_size_statistic.number_of_run_containers,
+      after.bitmap_container_size_statistic.number_of_run_containers,
+      before.bitmap_container_size_statistic.number_of_array_containers,
+      after.bitmap_container_size_statistic.number_of_array_containers,
+      before.bitmap_container_size_statistic.number_of_bitset_containers,
+      after.bitmap_container_size_statistic.number_of_bitset_containers
+   );
+}
+
+std::string Preprocessor::getOrderByClause(bool optimize_row_order) const {
+   // The chunks of a partition are stored one after the other, each sorted by date
+   std::vector<std::string> order_by_fields{"silo_chunk"};
+   if (optimize_row_order) {
+      order_by_fields.emplace_back("silo_row_rank");
+   } else {
+      const auto strict_order_by_fields = database_config.schema.getStrictOrderByFields();
+      order_by_fields.insert(
+         order_by_fields.end(), strict_order_by_fields.begin(), strict_order_by_fields.end()
+      );
+   }
+   return "ORDER BY " + boost::join(order_by_fields, ", ");
+}
+
 Database Preprocessor::buildDatabase(
    const preprocessing::Partitions& partition_descriptor,
    const std::string& order_by_clause,
@@ -464,6 +770,7 @@ Database Preprocessor::buildDatabase(
       for (const auto& partition : partition_descriptor.getPartitions()) {
          database.partitions.emplace_back(partition.getPartitionChunks());
       }
+      database.placePartitionsOnNumaNodes();
       database.initializeColumns();
       database.initializeNucSequences(reference_genomes_.nucleotide_sequences);
       database.initializeAASequences(reference_genomes_.aa_sequences);
@@ -479,13 +786,11 @@ Database Preprocessor::buildDatabase(
       });
 
       tasks.run([&]() {
-         SPDLOG_INFO("build - building nucleotide sequence stores");
-         buildNucleotideSequenceStore(database, partition_descriptor, order_by_clause);
-         SPDLOG_INFO("build - finished nucleotide sequence stores");
-
-         SPDLOG_INFO("build - building amino acid sequence stores");
-         buildAminoAcidSequenceStore(database, partition_descriptor, order_by_clause);
-         SPDLOG_INFO("build - finished amino acid sequence stores");
+         SPDLOG_INFO("build - building sequence stores");
+         std::vector<uint32_t> partition_ids(partition_descriptor.getPartitions().size());
+         std::iota(partition_ids.begin(), partition_ids.end(), 0);
+         buildSequenceStores(database, partition_ids, order_by_clause);
+         SPDLOG_INFO("build - finished sequence stores");
       });
 
       tasks.wait();
@@ -496,114 +801,178 @@ Database Preprocessor::buildDatabase(
 
    SPDLOG_INFO("Build took {} ms", micros);
    SPDLOG_INFO("database info: {}", database.getDatabaseInfo());
+   if (PerfCounters::isEnabled()) {
+      for (const auto& [stage, values] : PerfCounters::getStages()) {
+         LOG_PERFORMANCE("Performance counters of build stage {}: {}", stage, values);
+      }
+   }
 
    database.validate();
 
    return database;
 }
 
+void Preprocessor::buildDeltaPartition(
+   Database& database,
+   uint32_t partition_id,
+   const std::string& order_by_clause
+) {
+   auto& partition = database.partitions.at(partition_id);
+
+   tbb::task_group tasks;
+
+   tasks.run([&]() {
+      SPDLOG_INFO("build - building metadata store of delta partition {}", partition_id);
+      partition.sequence_count += partition.columns.fill(
+         preprocessing_db.getConnection(), partition_id, order_by_clause, database_config
+      );
+   });
+
+   tasks.run([&]() {
+      SPDLOG_INFO("build - building sequence stores of delta partition {}", partition_id);
+      buildSequenceStores(database, {partition_id}, order_by_clause);
+   });
+
+   tasks.wait();
+}
+
 void Preprocessor::buildMetadataStore(
    Database& database,
    const preprocessing::Partitions& partition_descriptor,
    const std::string& order_by_clause
 ) {
-   for (size_t partition_id = 0; partition_id < partition_descriptor.getPartitions().size();
-        ++partition_id) {
-      const auto& part = partition_descriptor.getPartitions()[partition_id];
-      for (size_t chunk_index = 0; chunk_index < part.getPartitionChunks().size(); ++chunk_index) {
-         const uint32_t sequences_added =
-            database.partitions.at(partition_id)
-               .columns.fill(
-                  preprocessing_db.getConnection(), partition_id, order_by_clause, database_config
-               );
-         database.partitions.at(partition_id).sequence_count += sequences_added;
-      }
+   // The partitions are filled concurrently, so the ids are assigned up front to stay
+   // reproducible between builds of the same input
+   database.columns.prefillDictionaries(preprocessing_db.getConnection(), database_config);
+
+   tbb::enumerable_thread_specific<duckdb::Connection> connections([&]() {
+      return preprocessing_db.createConnection();
+   });
+   std::vector<uint32_t> numa_nodes = database.getPartitionNumaNodes();
+   numa_nodes.resize(partition_descriptor.getPartitions().size());
+   NumaNodes::get().parallelFor(numa_nodes, [&](size_t partition_id) {
+      auto& partition = database.partitions.at(partition_id);
+      partition.sequence_count += partition.columns.fill(
+         connections.local(), static_cast<uint32_t>(partition_id), order_by_clause, database_config
+      );
       SPDLOG_INFO("build - finished columns for partition {}", partition_id);
-   }
+   });
 }
 
-void Preprocessor::buildNucleotideSequenceStore(
+void Preprocessor::buildSequenceStores(
    Database& database,
-   const preprocessing::Partitions& partition_descriptor,
+   const std::vector<uint32_t>& partition_ids,
    const std::string& order_by_clause
 ) {
-   for (const auto& pair : reference_genomes_.raw_nucleotide_sequences) {
-      const std::string& nuc_name = pair.first;
-      const std::string& reference_sequence = pair.second;
-      tbb::parallel_for(
-         tbb::blocked_range<size_t>(0, partition_descriptor.getPartitions().size()),
-         [&](const auto& local) {
-            for (auto partition_index = local.begin(); partition_index != local.end();
-                 ++partition_index) {
-               const auto& part = partition_descriptor.getPartitions()[partition_index];
-               for (size_t chunk_index = 0; chunk_index < part.getPartitionChunks().size();
-                    ++chunk_index) {
-                  SPDLOG_DEBUG(
-                     "build - building aligned sequence store for nucleotide "
-                     "sequence {} and partition {}",
-                     nuc_name,
-                     partition_index
-                  );
-
-                  silo::ZstdFastaTableReader sequence_input(
-                     preprocessing_db.getConnection(),
-                     "nuc_" + nuc_name,
-                     reference_sequence,
-                     "sequence",
-                     fmt::format("partition_id = {}", partition_index),
-                     order_by_clause
-                  );
-                  database.partitions.at(partition_index)
-                     .nuc_sequences.at(nuc_name)
-                     .fill(sequence_input);
-               }
-            }
-         }
-      );
-      SPDLOG_INFO("build - finished nucleotide sequence {}", nuc_name);
+   struct SequenceStoreTask {
+      std::string name;
+      uint32_t partition_id;
+      std::function<void(duckdb::Connection&)> fill;
+   };
+
+   std::vector<SequenceStoreTask> tasks;
+   for (const uint32_t partition_id : partition_ids) {
+      auto& partition = database.partitions.at(partition_id);
+      for (const auto& [nuc_name, reference_sequence] :
+           reference_genomes_.raw_nucleotide_sequences) {
+         tasks.push_back(
+            {"nucleotide sequence " + nuc_name,
+             partition_id,
+             [this,
+              &sequence_store_partition = partition.nuc_sequences.at(nuc_name),
+              table_name = "nuc_" + nuc_name,
+              &reference_sequence = reference_sequence,
+              partition_id,
+              &order_by_clause](duckdb::Connection& connection) {
+                fillSequenceStorePartition(
+                   connection,
+                   sequence_store_partition,
+                   table_name,
+                   reference_sequence,
+                   partition_id,
+                   order_by_clause
+                );
+             }}
+         );
+      }
+      for (const auto& [aa_name, reference_sequence] : reference_genomes_.raw_aa_sequences) {
+         tasks.push_back(
+            {"amino acid sequence " + aa_name,
+             partition_id,
+             [this,
+              &sequence_store_partition = partition.aa_sequences.at(aa_name),
+              table_name = "gene_" + aa_name,
+              &reference_sequence = reference_sequence,
+              partition_id,
+              &order_by_clause](duckdb::Connection& connection) {
+                fillSequenceStorePartition(
+                   connection,
+                   sequence_store_partition,
+                   table_name,
+                   reference_sequence,
+                   partition_id,
+                   order_by_clause
+                );
+             }}
+         );
+      }
+   }
+
+   tbb::enumerable_thread_specific<duckdb::Connection> connections([&]() {
+      return preprocessing_db.createConnection();
+   });
+   // Every store is filled by the threads of the NUMA node of its partition, so that its bitmaps
+   // are allocated in the memory of that node
+   std::vector<uint32_t> numa_node_of_task;
+   numa_node_of_task.reserve(tasks.size());
+   for (const auto& task : tasks) {
+      numa_node_of_task.push_back(database.partitions.at(task.partition_id).numa_node);
    }
+   NumaNodes::get().parallelFor(numa_node_of_task, [&](size_t task_index) {
+      const auto& task = tasks[task_index];
+      int64_t millis = 0;
+      {
+         const BlockTimer<std::chrono::milliseconds> timer(millis);
+         task.fill(connections.local());
+      }
+      SPDLOG_INFO(
+         "build - finished {} of partition {} in {} ms", task.name, task.partition_id, millis
+      );
+   });
 }
 
-void Preprocessor::buildAminoAcidSequenceStore(
-   silo::Database& database,
-   const preprocessing::Partitions& partition_descriptor,
+template <typename SymbolType>
+void Preprocessor::fillSequenceStorePartition(
+   duckdb::Connection& connection,
+   SequenceStorePartition<SymbolType>& sequence_store_partition,
+   const std::string& table_name,
+   const std::string& reference_sequence,
+   uint32_t partition_id,
    const std::string& order_by_clause
 ) {
-   for (const auto& pair : reference_genomes_.raw_aa_sequences) {
-      const std::string& aa_name = pair.first;
-      const std::string& reference_sequence = pair.second;
-      tbb::parallel_for(
-         tbb::blocked_range<size_t>(0, partition_descriptor.getPartitions().size()),
-         [&](const auto& local) {
-            for (auto partition_index = local.begin(); partition_index != local.end();
-                 ++partition_index) {
-               const auto& part = partition_descriptor.getPartitions()[partition_index];
-               for (size_t chunk_index = 0; chunk_index < part.getPartitionChunks().size();
-                    ++chunk_index) {
-                  SPDLOG_DEBUG(
-                     "build - building sequence store for amino acid "
-                     "sequence {} and partition {}",
-                     aa_name,
-                     partition_index
-                  );
-
-                  silo::ZstdFastaTableReader sequence_input(
-                     preprocessing_db.getConnection(),
-                     "gene_" + aa_name,
-                     reference_sequence,
-                     "sequence",
-                     fmt::format("partition_id = {}", partition_index),
-                     order_by_clause
-                  );
-                  database.partitions.at(partition_index)
-                     .aa_sequences.at(aa_name)
-                     .fill(sequence_input);
-               }
-            }
-         }
+   const SequenceIngestionOptions options{
+      preprocessing_config.getSequenceBufferSize(), preprocessing_config.getSequenceTileSize()
+   };
+   if (mutation_list_input) {
+      MutationListTableReader<SymbolType> sequence_input(
+         connection,
+         table_name,
+         reference_sequence,
+         fmt::format("partition_id = {}", partition_id),
+         order_by_clause
       );
-      SPDLOG_INFO("build - finished amino acid sequence {}", aa_name);
+      sequence_store_partition.fill(sequence_input, options);
+      return;
    }
+   silo::ZstdFastaTableReader sequence_input(
+      connection,
+      table_name,
+      reference_sequence,
+      "sequence",
+      fmt::format("partition_id = {}", partition_id),
+      order_by_clause
+   );
+   sequence_store_partition.fill(sequence_input, options);
 }
 
 }  // namespace silo::preprocessing
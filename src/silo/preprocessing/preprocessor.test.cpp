@@ -55,6 +55,13 @@ const Scenario NDJSON_FILE_WITH_MISSING_SEGMENTS_AND_GENES = {
    FASTA_FILES_WITH_MISSING_SEGMENTS_AND_GENES.expected_query_result
 };
 
+const Scenario NDJSON_FILE_WITH_MUTATION_LISTS = {
+   "testBaseData/ndjsonWithMutationLists/",
+   FASTA_FILES_WITH_MISSING_SEGMENTS_AND_GENES.expected_sequence_count,
+   FASTA_FILES_WITH_MISSING_SEGMENTS_AND_GENES.query,
+   FASTA_FILES_WITH_MISSING_SEGMENTS_AND_GENES.expected_query_result
+};
+
 const Scenario NDJSON_WITH_SQL_KEYWORD_AS_FIELD = {
    "testBaseData/ndjsonWithSqlKeywordField/",
    2,
@@ -83,6 +90,32 @@ const Scenario TSV_FILE_WITH_SQL_KEYWORD_AS_FIELD = {
    NDJSON_WITH_SQL_KEYWORD_AS_FIELD.expected_query_result
 };
 
+/// Without nucleotide sequences, the optimized row order has no mutations to go by. The rows
+/// still have to be sorted by date for the date filter to find them
+const Scenario TSV_FILE_WITHOUT_NUCLEOTIDE_SEQUENCES = {
+   "testBaseData/tsvWithoutNucleotideSequences/",
+   5,
+   R"(
+      {
+         "action": {
+            "type": "Details",
+            "fields": ["primaryKey"],
+            "orderByFields": ["primaryKey"]
+         },
+         "filterExpression": {
+            "type": "DateBetween",
+            "column": "date",
+            "from": "2021-01-10",
+            "to": "2021-02-15"
+         }
+      }
+   )",
+   {
+      {{"primaryKey", "1.3"}},
+      {{"primaryKey", "1.4"}},
+   }
+};
+
 class PreprocessorTestFixture : public ::testing::TestWithParam<Scenario> {};
 
 INSTANTIATE_TEST_SUITE_P(
@@ -91,18 +124,21 @@ INSTANTIATE_TEST_SUITE_P(
    ::testing::Values(
       FASTA_FILES_WITH_MISSING_SEGMENTS_AND_GENES,
       NDJSON_FILE_WITH_MISSING_SEGMENTS_AND_GENES,
+      NDJSON_FILE_WITH_MUTATION_LISTS,
       NDJSON_WITH_SQL_KEYWORD_AS_FIELD,
-      TSV_FILE_WITH_SQL_KEYWORD_AS_FIELD
+      TSV_FILE_WITH_SQL_KEYWORD_AS_FIELD,
+      TSV_FILE_WITHOUT_NUCLEOTIDE_SEQUENCES
    ),
    printTestName
 );
 
-TEST_P(PreprocessorTestFixture, shouldProcessDataSetWithMissingSequences) {
-   const auto scenario = GetParam();
-
-   auto config = silo::preprocessing::PreprocessingConfigReader()
-                    .readConfig(scenario.input_directory + "preprocessing_config.yaml")
-                    .mergeValuesFromOrDefault(silo::preprocessing::OptionalPreprocessingConfig());
+void assertProcessesScenario(const Scenario& scenario, bool optimize_row_order) {
+   auto optional_config = silo::preprocessing::PreprocessingConfigReader().readConfig(
+      scenario.input_directory + "preprocessing_config.yaml"
+   );
+   optional_config.optimize_row_order = optimize_row_order;
+   const auto config =
+      optional_config.mergeValuesFromOrDefault(silo::preprocessing::OptionalPreprocessingConfig());
 
    const auto database_config = silo::config::ConfigRepository().getValidatedConfig(
       scenario.input_directory + "database_config.yaml"
@@ -126,4 +162,12 @@ TEST_P(PreprocessorTestFixture, shouldProcessDataSetWithMissingSequences) {
    ASSERT_EQ(actual, scenario.expected_query_result);
 }
 
+TEST_P(PreprocessorTestFixture, shouldProcessDataSetWithMissingSequences) {
+   assertProcessesScenario(GetParam(), false);
+}
+
+TEST_P(PreprocessorTestFixture, shouldProcessDataSetWithOptimizedRowOrder) {
+   assertProcessesScenario(GetParam(), true);
+}
+
 }  // namespace
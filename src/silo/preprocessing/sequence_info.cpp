@@ -32,6 +32,53 @@ std::vector<std::string> SequenceInfo::getAlignedSequenceSelects(
    return sequence_selects;
 }
 
+std::vector<std::string> SequenceInfo::getMutationListSelects() const {
+   std::vector<std::string> sequence_selects;
+   sequence_selects.reserve(2 * (nuc_sequence_names.size() + aa_sequence_names.size()));
+   // The lists are extracted as JSON, because DuckDB cannot infer a struct type for sequences
+   // that are NULL in every row
+   for (const std::string& name : nuc_sequence_names) {
+      sequence_selects.emplace_back(fmt::format(
+         "json_extract(to_json(nucleotideMutations), '$.\"{0}\".mutations')::VARCHAR[] "
+         "AS nuc_{0}_mutations, "
+         "json_extract(to_json(nucleotideMutations), '$.\"{0}\".missing')::BIGINT[][] "
+         "AS nuc_{0}_missing",
+         name
+      ));
+   }
+   for (const std::string& name : aa_sequence_names) {
+      sequence_selects.emplace_back(fmt::format(
+         "json_extract(to_json(aminoAcidMutations), '$.\"{0}\".mutations')::VARCHAR[] "
+         "AS gene_{0}_mutations, "
+         "json_extract(to_json(aminoAcidMutations), '$.\"{0}\".missing')::BIGINT[][] "
+         "AS gene_{0}_missing",
+         name
+      ));
+   }
+   return sequence_selects;
+}
+
+bool SequenceInfo::containsMutationLists(
+   duckdb::Connection& connection,
+   const std::filesystem::path& input_filename
+) {
+   auto result =
+      connection.Query(fmt::format("DESCRIBE SELECT * FROM '{}';", input_filename.string()));
+   if (result->HasError()) {
+      throw silo::preprocessing::PreprocessingException(
+         "Preprocessing exception when describing the input file, duckdb threw with error: " +
+         result->GetError()
+      );
+   }
+   for (size_t row = 0; row < result->RowCount(); ++row) {
+      const auto column_name = result->GetValue(0, row).GetValue<std::string>();
+      if (column_name == "nucleotideMutations" || column_name == "aminoAcidMutations") {
+         return true;
+      }
+   }
+   return false;
+}
+
 std::string SequenceInfo::getNucleotideSequenceSelect(
    const std::string& seq_name,
    const PreprocessingDatabase& preprocessing_db
@@ -80,17 +127,25 @@ void SequenceInfo::validate(
    duckdb::Connection& connection,
    const std::filesystem::path& input_filename
 ) const {
+   const bool mutation_lists = containsMutationLists(connection, input_filename);
+   const std::string nuc_field =
+      mutation_lists ? "nucleotideMutations" : "alignedNucleotideSequences";
+   const std::string aa_field = mutation_lists ? "aminoAcidMutations" : "alignedAminoAcidSequences";
+
    auto result = connection.Query(fmt::format(
-      "SELECT json_keys(alignedNucleotideSequences), json_keys(alignedAminoAcidSequences) "
-      "FROM '{}' LIMIT 1; ",
+      "SELECT json_keys({}), json_keys({}) FROM '{}' LIMIT 1; ",
+      nuc_field,
+      aa_field,
       input_filename.string()
    ));
    if (result->HasError()) {
-      throw silo::preprocessing::PreprocessingException(
-         "Preprocessing exception when retrieving the fields 'alignedNucleotideSequences' "
-         "and 'alignedAminoAcidSequences', duckdb threw with error: " +
+      throw silo::preprocessing::PreprocessingException(fmt::format(
+         "Preprocessing exception when retrieving the fields '{}' and '{}', duckdb threw with "
+         "error: {}",
+         nuc_field,
+         aa_field,
          result->GetError()
-      );
+      ));
    }
    if (result->RowCount() == 0) {
       throw silo::preprocessing::PreprocessingException(fmt::format(
@@ -1,6 +1,12 @@
 #include "silo/preprocessing/sql_function.h"
 
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <vector>
+
 #include <spdlog/spdlog.h>
+#include <boost/algorithm/string/join.hpp>
 
 #include "silo/common/pango_lineage.h"
 #include "silo/storage/reference_genomes.h"
@@ -15,6 +21,32 @@ using duckdb::string_t;
 using duckdb::StringVector;
 using duckdb::Vector;
 
+namespace {
+
+/// Each hash function of the MinHash contributes this many bits to the signature
+constexpr uint32_t SIGNATURE_BITS_PER_HASH = 16;
+constexpr size_t SIGNATURE_HASH_COUNT = 4;
+/// Derives the seeds of the independent hash functions from their index
+constexpr uint64_t SEED_MULTIPLIER = 0x9e3779b97f4a7c15ULL;
+
+/// The finalizer of splitmix64, a cheap hash with good avalanche behaviour
+uint64_t mixBits(uint64_t value) {
+   value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9ULL;
+   value = (value ^ (value >> 27)) * 0x94d049bb133111ebULL;
+   return value ^ (value >> 31);
+}
+
+uint64_t packMinHashes(const std::array<uint64_t, SIGNATURE_HASH_COUNT>& min_hashes) {
+   uint64_t signature = 0;
+   for (const uint64_t min_hash : min_hashes) {
+      signature = (signature << SIGNATURE_BITS_PER_HASH) |
+                  (min_hash >> (std::numeric_limits<uint64_t>::digits - SIGNATURE_BITS_PER_HASH));
+   }
+   return signature;
+}
+
+}  // namespace
+
 silo::CustomSqlFunction::CustomSqlFunction(std::string function_name)
     : function_name(std::move(function_name)) {}
 
@@ -63,3 +95,97 @@ std::string silo::CompressSequence::generateSqlStatement(
 ) const {
    return fmt::format("{0}({1}, '{2}')", function_name, column_name_in_data, sequence_name);
 }
+
+silo::MutationSignature::MutationSignature(
+   const std::string& sequence_name,
+   const std::map<std::string, std::string>& reference
+)
+    : CustomSqlFunction("mutation_signature_" + sequence_name),
+      references(reference.begin(), reference.end()) {
+   for (const auto& [name, sequence] : references) {
+      decompressors.emplace(
+         std::piecewise_construct,
+         std::forward_as_tuple(name),
+         std::forward_as_tuple([&sequence = sequence]() { return ZstdDecompressor(sequence); })
+      );
+   }
+}
+
+void silo::MutationSignature::addToConnection(Connection& connection) const {
+   const std::function<void(DataChunk&, ExpressionState&, Vector&)> signature_wrapper =
+      [&](DataChunk& args, ExpressionState& /*state*/, Vector& result) {
+         BinaryExecutor::Execute<string_t, string_t, uint64_t>(
+            args.data[0],
+            args.data[1],
+            result,
+            args.size(),
+            [&](const string_t compressed, const string_t segment_name) {
+               const std::string name = segment_name.GetString();
+               auto& decompressor = decompressors.at(name).local();
+               return computeSignature(
+                  decompressor.decompress(compressed.GetData(), compressed.GetSize()),
+                  references.find(name)->second
+               );
+            }
+         );
+      };
+
+   connection.CreateVectorizedFunction(
+      function_name,
+      {LogicalType::BLOB, LogicalType::VARCHAR},
+      LogicalType::UBIGINT,
+      signature_wrapper
+   );
+}
+
+std::string silo::MutationSignature::generateSqlStatement(
+   const std::string& column_name_in_data,
+   const std::string& sequence_name
+) const {
+   return fmt::format("{0}({1}, '{2}')", function_name, column_name_in_data, sequence_name);
+}
+
+std::string silo::MutationSignature::generateSqlStatementForMutationList(
+   const std::string& column_name_in_data
+) {
+   // Drops the optional reference symbol and the missing symbols, like computeSignature
+   const std::string normalized_mutations = fmt::format(
+      "list_transform(list_filter({0}, mutation -> NOT ends_with(mutation, 'N')), "
+      "mutation -> regexp_replace(mutation, '^[^0-9]+', ''))",
+      column_name_in_data
+   );
+   std::vector<std::string> min_hashes;
+   for (size_t index = 0; index < SIGNATURE_HASH_COUNT; ++index) {
+      min_hashes.push_back(fmt::format(
+         "(coalesce(list_min(list_transform({0}, mutation -> hash(mutation || '{1}'))), "
+         "{2}::UBIGINT) >> {3} << {4})",
+         normalized_mutations,
+         index,
+         std::numeric_limits<uint64_t>::max(),
+         std::numeric_limits<uint64_t>::digits - SIGNATURE_BITS_PER_HASH,
+         (SIGNATURE_HASH_COUNT - 1 - index) * SIGNATURE_BITS_PER_HASH
+      ));
+   }
+   return fmt::format("({})", boost::algorithm::join(min_hashes, " | "));
+}
+
+uint64_t silo::MutationSignature::computeSignature(
+   std::string_view sequence,
+   std::string_view reference
+) {
+   std::array<uint64_t, SIGNATURE_HASH_COUNT> min_hashes;
+   min_hashes.fill(std::numeric_limits<uint64_t>::max());
+   const size_t length = std::min(sequence.size(), reference.size());
+   for (size_t position = 0; position < length; ++position) {
+      const char symbol = sequence[position];
+      if (symbol == reference[position] || symbol == 'N') {
+         continue;
+      }
+      const uint64_t element = (uint64_t{position} << 8) | static_cast<unsigned char>(symbol);
+      for (size_t index = 0; index < SIGNATURE_HASH_COUNT; ++index) {
+         const uint64_t hash = mixBits(element ^ (index * SEED_MULTIPLIER));
+         min_hashes[index] = std::min(min_hashes[index], hash);
+      }
+   }
+   return packMinHashes(min_hashes);
+}
@@ -0,0 +1,64 @@
+#include "silo/preprocessing/sql_function.h"
+
+#include <cstdint>
+#include <limits>
+#include <string>
+
+#include <fmt/format.h>
+#include <gtest/gtest.h>
+#include <duckdb.hpp>
+
+using silo::MutationSignature;
+
+TEST(MutationSignature, referenceAndMissingSymbolsHaveNoMutations) {
+   const uint64_t no_mutations = std::numeric_limits<uint64_t>::max();
+   EXPECT_EQ(MutationSignature::computeSignature("ACGTACGT", "ACGTACGT"), no_mutations);
+   EXPECT_EQ(MutationSignature::computeSignature("NNGTACNN", "ACGTACGT"), no_mutations);
+}
+
+TEST(MutationSignature, ignoresMissingSymbolsNextToMutations) {
+   EXPECT_EQ(
+      MutationSignature::computeSignature("ACGAACGT", "ACGTACGT"),
+      MutationSignature::computeSignature("NNGAACNN", "ACGTACGT")
+   );
+}
+
+TEST(MutationSignature, distinguishesDifferentMutations) {
+   EXPECT_NE(
+      MutationSignature::computeSignature("ACGAACGT", "ACGTACGT"),
+      MutationSignature::computeSignature("ACGCACGT", "ACGTACGT")
+   );
+   EXPECT_NE(
+      MutationSignature::computeSignature("ACGAACGT", "ACGTACGT"),
+      MutationSignature::computeSignature("ACGTACGA", "ACGTACGT")
+   );
+}
+
+namespace {
+uint64_t signatureOfMutationList(duckdb::Connection& connection, const std::string& mutations) {
+   const auto result = connection.Query(fmt::format(
+      "SELECT {} FROM (SELECT {}::VARCHAR[] AS mutations);",
+      MutationSignature::generateSqlStatementForMutationList("mutations"),
+      mutations
+   ));
+   return result->GetValue(0, 0).GetValue<uint64_t>();
+}
+}  // namespace
+
+TEST(MutationSignature, mutationListsIgnoreReferenceAndMissingSymbols) {
+   duckdb::DuckDB duckdb;
+   duckdb::Connection connection(duckdb);
+
+   EXPECT_EQ(
+      signatureOfMutationList(connection, "['C241T', 'A23403G']"),
+      signatureOfMutationList(connection, "['241T', '23403G']")
+   );
+   EXPECT_EQ(
+      signatureOfMutationList(connection, "['C241T']"),
+      signatureOfMutationList(connection, "['C241T', 'A100N']")
+   );
+   EXPECT_NE(
+      signatureOfMutationList(connection, "['C241T']"),
+      signatureOfMutationList(connection, "['C241A']")
+   );
+}
@@ -16,6 +16,7 @@
 #include "silo/query_engine/actions/mutations.h"
 #include "silo/query_engine/operator_result.h"
 #include "silo/query_engine/query_parse_exception.h"
+#include "silo/query_engine/query_profile.h"
 #include "silo/query_engine/query_result.h"
 
 namespace silo {
@@ -91,6 +92,14 @@ void Action::applyOffsetAndLimit(QueryResult& result) const {
    }
 }
 
+void Action::setType(const std::string& type_) {
+   type = type_;
+}
+
+const std::string& Action::getType() const {
+   return type;
+}
+
 void Action::setOrdering(
    const std::vector<OrderByField>& order_by_fields_,
    std::optional<uint32_t> limit_,
@@ -107,11 +116,18 @@ QueryResult Action::executeAndOrder(
 ) const {
    validateOrderByFields(database);
 
-   QueryResult result = execute(database, std::move(bitmap_filter));
+   QueryResult result;
+   {
+      const ActionPhaseTimer timer("execute");
+      result = execute(database, std::move(bitmap_filter));
+   }
    if (offset.has_value() && offset.value() >= result.query_result.size()) {
       return {};
    }
-   applySort(result);
+   {
+      const ActionPhaseTimer timer("sort");
+      applySort(result);
+   }
    applyOffsetAndLimit(result);
    return result;
 }
@@ -183,6 +199,7 @@ void from_json(const nlohmann::json& json, std::unique_ptr<Action>& action) {
                                        : std::nullopt;
    auto offset = json.contains("offset") ? std::optional<uint32_t>(json["offset"].get<uint32_t>())
                                          : std::nullopt;
+   action->setType(expression_type);
    action->setOrdering(order_by_fields, limit, offset);
 }
 
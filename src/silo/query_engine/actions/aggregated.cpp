@@ -7,15 +7,16 @@
 #include <variant>
 #include <vector>
 
-#include <oneapi/tbb/blocked_range.h>
-#include <oneapi/tbb/parallel_for.h>
 #include <nlohmann/json.hpp>
 
+#include "silo/common/numa.h"
+#include "silo/common/perf_counters.h"
 #include "silo/config/database_config.h"
 #include "silo/database.h"
 #include "silo/query_engine/actions/action.h"
 #include "silo/query_engine/actions/tuple.h"
 #include "silo/query_engine/operator_result.h"
+#include "silo/query_engine/query_context.h"
 #include "silo/query_engine/query_parse_exception.h"
 #include "silo/query_engine/query_result.h"
 #include "silo/storage/column_group.h"
@@ -108,32 +109,33 @@ QueryResult Aggregated::execute(
       tuple_factories.emplace_back(partition.columns, group_by_metadata);
    }
 
-   tbb::parallel_for(
-      tbb::blocked_range<uint32_t>(0, database.partitions.size()),
-      [&](tbb::blocked_range<uint32_t> range) {
-         for (uint32_t partition_id = range.begin(); partition_id != range.end(); ++partition_id) {
-            TupleFactory& tuple_factory = tuple_factories.at(partition_id);
-            std::unordered_map<Tuple, uint32_t>& map = tuple_maps.at(partition_id);
-            OperatorResult& bitmap = bitmap_filters[partition_id];
-
-            auto iterator = bitmap->begin();
-            auto end = bitmap->end();
-            if (iterator != end) {
-               Tuple current_tuple = tuple_factory.allocateOne(*iterator);
+   const QueryContext* query_context = QueryContext::current();
+   PerfCounterAccumulator* perf_counters = PerfCounterBlock::current();
+   NumaNodes::get().parallelFor(database.getPartitionNumaNodes(), [&](size_t partition_id) {
+      const QueryContext::Scope scope(query_context);
+      const PerfCounterBlock perf_counter_block(perf_counters);
+      TupleFactory& tuple_factory = tuple_factories.at(partition_id);
+      std::unordered_map<Tuple, uint32_t>& map = tuple_maps.at(partition_id);
+      OperatorResult& bitmap = bitmap_filters[partition_id];
+
+      auto iterator = bitmap->begin();
+      auto end = bitmap->end();
+      if (iterator != end) {
+         Tuple current_tuple = tuple_factory.allocateOne(*iterator);
+         map.emplace(tuple_factory.copyTuple(current_tuple), 1);
+         iterator++;
+         uint32_t row_counter = 0;
+         for (; iterator != end; iterator++) {
+            QueryContext::checkCurrentPeriodically(row_counter);
+            tuple_factory.overwrite(current_tuple, *iterator);
+            if (map.contains(current_tuple)) {
+               ++map.at(current_tuple);
+            } else {
                map.emplace(tuple_factory.copyTuple(current_tuple), 1);
-               iterator++;
-               for (; iterator != end; iterator++) {
-                  tuple_factory.overwrite(current_tuple, *iterator);
-                  if (map.contains(current_tuple)) {
-                     ++map.at(current_tuple);
-                  } else {
-                     map.emplace(tuple_factory.copyTuple(current_tuple), 1);
-                  }
-               }
             }
          }
       }
-   );
+   });
    std::unordered_map<Tuple, uint32_t> final_map;
    for (uint32_t partition_id = 0; partition_id != database.partitions.size(); ++partition_id) {
       auto& tuple_factory = tuple_factories.at(partition_id);
@@ -7,12 +7,15 @@
 #include <oneapi/tbb/parallel_for.h>
 #include <nlohmann/json.hpp>
 
+#include "silo/common/perf_counters.h"
 #include "silo/config/database_config.h"
 #include "silo/database.h"
 #include "silo/query_engine/actions/action.h"
 #include "silo/query_engine/actions/tuple.h"
 #include "silo/query_engine/operator_result.h"
+#include "silo/query_engine/query_context.h"
 #include "silo/query_engine/query_parse_exception.h"
+#include "silo/query_engine/query_profile.h"
 #include "silo/query_engine/query_result.h"
 #include "silo/storage/column_group.h"
 
@@ -106,7 +109,11 @@ std::vector<actions::Tuple> produceSortedTuplesWithLimit(
    const uint32_t to_produce
 ) {
    std::vector<std::vector<actions::Tuple>> tuples_per_partition(bitmap_filter.size());
+   const QueryContext* query_context = QueryContext::current();
+   PerfCounterAccumulator* perf_counters = PerfCounterBlock::current();
    tbb::parallel_for(tbb::blocked_range<size_t>(0U, bitmap_filter.size()), [&](auto local) {
+      const QueryContext::Scope scope(query_context);
+      const PerfCounterBlock perf_counter_block(perf_counters);
       for (size_t partition_id = local.begin(); partition_id != local.end(); partition_id++) {
          const auto& bitmap = bitmap_filter.at(partition_id);
          TupleFactory& tuple_factory = tuple_factories.at(partition_id);
@@ -117,7 +124,9 @@ std::vector<actions::Tuple> produceSortedTuplesWithLimit(
          auto iterator = bitmap->begin();
          auto end = bitmap->end();
          uint32_t counter = 0;
+         uint32_t row_counter = 0;
          for (; iterator != end && counter < to_produce; iterator++) {
+            QueryContext::checkCurrentPeriodically(row_counter);
             tuple_factory.overwrite(my_tuples.at(counter), *iterator);
             counter++;
          }
@@ -131,6 +140,7 @@ std::vector<actions::Tuple> produceSortedTuplesWithLimit(
                std::push_heap(my_tuples.begin(), my_tuples.end(), tuple_comparator);
             }
             for (; iterator != end; iterator++) {
+               QueryContext::checkCurrentPeriodically(row_counter);
                tuple_factory.overwrite(current_tuple, *iterator);
                if (tuple_comparator(current_tuple, my_tuples.front())) {
                   std::pop_heap(my_tuples.begin(), my_tuples.end(), tuple_comparator);
@@ -163,14 +173,20 @@ std::vector<Tuple> produceAllTuples(
 
    std::vector<Tuple> all_tuples = tuple_factories.front().allocateMany(offsets.back());
 
+   const QueryContext* query_context = QueryContext::current();
+   PerfCounterAccumulator* perf_counters = PerfCounterBlock::current();
    tbb::parallel_for(tbb::blocked_range<size_t>(0U, bitmap_filter.size()), [&](auto local) {
+      const QueryContext::Scope scope(query_context);
+      const PerfCounterBlock perf_counter_block(perf_counters);
       for (size_t partition_id = local.begin(); partition_id != local.end(); partition_id++) {
          auto& tuple_factory = tuple_factories.at(partition_id);
          const auto& bitmap = bitmap_filter.at(partition_id);
 
          auto cursor = all_tuples.begin() +
                        static_cast<decltype(all_tuples)::difference_type>(offsets.at(partition_id));
+         uint32_t row_counter = 0;
          for (const uint32_t sequence_id : *bitmap) {
+            QueryContext::checkCurrentPeriodically(row_counter);
             tuple_factory.overwrite(*cursor, sequence_id);
             cursor++;
          }
@@ -194,6 +210,7 @@ QueryResult Details::executeAndOrder(
 
    std::vector<actions::Tuple> tuples;
    if (limit.has_value()) {
+      const ActionPhaseTimer timer("produceSortedTuples");
       tuples = produceSortedTuplesWithLimit(
          tuple_factories,
          bitmap_filter,
@@ -201,8 +218,12 @@ QueryResult Details::executeAndOrder(
          limit.value() + offset.value_or(0)
       );
    } else {
-      tuples = produceAllTuples(tuple_factories, bitmap_filter);
+      {
+         const ActionPhaseTimer timer("produceTuples");
+         tuples = produceAllTuples(tuple_factories, bitmap_filter);
+      }
       if (!order_by_fields.empty()) {
+         const ActionPhaseTimer timer("sort");
          std::sort(
             tuples.begin(), tuples.end(), Tuple::getComparator(field_metadata, order_by_fields)
          );
@@ -210,8 +231,11 @@ QueryResult Details::executeAndOrder(
    }
 
    QueryResult results_in_format;
-   for (const auto& tuple : tuples) {
-      results_in_format.query_result.push_back({tuple.getFields()});
+   {
+      const ActionPhaseTimer timer("format");
+      for (const auto& tuple : tuples) {
+         results_in_format.query_result.push_back({tuple.getFields()});
+      }
    }
    applyOffsetAndLimit(results_in_format);
    return results_in_format;
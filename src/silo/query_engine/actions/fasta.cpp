@@ -7,6 +7,7 @@
 
 #include "silo/database.h"
 #include "silo/query_engine/operator_result.h"
+#include "silo/query_engine/query_context.h"
 #include "silo/query_engine/query_parse_exception.h"
 #include "silo/query_engine/query_result.h"
 #include "silo/zstdfasta/zstdfasta_table_reader.h"
@@ -238,6 +239,7 @@ QueryResult Fasta::execute(const Database& database, std::vector<OperatorResult>
       const auto& database_partition = database.partitions[partition_index];
       const auto& bitmap = bitmap_filter[partition_index];
 
+      QueryContext::checkCurrent();
       addSequencesToResultsForPartition(results, database_partition, bitmap, primary_key_column);
    }
 
@@ -16,6 +16,7 @@
 #include "silo/database.h"
 #include "silo/query_engine/actions/action.h"
 #include "silo/query_engine/operator_result.h"
+#include "silo/query_engine/query_context.h"
 #include "silo/query_engine/query_parse_exception.h"
 #include "silo/query_engine/query_result.h"
 #include "silo/storage/sequence_store.h"
@@ -60,17 +61,21 @@ std::string reconstructSequence(
    }
 
    tbb::parallel_for(
-      tbb::blocked_range<size_t>(0, sequence_store.positions.size()),
+      tbb::blocked_range<size_t>(0, sequence_store.reference_sequence.size()),
       [&](const auto local) {
-         for (auto position_id = local.begin(); position_id != local.end(); position_id++) {
-            const Position<SymbolType>& position = sequence_store.positions.at(position_id);
-            for (const auto symbol : SymbolType::SYMBOLS) {
-               if (!position.isSymbolFlipped(symbol) && !position.isSymbolDeleted(symbol)
-                   && position.getBitmap(symbol)->contains(sequence_id)) {
-                  reconstructed_sequence[position_id] = SymbolType::symbolToChar(symbol);
+         // Positions that a SPARSE store did not materialize keep the reference symbol
+         sequence_store.forEachMaterializedPositionInRange(
+            local.begin(),
+            local.end(),
+            [&](size_t position_id, const Position<SymbolType>& position) {
+               for (const auto symbol : SymbolType::SYMBOLS) {
+                  if (!position.isSymbolFlipped(symbol) && !position.isSymbolDeleted(symbol)
+                      && position.getBitmap(symbol)->contains(sequence_id)) {
+                     reconstructed_sequence[position_id] = SymbolType::symbolToChar(symbol);
+                  }
                }
             }
-         }
+         );
       }
    );
 
@@ -112,6 +117,7 @@ QueryResult FastaAligned::execute(
       const auto& database_partition = database.partitions[partition_index];
       const auto& bitmap = bitmap_filter[partition_index];
       for (const uint32_t sequence_id : *bitmap) {
+         QueryContext::checkCurrent();
          QueryResultEntry entry;
          const std::string primary_key_column = database.database_config.schema.primary_key;
          entry.fields.emplace(
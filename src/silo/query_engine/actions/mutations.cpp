@@ -14,10 +14,13 @@
 
 #include "silo/common/aa_symbols.h"
 #include "silo/common/nucleotide_symbols.h"
+#include "silo/common/numa.h"
+#include "silo/common/perf_counters.h"
 #include "silo/common/symbol_map.h"
 #include "silo/database.h"
 #include "silo/query_engine/actions/action.h"
 #include "silo/query_engine/operator_result.h"
+#include "silo/query_engine/query_context.h"
 #include "silo/query_engine/query_parse_exception.h"
 #include "silo/query_engine/query_result.h"
 #include "silo/storage/database_partition.h"
@@ -33,10 +36,19 @@ Mutations<SymbolType>::Mutations(std::vector<std::string>&& sequence_names, doub
       min_proportion(min_proportion) {}
 
 template <typename SymbolType>
-std::unordered_map<std::string, typename Mutations<SymbolType>::PrefilteredBitmaps> Mutations<
-   SymbolType>::
-   preFilterBitmaps(const silo::Database& database, std::vector<OperatorResult>& bitmap_filter) {
-   std::unordered_map<std::string, PrefilteredBitmaps> bitmaps_to_evaluate;
+std::unordered_map<std::string, std::vector<typename Mutations<SymbolType>::PrefilteredBitmaps>>
+Mutations<SymbolType>::preFilterBitmaps(
+   const silo::Database& database,
+   std::vector<OperatorResult>& bitmap_filter
+) {
+   const size_t numa_node_count = NumaNodes::get().count();
+   std::unordered_map<std::string, std::vector<PrefilteredBitmaps>> bitmaps_to_evaluate;
+   const auto bitmaps_of_node = [&](const std::string& sequence_name, uint32_t numa_node)
+      -> PrefilteredBitmaps& {
+      auto& bitmaps_per_node = bitmaps_to_evaluate[sequence_name];
+      bitmaps_per_node.resize(numa_node_count);
+      return bitmaps_per_node.at(numa_node);
+   };
    for (size_t i = 0; i < database.partitions.size(); ++i) {
       const DatabasePartition& database_partition = database.partitions.at(i);
       OperatorResult& filter = bitmap_filter[i];
@@ -47,7 +59,8 @@ std::unordered_map<std::string, typename Mutations<SymbolType>::PrefilteredBitma
       if (cardinality == database_partition.sequence_count) {
          for (const auto& [sequence_name, sequence_store] :
               database_partition.getSequenceStores<SymbolType>()) {
-            bitmaps_to_evaluate[sequence_name].full_bitmaps.emplace_back(filter, sequence_store);
+            bitmaps_of_node(sequence_name, database_partition.numa_node)
+               .full_bitmaps.emplace_back(filter, sequence_store);
          }
       } else {
          if (filter.isMutable()) {
@@ -55,111 +68,202 @@ std::unordered_map<std::string, typename Mutations<SymbolType>::PrefilteredBitma
          }
          for (const auto& [sequence_name, sequence_store] :
               database_partition.getSequenceStores<SymbolType>()) {
-            bitmaps_to_evaluate[sequence_name].bitmaps.emplace_back(filter, sequence_store);
+            bitmaps_of_node(sequence_name, database_partition.numa_node)
+               .bitmaps.emplace_back(filter, sequence_store);
          }
       }
    }
    return bitmaps_to_evaluate;
 }
 
+namespace {
+
+/// Calls add_position(position, materialized_position) for the materialized positions in
+/// [begin, end) and add_reference_position(position) for the positions that a SPARSE store did
+/// not materialize. There, every sequence that is not missing has the reference symbol
+template <typename SymbolType, typename AddPosition, typename AddReferencePosition>
+void forEachPositionInRange(
+   const SequenceStorePartition<SymbolType>& sequence_store_partition,
+   uint32_t begin,
+   uint32_t end,
+   AddPosition add_position,
+   AddReferencePosition add_reference_position
+) {
+   uint32_t next_position = begin;
+   sequence_store_partition.forEachMaterializedPositionInRange(
+      begin,
+      end,
+      [&](size_t position, const Position<SymbolType>& materialized_position) {
+         for (; next_position < position; ++next_position) {
+            add_reference_position(next_position);
+         }
+         add_position(static_cast<uint32_t>(position), materialized_position);
+         next_position = static_cast<uint32_t>(position) + 1;
+      }
+   );
+   for (; next_position < end; ++next_position) {
+      add_reference_position(next_position);
+   }
+}
+
+}  // namespace
+
 template <typename SymbolType>
-void Mutations<SymbolType>::addPositionToMutationCountsForMixedBitmaps(
-   uint32_t position,
-   const PrefilteredBitmaps& bitmaps_to_evaluate,
+void Mutations<SymbolType>::addMutationCountsForMixedBitmap(
+   uint32_t begin,
+   uint32_t end,
+   const OperatorResult& filter,
+   const SequenceStorePartition<SymbolType>& sequence_store_partition,
    SymbolMap<SymbolType, std::vector<uint32_t>>& count_of_mutations_per_position
 ) {
-   for (const auto& [filter, sequence_store_partition] : bitmaps_to_evaluate.bitmaps) {
-      for (const auto symbol : SymbolType::SYMBOLS) {
-         const auto& current_position = sequence_store_partition.positions[position];
-         if (current_position.isSymbolDeleted(symbol)) {
-            count_of_mutations_per_position[symbol][position] += filter->cardinality();
-            for (const uint32_t idx : *filter) {
-               const roaring::Roaring& n_bitmap =
-                  sequence_store_partition.missing_symbol_bitmaps[idx];
-               if (n_bitmap.contains(position)) {
-                  count_of_mutations_per_position[symbol][position] -= 1;
-               }
-            }
-            continue;
+   const uint32_t filter_cardinality = filter->cardinality();
+   const auto add_deleted_symbol_count = [&](typename SymbolType::Symbol symbol,
+                                             uint32_t position) {
+      count_of_mutations_per_position[symbol][position] += filter_cardinality;
+      for (const uint32_t idx : *filter) {
+         const roaring::Roaring& n_bitmap = sequence_store_partition.missing_symbol_bitmaps[idx];
+         if (n_bitmap.contains(position)) {
+            count_of_mutations_per_position[symbol][position] -= 1;
          }
-         const uint32_t symbol_count =
-            current_position.isSymbolFlipped(symbol)
-               ? filter->andnot_cardinality(*current_position.getBitmap(symbol))
-               : filter->and_cardinality(*current_position.getBitmap(symbol));
+      }
+   };
+   forEachPositionInRange(
+      sequence_store_partition,
+      begin,
+      end,
+      [&](uint32_t position, const Position<SymbolType>& current_position) {
+         for (const auto symbol : SymbolType::SYMBOLS) {
+            if (current_position.isSymbolDeleted(symbol)) {
+               add_deleted_symbol_count(symbol, position);
+               continue;
+            }
+            const uint32_t symbol_count =
+               current_position.isSymbolFlipped(symbol)
+                  ? filter->andnot_cardinality(*current_position.getBitmap(symbol))
+                  : filter->and_cardinality(*current_position.getBitmap(symbol));
 
-         count_of_mutations_per_position[symbol][position] += symbol_count;
+            count_of_mutations_per_position[symbol][position] += symbol_count;
 
-         const auto deleted_symbol = current_position.getDeletedSymbol();
-         if (deleted_symbol.has_value() && symbol != *deleted_symbol) {
-            count_of_mutations_per_position[*deleted_symbol][position] -= symbol_count;
+            const auto deleted_symbol = current_position.getDeletedSymbol();
+            if (deleted_symbol.has_value() && symbol != *deleted_symbol) {
+               count_of_mutations_per_position[*deleted_symbol][position] -= symbol_count;
+            }
          }
+      },
+      [&](uint32_t position) {
+         add_deleted_symbol_count(sequence_store_partition.reference_sequence[position], position);
       }
-   }
+   );
 }
 
 template <typename SymbolType>
-void Mutations<SymbolType>::addPositionToMutationCountsForFullBitmaps(
-   uint32_t position,
-   const PrefilteredBitmaps& bitmaps_to_evaluate,
+void Mutations<SymbolType>::addMutationCountsForFullBitmap(
+   uint32_t begin,
+   uint32_t end,
+   const SequenceStorePartition<SymbolType>& sequence_store_partition,
    SymbolMap<SymbolType, std::vector<uint32_t>>& count_of_mutations_per_position
 ) {
    // For these partitions, we have full bitmaps. Do not need to bother with AND
    // cardinality
-   for (const auto& [filter, sequence_store_partition] : bitmaps_to_evaluate.full_bitmaps) {
-      for (const auto symbol : SymbolType::SYMBOLS) {
-         const auto& current_position = sequence_store_partition.positions[position];
-         if (current_position.isSymbolDeleted(symbol)) {
-            count_of_mutations_per_position[symbol][position] +=
-               sequence_store_partition.sequence_count;
-            for (const roaring::Roaring& n_bitmap :
-                 sequence_store_partition.missing_symbol_bitmaps) {
-               if (n_bitmap.contains(position)) {
-                  count_of_mutations_per_position[symbol][position] -= 1;
-               }
-            }
-            continue;
+   const auto add_deleted_symbol_count = [&](typename SymbolType::Symbol symbol,
+                                             uint32_t position) {
+      count_of_mutations_per_position[symbol][position] += sequence_store_partition.sequence_count;
+      for (const roaring::Roaring& n_bitmap : sequence_store_partition.missing_symbol_bitmaps) {
+         if (n_bitmap.contains(position)) {
+            count_of_mutations_per_position[symbol][position] -= 1;
          }
-         const uint32_t symbol_count = current_position.isSymbolFlipped(symbol)
-                                          ? sequence_store_partition.sequence_count -
-                                               current_position.getBitmap(symbol)->cardinality()
-                                          : current_position.getBitmap(symbol)->cardinality();
+      }
+   };
+   forEachPositionInRange(
+      sequence_store_partition,
+      begin,
+      end,
+      [&](uint32_t position, const Position<SymbolType>& current_position) {
+         for (const auto symbol : SymbolType::SYMBOLS) {
+            if (current_position.isSymbolDeleted(symbol)) {
+               add_deleted_symbol_count(symbol, position);
+               continue;
+            }
+            const uint32_t symbol_count =
+               current_position.isSymbolFlipped(symbol)
+                  ? sequence_store_partition.sequence_count -
+                       current_position.getBitmap(symbol)->cardinality()
+                  : current_position.getBitmap(symbol)->cardinality();
 
-         count_of_mutations_per_position[symbol][position] += symbol_count;
+            count_of_mutations_per_position[symbol][position] += symbol_count;
 
-         const auto deleted_symbol = current_position.getDeletedSymbol();
-         if (deleted_symbol.has_value() && symbol != *deleted_symbol) {
-            count_of_mutations_per_position[*deleted_symbol][position] -=
-               sequence_store_partition.positions[position].getBitmap(symbol)->cardinality();
+            const auto deleted_symbol = current_position.getDeletedSymbol();
+            if (deleted_symbol.has_value() && symbol != *deleted_symbol) {
+               count_of_mutations_per_position[*deleted_symbol][position] -=
+                  current_position.getBitmap(symbol)->cardinality();
+            }
          }
+      },
+      [&](uint32_t position) {
+         add_deleted_symbol_count(sequence_store_partition.reference_sequence[position], position);
       }
-   }
+   );
 }
 
 template <typename SymbolType>
 SymbolMap<SymbolType, std::vector<uint32_t>> Mutations<SymbolType>::calculateMutationsPerPosition(
    const SequenceStore<SymbolType>& sequence_store,
-   const PrefilteredBitmaps& bitmap_filter
+   const std::vector<PrefilteredBitmaps>& bitmap_filter_per_numa_node
 ) {
    const size_t sequence_length = sequence_store.reference_sequence.size();
 
+   std::vector<SymbolMap<SymbolType, std::vector<uint32_t>>> mutation_counts_per_numa_node(
+      bitmap_filter_per_numa_node.size()
+   );
+   static constexpr int POSITIONS_PER_PROCESS = 300;
+   const QueryContext* query_context = QueryContext::current();
+   PerfCounterAccumulator* perf_counters = PerfCounterBlock::current();
+   NumaNodes::get().parallelForEachNode([&](uint32_t numa_node) {
+      const auto& bitmap_filter = bitmap_filter_per_numa_node.at(numa_node);
+      if (bitmap_filter.bitmaps.empty() && bitmap_filter.full_bitmaps.empty()) {
+         return;
+      }
+      auto& mutation_counts_per_position = mutation_counts_per_numa_node.at(numa_node);
+      for (const auto symbol : SymbolType::SYMBOLS) {
+         mutation_counts_per_position[symbol].resize(sequence_length);
+      }
+      tbb::parallel_for(
+         tbb::blocked_range<uint32_t>(0, sequence_length, /*grain_size=*/POSITIONS_PER_PROCESS),
+         [&](const auto& local) {
+            const QueryContext::Scope scope(query_context);
+            const PerfCounterBlock perf_counter_block(perf_counters);
+            QueryContext::checkCurrent();
+            for (const auto& [filter, sequence_store_partition] : bitmap_filter.bitmaps) {
+               addMutationCountsForMixedBitmap(
+                  local.begin(),
+                  local.end(),
+                  filter,
+                  sequence_store_partition,
+                  mutation_counts_per_position
+               );
+            }
+            for (const auto& [filter, sequence_store_partition] : bitmap_filter.full_bitmaps) {
+               addMutationCountsForFullBitmap(
+                  local.begin(), local.end(), sequence_store_partition, mutation_counts_per_position
+               );
+            }
+         }
+      );
+   });
+
    SymbolMap<SymbolType, std::vector<uint32_t>> mutation_counts_per_position;
    for (const auto symbol : SymbolType::SYMBOLS) {
       mutation_counts_per_position[symbol].resize(sequence_length);
    }
-   static constexpr int POSITIONS_PER_PROCESS = 300;
-   tbb::parallel_for(
-      tbb::blocked_range<uint32_t>(0, sequence_length, /*grain_size=*/POSITIONS_PER_PROCESS),
-      [&](const auto& local) {
-         for (uint32_t pos = local.begin(); pos != local.end(); ++pos) {
-            addPositionToMutationCountsForMixedBitmaps(
-               pos, bitmap_filter, mutation_counts_per_position
-            );
-            addPositionToMutationCountsForFullBitmaps(
-               pos, bitmap_filter, mutation_counts_per_position
-            );
+   for (const auto& node_counts : mutation_counts_per_numa_node) {
+      for (const auto symbol : SymbolType::SYMBOLS) {
+         const auto& counts = node_counts.at(symbol);
+         auto& total_counts = mutation_counts_per_position[symbol];
+         for (size_t pos = 0; pos < counts.size(); ++pos) {
+            total_counts[pos] += counts[pos];
          }
       }
-   );
+   }
    return mutation_counts_per_position;
 }
 
@@ -185,13 +289,13 @@ template <typename SymbolType>
 void Mutations<SymbolType>::addMutationsToOutput(
    const std::string& sequence_name,
    const SequenceStore<SymbolType>& sequence_store,
-   const PrefilteredBitmaps& bitmap_filter,
+   const std::vector<PrefilteredBitmaps>& bitmap_filter_per_numa_node,
    std::vector<QueryResultEntry>& output
 ) const {
    const size_t sequence_length = sequence_store.reference_sequence.size();
 
    const SymbolMap<SymbolType, std::vector<uint32_t>> count_of_mutations_per_position =
-      calculateMutationsPerPosition(sequence_store, bitmap_filter);
+      calculateMutationsPerPosition(sequence_store, bitmap_filter_per_numa_node);
 
    for (size_t pos = 0; pos < sequence_length; ++pos) {
       uint32_t total = 0;
@@ -251,8 +355,8 @@ QueryResult Mutations<SymbolType>::execute(
       }
    }
 
-   std::unordered_map<std::string, Mutations<SymbolType>::PrefilteredBitmaps> bitmaps_to_evaluate =
-      preFilterBitmaps(database, bitmap_filter);
+   const std::unordered_map<std::string, std::vector<Mutations<SymbolType>::PrefilteredBitmaps>>
+      bitmaps_to_evaluate = preFilterBitmaps(database, bitmap_filter);
 
    std::vector<QueryResultEntry> mutation_proportions;
    for (const auto& sequence_name : sequence_names_to_evaluate) {
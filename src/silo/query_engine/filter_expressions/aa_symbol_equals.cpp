@@ -60,7 +60,7 @@ std::unique_ptr<silo::query_engine::operators::Operator> AASymbolEquals::compile
          position
       );
    }
-   if (aa_store_partition.positions[position].isSymbolFlipped(aa_symbol)) {
+   if (aa_store_partition.getPosition(position).isSymbolFlipped(aa_symbol)) {
       return std::make_unique<operators::Complement>(
          std::make_unique<operators::IndexScan>(
             aa_store_partition.getBitmap(position, aa_symbol), database_partition.sequence_count
@@ -68,7 +68,7 @@ std::unique_ptr<silo::query_engine::operators::Operator> AASymbolEquals::compile
          database_partition.sequence_count
       );
    }
-   if (aa_store_partition.positions[position].isSymbolDeleted(aa_symbol)) {
+   if (aa_store_partition.getPosition(position).isSymbolDeleted(aa_symbol)) {
       std::vector<AminoAcid::Symbol> symbols =
          std::vector<AminoAcid::Symbol>(AminoAcid::SYMBOLS.begin(), AminoAcid::SYMBOLS.end());
       // NOLINTNEXTLINE(bugprone-unused-return-value)
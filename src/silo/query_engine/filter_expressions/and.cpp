@@ -1,6 +1,7 @@
 #include "silo/query_engine/filter_expressions/and.h"
 
 #include <algorithm>
+#include <functional>
 #include <memory>
 #include <string>
 #include <utility>
@@ -44,6 +45,12 @@ std::string And::toString(const silo::Database& database) const {
    return "And(" + boost::algorithm::join(child_strings, " & ") + ")";
 }
 
+void And::visitChildren(const std::function<void(std::unique_ptr<Expression>&)>& visitor) {
+   for (auto& child : children) {
+      visitor(child);
+   }
+}
+
 namespace {
 
 template <typename T>
@@ -58,6 +65,7 @@ void inline appendVectorToVector(
       [&](std::unique_ptr<T>& ele) { return std::move(ele); }
    );
 }
+
 }  // namespace
 
 void logCompiledChildren(
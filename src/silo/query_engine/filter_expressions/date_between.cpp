@@ -31,7 +31,7 @@ DateBetween::DateBetween(
       date_to(date_to) {}
 
 std::string DateBetween::toString(const silo::Database& /*database*/) const {
-   std::string res = "[Date-between ";
+   std::string res = "[Date-between " + column + " ";
    res +=
       (date_from.has_value() ? silo::common::dateToString(date_from.value()).value_or("")
                              : "unbounded");
@@ -1,5 +1,6 @@
 #include "silo/query_engine/filter_expressions/exact.h"
 
+#include <functional>
 #include <memory>
 #include <string>
 #include <utility>
@@ -23,6 +24,11 @@ Exact::Exact(std::unique_ptr<Expression> child)
 std::string Exact::toString(const silo::Database& database) const {
    return "Exact ( " + child->toString(database) + ")";
 }
+
+void Exact::visitChildren(const std::function<void(std::unique_ptr<Expression>&)>& visitor) {
+   visitor(child);
+}
+
 std::unique_ptr<silo::query_engine::operators::Operator> Exact::compile(
    const silo::Database& database,
    const silo::DatabasePartition& database_partition,
@@ -1,5 +1,7 @@
 #include "silo/query_engine/filter_expressions/expression.h"
 
+#include <functional>
+#include <memory>
 #include <string>
 
 #include <nlohmann/json.hpp>
@@ -35,6 +37,10 @@ namespace silo::query_engine::filter_expressions {
 
 Expression::Expression() = default;
 
+void Expression::visitChildren(
+   const std::function<void(std::unique_ptr<Expression>&)>& /*visitor*/
+) {}
+
 Expression::AmbiguityMode invertMode(Expression::AmbiguityMode mode) {
    if (mode == Expression::UPPER_BOUND) {
       return Expression::LOWER_BOUND;
@@ -99,6 +105,7 @@ void from_json(const nlohmann::json& json, std::unique_ptr<Expression>& filter)
    } else {
       throw QueryParseException("Unknown object filter type '" + expression_type + "'");
    }
+   filter->canonical_json = json.dump();
 }
 
 }  // namespace silo::query_engine::filter_expressions
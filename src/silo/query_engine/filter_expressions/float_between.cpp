@@ -28,7 +28,7 @@ std::string FloatBetween::toString(const silo::Database& /*database*/) const {
    const auto from_string = from.has_value() ? std::to_string(from.value()) : "unbounded";
    const auto to_string = to.has_value() ? std::to_string(to.value()) : "unbounded";
 
-   return "[FloatBetween " + from_string + " - " + to_string + "]";
+   return "[FloatBetween " + column + " " + from_string + " - " + to_string + "]";
 }
 
 std::unique_ptr<silo::query_engine::operators::Operator> FloatBetween::compile(
@@ -1,5 +1,6 @@
 #include "silo/query_engine/filter_expressions/maybe.h"
 
+#include <functional>
 #include <memory>
 #include <string>
 #include <utility>
@@ -23,6 +24,11 @@ Maybe::Maybe(std::unique_ptr<Expression> child)
 std::string Maybe::toString(const silo::Database& database) const {
    return "Maybe (" + child->toString(database) + ")";
 }
+
+void Maybe::visitChildren(const std::function<void(std::unique_ptr<Expression>&)>& visitor) {
+   visitor(child);
+}
+
 std::unique_ptr<silo::query_engine::operators::Operator> Maybe::compile(
    const silo::Database& database,
    const silo::DatabasePartition& database_partition,
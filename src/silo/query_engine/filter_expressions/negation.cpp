@@ -1,5 +1,6 @@
 #include "silo/query_engine/filter_expressions/negation.h"
 
+#include <functional>
 #include <memory>
 #include <string>
 #include <utility>
@@ -24,6 +25,10 @@ std::string Negation::toString(const silo::Database& database) const {
    return "!(" + child->toString(database) + ")";
 }
 
+void Negation::visitChildren(const std::function<void(std::unique_ptr<Expression>&)>& visitor) {
+   visitor(child);
+}
+
 std::unique_ptr<operators::Operator> Negation::compile(
    const silo::Database& database,
    const silo::DatabasePartition& database_partition,
@@ -1,5 +1,6 @@
 #include "silo/query_engine/filter_expressions/nof.h"
 
+#include <functional>
 #include <memory>
 #include <string>
 #include <utility>
@@ -181,6 +182,12 @@ std::string NOf::toString(const silo::Database& database) const {
    return res;
 }
 
+void NOf::visitChildren(const std::function<void(std::unique_ptr<Expression>&)>& visitor) {
+   for (auto& child : children) {
+      visitor(child);
+   }
+}
+
 std::tuple<
    std::vector<std::unique_ptr<operators::Operator>>,
    std::vector<std::unique_ptr<operators::Operator>>,
@@ -141,7 +141,7 @@ std::unique_ptr<silo::query_engine::operators::Operator> NucleotideSymbolEquals:
          position
       );
    }
-   if (seq_store_partition.positions[position].isSymbolFlipped(nucleotide_symbol)) {
+   if (seq_store_partition.getPosition(position).isSymbolFlipped(nucleotide_symbol)) {
       SPDLOG_TRACE(
          "Filtering for flipped symbol '{}' at position {}",
          Nucleotide::symbolToChar(nucleotide_symbol),
@@ -155,7 +155,7 @@ std::unique_ptr<silo::query_engine::operators::Operator> NucleotideSymbolEquals:
          database_partition.sequence_count
       );
    }
-   if (seq_store_partition.positions[position].isSymbolDeleted(nucleotide_symbol)) {
+   if (seq_store_partition.getPosition(position).isSymbolDeleted(nucleotide_symbol)) {
       SPDLOG_TRACE(
          "Filtering for deleted symbol '{}' at position {}",
          Nucleotide::symbolToChar(nucleotide_symbol),
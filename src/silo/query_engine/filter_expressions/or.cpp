@@ -1,6 +1,7 @@
 #include "silo/query_engine/filter_expressions/or.h"
 
 #include <algorithm>
+#include <functional>
 #include <string>
 #include <utility>
 
@@ -38,6 +39,12 @@ std::string Or::toString(const silo::Database& database) const {
    return "Or(" + boost::algorithm::join(child_strings, " | ") + ")";
 }
 
+void Or::visitChildren(const std::function<void(std::unique_ptr<Expression>&)>& visitor) {
+   for (auto& child : children) {
+      visitor(child);
+   }
+}
+
 std::unique_ptr<operators::Operator> Or::compile(
    const Database& database,
    const DatabasePartition& database_partition,
@@ -27,11 +27,11 @@ PangoLineageFilter::PangoLineageFilter(
       include_sublineages(include_sublineages) {}
 
 std::string PangoLineageFilter::toString(const silo::Database& /*database*/) const {
-   std::string res = lineage;
+   std::string res = column + " = '" + lineage;
    if (include_sublineages) {
       res += "*";
    }
-   return res;
+   return res + "'";
 }
 
 std::unique_ptr<silo::query_engine::operators::Operator> PangoLineageFilter::compile(
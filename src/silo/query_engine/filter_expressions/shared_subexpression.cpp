@@ -0,0 +1,70 @@
+#include "silo/query_engine/filter_expressions/shared_subexpression.h"
+
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+
+#include "silo/query_engine/operator_result.h"
+#include "silo/query_engine/operators/bitmap_producer.h"
+#include "silo/query_engine/operators/operator.h"
+#include "silo/storage/database_partition.h"
+
+namespace silo::query_engine::filter_expressions {
+
+std::unique_ptr<operators::Operator> SubexpressionCache::compile(
+   const Expression& expression,
+   const Database& database,
+   const DatabasePartition& database_partition,
+   Expression::AmbiguityMode mode
+) {
+   Entry* entry;
+   {
+      const std::lock_guard<std::mutex> lock(mutex);
+      entry = &entries[{&database_partition, mode}];
+      if (entry->compiled == nullptr) {
+         entry->compiled = expression.compile(database, database_partition, mode);
+      }
+   }
+   return std::make_unique<operators::BitmapProducer>(
+      [entry]() {
+         std::call_once(entry->evaluated, [entry]() {
+            entry->result = entry->compiled->evaluate();
+            if (entry->result.isMutable()) {
+               entry->result->runOptimize();
+            }
+         });
+         const OperatorResult& result = entry->result;
+         return OperatorResult(*result);
+      },
+      database_partition.sequence_count
+   );
+}
+
+SharedSubexpression::SharedSubexpression(
+   std::unique_ptr<Expression> child,
+   std::shared_ptr<SubexpressionCache> cache
+)
+    : child(std::move(child)),
+      cache(std::move(cache)) {}
+
+std::string SharedSubexpression::toString(const silo::Database& database) const {
+   return child->toString(database);
+}
+
+void SharedSubexpression::visitChildren(
+   const std::function<void(std::unique_ptr<Expression>&)>& visitor
+) {
+   visitor(child);
+}
+
+std::unique_ptr<operators::Operator> SharedSubexpression::compile(
+   const silo::Database& database,
+   const silo::DatabasePartition& database_partition,
+   AmbiguityMode mode
+) const {
+   return cache->compile(*child, database, database_partition, mode);
+}
+
+}  // namespace silo::query_engine::filter_expressions
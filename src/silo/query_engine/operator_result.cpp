@@ -2,12 +2,40 @@
 
 #include <utility>
 
+#include <oneapi/tbb/scalable_allocator.h>
 #include <roaring/roaring.hh>
 
+namespace {
+
+/// Results are created and dropped for every operator of every query on all threads, therefore
+/// they are taken from the per-thread pools of the scalable allocator like their containers
+template <typename... Args>
+roaring::Roaring* newBitmap(Args&&... args) {
+   tbb::scalable_allocator<roaring::Roaring> allocator;
+   roaring::Roaring* bitmap = allocator.allocate(1);
+   try {
+      new (bitmap) roaring::Roaring(std::forward<Args>(args)...);
+   } catch (...) {
+      allocator.deallocate(bitmap, 1);
+      throw;
+   }
+   return bitmap;
+}
+
+void deleteBitmap(roaring::Roaring* bitmap) {
+   if (bitmap == nullptr) {
+      return;
+   }
+   bitmap->~Roaring();
+   tbb::scalable_allocator<roaring::Roaring>().deallocate(bitmap, 1);
+}
+
+}  // namespace
+
 namespace silo::query_engine {
 
 OperatorResult::OperatorResult()
-    : mutable_bitmap(new roaring::Roaring()),
+    : mutable_bitmap(newBitmap()),
       immutable_bitmap(nullptr) {}
 
 OperatorResult::OperatorResult(const roaring::Roaring& bitmap)
@@ -15,11 +43,11 @@ OperatorResult::OperatorResult(const roaring::Roaring& bitmap)
       immutable_bitmap(&bitmap) {}
 
 OperatorResult::OperatorResult(roaring::Roaring&& bitmap)
-    : mutable_bitmap(new roaring::Roaring(std::move(bitmap))),
+    : mutable_bitmap(newBitmap(std::move(bitmap))),
       immutable_bitmap(nullptr) {}
 
 OperatorResult::~OperatorResult() {
-   delete mutable_bitmap;
+   deleteBitmap(mutable_bitmap);
 }
 
 OperatorResult::OperatorResult(OperatorResult&& other) noexcept  // move constructor
@@ -39,7 +67,7 @@ const roaring::Roaring& OperatorResult::operator*() const {
 
 roaring::Roaring& OperatorResult::operator*() {
    if (!mutable_bitmap) {
-      mutable_bitmap = new roaring::Roaring(*immutable_bitmap);
+      mutable_bitmap = newBitmap(*immutable_bitmap);
       immutable_bitmap = nullptr;
    }
    return *mutable_bitmap;
@@ -47,7 +75,7 @@ roaring::Roaring& OperatorResult::operator*() {
 
 roaring::Roaring* OperatorResult::operator->() {
    if (!mutable_bitmap) {
-      mutable_bitmap = new roaring::Roaring(*immutable_bitmap);
+      mutable_bitmap = newBitmap(*immutable_bitmap);
       immutable_bitmap = nullptr;
    }
    return mutable_bitmap;
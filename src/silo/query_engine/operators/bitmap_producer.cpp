@@ -22,7 +22,7 @@ Type BitmapProducer::type() const {
    return BITMAP_PRODUCER;
 }
 
-OperatorResult BitmapProducer::evaluate() const {
+OperatorResult BitmapProducer::evaluateImpl() const {
    return producer();
 }
 
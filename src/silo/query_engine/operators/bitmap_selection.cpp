@@ -30,7 +30,7 @@ Type BitmapSelection::type() const {
    return BITMAP_SELECTION;
 }
 
-OperatorResult BitmapSelection::evaluate() const {
+OperatorResult BitmapSelection::evaluateImpl() const {
    OperatorResult bitmap;
    switch (this->comparator) {
       case CONTAINS:
@@ -8,6 +8,7 @@
 #include "silo/query_engine/operator_result.h"
 #include "silo/query_engine/operators/intersection.h"
 #include "silo/query_engine/operators/operator.h"
+#include "silo/query_engine/query_context.h"
 
 namespace silo::query_engine::operators {
 
@@ -47,7 +48,8 @@ Type Complement::type() const {
    return COMPLEMENT;
 }
 
-OperatorResult Complement::evaluate() const {
+OperatorResult Complement::evaluateImpl() const {
+   QueryContext::checkCurrent();
    auto result = child->evaluate();
    result->flip(0, row_count);
    return result;
@@ -21,7 +21,7 @@ Type Empty::type() const {
    return EMPTY;
 }
 
-OperatorResult Empty::evaluate() const {
+OperatorResult Empty::evaluateImpl() const {
    return OperatorResult();
 }
 
@@ -21,7 +21,7 @@ Type Full::type() const {
    return FULL;
 }
 
-OperatorResult Full::evaluate() const {
+OperatorResult Full::evaluateImpl() const {
    OperatorResult result;
    result->addRange(0, row_count);
    return result;
@@ -25,7 +25,7 @@ Type IndexScan::type() const {
    return INDEX_SCAN;
 }
 
-OperatorResult IndexScan::evaluate() const {
+OperatorResult IndexScan::evaluateImpl() const {
    return OperatorResult(*bitmap);
 }
 
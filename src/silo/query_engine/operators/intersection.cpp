@@ -10,6 +10,7 @@
 #include "silo/query_engine/operators/complement.h"
 #include "silo/query_engine/operators/operator.h"
 #include "silo/query_engine/query_compilation_exception.h"
+#include "silo/query_engine/query_context.h"
 
 namespace silo::query_engine::operators {
 
@@ -73,7 +74,8 @@ OperatorResult intersectTwo(OperatorResult first, OperatorResult second) {
    return result;
 }
 
-OperatorResult Intersection::evaluate() const {
+OperatorResult Intersection::evaluateImpl() const {
+   QueryContext::checkCurrent();
    std::vector<OperatorResult> children_bm;
    children_bm.reserve(children.size());
    std::transform(
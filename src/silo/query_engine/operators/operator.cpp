@@ -1,9 +1,62 @@
 #include "silo/query_engine/operators/operator.h"
 
+#include "silo/common/block_timer.h"
+#include "silo/query_engine/query_profile.h"
+
 namespace silo::query_engine::operators {
 
+std::string typeName(Type type) {
+   switch (type) {
+      case EMPTY:
+         return "Empty";
+      case FULL:
+         return "Full";
+      case INDEX_SCAN:
+         return "IndexScan";
+      case INTERSECTION:
+         return "Intersection";
+      case COMPLEMENT:
+         return "Complement";
+      case RANGE_SELECTION:
+         return "RangeSelection";
+      case SELECTION:
+         return "Selection";
+      case BITMAP_SELECTION:
+         return "BitmapSelection";
+      case THRESHOLD:
+         return "Threshold";
+      case UNION:
+         return "Union";
+      case BITMAP_PRODUCER:
+         return "BitmapProducer";
+   }
+   return "Unknown";
+}
+
 Operator::Operator() = default;
 
 Operator::~Operator() noexcept = default;
 
+OperatorResult Operator::evaluate() const {
+   OperatorProfile* parent = OperatorProfileScope::current();
+   if (parent == nullptr) {
+      return evaluateImpl();
+   }
+   // The children of this operator are added to its profile while it is evaluated, the list of
+   // its siblings is not touched until then
+   OperatorProfile& profile = parent->children.emplace_back();
+   profile.type = typeName(type());
+   OperatorResult result = [&]() {
+      const OperatorProfileScope scope(&profile);
+      const BlockTimer timer(profile.evaluation_time_in_microseconds);
+      return evaluateImpl();
+   }();
+   profile.cardinality = result->cardinality();
+   profile.is_mutable = result.isMutable();
+   if (profile.children.empty()) {
+      profile.expression = toString();
+   }
+   return result;
+}
+
 }  // namespace silo::query_engine::operators
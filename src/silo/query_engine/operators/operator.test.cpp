@@ -0,0 +1,47 @@
+#include "silo/query_engine/operators/operator.h"
+
+#include <gtest/gtest.h>
+#include <roaring/roaring.hh>
+
+#include "silo/query_engine/operators/complement.h"
+#include "silo/query_engine/operators/index_scan.h"
+#include "silo/query_engine/query_profile.h"
+
+using silo::query_engine::OperatorProfile;
+using silo::query_engine::OperatorProfileScope;
+using silo::query_engine::operators::Complement;
+using silo::query_engine::operators::IndexScan;
+
+TEST(Operator, evaluateShouldAddProfilesOfEvaluatedOperators) {
+   const roaring::Roaring test_bitmap(roaring::Roaring({1, 2, 3}));
+   const uint32_t row_count = 5;
+   const Complement under_test(std::make_unique<IndexScan>(&test_bitmap, row_count), row_count);
+
+   OperatorProfile root;
+   {
+      const OperatorProfileScope scope(&root);
+      ASSERT_EQ(*under_test.evaluate(), roaring::Roaring({0, 4}));
+   }
+
+   ASSERT_EQ(root.children.size(), 1);
+   const OperatorProfile& complement = root.children.front();
+   EXPECT_EQ(complement.type, "Complement");
+   EXPECT_EQ(complement.cardinality, 2);
+   EXPECT_TRUE(complement.is_mutable);
+   EXPECT_EQ(complement.expression, "");
+   ASSERT_EQ(complement.children.size(), 1);
+   const OperatorProfile& index_scan = complement.children.front();
+   EXPECT_EQ(index_scan.type, "IndexScan");
+   EXPECT_EQ(index_scan.cardinality, 3);
+   EXPECT_FALSE(index_scan.is_mutable);
+   EXPECT_EQ(index_scan.expression, "IndexScan(Cardinality: 3)");
+   EXPECT_TRUE(index_scan.children.empty());
+}
+
+TEST(Operator, evaluateShouldNotProfileWithoutScope) {
+   const roaring::Roaring test_bitmap(roaring::Roaring({1, 2, 3}));
+   const IndexScan under_test(&test_bitmap, 5);
+
+   ASSERT_EQ(*under_test.evaluate(), test_bitmap);
+   EXPECT_EQ(OperatorProfileScope::current(), nullptr);
+}
@@ -39,7 +39,7 @@ Type RangeSelection::type() const {
    return RANGE_SELECTION;
 }
 
-OperatorResult RangeSelection::evaluate() const {
+OperatorResult RangeSelection::evaluateImpl() const {
    OperatorResult result;
    for (const auto& range : ranges) {
       result->addRange(range.start, range.end);
@@ -17,6 +17,7 @@
 #include "silo/query_engine/operator_result.h"
 #include "silo/query_engine/operators/complement.h"
 #include "silo/query_engine/operators/operator.h"
+#include "silo/query_engine/query_context.h"
 
 namespace silo::query_engine::operators {
 
@@ -89,17 +90,22 @@ bool Selection::matchesPredicates(uint32_t row) const {
    });
 }
 
-OperatorResult Selection::evaluate() const {
+OperatorResult Selection::evaluateImpl() const {
+   QueryContext::checkCurrent();
    OperatorResult result;
    if (child_operator.has_value()) {
       OperatorResult child_result = (*child_operator)->evaluate();
+      uint32_t row_counter = 0;
       for (const uint32_t row : *child_result) {
+         QueryContext::checkCurrentPeriodically(row_counter);
          if (matchesPredicates(row)) {
             result->add(row);
          }
       }
    } else {
+      uint32_t row_counter = 0;
       for (uint32_t row = 0; row < row_count; ++row) {
+         QueryContext::checkCurrentPeriodically(row_counter);
          if (matchesPredicates(row)) {
             result->add(row);
          }
@@ -10,6 +10,7 @@
 #include "silo/query_engine/operators/complement.h"
 #include "silo/query_engine/operators/operator.h"
 #include "silo/query_engine/query_compilation_exception.h"
+#include "silo/query_engine/query_context.h"
 
 namespace silo::query_engine::operators {
 
@@ -61,7 +62,8 @@ Type Threshold::type() const {
    return THRESHOLD;
 }
 
-OperatorResult Threshold::evaluate() const {
+OperatorResult Threshold::evaluateImpl() const {
+   QueryContext::checkCurrent();
    uint32_t dp_table_size;
    if (this->match_exactly) {
       // We need to keep track of the ones that matched too many
@@ -71,10 +73,11 @@ OperatorResult Threshold::evaluate() const {
    }
    std::vector<roaring::Roaring> partition_bitmaps(dp_table_size);
    // Copy bitmap of first child if immutable, otherwise use it directly
-   if (non_negated_children.empty()) {
-      partition_bitmaps[0] = *negated_children[0]->evaluate();
-   } else {
-      partition_bitmaps[0] = *non_negated_children[0]->evaluate();
+   {
+      OperatorResult first_child_result = non_negated_children.empty()
+                                             ? negated_children[0]->evaluate()
+                                             : non_negated_children[0]->evaluate();
+      partition_bitmaps[0] = std::move(*first_child_result);
    }
 
    if (non_negated_children.empty()) {
@@ -91,6 +94,7 @@ OperatorResult Threshold::evaluate() const {
    );  // Number of loop iterations
 
    for (int i = 1; i < non_negated_child_count; ++i) {
+      QueryContext::checkCurrent();
       auto bitmap = non_negated_children[i]->evaluate();
       // positions higher than (i-1) cannot have been reached yet, are therefore all 0s and the
       // conjunction would return 0
@@ -112,6 +116,7 @@ OperatorResult Threshold::evaluate() const {
    // (Number of children left is less than the distance we need to cross to reach the result)
    const int took_first_offset = non_negated_children.empty() ? 1 : 0;
    for (int local_i = took_first_offset; local_i < negated_child_count; ++local_i) {
+      QueryContext::checkCurrent();
       auto bitmap = negated_children[local_i]->evaluate();
       const int i = local_i + non_negated_child_count;
       // positions higher than (i-1) cannot have been reached yet, are therefore all 0s and the
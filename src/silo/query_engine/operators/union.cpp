@@ -9,6 +9,7 @@
 #include "silo/query_engine/operator_result.h"
 #include "silo/query_engine/operators/complement.h"
 #include "silo/query_engine/operators/operator.h"
+#include "silo/query_engine/query_context.h"
 
 namespace silo::query_engine::operators {
 
@@ -32,14 +33,16 @@ Type Union::type() const {
    return UNION;
 }
 
-OperatorResult Union::evaluate() const {
+OperatorResult Union::evaluateImpl() const {
+   QueryContext::checkCurrent();
    const uint32_t size_of_children = children.size();
    std::vector<const roaring::Roaring*> union_tmp(size_of_children);
-   std::vector<OperatorResult> child_res(size_of_children);
+   // Not default-constructed, because an empty OperatorResult allocates a bitmap
+   std::vector<OperatorResult> child_res;
+   child_res.reserve(size_of_children);
    for (uint32_t i = 0; i < size_of_children; i++) {
-      child_res[i] = children[i]->evaluate();
-      const roaring::Roaring& const_bitmap = *child_res[i];
-      union_tmp[i] = &const_bitmap;
+      const OperatorResult& child_result = child_res.emplace_back(children[i]->evaluate());
+      union_tmp[i] = &*child_result;
    }
    return OperatorResult(roaring::Roaring::fastunion(union_tmp.size(), union_tmp.data()));
 }
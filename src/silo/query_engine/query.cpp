@@ -10,21 +10,75 @@
 
 namespace silo::query_engine {
 
-Query::Query(const std::string& query_string) {
+namespace {
+
+nlohmann::json parseJson(const std::string& query_string) {
+   try {
+      return nlohmann::json::parse(query_string);
+   } catch (const nlohmann::json::parse_error& ex) {
+      throw QueryParseException("The query was not a valid JSON: " + std::string(ex.what()));
+   }
+}
+
+}  // namespace
+
+Query::Query(const std::string& query_string)
+    : Query(parseJson(query_string)) {}
+
+Query::Query(const nlohmann::json& json) {
    try {
-      nlohmann::json json = nlohmann::json::parse(query_string);
+      const bool has_action = json.contains("action") && json["action"].is_object();
+      const bool has_actions = json.contains("actions") && json["actions"].is_array();
       if (!json.contains("filterExpression") || !json["filterExpression"].is_object() ||
-          !json.contains("action") || !json["action"].is_object()) {
+          (!has_action && !has_actions)) {
          throw QueryParseException("Query json must contain filterExpression and action.");
       }
+      CHECK_SILO_QUERY(
+         !(json.contains("action") && json.contains("actions")),
+         "Query json must contain either the field action or the field actions, but not both."
+      )
       filter = json["filterExpression"]
                   .get<std::unique_ptr<silo::query_engine::filter_expressions::Expression>>();
-      action = json["action"].get<std::unique_ptr<silo::query_engine::actions::Action>>();
-   } catch (const nlohmann::json::parse_error& ex) {
-      throw QueryParseException("The query was not a valid JSON: " + std::string(ex.what()));
+      if (has_action) {
+         actions.emplace_back(
+            json["action"].get<std::unique_ptr<silo::query_engine::actions::Action>>()
+         );
+         return;
+      }
+      CHECK_SILO_QUERY(
+         !json["actions"].empty(), "The field actions of a query must not be an empty array."
+      )
+      for (const auto& action_json : json["actions"]) {
+         CHECK_SILO_QUERY(
+            action_json.is_object(),
+            "All entries of the field actions must be objects, but found: " + action_json.dump()
+         )
+         actions.emplace_back(action_json.get<std::unique_ptr<silo::query_engine::actions::Action>>()
+         );
+      }
+      is_multi_action = true;
    } catch (const nlohmann::json::exception& ex) {
       throw QueryParseException("The query was not a valid JSON: " + std::string(ex.what()));
    }
 }
 
-}  // namespace silo::query_engine
\ No newline at end of file
+BatchQuery::BatchQuery(const std::string& batch_query_string) {
+   const nlohmann::json json = parseJson(batch_query_string);
+   CHECK_SILO_QUERY(
+      json.is_object() && json.contains("queries") && json["queries"].is_array(),
+      "Batch query json must contain the field queries, which must be an array."
+   )
+   CHECK_SILO_QUERY(
+      !json["queries"].empty(), "The field queries of a batch query must not be an empty array."
+   )
+   queries.reserve(json["queries"].size());
+   for (const auto& query_json : json["queries"]) {
+      CHECK_SILO_QUERY(
+         query_json.is_object(),
+         "All entries of the field queries must be objects, but found: " + query_json.dump()
+      )
+      queries.emplace_back(query_json);
+   }
+}
+
+}  // namespace silo::query_engine
@@ -0,0 +1,94 @@
+#include "silo/query_engine/query.h"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "silo/query_engine/query_parse_exception.h"
+
+using silo::query_engine::Query;
+
+TEST(Query, shouldParseQueryWithSingleAction) {
+   const Query under_test(R"({
+      "action": {"type": "Aggregated"},
+      "filterExpression": {"type": "True"}
+   })");
+
+   EXPECT_EQ(under_test.actions.size(), 1);
+   EXPECT_FALSE(under_test.is_multi_action);
+}
+
+TEST(Query, shouldParseQueryWithListOfActions) {
+   const Query under_test(R"({
+      "actions": [
+         {"type": "Aggregated", "groupByFields": ["country"]},
+         {"type": "Mutations", "minProportion": 0.05}
+      ],
+      "filterExpression": {"type": "True"}
+   })");
+
+   EXPECT_EQ(under_test.actions.size(), 2);
+   EXPECT_TRUE(under_test.is_multi_action);
+}
+
+TEST(Query, shouldThrowWhenQueryContainsActionAndActions) {
+   EXPECT_THAT(
+      []() {
+         const Query under_test(R"({
+            "action": {"type": "Aggregated"},
+            "actions": [{"type": "Aggregated"}],
+            "filterExpression": {"type": "True"}
+         })");
+      },
+      ThrowsMessage<silo::QueryParseException>(::testing::HasSubstr("but not both"))
+   );
+}
+
+TEST(Query, shouldThrowWhenActionsIsEmpty) {
+   EXPECT_THAT(
+      []() {
+         const Query under_test(R"({
+            "actions": [],
+            "filterExpression": {"type": "True"}
+         })");
+      },
+      ThrowsMessage<silo::QueryParseException>(::testing::HasSubstr("must not be an empty array"))
+   );
+}
+
+TEST(BatchQuery, shouldParseAllQueries) {
+   const silo::query_engine::BatchQuery under_test(R"({
+      "queries": [
+         {"action": {"type": "Aggregated"}, "filterExpression": {"type": "True"}},
+         {"actions": [{"type": "Aggregated"}], "filterExpression": {"type": "False"}}
+      ]
+   })");
+
+   ASSERT_EQ(under_test.queries.size(), 2);
+   EXPECT_FALSE(under_test.queries[0].is_multi_action);
+   EXPECT_TRUE(under_test.queries[1].is_multi_action);
+}
+
+TEST(BatchQuery, shouldThrowWhenQueriesAreMissing) {
+   EXPECT_THAT(
+      []() { const silo::query_engine::BatchQuery under_test(R"({"query": []})"); },
+      ThrowsMessage<silo::QueryParseException>(
+         ::testing::HasSubstr("must contain the field queries")
+      )
+   );
+}
+
+TEST(BatchQuery, shouldThrowWhenOneQueryIsInvalid) {
+   EXPECT_THAT(
+      []() {
+         const silo::query_engine::BatchQuery under_test(R"({
+            "queries": [
+               {"action": {"type": "Aggregated"}, "filterExpression": {"type": "True"}},
+               {"filterExpression": {"type": "True"}}
+            ]
+         })");
+      },
+      ThrowsMessage<silo::QueryParseException>(
+         ::testing::HasSubstr("must contain filterExpression and action")
+      )
+   );
+}
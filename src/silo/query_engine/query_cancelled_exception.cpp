@@ -0,0 +1,9 @@
+#include "silo/query_engine/query_cancelled_exception.h"
+
+#include <stdexcept>
+#include <string>
+
+namespace silo {
+QueryCancelledException::QueryCancelledException(const std::string& error_message)
+    : std::runtime_error(error_message.c_str()) {}
+}  // namespace silo
@@ -0,0 +1,112 @@
+#include "silo/query_engine/query_context.h"
+
+#include <string>
+#include <utility>
+
+#include <fmt/format.h>
+
+#include "silo/query_engine/query_cancelled_exception.h"
+
+namespace silo::query_engine {
+
+namespace {
+
+thread_local const QueryContext* current_context = nullptr;
+
+}  // namespace
+
+QueryContext::Scope::Scope(const QueryContext* context)
+    : previous(current_context) {
+   current_context = context;
+}
+
+QueryContext::Scope::~Scope() {
+   current_context = previous;
+}
+
+QueryContext::QueryContext(std::optional<std::chrono::milliseconds> timeout)
+    : timeout(timeout) {
+   if (timeout.has_value()) {
+      deadline = Clock::now() + *timeout;
+   }
+}
+
+void QueryContext::setClientDisconnectCheck(std::function<bool()> is_client_disconnected) {
+   this->is_client_disconnected = std::move(is_client_disconnected);
+}
+
+void QueryContext::setReason(CancellationReason new_reason) const {
+   // The first reason wins, later checks must not overwrite it
+   auto expected = CancellationReason::NONE;
+   reason.compare_exchange_strong(expected, new_reason);
+}
+
+void QueryContext::cancel() const {
+   setReason(CancellationReason::CANCELLED);
+}
+
+std::optional<QueryContext::Clock::time_point> QueryContext::getDeadline() const {
+   return deadline;
+}
+
+bool QueryContext::isCancelled() const {
+   if (reason.load(std::memory_order_relaxed) != CancellationReason::NONE) {
+      return true;
+   }
+   if (!deadline.has_value() && !is_client_disconnected) {
+      return false;
+   }
+   const auto now = Clock::now();
+   if (deadline.has_value() && now >= *deadline) {
+      setReason(CancellationReason::DEADLINE_EXCEEDED);
+      return true;
+   }
+   if (is_client_disconnected) {
+      auto next_check = next_disconnect_check.load(std::memory_order_relaxed);
+      const auto now_ticks = now.time_since_epoch().count();
+      // Only the thread that moves the next check forward probes the connection
+      if (now_ticks >= next_check &&
+          next_disconnect_check.compare_exchange_strong(
+             next_check, (now + DISCONNECT_CHECK_INTERVAL).time_since_epoch().count()
+          ) &&
+          is_client_disconnected()) {
+         setReason(CancellationReason::CLIENT_DISCONNECTED);
+         return true;
+      }
+   }
+   return false;
+}
+
+CancellationReason QueryContext::getCancellationReason() const {
+   return reason.load();
+}
+
+void QueryContext::checkCancellation() const {
+   if (!isCancelled()) {
+      return;
+   }
+   switch (getCancellationReason()) {
+      case CancellationReason::DEADLINE_EXCEEDED:
+         throw QueryCancelledException(fmt::format(
+            "The query exceeded its timeout of {} milliseconds",
+            timeout.value_or(std::chrono::milliseconds{0}).count()
+         ));
+      case CancellationReason::CLIENT_DISCONNECTED:
+         throw QueryCancelledException("The client closed the connection");
+      case CancellationReason::NONE:
+      case CancellationReason::CANCELLED:
+         throw QueryCancelledException("The query was cancelled");
+   }
+}
+
+const QueryContext* QueryContext::current() {
+   return current_context;
+}
+
+void QueryContext::checkCurrent() {
+   if (current_context != nullptr) {
+      current_context->checkCancellation();
+   }
+}
+
+}  // namespace silo::query_engine
@@ -0,0 +1,65 @@
+#include "silo/query_engine/query_context.h"
+
+#include <chrono>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include "silo/query_engine/query_cancelled_exception.h"
+
+using silo::query_engine::CancellationReason;
+using silo::query_engine::QueryContext;
+
+TEST(QueryContext, isNotCancelledWithoutDeadline) {
+   const QueryContext under_test;
+
+   EXPECT_FALSE(under_test.isCancelled());
+   EXPECT_NO_THROW(under_test.checkCancellation());
+   EXPECT_EQ(under_test.getCancellationReason(), CancellationReason::NONE);
+}
+
+TEST(QueryContext, isCancelledAfterTheDeadline) {
+   const QueryContext under_test(std::chrono::milliseconds{1});
+
+   std::this_thread::sleep_for(std::chrono::milliseconds{5});
+
+   EXPECT_TRUE(under_test.isCancelled());
+   EXPECT_EQ(under_test.getCancellationReason(), CancellationReason::DEADLINE_EXCEEDED);
+   EXPECT_THROW(under_test.checkCancellation(), silo::QueryCancelledException);
+}
+
+TEST(QueryContext, keepsTheFirstCancellationReason) {
+   const QueryContext under_test(std::chrono::milliseconds{1});
+   under_test.cancel();
+
+   std::this_thread::sleep_for(std::chrono::milliseconds{5});
+
+   EXPECT_TRUE(under_test.isCancelled());
+   EXPECT_EQ(under_test.getCancellationReason(), CancellationReason::CANCELLED);
+}
+
+TEST(QueryContext, isCancelledWhenTheClientDisconnected) {
+   QueryContext under_test;
+   bool disconnected = false;
+   under_test.setClientDisconnectCheck([&]() { return disconnected; });
+
+   EXPECT_FALSE(under_test.isCancelled());
+   disconnected = true;
+   std::this_thread::sleep_for(QueryContext::DISCONNECT_CHECK_INTERVAL);
+
+   EXPECT_TRUE(under_test.isCancelled());
+   EXPECT_EQ(under_test.getCancellationReason(), CancellationReason::CLIENT_DISCONNECTED);
+}
+
+TEST(QueryContext, checksTheContextOfTheCurrentScope) {
+   const QueryContext cancelled;
+   cancelled.cancel();
+
+   EXPECT_NO_THROW(QueryContext::checkCurrent());
+   {
+      const QueryContext::Scope scope(&cancelled);
+      EXPECT_EQ(QueryContext::current(), &cancelled);
+      EXPECT_THROW(QueryContext::checkCurrent(), silo::QueryCancelledException);
+   }
+   EXPECT_EQ(QueryContext::current(), nullptr);
+}
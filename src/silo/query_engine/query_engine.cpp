@@ -1,21 +1,34 @@
 #include "silo/query_engine/query_engine.h"
 
+#include <algorithm>
+#include <map>
 #include <memory>
+#include <optional>
 #include <string>
 #include <utility>
 #include <vector>
 
+#include <oneapi/tbb/blocked_range.h>
 #include <oneapi/tbb/parallel_for.h>
 #include <spdlog/spdlog.h>
 
 #include "silo/common/block_timer.h"
 #include "silo/common/log.h"
+#include "silo/common/metrics.h"
+#include "silo/common/numa.h"
+#include "silo/common/perf_counters.h"
 #include "silo/database.h"
 #include "silo/query_engine/filter_expressions/expression.h"
+#include "silo/query_engine/filter_expressions/false.h"
+#include "silo/query_engine/filter_expressions/shared_subexpression.h"
+#include "silo/query_engine/filter_expressions/true.h"
 #include "silo/query_engine/operator_result.h"
 #include "silo/query_engine/operators/operator.h"
 #include "silo/query_engine/query.h"
+#include "silo/query_engine/query_context.h"
+#include "silo/query_engine/query_profile.h"
 #include "silo/query_engine/query_result.h"
+#include "silo/roaring/roaring_allocator.h"
 
 #define CHECK_SILO_QUERY(condition, message)    \
    if (!(condition)) {                          \
@@ -27,26 +40,297 @@ namespace silo::query_engine {
 QueryEngine::QueryEngine(const silo::Database& database)
     : database(database) {}
 
+namespace {
+
+/// Creates immutable views on the partition filters, which stay owned by the caller.
+/// Actions that need to modify their filter will copy it on write.
+std::vector<OperatorResult> createFilterViews(const std::vector<OperatorResult>& partition_filters
+) {
+   std::vector<OperatorResult> filter_views;
+   filter_views.reserve(partition_filters.size());
+   for (const OperatorResult& partition_filter : partition_filters) {
+      filter_views.emplace_back(*partition_filter);
+   }
+   return filter_views;
+}
+
+/// Counts include the allocations of queries running at the same time. The intermediate bitmaps
+/// of the query are dropped by now, so the pools of the calling thread are reset afterwards
+void logRoaringAllocations(const RoaringAllocationStatistics& allocations_before) {
+   const auto allocations = getRoaringAllocationStatistics() - allocations_before;
+   LOG_PERFORMANCE(
+      "Bitmap allocations: {} ({} bytes)", allocations.allocation_count, allocations.allocated_bytes
+   );
+   releaseThreadRoaringMemory();
+}
+
+void countResultRows(const actions::Action& action, size_t row_count) {
+   MetricRegistry::get()
+      .counter(
+         "silo_query_result_rows_total",
+         "Number of rows returned by actions, by action type",
+         {{"action", action.getType()}}
+      )
+      .increment(static_cast<double>(row_count));
+}
+
+void countResultRows(const Query& query, const QueryResult& result) {
+   if (!query.is_multi_action) {
+      countResultRows(*query.actions.front(), result.query_result.size());
+      return;
+   }
+   for (size_t action_index = 0; action_index < query.actions.size(); ++action_index) {
+      countResultRows(
+         *query.actions[action_index], result.query_results_per_action->at(action_index).size()
+      );
+   }
+}
+
+QueryResult executeAction(
+   const Database& database,
+   const actions::Action& action,
+   std::vector<OperatorResult> partition_filters,
+   ActionProfile* profile
+) {
+   if (profile == nullptr) {
+      return action.executeAndOrder(database, std::move(partition_filters));
+   }
+   profile->type = action.getType();
+   const ActionProfileScope scope(profile);
+   QueryResult result;
+   {
+      const BlockTimer timer(profile->time_in_microseconds);
+      result = action.executeAndOrder(database, std::move(partition_filters));
+   }
+   profile->result_row_count = result.query_result.size();
+   return result;
+}
+
+/// Queries with an "actions" list are attributed to the action type "Multiple"
+void recordQueryDurations(const Query& query, int64_t filter_time, int64_t action_time) {
+   auto& registry = MetricRegistry::get();
+   const std::string action_type =
+      query.is_multi_action ? "Multiple" : query.actions.front()->getType();
+   registry
+      .histogram(
+         "silo_query_duration_seconds",
+         "Time to evaluate the filter and execute the actions of a query, by action type",
+         {{"action", action_type}}
+      )
+      .observe(microsecondsToSeconds(filter_time + action_time));
+   const std::string phase_help = "Time spent in the filter and in the action phase of queries";
+   registry.histogram("silo_query_phase_duration_seconds", phase_help, {{"phase", "filter"}})
+      .observe(microsecondsToSeconds(filter_time));
+   registry.histogram("silo_query_phase_duration_seconds", phase_help, {{"phase", "action"}})
+      .observe(microsecondsToSeconds(action_time));
+}
+
+/// The counters are only logged if they are enabled
+std::optional<PerfCounterValues> logPerfCounters(
+   const std::string& phase,
+   const PerfCounterAccumulator& accumulator
+) {
+   if (!PerfCounters::isEnabled()) {
+      return std::nullopt;
+   }
+   const auto values = accumulator.get();
+   LOG_PERFORMANCE("Performance counters ({}): {}", phase, values);
+   return values;
+}
+
+/// Exports return rows of the database rather than aggregates, so their cost grows with the
+/// matched rows and repeating them does not warm up any shared state
+bool isExportAction(const actions::Action& action) {
+   const std::string& type = action.getType();
+   return type == "Details" || type == "Fasta" || type == "FastaAligned";
+}
+
+using filter_expressions::Expression;
+
+void countSubexpressions(
+   std::unique_ptr<Expression>& expression,
+   std::map<std::string, size_t>& occurrences
+) {
+   ++occurrences[expression->canonical_json];
+   expression->visitChildren([&](std::unique_ptr<Expression>& child) {
+      countSubexpressions(child, occurrences);
+   });
+}
+
+bool isTrivial(const Expression& expression) {
+   return expression.canonical_json.empty() ||
+          dynamic_cast<const filter_expressions::True*>(&expression) != nullptr ||
+          dynamic_cast<const filter_expressions::False*>(&expression) != nullptr;
+}
+
+size_t replaceSharedSubexpressions(
+   std::unique_ptr<Expression>& expression,
+   const std::map<std::string, size_t>& occurrences,
+   std::map<std::string, std::shared_ptr<filter_expressions::SubexpressionCache>>& caches
+) {
+   const std::string& key = expression->canonical_json;
+   if (occurrences.at(key) > 1 && !isTrivial(*expression)) {
+      auto& cache = caches[key];
+      const bool is_new_cache = cache == nullptr;
+      if (is_new_cache) {
+         cache = std::make_shared<filter_expressions::SubexpressionCache>();
+      }
+      expression =
+         std::make_unique<filter_expressions::SharedSubexpression>(std::move(expression), cache);
+      return is_new_cache ? 1 : 0;
+   }
+   size_t shared_count = 0;
+   expression->visitChildren([&](std::unique_ptr<Expression>& child) {
+      shared_count += replaceSharedSubexpressions(child, occurrences, caches);
+   });
+   return shared_count;
+}
+
+/// Replaces the largest subexpressions that occur more than once in the batch by shared
+/// subexpressions, which are evaluated at most once per partition.
+/// Returns the number of distinct shared subexpressions
+size_t shareCommonSubexpressions(std::vector<Query>& queries) {
+   std::map<std::string, size_t> occurrences;
+   for (Query& query : queries) {
+      countSubexpressions(query.filter, occurrences);
+   }
+   std::map<std::string, std::shared_ptr<filter_expressions::SubexpressionCache>> caches;
+   size_t shared_count = 0;
+   for (Query& query : queries) {
+      shared_count += replaceSharedSubexpressions(query.filter, occurrences, caches);
+   }
+   return shared_count;
+}
+
+}  // namespace
+
+QueryResult QueryEngine::executeActions(
+   const Query& query,
+   std::vector<OperatorResult> partition_filters,
+   std::vector<ActionProfile>* action_profiles
+) const {
+   if (action_profiles != nullptr) {
+      action_profiles->resize(query.actions.size());
+   }
+   const auto action_profile = [&](size_t action_index) {
+      return action_profiles == nullptr ? nullptr : &action_profiles->at(action_index);
+   };
+
+   if (!query.is_multi_action) {
+      return executeAction(
+         database, *query.actions.front(), std::move(partition_filters), action_profile(0)
+      );
+   }
+
+   // The filters are shared by all actions, therefore optimize them once up front
+   for (OperatorResult& partition_filter : partition_filters) {
+      if (partition_filter.isMutable()) {
+         partition_filter->runOptimize();
+      }
+   }
+
+   std::vector<std::vector<QueryResultEntry>> results_per_action(query.actions.size());
+   const QueryContext* query_context = QueryContext::current();
+   PerfCounterAccumulator* perf_counters = PerfCounterBlock::current();
+   tbb::parallel_for(
+      tbb::blocked_range<size_t>(0, query.actions.size()),
+      [&](const auto& local) {
+         const QueryContext::Scope scope(query_context);
+         const PerfCounterBlock perf_counter_block(perf_counters);
+         for (size_t action_index = local.begin(); action_index != local.end(); ++action_index) {
+            results_per_action[action_index] =
+               executeAction(
+                  database,
+                  *query.actions[action_index],
+                  createFilterViews(partition_filters),
+                  action_profile(action_index)
+               )
+                  .query_result;
+         }
+      }
+   );
+
+   QueryResult query_result;
+   query_result.query_results_per_action = std::move(results_per_action);
+   return query_result;
+}
+
 QueryResult QueryEngine::executeQuery(const std::string& query_string) const {
+   return runQuery(query_string, nullptr, true);
+}
+
+bool QueryEngine::warmUpQuery(const std::string& query_string) const {
+   const Query query(query_string);
+   const bool exports_rows =
+      std::any_of(query.actions.begin(), query.actions.end(), [](const auto& action) {
+         return isExportAction(*action);
+      });
+   if (exports_rows) {
+      return false;
+   }
+   runQuery(query_string, nullptr, false);
+   return true;
+}
+
+QueryProfile QueryEngine::explainQuery(const std::string& query_string) const {
+   QueryProfile profile;
+   runQuery(query_string, &profile, true);
+   return profile;
+}
+
+QueryResult QueryEngine::runQuery(
+   const std::string& query_string,
+   QueryProfile* profile,
+   bool is_recorded
+) const {
+   const auto allocations_before = getRoaringAllocationStatistics();
    Query query(query_string);
 
    SPDLOG_DEBUG("Parsed query: {}", query.filter->toString(database));
 
+   if (profile != nullptr) {
+      profile->filter = query.filter->toString(database);
+      profile->partitions.resize(database.partitions.size());
+   }
+
    std::vector<std::string> compiled_queries(database.partitions.size());
    std::vector<silo::query_engine::OperatorResult> partition_filters(database.partitions.size());
+   PerfCounterAccumulator filter_perf_counters;
    int64_t filter_time;
    {
       const BlockTimer timer(filter_time);
-      for (size_t partition_index = 0; partition_index != database.partitions.size();
-           partition_index++) {
-         std::unique_ptr<operators::Operator> part_filter = query.filter->compile(
-            database,
-            database.partitions[partition_index],
-            silo::query_engine::filter_expressions::Expression::AmbiguityMode::NONE
-         );
+      const QueryContext* query_context = QueryContext::current();
+      NumaNodes::get().parallelFor(database.getPartitionNumaNodes(), [&](size_t partition_index) {
+         const QueryContext::Scope scope(query_context);
+         const PerfCounterBlock perf_counter_block(&filter_perf_counters);
+         QueryContext::checkCurrent();
+         int64_t compilation_time;
+         std::unique_ptr<operators::Operator> part_filter;
+         {
+            const BlockTimer compilation_timer(compilation_time);
+            part_filter = query.filter->compile(
+               database,
+               database.partitions[partition_index],
+               silo::query_engine::filter_expressions::Expression::AmbiguityMode::NONE
+            );
+         }
          compiled_queries[partition_index] = part_filter->toString();
-         partition_filters[partition_index] = part_filter->evaluate();
-      }
+         if (profile == nullptr) {
+            partition_filters[partition_index] = part_filter->evaluate();
+            return;
+         }
+         auto& partition_profile = profile->partitions[partition_index];
+         partition_profile.partition_index = static_cast<uint32_t>(partition_index);
+         partition_profile.sequence_count = database.partitions[partition_index].sequence_count;
+         partition_profile.compilation_time_in_microseconds = compilation_time;
+         // The root operator is added as the only child of this placeholder
+         OperatorProfile root;
+         {
+            const OperatorProfileScope scope(&root);
+            partition_filters[partition_index] = part_filter->evaluate();
+         }
+         partition_profile.filter = std::move(root.children.front());
+      });
    }
 
    for (uint32_t i = 0; i < database.partitions.size(); ++i) {
@@ -54,17 +338,105 @@ QueryResult QueryEngine::executeQuery(const std::string& query_string) const {
    }
 
    QueryResult query_result;
+   PerfCounterAccumulator action_perf_counters;
    int64_t action_time;
    {
       const BlockTimer timer(action_time);
-      query_result = query.action->executeAndOrder(database, std::move(partition_filters));
+      const PerfCounterBlock perf_counter_block(&action_perf_counters);
+      QueryContext::checkCurrent();
+      query_result = executeActions(
+         query, std::move(partition_filters), profile == nullptr ? nullptr : &profile->actions
+      );
+   }
+
+   if (!is_recorded) {
+      releaseThreadRoaringMemory();
+      return query_result;
    }
 
    LOG_PERFORMANCE("Query: {}", query_string);
+   LOG_PERFORMANCE("Number of actions: {}", query.actions.size());
    LOG_PERFORMANCE("Execution (filter): {} microseconds", std::to_string(filter_time));
    LOG_PERFORMANCE("Execution (action): {} microseconds", std::to_string(action_time));
+   recordQueryDurations(query, filter_time, action_time);
+   countResultRows(query, query_result);
+   auto filter_perf_counter_values = logPerfCounters("filter", filter_perf_counters);
+   auto action_perf_counter_values = logPerfCounters("action", action_perf_counters);
+   logRoaringAllocations(allocations_before);
+
+   if (profile != nullptr) {
+      profile->filter_time_in_microseconds = filter_time;
+      profile->action_time_in_microseconds = action_time;
+      profile->filter_perf_counters = filter_perf_counter_values;
+      profile->action_perf_counters = action_perf_counter_values;
+   }
 
    return query_result;
 }
 
+std::vector<QueryResult> QueryEngine::executeBatchQuery(const std::string& batch_query_string
+) const {
+   const auto allocations_before = getRoaringAllocationStatistics();
+   BatchQuery batch_query(batch_query_string);
+   auto& queries = batch_query.queries;
+
+   const size_t shared_subexpression_count = shareCommonSubexpressions(queries);
+
+   std::vector<std::vector<OperatorResult>> partition_filters_per_query(queries.size());
+   for (auto& partition_filters : partition_filters_per_query) {
+      partition_filters.resize(database.partitions.size());
+   }
+   const QueryContext* query_context = QueryContext::current();
+   PerfCounterAccumulator filter_perf_counters;
+   int64_t filter_time;
+   {
+      const BlockTimer timer(filter_time);
+      NumaNodes::get().parallelFor(database.getPartitionNumaNodes(), [&](size_t partition_index) {
+         const QueryContext::Scope scope(query_context);
+         const PerfCounterBlock perf_counter_block(&filter_perf_counters);
+         for (size_t query_index = 0; query_index < queries.size(); ++query_index) {
+            partition_filters_per_query[query_index][partition_index] =
+               queries[query_index]
+                  .filter
+                  ->compile(
+                     database,
+                     database.partitions[partition_index],
+                     filter_expressions::Expression::AmbiguityMode::NONE
+                  )
+                  ->evaluate();
+         }
+      });
+   }
+
+   std::vector<QueryResult> query_results(queries.size());
+   PerfCounterAccumulator action_perf_counters;
+   int64_t action_time;
+   {
+      const BlockTimer timer(action_time);
+      tbb::parallel_for(tbb::blocked_range<size_t>(0, queries.size()), [&](const auto& local) {
+         const QueryContext::Scope scope(query_context);
+         const PerfCounterBlock perf_counter_block(&action_perf_counters);
+         for (size_t query_index = local.begin(); query_index != local.end(); ++query_index) {
+            query_results[query_index] = executeActions(
+               queries[query_index], std::move(partition_filters_per_query[query_index]), nullptr
+            );
+         }
+      });
+   }
+
+   for (size_t query_index = 0; query_index < queries.size(); ++query_index) {
+      countResultRows(queries[query_index], query_results[query_index]);
+   }
+   LOG_PERFORMANCE("Batch query: {}", batch_query_string);
+   LOG_PERFORMANCE("Number of queries: {}", queries.size());
+   LOG_PERFORMANCE("Number of shared subexpressions: {}", shared_subexpression_count);
+   LOG_PERFORMANCE("Execution (filter): {} microseconds", std::to_string(filter_time));
+   LOG_PERFORMANCE("Execution (action): {} microseconds", std::to_string(action_time));
+   logPerfCounters("filter", filter_perf_counters);
+   logPerfCounters("action", action_perf_counters);
+   logRoaringAllocations(allocations_before);
+
+   return query_results;
+}
+
 }  // namespace silo::query_engine
@@ -0,0 +1,116 @@
+#include "silo/query_engine/query_profile.h"
+
+#include <nlohmann/json.hpp>
+
+namespace silo::query_engine {
+
+namespace {
+
+thread_local OperatorProfile* current_operator_profile = nullptr;
+thread_local ActionProfile* current_action_profile = nullptr;
+
+}  // namespace
+
+OperatorProfileScope::OperatorProfileScope(OperatorProfile* parent)
+    : previous(current_operator_profile) {
+   current_operator_profile = parent;
+}
+
+OperatorProfileScope::~OperatorProfileScope() {
+   current_operator_profile = previous;
+}
+
+OperatorProfile* OperatorProfileScope::current() {
+   return current_operator_profile;
+}
+
+ActionProfileScope::ActionProfileScope(ActionProfile* profile)
+    : previous(current_action_profile) {
+   current_action_profile = profile;
+}
+
+ActionProfileScope::~ActionProfileScope() {
+   current_action_profile = previous;
+}
+
+ActionProfile* ActionProfileScope::current() {
+   return current_action_profile;
+}
+
+ActionPhaseTimer::ActionPhaseTimer(const char* name)
+    : profile(current_action_profile),
+      name(name),
+      start(std::chrono::steady_clock::now()) {}
+
+ActionPhaseTimer::~ActionPhaseTimer() {
+   if (profile == nullptr) {
+      return;
+   }
+   const auto time = std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::steady_clock::now() - start
+   );
+   profile->phases.push_back({name, time.count()});
+}
+
+// NOLINTNEXTLINE(readability-identifier-naming)
+void to_json(nlohmann::json& json, const OperatorProfile& profile) {
+   json = nlohmann::json{
+      {"type", profile.type},
+      {"evaluationTimeInMicroseconds", profile.evaluation_time_in_microseconds},
+      {"cardinality", profile.cardinality},
+      {"isMutable", profile.is_mutable},
+   };
+   if (!profile.expression.empty()) {
+      json["expression"] = profile.expression;
+   }
+   if (!profile.children.empty()) {
+      json["children"] = profile.children;
+   }
+}
+
+// NOLINTNEXTLINE(readability-identifier-naming)
+void to_json(nlohmann::json& json, const PartitionProfile& profile) {
+   json = nlohmann::json{
+      {"partition", profile.partition_index},
+      {"sequenceCount", profile.sequence_count},
+      {"compilationTimeInMicroseconds", profile.compilation_time_in_microseconds},
+      {"filter", profile.filter},
+   };
+}
+
+// NOLINTNEXTLINE(readability-identifier-naming)
+void to_json(nlohmann::json& json, const ActionPhaseProfile& profile) {
+   json = nlohmann::json{
+      {"name", profile.name},
+      {"timeInMicroseconds", profile.time_in_microseconds},
+   };
+}
+
+// NOLINTNEXTLINE(readability-identifier-naming)
+void to_json(nlohmann::json& json, const ActionProfile& profile) {
+   json = nlohmann::json{
+      {"type", profile.type},
+      {"timeInMicroseconds", profile.time_in_microseconds},
+      {"phases", profile.phases},
+      {"resultRowCount", profile.result_row_count},
+   };
+}
+
+// NOLINTNEXTLINE(readability-identifier-naming)
+void to_json(nlohmann::json& json, const QueryProfile& profile) {
+   json = nlohmann::json{
+      {"filter", profile.filter},
+      {"filterTimeInMicroseconds", profile.filter_time_in_microseconds},
+      {"actionTimeInMicroseconds", profile.action_time_in_microseconds},
+      {"partitions", profile.partitions},
+      {"actions", profile.actions},
+   };
+   if (profile.filter_perf_counters.has_value()) {
+      json["filterPerfCounters"] = *profile.filter_perf_counters;
+   }
+   if (profile.action_perf_counters.has_value()) {
+      json["actionPerfCounters"] = *profile.action_perf_counters;
+   }
+}
+
+}  // namespace silo::query_engine
@@ -8,6 +8,12 @@ namespace silo::query_engine {
 
 // NOLINTNEXTLINE(readability-identifier-naming)
 void to_json(nlohmann::json& json, const QueryResult& query_result) {
+   if (query_result.query_results_per_action.has_value()) {
+      json = nlohmann::json{
+         {"queryResults", query_result.query_results_per_action.value()},
+      };
+      return;
+   }
    json = nlohmann::json{
       {"queryResult", query_result.query_result},
    };
@@ -0,0 +1,104 @@
+#include "silo/roaring/roaring_allocator.h"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+
+#include <oneapi/tbb/scalable_allocator.h>
+#include <roaring/memory.h>
+
+namespace {
+
+/// Allocations are counted in one slot per thread, so that the threads do not contend for a shared
+/// counter. Threads share a slot if there are more threads than slots
+constexpr size_t COUNTER_SLOT_COUNT = 256;
+constexpr size_t CACHE_LINE_SIZE = 64;
+
+struct alignas(CACHE_LINE_SIZE) CounterSlot {
+   std::atomic<uint64_t> allocation_count{0};
+   std::atomic<uint64_t> allocated_bytes{0};
+};
+
+std::array<CounterSlot, COUNTER_SLOT_COUNT> counter_slots;
+std::atomic<size_t> next_counter_slot{0};
+std::atomic<bool> allocator_installed{false};
+
+void countAllocation(size_t size) {
+   thread_local CounterSlot& slot =
+      counter_slots[next_counter_slot.fetch_add(1, std::memory_order_relaxed) % COUNTER_SLOT_COUNT];
+   slot.allocation_count.fetch_add(1, std::memory_order_relaxed);
+   slot.allocated_bytes.fetch_add(size, std::memory_order_relaxed);
+}
+
+void* roaringMalloc(size_t size) {
+   countAllocation(size);
+   return scalable_malloc(size);
+}
+
+void* roaringRealloc(void* pointer, size_t size) {
+   countAllocation(size);
+   return scalable_realloc(pointer, size);
+}
+
+void* roaringCalloc(size_t count, size_t size) {
+   countAllocation(count * size);
+   return scalable_calloc(count, size);
+}
+
+void roaringFree(void* pointer) {
+   scalable_free(pointer);
+}
+
+void* roaringAlignedMalloc(size_t alignment, size_t size) {
+   countAllocation(size);
+   return scalable_aligned_malloc(size, alignment);
+}
+
+void roaringAlignedFree(void* pointer) {
+   scalable_aligned_free(pointer);
+}
+
+}  // namespace
+
+namespace silo {
+
+RoaringAllocationStatistics RoaringAllocationStatistics::operator-(
+   const RoaringAllocationStatistics& other
+) const {
+   return {allocation_count - other.allocation_count, allocated_bytes - other.allocated_bytes};
+}
+
+void installRoaringAllocator() {
+   if (allocator_installed.exchange(true)) {
+      return;
+   }
+   roaring_init_memory_hook({
+      roaringMalloc,
+      roaringRealloc,
+      roaringCalloc,
+      roaringFree,
+      roaringAlignedMalloc,
+      roaringAlignedFree,
+   });
+}
+
+bool isRoaringAllocatorInstalled() {
+   return allocator_installed.load();
+}
+
+RoaringAllocationStatistics getRoaringAllocationStatistics() {
+   RoaringAllocationStatistics statistics{0, 0};
+   for (const auto& slot : counter_slots) {
+      statistics.allocation_count += slot.allocation_count.load(std::memory_order_relaxed);
+      statistics.allocated_bytes += slot.allocated_bytes.load(std::memory_order_relaxed);
+   }
+   return statistics;
+}
+
+void releaseThreadRoaringMemory() {
+   if (allocator_installed.load(std::memory_order_relaxed)) {
+      (void)scalable_allocation_command(TBBMALLOC_CLEAN_THREAD_BUFFERS, nullptr);
+   }
+}
+
+}  // namespace silo
@@ -0,0 +1,38 @@
+#include "silo/roaring/roaring_allocator.h"
+
+#include <gtest/gtest.h>
+#include <roaring/roaring.hh>
+
+using silo::getRoaringAllocationStatistics;
+
+TEST(RoaringAllocator, isInstalledForTheTests) {
+   EXPECT_TRUE(silo::isRoaringAllocatorInstalled());
+}
+
+TEST(RoaringAllocator, countsTheAllocationsOfBitmaps) {
+   const auto before = getRoaringAllocationStatistics();
+
+   roaring::Roaring bitmap;
+   bitmap.addRange(0, 100000);
+   bitmap.add(200000);
+
+   const auto allocations = getRoaringAllocationStatistics() - before;
+   EXPECT_GT(allocations.allocation_count, 0);
+   EXPECT_GT(allocations.allocated_bytes, 0);
+}
+
+TEST(RoaringAllocator, bitmapsRemainUsableAfterReleasingThePools) {
+   roaring::Roaring bitmap({1, 2, 3});
+   {
+      roaring::Roaring temporary = bitmap | roaring::Roaring({70000, 140000});
+      EXPECT_EQ(temporary.cardinality(), 5);
+   }
+
+   silo::releaseThreadRoaringMemory();
+
+   bitmap.addRange(100, 10000);
+   roaring::Roaring copy(bitmap);
+   copy.flip(0, 20000);
+   EXPECT_EQ(bitmap.cardinality(), 3 + 9900);
+   EXPECT_EQ(copy.cardinality(), 20000 - 3 - 9900);
+}
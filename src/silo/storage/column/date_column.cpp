@@ -23,6 +23,10 @@ void DateColumnPartition::reserve(size_t row_count) {
    values.reserve(values.size() + row_count);
 }
 
+void DateColumnPartition::append(const DateColumnPartition& other) {
+   values.insert(values.end(), other.values.begin(), other.values.end());
+}
+
 const std::vector<silo::common::Date>& DateColumnPartition::getValues() const {
    return values;
 }
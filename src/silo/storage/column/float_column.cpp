@@ -21,6 +21,10 @@ void FloatColumnPartition::insert(const std::string& value) {
    values.push_back(double_value);
 }
 
+void FloatColumnPartition::insert(double value) {
+   values.push_back(value);
+}
+
 void FloatColumnPartition::insertNull() {
    values.push_back(std::nan(""));
 }
@@ -29,6 +33,10 @@ void FloatColumnPartition::reserve(size_t row_count) {
    values.reserve(values.size() + row_count);
 }
 
+void FloatColumnPartition::append(const FloatColumnPartition& other) {
+   values.insert(values.end(), other.values.begin(), other.values.end());
+}
+
 FloatColumn::FloatColumn() = default;
 
 FloatColumnPartition& FloatColumn::createPartition() {
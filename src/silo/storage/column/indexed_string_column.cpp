@@ -11,6 +11,14 @@ IndexedStringColumnPartition::IndexedStringColumnPartition(
 )
     : lookup(lookup) {}
 
+void IndexedStringColumnPartition::append(const IndexedStringColumnPartition& other) {
+   value_ids.reserve(value_ids.size() + other.value_ids.size());
+   for (const Idx value_id : other.value_ids) {
+      indexed_values[value_id].add(value_ids.size());
+      value_ids.push_back(value_id);
+   }
+}
+
 std::optional<const roaring::Roaring*> IndexedStringColumnPartition::filter(const std::string& value
 ) const {
    const auto value_id = lookup.getId(value);
@@ -50,4 +58,16 @@ IndexedStringColumnPartition& IndexedStringColumn::createPartition() {
    return partitions.emplace_back(*lookup);
 }
 
+void IndexedStringColumn::prefillDictionary(const std::vector<std::optional<std::string>>& values
+) {
+   IndexedStringColumnPartition scratch_partition(*lookup);
+   for (const auto& value : values) {
+      if (value.has_value()) {
+         scratch_partition.insert(*value);
+      } else {
+         scratch_partition.insertNull();
+      }
+   }
+}
+
 }  // namespace silo::storage::column
@@ -48,3 +48,16 @@ TEST(IndexedStringColumnPartition, insertValuesToPartition) {
 }
 
 // NOLINTEND(bugprone-unchecked-optional-access)
+
+TEST(IndexedStringColumn, prefilledDictionaryDeterminesTheIdsOfInsertedValues) {
+   silo::storage::column::IndexedStringColumn column;
+   column.prefillDictionary({std::nullopt, "value 1", "value 2"});
+   auto& under_test = column.createPartition();
+
+   under_test.insert("value 2");
+   under_test.insertNull();
+   under_test.insert("value 1");
+
+   EXPECT_EQ(under_test.getValues(), std::vector<silo::Idx>({2, 0, 1}));
+   EXPECT_EQ(under_test.lookupValue(2), "value 2");
+}
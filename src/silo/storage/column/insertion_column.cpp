@@ -73,6 +73,15 @@ InsertionColumnPartition<SymbolType>::InsertionColumnPartition(
     : lookup(lookup),
       default_sequence_name(std::move(default_sequence_name)) {}
 
+template <typename SymbolType>
+void InsertionColumnPartition<SymbolType>::append(const InsertionColumnPartition<SymbolType>& other
+) {
+   values.reserve(values.size() + other.values.size());
+   for (const Idx value_id : other.values) {
+      insert(lookup.getValue(value_id));
+   }
+}
+
 template <typename SymbolType>
 void InsertionColumnPartition<SymbolType>::insert(const std::string& value) {
    if (value.empty()) {
@@ -168,6 +177,20 @@ InsertionColumnPartition<SymbolType>& InsertionColumn<SymbolType>::createPartiti
    return partitions.emplace_back(*lookup, default_sequence_name);
 }
 
+template <typename SymbolType>
+void InsertionColumn<SymbolType>::prefillDictionary(
+   const std::vector<std::optional<std::string>>& values
+) {
+   InsertionColumnPartition<SymbolType> scratch_partition(*lookup, default_sequence_name);
+   for (const auto& value : values) {
+      if (value.has_value()) {
+         scratch_partition.insert(*value);
+      } else {
+         scratch_partition.insertNull();
+      }
+   }
+}
+
 template class InsertionColumnPartition<AminoAcid>;
 template class InsertionColumnPartition<Nucleotide>;
 template class InsertionColumn<AminoAcid>;
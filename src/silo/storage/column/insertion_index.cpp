@@ -251,9 +251,18 @@ void InsertionIndex<SymbolType>::addLazily(
 
 template <typename SymbolType>
 void InsertionIndex<SymbolType>::buildIndex() {
-   insertion_positions.reserve(collected_insertions.size());
+   insertion_positions.reserve(insertion_positions.size() + collected_insertions.size());
 
    for (auto [pos, insertion_info] : collected_insertions) {
+      // Insertions that were collected after the index was built are merged into the position
+      auto existing_position = insertion_positions.find(pos);
+      if (existing_position != insertion_positions.end()) {
+         for (auto& insertion : existing_position->second.insertions) {
+            insertion_info[insertion.value] |= insertion.sequence_ids;
+         }
+         insertion_positions.erase(existing_position);
+      }
+
       InsertionPosition<SymbolType> insertion_position;
       insertion_position.insertions.reserve(insertion_info.size());
       std::transform(
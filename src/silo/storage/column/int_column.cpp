@@ -21,6 +21,10 @@ void IntColumnPartition::insert(const std::string& value) {
    }
 }
 
+void IntColumnPartition::insert(int32_t value) {
+   values.push_back(value);
+}
+
 void IntColumnPartition::insertNull() {
    values.push_back(INT32_MIN);
 }
@@ -29,6 +33,10 @@ void IntColumnPartition::reserve(size_t row_count) {
    values.reserve(values.size() + row_count);
 }
 
+void IntColumnPartition::append(const IntColumnPartition& other) {
+   values.insert(values.end(), other.values.begin(), other.values.end());
+}
+
 IntColumn::IntColumn() = default;
 
 IntColumnPartition& IntColumn::createPartition() {
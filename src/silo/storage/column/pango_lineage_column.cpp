@@ -1,5 +1,6 @@
 #include "silo/storage/column/pango_lineage_column.h"
 
+#include <mutex>
 #include <optional>
 #include <utility>
 
@@ -12,20 +13,41 @@ namespace silo::storage::column {
 PangoLineageColumnPartition::PangoLineageColumnPartition(
    silo::PangoLineageAliasLookup& alias_key,
    common::BidirectionalMap<common::UnaliasedPangoLineage>& lookup_unaliased,
-   common::BidirectionalMap<common::AliasedPangoLineage>& lookup_aliased
+   common::BidirectionalMap<common::AliasedPangoLineage>& lookup_aliased,
+   std::mutex& lookup_mutex
 )
     : alias_key(alias_key),
       lookup_unaliased(lookup_unaliased),
-      lookup_aliased(lookup_aliased) {}
+      lookup_aliased(lookup_aliased),
+      lookup_mutex(lookup_mutex) {}
+
+void PangoLineageColumnPartition::append(const PangoLineageColumnPartition& other) {
+   value_ids.reserve(value_ids.size() + other.value_ids.size());
+   for (const Idx value_id : other.value_ids) {
+      const size_t row_number = value_ids.size();
+      value_ids.push_back(value_id);
+      indexed_values[value_id].add(row_number);
+      insertSublineageValues(lookup_unaliased.getValue(value_id), row_number);
+   }
+}
 
-void PangoLineageColumnPartition::insert(const common::RawPangoLineage& value) {
-   const common::UnaliasedPangoLineage resolved_lineage = alias_key.unaliasPangoLineage(value);
-   for (const auto& parent_lineage : resolved_lineage.getParentLineages()) {
+Idx PangoLineageColumnPartition::getOrCreateIds(const common::UnaliasedPangoLineage& lineage) {
+   if (const auto value_id = lookup_unaliased.getId(lineage)) {
+      return *value_id;
+   }
+   const std::lock_guard<std::mutex> lock(lookup_mutex);
+   for (const auto& parent_lineage : lineage.getParentLineages()) {
       (void)lookup_unaliased.getOrCreateId(parent_lineage);
       (void)lookup_aliased.getOrCreateId(alias_key.aliasPangoLineage(parent_lineage));
    }
-   const Idx value_id = lookup_unaliased.getOrCreateId(resolved_lineage);
-   (void)lookup_aliased.getOrCreateId(alias_key.aliasPangoLineage(resolved_lineage));
+   const Idx value_id = lookup_unaliased.getOrCreateId(lineage);
+   (void)lookup_aliased.getOrCreateId(alias_key.aliasPangoLineage(lineage));
+   return value_id;
+}
+
+void PangoLineageColumnPartition::insert(const common::RawPangoLineage& value) {
+   const common::UnaliasedPangoLineage resolved_lineage = alias_key.unaliasPangoLineage(value);
+   const Idx value_id = getOrCreateIds(resolved_lineage);
 
    const size_t row_number = value_ids.size();
    value_ids.push_back(value_id);
@@ -46,11 +68,8 @@ void PangoLineageColumnPartition::insertSublineageValues(
    size_t row_number
 ) {
    for (const auto& pango_lineage : value.getParentLineages()) {
-      const Idx value_id = lookup_unaliased.getOrCreateId(pango_lineage);
+      const Idx value_id = lookup_unaliased.getId(pango_lineage).value();
       indexed_sublineage_values[value_id].add(row_number);
-
-      const auto aliased_lineage = alias_key.aliasPangoLineage(pango_lineage);
-      (void)lookup_aliased.getOrCreateId(aliased_lineage);
    }
 }
 
@@ -91,10 +110,24 @@ PangoLineageColumn::PangoLineageColumn(silo::PangoLineageAliasLookup alias_key)
    lookup_unaliased = std::make_unique<common::BidirectionalMap<common::UnaliasedPangoLineage>>();
    lookup_aliased = std::make_unique<common::BidirectionalMap<common::AliasedPangoLineage>>();
    this->alias_key = std::make_unique<PangoLineageAliasLookup>(std::move(alias_key));
+   lookup_mutex = std::make_unique<std::mutex>();
 }
 
 PangoLineageColumnPartition& PangoLineageColumn::createPartition() {
-   return partitions.emplace_back(*alias_key, *lookup_unaliased, *lookup_aliased);
+   return partitions.emplace_back(*alias_key, *lookup_unaliased, *lookup_aliased, *lookup_mutex);
+}
+
+void PangoLineageColumn::prefillDictionary(const std::vector<std::optional<std::string>>& values) {
+   PangoLineageColumnPartition scratch_partition(
+      *alias_key, *lookup_unaliased, *lookup_aliased, *lookup_mutex
+   );
+   for (const auto& value : values) {
+      if (value.has_value()) {
+         scratch_partition.insert(common::RawPangoLineage{*value});
+      } else {
+         scratch_partition.insertNull();
+      }
+   }
 }
 
 }  // namespace silo::storage::column
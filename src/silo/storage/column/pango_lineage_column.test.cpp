@@ -1,5 +1,7 @@
 #include "silo/storage/column/pango_lineage_column.h"
 
+#include <mutex>
+
 #include <gtest/gtest.h>
 
 // NOLINTBEGIN(bugprone-unchecked-optional-access)
@@ -7,11 +9,12 @@
 TEST(PangoLineageColumn, addingLineageAndThenSublineageFiltersCorrectly) {
    silo::common::BidirectionalMap<silo::common::UnaliasedPangoLineage> lookup_unaliased;
    silo::common::BidirectionalMap<silo::common::AliasedPangoLineage> lookup_aliased;
+   std::mutex lookup_mutex;
    auto alias_key = silo::PangoLineageAliasLookup::readFromFile(
       "testBaseData/exampleDataset/pangolineage_alias.json"
    );
    auto under_test = silo::storage::column::PangoLineageColumnPartition(
-      alias_key, lookup_unaliased, lookup_aliased
+      alias_key, lookup_unaliased, lookup_aliased, lookup_mutex
    );
 
    under_test.insert({"A.1.2"});
@@ -32,11 +35,12 @@ TEST(PangoLineageColumn, addingLineageAndThenSublineageFiltersCorrectly) {
 TEST(PangoLineageColumn, addingSublineageAndThenLineageFiltersCorrectly) {
    silo::common::BidirectionalMap<silo::common::UnaliasedPangoLineage> lookup_unaliased;
    silo::common::BidirectionalMap<silo::common::AliasedPangoLineage> lookup_aliased;
+   std::mutex lookup_mutex;
    auto alias_key = silo::PangoLineageAliasLookup::readFromFile(
       "testBaseData/exampleDataset/pangolineage_alias.json"
    );
    auto under_test = silo::storage::column::PangoLineageColumnPartition(
-      alias_key, lookup_unaliased, lookup_aliased
+      alias_key, lookup_unaliased, lookup_aliased, lookup_mutex
    );
 
    under_test.insert({"A.1.2.3"});
@@ -59,11 +63,12 @@ TEST(PangoLineageColumn, addingSublineageAndThenLineageFiltersCorrectly) {
 TEST(PangoLineageColumn, queryParentLineageThatWasNeverInserted) {
    silo::common::BidirectionalMap<silo::common::UnaliasedPangoLineage> lookup_unaliased;
    silo::common::BidirectionalMap<silo::common::AliasedPangoLineage> lookup_aliased;
+   std::mutex lookup_mutex;
    auto alias_key = silo::PangoLineageAliasLookup::readFromFile(
       "testBaseData/exampleDataset/pangolineage_alias.json"
    );
    auto under_test = silo::storage::column::PangoLineageColumnPartition(
-      alias_key, lookup_unaliased, lookup_aliased
+      alias_key, lookup_unaliased, lookup_aliased, lookup_mutex
    );
 
    under_test.insert({"A.1.2.3"});
@@ -78,11 +83,12 @@ TEST(PangoLineageColumn, queryParentLineageThatWasNeverInserted) {
 TEST(PangoLineageColumnPartition, returnsAliasedLookupValue) {
    silo::common::BidirectionalMap<silo::common::UnaliasedPangoLineage> lookup_unaliased;
    silo::common::BidirectionalMap<silo::common::AliasedPangoLineage> lookup_aliased;
+   std::mutex lookup_mutex;
    auto alias_key = silo::PangoLineageAliasLookup::readFromFile(
       "testBaseData/exampleDataset/pangolineage_alias.json"
    );
    auto under_test = silo::storage::column::PangoLineageColumnPartition(
-      alias_key, lookup_unaliased, lookup_aliased
+      alias_key, lookup_unaliased, lookup_aliased, lookup_mutex
    );
 
    under_test.insert({"B.1.1"});
@@ -13,6 +13,10 @@ namespace silo::storage::column {
 StringColumnPartition::StringColumnPartition(silo::common::BidirectionalMap<std::string>& lookup)
     : lookup(lookup) {}
 
+void StringColumnPartition::append(const StringColumnPartition& other) {
+   values.insert(values.end(), other.values.begin(), other.values.end());
+}
+
 void StringColumnPartition::insert(const std::string& value) {
    const String<STRING_SIZE> tmp(value, lookup);
    values.push_back(tmp);
@@ -44,6 +48,17 @@ StringColumnPartition& StringColumn::createPartition() {
    return partitions.emplace_back(*lookup);
 }
 
+void StringColumn::prefillDictionary(const std::vector<std::optional<std::string>>& values) {
+   StringColumnPartition scratch_partition(*lookup);
+   for (const auto& value : values) {
+      if (value.has_value()) {
+         scratch_partition.insert(*value);
+      } else {
+         scratch_partition.insertNull();
+      }
+   }
+}
+
 std::optional<String<STRING_SIZE>> StringColumn::embedString(const std::string& string) const {
    return String<STRING_SIZE>::embedString(string, *lookup);
 }
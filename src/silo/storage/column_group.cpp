@@ -1,12 +1,15 @@
 #include "silo/storage/column_group.h"
 
 #include <cmath>
+#include <cstddef>
+#include <optional>
 #include <stdexcept>
 #include <string>
 #include <vector>
 
 #include <boost/algorithm/string.hpp>
 #include <duckdb.hpp>
+#include <spdlog/spdlog.h>
 
 #include "silo/common/date.h"
 #include "silo/config/database_config.h"
@@ -20,24 +23,175 @@ class Nucleotide;
 
 namespace silo::storage {
 
+namespace {
+
+/// Casts every metadata column in SQL to the type that addColumnValues reads from the
+/// DataChunks, so that the values don't need to be parsed from their string representation
+std::string selectColumnAsStorageType(const std::string& column_name, config::ColumnType type) {
+   const std::string quoted_name = "\"" + column_name + "\"";
+   switch (type) {
+      case silo::config::ColumnType::INT:
+         return fmt::format(
+            "CAST(NULLIF(CAST({0} AS VARCHAR), '') AS INTEGER) AS {0}", quoted_name
+         );
+      case silo::config::ColumnType::FLOAT:
+         return fmt::format("CAST(NULLIF(CAST({0} AS VARCHAR), '') AS DOUBLE) AS {0}", quoted_name);
+      case silo::config::ColumnType::DATE:
+         return fmt::format(
+            "TRY_CAST(NULLIF(CAST({0} AS VARCHAR), '') AS DATE) AS {0}", quoted_name
+         );
+      default:
+         return fmt::format("CAST({0} AS VARCHAR) AS {0}", quoted_name);
+   }
+}
+
+/// Counts the non-empty values of a date column that DuckDB cannot parse as a date and that
+/// selectColumnAsStorageType therefore turns into NULL
+std::string countUnparseableDates(const std::string& column_name) {
+   return fmt::format(
+      "count(*) FILTER (WHERE NULLIF(CAST({0} AS VARCHAR), '') IS NOT NULL AND "
+      "TRY_CAST(NULLIF(CAST({0} AS VARCHAR), '') AS DATE) IS NULL)",
+      "\"" + column_name + "\""
+   );
+}
+
+/// The distinct values of a VARCHAR column of partitioned_metadata in ascending order, null first
+std::vector<std::optional<std::string>> selectDistinctValues(
+   duckdb::Connection& connection,
+   const std::string& column_name,
+   config::ColumnType type
+) {
+   auto result = connection.SendQuery(fmt::format(
+      "SELECT DISTINCT {} FROM partitioned_metadata ORDER BY 1 NULLS FIRST",
+      selectColumnAsStorageType(column_name, type)
+   ));
+   if (result->HasError()) {
+      throw preprocessing::PreprocessingException(
+         "Error in the execution of the duckdb statement for the distinct values of column " +
+         column_name + ": " + result->GetError()
+      );
+   }
+   std::vector<std::optional<std::string>> values;
+   for (auto chunk = result->Fetch(); chunk != nullptr; chunk = result->Fetch()) {
+      auto& chunk_values = chunk->data[0];
+      chunk_values.Flatten(chunk->size());
+      const auto* data = duckdb::FlatVector::GetData<duckdb::string_t>(chunk_values);
+      const auto& validity = duckdb::FlatVector::Validity(chunk_values);
+      for (size_t row = 0; row < chunk->size(); ++row) {
+         values.push_back(
+            validity.RowIsValid(row) ? std::optional(data[row].GetString()) : std::nullopt
+         );
+      }
+   }
+   return values;
+}
+
+common::Date toSiloDate(duckdb::date_t date) {
+   if (!duckdb::Date::IsFinite(date)) {
+      return common::NULL_DATE;
+   }
+   int32_t year = 0;
+   int32_t month = 0;
+   int32_t day = 0;
+   duckdb::Date::Convert(date, year, month, day);
+   if (year < 0) {
+      return common::NULL_DATE;
+   }
+   return common::dateFromYearMonthDay(
+      static_cast<uint32_t>(year), static_cast<uint32_t>(month), static_cast<uint32_t>(day)
+   );
+}
+
+template <typename Column>
+void addStringValues(Column& column, duckdb::Vector& values, size_t row_count) {
+   const auto* data = duckdb::FlatVector::GetData<duckdb::string_t>(values);
+   const auto& validity = duckdb::FlatVector::Validity(values);
+   for (size_t row = 0; row < row_count; ++row) {
+      if (validity.RowIsValid(row)) {
+         column.insert(data[row].GetString());
+      } else {
+         column.insertNull();
+      }
+   }
+}
+
+template <typename Column, typename DuckDBType, typename Transform>
+void addTypedValues(
+   Column& column,
+   duckdb::Vector& values,
+   size_t row_count,
+   const Transform& transform
+) {
+   const auto* data = duckdb::FlatVector::GetData<DuckDBType>(values);
+   const auto& validity = duckdb::FlatVector::Validity(values);
+   for (size_t row = 0; row < row_count; ++row) {
+      if (validity.RowIsValid(row)) {
+         column.insert(transform(data[row]));
+      } else {
+         column.insertNull();
+      }
+   }
+}
+
+}  // namespace
+
 uint32_t ColumnPartitionGroup::fill(
    duckdb::Connection& connection,
    uint32_t partition_id,
    const std::string& order_by_clause,
    const silo::config::DatabaseConfig& database_config
 ) {
-   uint32_t sequence_count = 0;
+   std::vector<std::string> counts{"count(*)"};
+   std::vector<std::string> date_column_names;
+   for (const auto& item : database_config.schema.metadata) {
+      if (item.getColumnType() == silo::config::ColumnType::DATE) {
+         counts.push_back(countUnparseableDates(item.name));
+         date_column_names.push_back(item.name);
+      }
+   }
+   auto count_result = connection.Query(fmt::format(
+      "SELECT {} FROM partitioned_metadata WHERE partition_id = {}",
+      boost::algorithm::join(counts, ", "),
+      partition_id
+   ));
+   if (count_result->HasError()) {
+      throw preprocessing::PreprocessingException(
+         "Error in the execution of the duckdb statement for counting the rows of partition " +
+         std::to_string(partition_id) + ": " + count_result->GetError()
+      );
+   }
+   const auto row_count = count_result->GetValue<int64_t>(0, 0);
+   if (row_count >= UINT32_MAX) {
+      throw std::runtime_error(
+         "SILO is currently limited to UINT32_MAX=" + std::to_string(UINT32_MAX) + " sequences."
+      );
+   }
+   for (size_t index = 0; index < date_column_names.size(); ++index) {
+      const auto unparseable_date_count = count_result->GetValue<int64_t>(index + 1, 0);
+      if (unparseable_date_count > 0) {
+         SPDLOG_WARN(
+            "{} values of the date column '{}' in partition {} are not valid dates, they are "
+            "stored as null",
+            unparseable_date_count,
+            date_column_names[index],
+            partition_id
+         );
+      }
+   }
+   for (const auto& item : database_config.schema.metadata) {
+      reserveSpaceInColumn(item.name, item.getColumnType(), static_cast<size_t>(row_count));
+   }
 
-   std::vector<std::string> column_names;
-   column_names.reserve(database_config.schema.metadata.size());
+   std::vector<std::string> column_selects;
+   column_selects.reserve(database_config.schema.metadata.size());
    for (const auto& item : database_config.schema.metadata) {
-      column_names.push_back("\"" + item.name + "\"");
+      column_selects.push_back(selectColumnAsStorageType(item.name, item.getColumnType()));
    }
-   std::string column_name_sql = boost::algorithm::join(column_names, ", ");
+   const std::string column_select_sql = boost::algorithm::join(column_selects, ", ");
 
-   auto result = connection.Query(fmt::format(
+   auto result = connection.SendQuery(fmt::format(
       "SELECT {} FROM partitioned_metadata WHERE partition_id = {} {}",
-      column_name_sql,
+      column_select_sql,
       partition_id,
       order_by_clause
    ));
@@ -48,90 +202,76 @@ uint32_t ColumnPartitionGroup::fill(
          result->GetError()
       );
    }
-   const size_t row_count = result->RowCount();
-   for (const auto& item : database_config.schema.metadata) {
-      const auto column_type = item.getColumnType();
-      reserveSpaceInColumn(item.name, column_type, row_count);
-   }
 
-   for (auto it = result->begin(); it != result->end(); ++it) {
-      size_t column_index = 0;
-      for (const auto& item : database_config.schema.metadata) {
-         const auto column_type = item.getColumnType();
-         const auto value = it.current_row.GetValue<duckdb::Value>(column_index++);
-         addValueToColumn(item.name, column_type, value);
-      }
-      if (++sequence_count == UINT32_MAX) {
+   uint32_t sequence_count = 0;
+   for (auto chunk = result->Fetch(); chunk != nullptr; chunk = result->Fetch()) {
+      const size_t chunk_size = chunk->size();
+      if (sequence_count + chunk_size >= UINT32_MAX) {
          throw std::runtime_error(
             "SILO is currently limited to UINT32_MAX=" + std::to_string(UINT32_MAX) + " sequences."
          );
       }
+      size_t column_index = 0;
+      for (const auto& item : database_config.schema.metadata) {
+         auto& values = chunk->data[column_index++];
+         values.Flatten(chunk_size);
+         addColumnValues(item.name, item.getColumnType(), values, chunk_size);
+      }
+      sequence_count += chunk_size;
+   }
+   if (result->HasError()) {
+      throw preprocessing::PreprocessingException(
+         "Error while fetching the metadata of partition " + std::to_string(partition_id) + ": " +
+         result->GetError()
+      );
    }
 
    return sequence_count;
 }
 
-void ColumnPartitionGroup::addValueToColumn(
+void ColumnPartitionGroup::addColumnValues(
    const std::string& column_name,
    config::ColumnType column_type,
-   const duckdb::Value& value
+   duckdb::Vector& values,
+   size_t row_count
 ) {
    switch (column_type) {
       case silo::config::ColumnType::INDEXED_STRING:
-         if (value.IsNull()) {
-            indexed_string_columns.at(column_name).insertNull();
-         } else {
-            indexed_string_columns.at(column_name).insert(value.ToString());
-         }
+         addStringValues(indexed_string_columns.at(column_name), values, row_count);
          break;
       case silo::config::ColumnType::STRING:
-         if (value.IsNull()) {
-            string_columns.at(column_name).insertNull();
-         } else {
-            string_columns.at(column_name).insert(value.ToString());
-         }
+         addStringValues(string_columns.at(column_name), values, row_count);
          break;
       case silo::config::ColumnType::INDEXED_PANGOLINEAGE:
-         if (value.IsNull()) {
-            pango_lineage_columns.at(column_name).insertNull();
-         } else {
-            pango_lineage_columns.at(column_name).insert({value.ToString()});
-         }
+         addTypedValues<storage::column::PangoLineageColumnPartition, duckdb::string_t>(
+            pango_lineage_columns.at(column_name),
+            values,
+            row_count,
+            [](const duckdb::string_t& value) {
+               return common::RawPangoLineage{value.GetString()};
+            }
+         );
          break;
       case silo::config::ColumnType::DATE:
-         if (value.IsNull()) {
-            date_columns.at(column_name).insertNull();
-         } else {
-            date_columns.at(column_name).insert(common::stringToDate(value.ToString()));
-         }
+         addTypedValues<storage::column::DateColumnPartition, duckdb::date_t>(
+            date_columns.at(column_name), values, row_count, toSiloDate
+         );
          break;
       case silo::config::ColumnType::INT:
-         if (value.IsNull()) {
-            int_columns.at(column_name).insertNull();
-         } else {
-            int_columns.at(column_name).insert(value.ToString());
-         }
+         addTypedValues<storage::column::IntColumnPartition, int32_t>(
+            int_columns.at(column_name), values, row_count, [](int32_t value) { return value; }
+         );
          break;
       case silo::config::ColumnType::FLOAT:
-         if (value.IsNull()) {
-            float_columns.at(column_name).insertNull();
-         } else {
-            float_columns.at(column_name).insert(value.ToString());
-         }
+         addTypedValues<storage::column::FloatColumnPartition, double>(
+            float_columns.at(column_name), values, row_count, [](double value) { return value; }
+         );
          break;
       case silo::config::ColumnType::NUC_INSERTION:
-         if (value.IsNull()) {
-            nuc_insertion_columns.at(column_name).insertNull();
-         } else {
-            nuc_insertion_columns.at(column_name).insert(value.ToString());
-         }
+         addStringValues(nuc_insertion_columns.at(column_name), values, row_count);
          break;
       case silo::config::ColumnType::AA_INSERTION:
-         if (value.IsNull()) {
-            aa_insertion_columns.at(column_name).insertNull();
-         } else {
-            aa_insertion_columns.at(column_name).insert(value.ToString());
-         }
+         addStringValues(aa_insertion_columns.at(column_name), values, row_count);
          break;
    }
 }
@@ -260,6 +400,46 @@ std::optional<std::variant<std::string, int32_t, double>> ColumnPartitionGroup::
    return std::nullopt;
 }
 
+void ColumnGroup::prefillDictionaries(
+   duckdb::Connection& connection,
+   const silo::config::DatabaseConfig& database_config
+) {
+   for (const auto& item : database_config.schema.metadata) {
+      const auto column_type = item.getColumnType();
+      switch (column_type) {
+         case silo::config::ColumnType::INDEXED_STRING:
+            indexed_string_columns.at(item.name).prefillDictionary(
+               selectDistinctValues(connection, item.name, column_type)
+            );
+            break;
+         case silo::config::ColumnType::STRING:
+            string_columns.at(item.name).prefillDictionary(
+               selectDistinctValues(connection, item.name, column_type)
+            );
+            break;
+         case silo::config::ColumnType::INDEXED_PANGOLINEAGE:
+            pango_lineage_columns.at(item.name).prefillDictionary(
+               selectDistinctValues(connection, item.name, column_type)
+            );
+            break;
+         case silo::config::ColumnType::NUC_INSERTION:
+            nuc_insertion_columns.at(item.name).prefillDictionary(
+               selectDistinctValues(connection, item.name, column_type)
+            );
+            break;
+         case silo::config::ColumnType::AA_INSERTION:
+            aa_insertion_columns.at(item.name).prefillDictionary(
+               selectDistinctValues(connection, item.name, column_type)
+            );
+            break;
+         case silo::config::ColumnType::DATE:
+         case silo::config::ColumnType::INT:
+         case silo::config::ColumnType::FLOAT:
+            break;
+      }
+   }
+}
+
 template <>
 const std::map<std::string, storage::column::InsertionColumn<Nucleotide>>& ColumnGroup::
    getInsertionColumns<Nucleotide>() const {
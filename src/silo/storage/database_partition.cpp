@@ -10,6 +10,13 @@
 #include "silo/common/nucleotide_symbols.h"
 #include "silo/preprocessing/partition.h"
 #include "silo/preprocessing/preprocessing_exception.h"
+#include "silo/storage/column/date_column.h"
+#include "silo/storage/column/float_column.h"
+#include "silo/storage/column/indexed_string_column.h"
+#include "silo/storage/column/insertion_column.h"
+#include "silo/storage/column/int_column.h"
+#include "silo/storage/column/pango_lineage_column.h"
+#include "silo/storage/column/string_column.h"
 #include "silo/storage/column_group.h"
 #include "silo/storage/sequence_store.h"
 
@@ -25,8 +32,52 @@ template <typename SymbolType>
 class InsertionColumnPartition;
 }  // namespace storage::column
 
-DatabasePartition::DatabasePartition(std::vector<silo::preprocessing::PartitionChunk> chunks)
-    : chunks(std::move(chunks)) {}
+DatabasePartition::DatabasePartition(
+   std::vector<silo::preprocessing::PartitionChunk> chunks,
+   bool is_delta
+)
+    : chunks(std::move(chunks)),
+      is_delta(is_delta) {}
+
+void DatabasePartition::append(const DatabasePartition& other) {
+   for (auto& [name, column] : columns.string_columns) {
+      column.append(other.columns.string_columns.at(name));
+   }
+   for (auto& [name, column] : columns.indexed_string_columns) {
+      column.append(other.columns.indexed_string_columns.at(name));
+   }
+   for (auto& [name, column] : columns.int_columns) {
+      column.append(other.columns.int_columns.at(name));
+   }
+   for (auto& [name, column] : columns.float_columns) {
+      column.append(other.columns.float_columns.at(name));
+   }
+   for (auto& [name, column] : columns.date_columns) {
+      column.append(other.columns.date_columns.at(name));
+   }
+   for (auto& [name, column] : columns.pango_lineage_columns) {
+      column.append(other.columns.pango_lineage_columns.at(name));
+   }
+   for (auto& [name, column] : columns.nuc_insertion_columns) {
+      column.append(other.columns.nuc_insertion_columns.at(name));
+   }
+   for (auto& [name, column] : columns.aa_insertion_columns) {
+      column.append(other.columns.aa_insertion_columns.at(name));
+   }
+   for (auto& [name, store] : nuc_sequences) {
+      store.append(other.nuc_sequences.at(name));
+   }
+   for (auto& [name, store] : aa_sequences) {
+      store.append(other.aa_sequences.at(name));
+   }
+
+   const uint32_t partition_id = chunks.empty() ? 0 : chunks.front().partition;
+   for (const auto& chunk : other.chunks) {
+      const auto chunk_index = static_cast<uint32_t>(chunks.size());
+      chunks.push_back({partition_id, chunk_index, chunk.size, sequence_count + chunk.offset});
+   }
+   sequence_count += other.sequence_count;
+}
 
 void DatabasePartition::validate() const {
    validateNucleotideSequences();
@@ -46,11 +97,12 @@ void DatabasePartition::validateNucleotideSequences() const {
             partition_size
          ));
       }
-      if (nuc_store.positions.size() != nuc_store.reference_sequence.size()) {
+      if (nuc_store.getLayout() == SequenceStoreLayout::DENSE
+          && nuc_store.getMaterializedPositionCount() != nuc_store.reference_sequence.size()) {
          throw preprocessing::PreprocessingException(fmt::format(
             "nuc_store positions {} ({}) has size unequal to reference (expected {}).",
             name,
-            nuc_store.positions.size(),
+            nuc_store.getMaterializedPositionCount(),
             nuc_store.reference_sequence.size()
          ));
       }
@@ -77,7 +129,8 @@ void DatabasePartition::validateAminoAcidSequences() const {
             partition_size
          ));
       }
-      if (aa_store.positions.size() != aa_store.reference_sequence.size()) {
+      if (aa_store.getLayout() == SequenceStoreLayout::DENSE
+          && aa_store.getMaterializedPositionCount() != aa_store.reference_sequence.size()) {
          throw preprocessing::PreprocessingException(
             "aa_store " + name + " has invalid position size."
          );
@@ -158,6 +211,10 @@ const std::vector<preprocessing::PartitionChunk>& DatabasePartition::getChunks()
    return chunks;
 }
 
+bool DatabasePartition::isDelta() const {
+   return is_delta;
+}
+
 void DatabasePartition::insertColumn(
    const std::string& name,
    storage::column::StringColumnPartition& column
@@ -1,7 +1,62 @@
 #include "silo/storage/position.h"
 
+#include <algorithm>
+
 #include <spdlog/spdlog.h>
 
+namespace {
+
+const roaring::Roaring EMPTY_BITMAP;
+
+template <typename Bitmaps, typename Symbol>
+auto findEntry(Bitmaps& bitmaps, Symbol symbol) {
+   return std::lower_bound(
+      bitmaps.begin(),
+      bitmaps.end(),
+      symbol,
+      [](const auto& entry, Symbol value) { return entry.first < value; }
+   );
+}
+
+}  // namespace
+
+template <typename SymbolType>
+roaring::Roaring* silo::Position<SymbolType>::findBitmap(typename SymbolType::Symbol symbol) {
+   auto entry = findEntry(bitmaps, symbol);
+   if (entry == bitmaps.end() || entry->first != symbol) {
+      return nullptr;
+   }
+   return &entry->second;
+}
+
+template <typename SymbolType>
+const roaring::Roaring* silo::Position<SymbolType>::findBitmap(typename SymbolType::Symbol symbol
+) const {
+   auto entry = findEntry(bitmaps, symbol);
+   if (entry == bitmaps.end() || entry->first != symbol) {
+      return nullptr;
+   }
+   return &entry->second;
+}
+
+template <typename SymbolType>
+roaring::Roaring& silo::Position<SymbolType>::getOrCreateBitmap(typename SymbolType::Symbol symbol
+) {
+   auto entry = findEntry(bitmaps, symbol);
+   if (entry == bitmaps.end() || entry->first != symbol) {
+      entry = bitmaps.emplace(entry, symbol, roaring::Roaring());
+   }
+   return entry->second;
+}
+
+template <typename SymbolType>
+void silo::Position<SymbolType>::eraseBitmapIfEmpty(typename SymbolType::Symbol symbol) {
+   auto entry = findEntry(bitmaps, symbol);
+   if (entry != bitmaps.end() && entry->first == symbol && entry->second.isEmpty()) {
+      bitmaps.erase(entry);
+   }
+}
+
 template <typename SymbolType>
 silo::Position<SymbolType> silo::Position<SymbolType>::fromInitiallyDeleted(
    typename SymbolType::Symbol symbol
@@ -30,14 +85,31 @@ void silo::Position<SymbolType>::addValues(
    if (symbol == symbol_whose_bitmap_is_deleted) {
       return;
    }
+   if (values.empty() && symbol != symbol_whose_bitmap_is_flipped) {
+      return;
+   }
+   roaring::Roaring& bitmap = getOrCreateBitmap(symbol);
    if (!values.empty()) {
-      bitmaps[symbol].addMany(values.size(), values.data());
+      bitmap.addMany(values.size(), values.data());
    }
    if (symbol == symbol_whose_bitmap_is_flipped) {
-      bitmaps[symbol].flip(current_offset, current_offset + interval_size);
+      bitmap.flip(current_offset, current_offset + interval_size);
+      eraseBitmapIfEmpty(symbol);
    }
 }
 
+template <typename SymbolType>
+void silo::Position<SymbolType>::flipBitmap(
+   typename SymbolType::Symbol symbol,
+   uint32_t sequence_count
+) {
+   roaring::Roaring& bitmap = getOrCreateBitmap(symbol);
+   bitmap.flip(0, sequence_count);
+   bitmap.runOptimize();
+   bitmap.shrinkToFit();
+   eraseBitmapIfEmpty(symbol);
+}
+
 template <typename SymbolType>
 std::optional<typename SymbolType::Symbol> silo::Position<SymbolType>::getHighestCardinalitySymbol(
    uint32_t sequence_count
@@ -53,12 +125,12 @@ std::optional<typename SymbolType::Symbol> silo::Position<SymbolType>::getHighes
    std::optional<typename SymbolType::Symbol> max_symbol = std::nullopt;
    uint32_t max_count = 0;
 
+   optimizeStoredBitmaps();
+
    for (const auto& symbol : SymbolType::SYMBOLS) {
-      roaring::Roaring& bitmap = bitmaps[symbol];
-      bitmap.runOptimize();
-      bitmap.shrinkToFit();
-      const uint32_t count =
-         isSymbolFlipped(symbol) ? sequence_count - bitmap.cardinality() : bitmap.cardinality();
+      const roaring::Roaring* bitmap = findBitmap(symbol);
+      const uint32_t cardinality = bitmap == nullptr ? 0 : bitmap->cardinality();
+      const uint32_t count = isSymbolFlipped(symbol) ? sequence_count - cardinality : cardinality;
       if (count > max_count) {
          max_symbol = symbol;
          max_count = count;
@@ -83,14 +155,10 @@ std::optional<typename SymbolType::Symbol> silo::Position<SymbolType>::flipMostN
 
    if (max_symbol != symbol_whose_bitmap_is_flipped) {
       if (symbol_whose_bitmap_is_flipped.has_value()) {
-         bitmaps[*symbol_whose_bitmap_is_flipped].flip(0, sequence_count);
-         bitmaps[*symbol_whose_bitmap_is_flipped].runOptimize();
-         bitmaps[*symbol_whose_bitmap_is_flipped].shrinkToFit();
+         flipBitmap(*symbol_whose_bitmap_is_flipped, sequence_count);
       }
       if (max_symbol.has_value()) {
-         bitmaps[*max_symbol].flip(0, sequence_count);
-         bitmaps[*max_symbol].runOptimize();
-         bitmaps[*max_symbol].shrinkToFit();
+         flipBitmap(*max_symbol, sequence_count);
       }
       symbol_whose_bitmap_is_flipped = max_symbol;
       return symbol_whose_bitmap_is_flipped;
@@ -109,9 +177,7 @@ std::optional<typename SymbolType::Symbol> silo::Position<SymbolType>::deleteMos
       ));
    }
    if (symbol_whose_bitmap_is_flipped.has_value()) {
-      bitmaps[*symbol_whose_bitmap_is_flipped].flip(0, sequence_count);
-      bitmaps[*symbol_whose_bitmap_is_flipped].runOptimize();
-      bitmaps[*symbol_whose_bitmap_is_flipped].shrinkToFit();
+      flipBitmap(*symbol_whose_bitmap_is_flipped, sequence_count);
       symbol_whose_bitmap_is_flipped = std::nullopt;
    }
 
@@ -119,18 +185,30 @@ std::optional<typename SymbolType::Symbol> silo::Position<SymbolType>::deleteMos
       getHighestCardinalitySymbol(sequence_count);
 
    if (max_symbol.has_value()) {
-      bitmaps[*max_symbol] = roaring::Roaring();
+      auto entry = findEntry(bitmaps, *max_symbol);
+      if (entry != bitmaps.end() && entry->first == *max_symbol) {
+         bitmaps.erase(entry);
+      }
+      bitmaps.shrink_to_fit();
       symbol_whose_bitmap_is_deleted = max_symbol;
       return symbol_whose_bitmap_is_deleted;
    }
    return std::nullopt;
 }
 
+template <typename SymbolType>
+void silo::Position<SymbolType>::optimizeStoredBitmaps() {
+   for (auto& [symbol, bitmap] : bitmaps) {
+      bitmap.runOptimize();
+      bitmap.shrinkToFit();
+   }
+}
+
 template <typename SymbolType>
 size_t silo::Position<SymbolType>::computeSize() const {
    size_t result = 0;
-   for (const auto symbol : SymbolType::SYMBOLS) {
-      result += bitmaps.at(symbol).getSizeInBytes(false);
+   for (const auto& [symbol, bitmap] : bitmaps) {
+      result += bitmap.getSizeInBytes(false);
    }
    return result;
 }
@@ -138,7 +216,13 @@ size_t silo::Position<SymbolType>::computeSize() const {
 template <typename SymbolType>
 const roaring::Roaring* silo::Position<SymbolType>::getBitmap(typename SymbolType::Symbol symbol
 ) const {
-   return &bitmaps.at(symbol);
+   const roaring::Roaring* bitmap = findBitmap(symbol);
+   return bitmap == nullptr ? &EMPTY_BITMAP : bitmap;
+}
+
+template <typename SymbolType>
+size_t silo::Position<SymbolType>::storedBitmapCount() const {
+   return bitmaps.size();
 }
 
 template <typename SymbolType>
@@ -7,6 +7,8 @@
 #include <boost/archive/binary_iarchive.hpp>
 #include <boost/archive/binary_oarchive.hpp>
 #include <boost/serialization/array.hpp>
+#include <boost/serialization/utility.hpp>
+#include <boost/serialization/vector.hpp>
 
 #include "silo/roaring/roaring_serialize.h"
 #include "silo/storage/serialize_optional.h"
@@ -227,4 +229,48 @@ TEST(Position, shouldSerializeAndDeserializePositionWithDeletedBitmap) {
    }
 
    ASSERT_NO_THROW(std::remove(test_file.c_str()));
-}
\ No newline at end of file
+}
+
+TEST(Position, storesOnlyNonEmptyBitmaps) {
+   Position<Nucleotide> under_test =
+      Position<Nucleotide>::fromInitiallyFlipped(Nucleotide::Symbol::A);
+
+   under_test.addValues(Nucleotide::Symbol::A, std::vector<uint32_t>{0, 1, 2, 3, 4}, 0, 5);
+   under_test.addValues(Nucleotide::Symbol::C, std::vector<uint32_t>{}, 0, 5);
+
+   EXPECT_EQ(under_test.storedBitmapCount(), 0);
+   EXPECT_EQ(*under_test.getBitmap(Nucleotide::Symbol::A), roaring::Roaring());
+   EXPECT_EQ(*under_test.getBitmap(Nucleotide::Symbol::C), roaring::Roaring());
+
+   under_test.addValues(Nucleotide::Symbol::A, std::vector<uint32_t>{5, 7}, 5, 3);
+   under_test.addValues(Nucleotide::Symbol::G, std::vector<uint32_t>{6}, 5, 3);
+
+   EXPECT_EQ(under_test.storedBitmapCount(), 2);
+   EXPECT_EQ(*under_test.getBitmap(Nucleotide::Symbol::A), roaring::Roaring({6}));
+   EXPECT_EQ(*under_test.getBitmap(Nucleotide::Symbol::G), roaring::Roaring({6}));
+
+   ASSERT_EQ(under_test.deleteMostNumerousBitmap(8), Nucleotide::Symbol::A);
+
+   EXPECT_EQ(under_test.storedBitmapCount(), 1);
+   EXPECT_EQ(*under_test.getBitmap(Nucleotide::Symbol::A), roaring::Roaring());
+   EXPECT_EQ(*under_test.getBitmap(Nucleotide::Symbol::G), roaring::Roaring({6}));
+}
+
+TEST(Position, shouldSerializeAndDeserializeStoredBitmaps) {
+   const std::string test_file = "test.bin";
+
+   Position<Nucleotide> position;
+   position.addValues(Nucleotide::Symbol::T, std::vector<uint32_t>{1, 3}, 0, 4);
+   position.addValues(Nucleotide::Symbol::C, std::vector<uint32_t>{0, 2}, 0, 4);
+   serializeToFile(test_file, position);
+
+   Position<Nucleotide> deserialized_position;
+   deserializeFromFile(test_file, deserialized_position);
+
+   EXPECT_EQ(deserialized_position.storedBitmapCount(), 2);
+   EXPECT_EQ(*deserialized_position.getBitmap(Nucleotide::Symbol::C), roaring::Roaring({0, 2}));
+   EXPECT_EQ(*deserialized_position.getBitmap(Nucleotide::Symbol::T), roaring::Roaring({1, 3}));
+   EXPECT_EQ(*deserialized_position.getBitmap(Nucleotide::Symbol::A), roaring::Roaring());
+
+   ASSERT_NO_THROW(std::remove(test_file.c_str()));
+}
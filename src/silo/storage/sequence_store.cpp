@@ -1,65 +1,352 @@
 #include "silo/storage/sequence_store.h"
 
+#include <algorithm>
+#include <array>
 #include <string>
+#include <tuple>
 #include <utility>
 #include <vector>
 
 #include <oneapi/tbb/blocked_range.h>
 #include <oneapi/tbb/enumerable_thread_specific.h>
 #include <oneapi/tbb/parallel_for.h>
+#include <oneapi/tbb/parallel_for_each.h>
+#include <oneapi/tbb/parallel_pipeline.h>
+#include <oneapi/tbb/parallel_sort.h>
 #include <spdlog/spdlog.h>
 #include <roaring/roaring.hh>
 
 #include "silo/common/aa_symbols.h"
 #include "silo/common/format_number.h"
 #include "silo/common/nucleotide_symbols.h"
+#include "silo/common/perf_counters.h"
 #include "silo/common/symbol_map.h"
+#include "silo/preprocessing/mutation_list_table_reader.h"
 #include "silo/preprocessing/preprocessing_exception.h"
 #include "silo/storage/position.h"
+#include "silo/zstdfasta/zstd_decompressor.h"
 #include "silo/zstdfasta/zstdfasta_table_reader.h"
 
+namespace {
+
+constexpr uint8_t ILLEGAL_SYMBOL = 0xFF;
+
+/// Maps every character to the index of its symbol, or to ILLEGAL_SYMBOL
+template <typename SymbolType>
+const std::array<uint8_t, 256>& symbolLookupTable() {
+   static const std::array<uint8_t, 256> lookup_table = [] {
+      std::array<uint8_t, 256> table{};
+      for (size_t character = 0; character < table.size(); ++character) {
+         const auto symbol = SymbolType::charToSymbol(static_cast<char>(character));
+         table[character] = symbol.has_value() ? static_cast<uint8_t>(*symbol) : ILLEGAL_SYMBOL;
+      }
+      return table;
+   }();
+   return lookup_table;
+}
+
+/// Writes the symbols of the positions [tile_begin, tile_begin + tile_width) of all genomes into
+/// tile, position-major, so that the symbols of one position lie next to each other. Reads each
+/// genome in one contiguous run instead of once per position
+template <typename SymbolType>
+void transposeTile(
+   const std::vector<std::optional<std::string>>& genomes,
+   size_t tile_begin,
+   size_t tile_width,
+   uint8_t* tile
+) {
+   const auto& lookup_table = symbolLookupTable<SymbolType>();
+   const size_t number_of_sequences = genomes.size();
+   bool contains_illegal_symbol = false;
+   for (size_t sequence_id = 0; sequence_id < number_of_sequences; ++sequence_id) {
+      const auto& genome = genomes[sequence_id];
+      if (!genome.has_value()) {
+         for (size_t offset = 0; offset < tile_width; ++offset) {
+            tile[offset * number_of_sequences + sequence_id] =
+               static_cast<uint8_t>(SymbolType::SYMBOL_MISSING);
+         }
+         continue;
+      }
+      const char* characters = genome->data() + tile_begin;
+      for (size_t offset = 0; offset < tile_width; ++offset) {
+         const uint8_t symbol = lookup_table[static_cast<uint8_t>(characters[offset])];
+         contains_illegal_symbol |= symbol == ILLEGAL_SYMBOL;
+         tile[offset * number_of_sequences + sequence_id] = symbol;
+      }
+   }
+   if (contains_illegal_symbol) {
+      for (const auto& genome : genomes) {
+         if (!genome.has_value()) {
+            continue;
+         }
+         for (size_t offset = 0; offset < tile_width; ++offset) {
+            const char character = (*genome)[tile_begin + offset];
+            if (lookup_table[static_cast<uint8_t>(character)] == ILLEGAL_SYMBOL) {
+               throw silo::preprocessing::PreprocessingException(
+                  "Illegal character " + std::to_string(character) + " contained in sequence."
+               );
+            }
+         }
+      }
+   }
+}
+
+template <typename SymbolType>
+void checkDifferencesWithinReference(
+   const silo::SequenceDifferences<SymbolType>& differences,
+   size_t genome_length
+) {
+   for (const auto& [position, symbol] : differences.substitutions) {
+      if (position >= genome_length) {
+         throw silo::preprocessing::PreprocessingException(fmt::format(
+            "Substitution at position {} lies outside of the reference of length {}",
+            position,
+            genome_length
+         ));
+      }
+   }
+   for (const auto& [start, end] : differences.missing_ranges) {
+      if (start > end || end > genome_length) {
+         throw silo::preprocessing::PreprocessingException(fmt::format(
+            "Missing range [{}, {}) lies outside of the reference of length {}",
+            start,
+            end,
+            genome_length
+         ));
+      }
+   }
+}
+
+}  // namespace
+
+silo::SequenceStoreLayout silo::defaultSequenceStoreLayout(size_t reference_length) {
+   return reference_length >= SPARSE_LAYOUT_MIN_REFERENCE_LENGTH ? SequenceStoreLayout::SPARSE
+                                                                 : SequenceStoreLayout::DENSE;
+}
+
 template <typename SymbolType>
 silo::SequenceStorePartition<SymbolType>::SequenceStorePartition(
-   const std::vector<typename SymbolType::Symbol>& reference_sequence
+   std::shared_ptr<const std::vector<typename SymbolType::Symbol>> reference_sequence,
+   SequenceStoreLayout layout
 )
-    : reference_sequence(reference_sequence) {
+    : shared_reference_sequence(std::move(reference_sequence)),
+      reference_sequence(*shared_reference_sequence),
+      layout(layout) {
+   initializeLayout(layout);
+}
+
+template <typename SymbolType>
+void silo::SequenceStorePartition<SymbolType>::initializeLayout(SequenceStoreLayout new_layout) {
+   layout = new_layout;
+   positions.clear();
+   sparse_positions.clear();
+   unmaterialized_positions.reset();
+   if (layout == SequenceStoreLayout::SPARSE) {
+      unmaterialized_positions = std::make_unique<SymbolMap<SymbolType, Position<SymbolType>>>();
+      for (const auto symbol : SymbolType::SYMBOLS) {
+         (*unmaterialized_positions)[symbol] = Position<SymbolType>::fromInitiallyDeleted(symbol);
+      }
+      return;
+   }
    positions.reserve(reference_sequence.size());
    for (const auto symbol : reference_sequence) {
       positions.emplace_back(Position<SymbolType>::fromInitiallyFlipped(symbol));
    }
 }
 
+template <typename SymbolType>
+void silo::SequenceStorePartition<SymbolType>::append(
+   const SequenceStorePartition<SymbolType>& other
+) {
+   if (layout == SequenceStoreLayout::SPARSE) {
+      appendSparse(other);
+      return;
+   }
+
+   const size_t genome_length = positions.size();
+
+   std::vector<std::vector<uint32_t>> missing_sequence_ids_per_position(genome_length);
+   for (uint32_t sequence_id = 0; sequence_id < other.sequence_count; ++sequence_id) {
+      for (const uint32_t position : other.missing_symbol_bitmaps[sequence_id]) {
+         missing_sequence_ids_per_position[position].push_back(sequence_id);
+      }
+   }
+
+   tbb::parallel_for(tbb::blocked_range<size_t>(0, genome_length), [&](const auto& local) {
+      SymbolMap<SymbolType, std::vector<uint32_t>> ids_per_symbol_for_current_position;
+      for (size_t position = local.begin(); position != local.end(); ++position) {
+         const auto& other_position = other.positions[position];
+         const auto& missing_sequence_ids = missing_sequence_ids_per_position[position];
+         roaring::Roaring sequences_with_explicit_symbol(
+            missing_sequence_ids.size(), missing_sequence_ids.data()
+         );
+         for (const auto symbol : SymbolType::SYMBOLS) {
+            if (other_position.isSymbolDeleted(symbol)) {
+               continue;
+            }
+            roaring::Roaring sequence_ids = *other_position.getBitmap(symbol);
+            if (other_position.isSymbolFlipped(symbol)) {
+               sequence_ids.flip(0, other.sequence_count);
+            }
+            sequences_with_explicit_symbol |= sequence_ids;
+            for (const uint32_t sequence_id : sequence_ids) {
+               ids_per_symbol_for_current_position[symbol].push_back(sequence_count + sequence_id);
+            }
+         }
+         const auto deleted_symbol = other_position.getDeletedSymbol();
+         if (deleted_symbol.has_value()) {
+            roaring::Roaring sequence_ids;
+            sequence_ids.addRange(0, other.sequence_count);
+            sequence_ids -= sequences_with_explicit_symbol;
+            for (const uint32_t sequence_id : sequence_ids) {
+               ids_per_symbol_for_current_position[*deleted_symbol].push_back(
+                  sequence_count + sequence_id
+               );
+            }
+         }
+         addSymbolsToPositions(position, ids_per_symbol_for_current_position, other.sequence_count);
+      }
+   });
+
+   missing_symbol_bitmaps.insert(
+      missing_symbol_bitmaps.end(),
+      other.missing_symbol_bitmaps.begin(),
+      other.missing_symbol_bitmaps.end()
+   );
+   sequence_count += other.sequence_count;
+}
+
+template <typename SymbolType>
+void silo::SequenceStorePartition<SymbolType>::appendSparse(
+   const SequenceStorePartition<SymbolType>& other
+) {
+   // The reference symbol is deleted at every materialized position of both partitions, so only
+   // the explicit bitmaps of the other partition have to be carried over
+   std::vector<std::pair<Position<SymbolType>*, const Position<SymbolType>*>> position_pairs;
+   position_pairs.reserve(other.sparse_positions.size());
+   for (const auto& [position, other_position] : other.sparse_positions) {
+      position_pairs.emplace_back(&materializePosition(position), &other_position);
+   }
+
+   tbb::parallel_for(tbb::blocked_range<size_t>(0, position_pairs.size()), [&](const auto& local) {
+      std::vector<uint32_t> sequence_ids;
+      for (size_t index = local.begin(); index != local.end(); ++index) {
+         const auto& [position, other_position] = position_pairs[index];
+         for (const auto symbol : SymbolType::SYMBOLS) {
+            if (other_position->isSymbolDeleted(symbol)) {
+               continue;
+            }
+            for (const uint32_t sequence_id : *other_position->getBitmap(symbol)) {
+               sequence_ids.push_back(sequence_count + sequence_id);
+            }
+            position->addValues(symbol, sequence_ids, sequence_count, other.sequence_count);
+            sequence_ids.clear();
+         }
+      }
+   });
+
+   missing_symbol_bitmaps.insert(
+      missing_symbol_bitmaps.end(),
+      other.missing_symbol_bitmaps.begin(),
+      other.missing_symbol_bitmaps.end()
+   );
+   sequence_count += other.sequence_count;
+}
+
 template <typename Symbol>
-size_t silo::SequenceStorePartition<Symbol>::fill(ZstdFastaTableReader& input) {
-   static constexpr size_t BUFFER_SIZE = 1024;
+size_t silo::SequenceStorePartition<Symbol>::fill(
+   ZstdFastaTableReader& input,
+   const SequenceIngestionOptions& options
+) {
+   // Reading, decompressing and interpreting the genomes overlap in a pipeline of batches. Reading
+   // and interpreting keep the order of the input, several batches may be decompressed at once
+   static constexpr size_t MAX_LIVE_BATCHES = 4;
+   using GenomeBatch = std::vector<std::optional<std::string>>;
 
    input.loadTable();
 
+   tbb::enumerable_thread_specific<ZstdDecompressor> decompressors(
+      [&]() { return ZstdDecompressor(input.getCompressionDict()); }
+   );
    size_t read_sequences_count = 0;
 
-   std::vector<std::optional<std::string>> genome_buffer;
-
-   std::optional<std::string> key;
-   std::optional<std::string> genome;
-   while (true) {
-      key = input.next(genome);
-      if (!key) {
-         break;
+   const auto read_batches = tbb::make_filter<void, GenomeBatch>(
+      tbb::filter_mode::serial_in_order,
+      [&](tbb::flow_control& control) {
+         GenomeBatch compressed_genomes;
+         std::optional<std::string> compressed_genome;
+         while (compressed_genomes.size() < options.buffer_size
+                && input.nextCompressed(compressed_genome)) {
+            compressed_genomes.push_back(std::move(compressed_genome));
+         }
+         if (compressed_genomes.empty()) {
+            control.stop();
+         }
+         read_sequences_count += compressed_genomes.size();
+         return compressed_genomes;
+      }
+   );
+   const auto decompress_batches = tbb::make_filter<GenomeBatch, GenomeBatch>(
+      tbb::filter_mode::parallel,
+      [&](GenomeBatch genomes) {
+         tbb::parallel_for(tbb::blocked_range<size_t>(0, genomes.size()), [&](const auto& local) {
+            auto& decompressor = decompressors.local();
+            for (size_t index = local.begin(); index != local.end(); ++index) {
+               auto& genome = genomes[index];
+               if (genome.has_value()) {
+                  genome = std::string(decompressor.decompress(*genome));
+               }
+            }
+         });
+         return genomes;
       }
-      genome_buffer.push_back(std::move(genome));
-      if (genome_buffer.size() >= BUFFER_SIZE) {
-         interpret(genome_buffer);
-         genome_buffer.clear();
+   );
+   const auto interpret_batches = tbb::make_filter<GenomeBatch, void>(
+      tbb::filter_mode::serial_in_order,
+      [&](const GenomeBatch& genomes) { interpret(genomes, options); }
+   );
+   tbb::parallel_pipeline(MAX_LIVE_BATCHES, read_batches & decompress_batches & interpret_batches);
+
+   const SequenceStoreInfo info_before_optimisation = getInfo();
+   optimizeBitmaps();
+
+   SPDLOG_DEBUG(
+      "Sequence store partition info after filling it: {}, and after optimising: {}",
+      info_before_optimisation,
+      getInfo()
+   );
+
+   return read_sequences_count;
+}
+
+template <typename SymbolType>
+size_t silo::SequenceStorePartition<SymbolType>::fill(
+   preprocessing::MutationListTableReader<SymbolType>& input,
+   const SequenceIngestionOptions& options
+) {
+   input.loadTable();
+
+   size_t read_sequences_count = 0;
+
+   std::vector<std::optional<SequenceDifferences<SymbolType>>> differences_buffer;
+
+   std::optional<SequenceDifferences<SymbolType>> differences;
+   while (input.next(differences)) {
+      differences_buffer.push_back(std::move(differences));
+      if (differences_buffer.size() >= options.buffer_size) {
+         interpretDifferences(differences_buffer);
+         differences_buffer.clear();
       }
 
       ++read_sequences_count;
    }
-   interpret(genome_buffer);
+   interpretDifferences(differences_buffer);
    const SequenceStoreInfo info_before_optimisation = getInfo();
    optimizeBitmaps();
 
    SPDLOG_DEBUG(
-      "Sequence store partition info after filling it: {}, and after optimising: {}",
+      "Sequence store partition info after filling it from mutation lists: {}, and after "
+      "optimising: {}",
       info_before_optimisation,
       getInfo()
    );
@@ -94,45 +381,83 @@ const roaring::Roaring* silo::SequenceStorePartition<SymbolType>::getBitmap(
    size_t position,
    typename SymbolType::Symbol symbol
 ) const {
-   return positions[position].getBitmap(symbol);
+   return getPosition(position).getBitmap(symbol);
+}
+
+template <typename SymbolType>
+silo::SequenceStoreLayout silo::SequenceStorePartition<SymbolType>::getLayout() const {
+   return layout;
+}
+
+template <typename SymbolType>
+size_t silo::SequenceStorePartition<SymbolType>::getMaterializedPositionCount() const {
+   return layout == SequenceStoreLayout::DENSE ? positions.size() : sparse_positions.size();
+}
+
+template <typename SymbolType>
+const silo::Position<SymbolType>& silo::SequenceStorePartition<SymbolType>::getPosition(
+   size_t position
+) const {
+   if (layout == SequenceStoreLayout::DENSE) {
+      return positions[position];
+   }
+   const auto materialized_position = sparse_positions.find(position);
+   if (materialized_position == sparse_positions.end()) {
+      return unmaterialized_positions->at(reference_sequence[position]);
+   }
+   return materialized_position->second;
+}
+
+template <typename SymbolType>
+silo::Position<SymbolType>& silo::SequenceStorePartition<SymbolType>::materializePosition(
+   size_t position
+) {
+   auto materialized_position = sparse_positions.find(position);
+   if (materialized_position == sparse_positions.end()) {
+      materialized_position =
+         sparse_positions
+            .emplace(
+               position, Position<SymbolType>::fromInitiallyDeleted(reference_sequence[position])
+            )
+            .first;
+   }
+   return materialized_position->second;
 }
 
 template <typename SymbolType>
 void silo::SequenceStorePartition<SymbolType>::fillIndexes(
-   const std::vector<std::optional<std::string>>& genomes
+   const std::vector<std::optional<std::string>>& genomes,
+   size_t tile_size
 ) {
    const size_t genome_length = positions.size();
-   static constexpr int COUNT_SYMBOLS_PER_PROCESSOR = 64;
-   tbb::parallel_for(
-      tbb::blocked_range<size_t>(0, genome_length, genome_length / COUNT_SYMBOLS_PER_PROCESSOR),
-      [&](const auto& local) {
-         SymbolMap<SymbolType, std::vector<uint32_t>> ids_per_symbol_for_current_position;
-         for (size_t position = local.begin(); position != local.end(); ++position) {
-            const size_t number_of_sequences = genomes.size();
+   const size_t number_of_sequences = genomes.size();
+   const size_t tile_count = (genome_length + tile_size - 1) / tile_size;
+   static PerfCounterAccumulator& perf_counters = PerfCounters::stage("fillIndexes");
+   tbb::parallel_for(tbb::blocked_range<size_t>(0, tile_count), [&](const auto& local) {
+      const PerfCounterBlock perf_counter_block(&perf_counters);
+      std::vector<uint8_t> tile(tile_size * number_of_sequences);
+      SymbolMap<SymbolType, std::vector<uint32_t>> ids_per_symbol_for_current_position;
+      for (size_t tile_index = local.begin(); tile_index != local.end(); ++tile_index) {
+         const size_t tile_begin = tile_index * tile_size;
+         const size_t tile_width = std::min(tile_size, genome_length - tile_begin);
+         transposeTile<SymbolType>(genomes, tile_begin, tile_width, tile.data());
+
+         for (size_t offset = 0; offset < tile_width; ++offset) {
+            const uint8_t* symbols = tile.data() + offset * number_of_sequences;
             for (size_t sequence_id = 0; sequence_id < number_of_sequences; ++sequence_id) {
-               const auto& genome = genomes[sequence_id];
-               if (!genome.has_value()) {
-                  continue;
-               }
-               char const character = genome.value()[position];
-               const auto symbol = SymbolType::charToSymbol(character);
-               if (!symbol.has_value()) {
-                  throw silo::preprocessing::PreprocessingException(
-                     "Illegal character " + std::to_string(character) + " contained in sequence."
-                  );
-               }
+               const auto symbol = static_cast<typename SymbolType::Symbol>(symbols[sequence_id]);
                if (symbol != SymbolType::SYMBOL_MISSING) {
-                  ids_per_symbol_for_current_position[*symbol].push_back(
+                  ids_per_symbol_for_current_position[symbol].push_back(
                      sequence_count + sequence_id
                   );
                }
             }
             addSymbolsToPositions(
-               position, ids_per_symbol_for_current_position, number_of_sequences
+               tile_begin + offset, ids_per_symbol_for_current_position, number_of_sequences
             );
          }
       }
-   );
+   });
 }
 
 template <typename SymbolType>
@@ -154,11 +479,15 @@ void silo::SequenceStorePartition<SymbolType>::fillNBitmaps(
    const std::vector<std::optional<std::string>>& genomes
 ) {
    const size_t genome_length = positions.size();
+   const auto& lookup_table = symbolLookupTable<SymbolType>();
+   const auto missing_symbol = static_cast<uint8_t>(SymbolType::SYMBOL_MISSING);
 
    missing_symbol_bitmaps.resize(sequence_count + genomes.size());
 
+   static PerfCounterAccumulator& perf_counters = PerfCounters::stage("fillNBitmaps");
    const tbb::blocked_range<size_t> range(0, genomes.size());
    tbb::parallel_for(range, [&](const decltype(range)& local) {
+      const PerfCounterBlock perf_counter_block(&perf_counters);
       std::vector<uint32_t> positions_with_symbol_missing;
       for (size_t sequence_index = local.begin(); sequence_index != local.end(); ++sequence_index) {
          const auto& maybe_genome = genomes[sequence_index];
@@ -172,9 +501,7 @@ void silo::SequenceStorePartition<SymbolType>::fillNBitmaps(
          const auto& genome = maybe_genome.value();
 
          for (size_t position = 0; position < genome_length; ++position) {
-            char const character = genome[position];
-            const auto symbol = SymbolType::charToSymbol(character);
-            if (symbol == SymbolType::SYMBOL_MISSING) {
+            if (lookup_table[static_cast<uint8_t>(genome[position])] == missing_symbol) {
                positions_with_symbol_missing.push_back(position);
             }
          }
@@ -191,10 +518,22 @@ void silo::SequenceStorePartition<SymbolType>::fillNBitmaps(
 
 template <typename Symbol>
 void silo::SequenceStorePartition<Symbol>::optimizeBitmaps() {
+   static PerfCounterAccumulator& perf_counters = PerfCounters::stage("optimizeBitmaps");
+   if (layout == SequenceStoreLayout::SPARSE) {
+      // The reference symbol stays deleted at materialized positions, so that they agree with
+      // the positions that were never materialized
+      tbb::parallel_for_each(sparse_positions.begin(), sparse_positions.end(), [](auto& entry) {
+         const PerfCounterBlock perf_counter_block(&perf_counters);
+         entry.second.optimizeStoredBitmaps();
+      });
+      return;
+   }
+
    tbb::enumerable_thread_specific<decltype(indexing_differences_to_reference_sequence)>
       index_changes_to_reference;
 
    tbb::parallel_for(tbb::blocked_range<uint32_t>(0, positions.size()), [&](const auto& local) {
+      const PerfCounterBlock perf_counter_block(&perf_counters);
       auto& local_index_changes = index_changes_to_reference.local();
       for (auto position = local.begin(); position != local.end(); ++position) {
          auto symbol_changed = positions[position].deleteMostNumerousBitmap(sequence_count);
@@ -212,19 +551,199 @@ void silo::SequenceStorePartition<Symbol>::optimizeBitmaps() {
 
 template <typename SymbolType>
 void silo::SequenceStorePartition<SymbolType>::interpret(
-   const std::vector<std::optional<std::string>>& genomes
+   const std::vector<std::optional<std::string>>& genomes,
+   const SequenceIngestionOptions& options
 ) {
-   fillIndexes(genomes);
+   if (layout == SequenceStoreLayout::SPARSE) {
+      std::vector<std::optional<SequenceDifferences<SymbolType>>> sequences(genomes.size());
+      tbb::parallel_for(tbb::blocked_range<size_t>(0, genomes.size()), [&](const auto& local) {
+         for (size_t index = local.begin(); index != local.end(); ++index) {
+            if (genomes[index].has_value()) {
+               sequences[index] = computeDifferences(*genomes[index]);
+            }
+         }
+      });
+      interpretDifferences(sequences);
+      return;
+   }
+   for (const auto& genome : genomes) {
+      if (genome.has_value() && genome->size() != reference_sequence.size()) {
+         throw silo::preprocessing::PreprocessingException(fmt::format(
+            "Sequence of length {} does not match the reference of length {}",
+            genome->size(),
+            reference_sequence.size()
+         ));
+      }
+   }
+   fillIndexes(genomes, options.tile_size);
    fillNBitmaps(genomes);
    sequence_count += genomes.size();
 }
 
+template <typename SymbolType>
+silo::SequenceDifferences<SymbolType> silo::SequenceStorePartition<SymbolType>::computeDifferences(
+   const std::string& genome
+) const {
+   if (genome.size() != reference_sequence.size()) {
+      throw silo::preprocessing::PreprocessingException(fmt::format(
+         "Sequence of length {} does not match the reference of length {}",
+         genome.size(),
+         reference_sequence.size()
+      ));
+   }
+   SequenceDifferences<SymbolType> differences;
+   for (uint32_t position = 0; position < genome.size(); ++position) {
+      char const character = genome[position];
+      const auto symbol = SymbolType::charToSymbol(character);
+      if (!symbol.has_value()) {
+         throw silo::preprocessing::PreprocessingException(
+            "Illegal character " + std::to_string(character) + " contained in sequence."
+         );
+      }
+      if (*symbol == SymbolType::SYMBOL_MISSING) {
+         auto& missing_ranges = differences.missing_ranges;
+         if (!missing_ranges.empty() && missing_ranges.back().second == position) {
+            missing_ranges.back().second = position + 1;
+         } else {
+            missing_ranges.emplace_back(position, position + 1);
+         }
+      } else if (*symbol != reference_sequence[position]) {
+         differences.substitutions.emplace_back(position, *symbol);
+      }
+   }
+   return differences;
+}
+
+template <typename SymbolType>
+void silo::SequenceStorePartition<SymbolType>::interpretDifferences(
+   const std::vector<std::optional<SequenceDifferences<SymbolType>>>& sequences
+) {
+   const size_t genome_length = reference_sequence.size();
+   for (const auto& differences : sequences) {
+      if (differences.has_value()) {
+         checkDifferencesWithinReference(*differences, genome_length);
+      }
+   }
+
+   missing_symbol_bitmaps.resize(sequence_count + sequences.size());
+   tbb::parallel_for(tbb::blocked_range<size_t>(0, sequences.size()), [&](const auto& local) {
+      for (size_t index = local.begin(); index != local.end(); ++index) {
+         auto& missing_symbol_bitmap = missing_symbol_bitmaps[sequence_count + index];
+         const auto& differences = sequences[index];
+         if (!differences.has_value()) {
+            missing_symbol_bitmap.addRange(0, genome_length);
+            missing_symbol_bitmap.runOptimize();
+            continue;
+         }
+         for (const auto& [start, end] : differences->missing_ranges) {
+            missing_symbol_bitmap.addRange(start, end);
+         }
+         for (const auto& [position, symbol] : differences->substitutions) {
+            if (symbol == SymbolType::SYMBOL_MISSING) {
+               missing_symbol_bitmap.add(position);
+            }
+         }
+         missing_symbol_bitmap.runOptimize();
+      }
+   });
+
+   // (position, symbol, sequence id) for every symbol that differs from the reference. Dense
+   // stores also need the missing symbols, because their flipped reference bitmaps contain every
+   // sequence that does not have the reference symbol
+   const bool collect_missing_symbols = layout == SequenceStoreLayout::DENSE;
+   std::vector<std::tuple<uint32_t, typename SymbolType::Symbol, uint32_t>> symbol_occurrences;
+   for (uint32_t index = 0; index < sequences.size(); ++index) {
+      const uint32_t sequence_id = sequence_count + index;
+      const auto& differences = sequences[index];
+      if (!differences.has_value()) {
+         if (collect_missing_symbols) {
+            for (uint32_t position = 0; position < genome_length; ++position) {
+               symbol_occurrences.emplace_back(position, SymbolType::SYMBOL_MISSING, sequence_id);
+            }
+         }
+         continue;
+      }
+      for (const auto& [position, symbol] : differences->substitutions) {
+         if (symbol == reference_sequence[position]
+             || (symbol == SymbolType::SYMBOL_MISSING && !collect_missing_symbols)) {
+            continue;
+         }
+         symbol_occurrences.emplace_back(position, symbol, sequence_id);
+      }
+      if (collect_missing_symbols) {
+         for (const auto& [start, end] : differences->missing_ranges) {
+            for (uint32_t position = start; position < end; ++position) {
+               symbol_occurrences.emplace_back(position, SymbolType::SYMBOL_MISSING, sequence_id);
+            }
+         }
+      }
+   }
+   tbb::parallel_sort(symbol_occurrences.begin(), symbol_occurrences.end());
+
+   std::vector<std::pair<size_t, size_t>> occurrence_ranges;
+   std::vector<Position<SymbolType>*> touched_positions;
+   for (size_t begin = 0; begin < symbol_occurrences.size();) {
+      const uint32_t position = std::get<0>(symbol_occurrences[begin]);
+      size_t end = begin;
+      while (end < symbol_occurrences.size() && std::get<0>(symbol_occurrences[end]) == position) {
+         ++end;
+      }
+      occurrence_ranges.emplace_back(begin, end);
+      touched_positions.push_back(
+         layout == SequenceStoreLayout::DENSE ? &positions[position]
+                                              : &materializePosition(position)
+      );
+      begin = end;
+   }
+
+   const tbb::blocked_range<size_t> range(0, touched_positions.size());
+   tbb::parallel_for(range, [&](const decltype(range)& local) {
+      std::vector<uint32_t> sequence_ids;
+      roaring::Roaring sequences_without_reference;
+      for (size_t index = local.begin(); index != local.end(); ++index) {
+         auto [begin, end] = occurrence_ranges[index];
+         const uint32_t position = std::get<0>(symbol_occurrences[begin]);
+         while (begin < end) {
+            const auto symbol = std::get<1>(symbol_occurrences[begin]);
+            for (; begin < end && std::get<1>(symbol_occurrences[begin]) == symbol; ++begin) {
+               sequence_ids.push_back(std::get<2>(symbol_occurrences[begin]));
+            }
+            if (layout == SequenceStoreLayout::DENSE) {
+               sequences_without_reference.addMany(sequence_ids.size(), sequence_ids.data());
+            }
+            if (symbol != SymbolType::SYMBOL_MISSING) {
+               touched_positions[index]->addValues(
+                  symbol, sequence_ids, sequence_count, sequences.size()
+               );
+            }
+            sequence_ids.clear();
+         }
+         if (layout == SequenceStoreLayout::DENSE) {
+            // Positions that no sequence differs at can be skipped, because the flipped reference
+            // bitmap does not contain any of the new sequences there
+            roaring::Roaring sequences_with_reference;
+            sequences_with_reference.addRange(sequence_count, sequence_count + sequences.size());
+            sequences_with_reference -= sequences_without_reference;
+            sequence_ids.resize(sequences_with_reference.cardinality());
+            sequences_with_reference.toUint32Array(sequence_ids.data());
+            touched_positions[index]->addValues(
+               reference_sequence[position], sequence_ids, sequence_count, sequences.size()
+            );
+            sequence_ids.clear();
+            sequences_without_reference = roaring::Roaring();
+         }
+      }
+   });
+
+   sequence_count += sequences.size();
+}
+
 template <typename SymbolType>
 size_t silo::SequenceStorePartition<SymbolType>::computeSize() const {
    size_t result = 0;
-   for (const auto& position : positions) {
+   forEachMaterializedPosition([&](size_t /*position_index*/, const auto& position) {
       result += position.computeSize();
-   }
+   });
    return result;
 }
 
@@ -232,11 +751,43 @@ template <typename SymbolType>
 silo::SequenceStore<SymbolType>::SequenceStore(
    std::vector<typename SymbolType::Symbol> reference_sequence
 )
-    : reference_sequence(std::move(reference_sequence)) {}
+    : shared_reference_sequence(
+         std::make_shared<const std::vector<typename SymbolType::Symbol>>(
+            std::move(reference_sequence)
+         )
+      ),
+      reference_sequence(*shared_reference_sequence),
+      layout(defaultSequenceStoreLayout(this->reference_sequence.size())) {}
+
+template <typename SymbolType>
+silo::SequenceStore<SymbolType>::SequenceStore(
+   std::vector<typename SymbolType::Symbol> reference_sequence,
+   SequenceStoreLayout layout
+)
+    : shared_reference_sequence(
+         std::make_shared<const std::vector<typename SymbolType::Symbol>>(
+            std::move(reference_sequence)
+         )
+      ),
+      reference_sequence(*shared_reference_sequence),
+      layout(layout) {}
 
 template <typename Symbol>
 silo::SequenceStorePartition<Symbol>& silo::SequenceStore<Symbol>::createPartition() {
-   return partitions.emplace_back(reference_sequence);
+   return *partitions.emplace_back(
+      std::make_shared<SequenceStorePartition<Symbol>>(shared_reference_sequence, layout)
+   );
+}
+
+template <typename Symbol>
+silo::SequenceStorePartition<Symbol>& silo::SequenceStore<Symbol>::sharePartition(
+   size_t partition_index,
+   const SequenceStore<Symbol>& other,
+   size_t other_partition_index
+) {
+   auto& partition = partitions.at(partition_index);
+   partition = other.partitions.at(other_partition_index);
+   return *partition;
 }
 template class silo::SequenceStorePartition<silo::Nucleotide>;
 template class silo::SequenceStorePartition<silo::AminoAcid>;
@@ -0,0 +1,208 @@
+#include "silo/storage/sequence_store.h"
+
+#include <optional>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <boost/archive/binary_iarchive.hpp>
+#include <boost/archive/binary_oarchive.hpp>
+#include <boost/serialization/array.hpp>
+#include <boost/serialization/map.hpp>
+#include <boost/serialization/utility.hpp>
+#include <boost/serialization/vector.hpp>
+#include <duckdb.hpp>
+#include <roaring/roaring.hh>
+
+#include "silo/common/fasta_reader.h"
+#include "silo/common/nucleotide_symbols.h"
+#include "silo/preprocessing/preprocessing_exception.h"
+#include "silo/roaring/roaring_serialize.h"
+#include "silo/storage/serialize_optional.h"
+#include "silo/zstdfasta/zstdfasta_table.h"
+#include "silo/zstdfasta/zstdfasta_table_reader.h"
+
+using silo::Nucleotide;
+using silo::SequenceDifferences;
+using silo::SequenceStore;
+using silo::SequenceStoreLayout;
+using silo::SequenceStorePartition;
+
+namespace {
+
+roaring::Roaring sequencesWithSymbol(
+   const SequenceStorePartition<Nucleotide>& partition,
+   size_t position_index,
+   Nucleotide::Symbol symbol
+) {
+   roaring::Roaring result;
+   if (symbol == Nucleotide::SYMBOL_MISSING) {
+      for (uint32_t sequence_id = 0; sequence_id < partition.sequence_count; ++sequence_id) {
+         if (partition.missing_symbol_bitmaps[sequence_id].contains(position_index)) {
+            result.add(sequence_id);
+         }
+      }
+      return result;
+   }
+   const auto& position = partition.getPosition(position_index);
+   if (position.isSymbolDeleted(symbol)) {
+      result.addRange(0, partition.sequence_count);
+      for (const auto other_symbol : Nucleotide::SYMBOLS) {
+         if (other_symbol != symbol) {
+            result -= sequencesWithSymbol(partition, position_index, other_symbol);
+         }
+      }
+      return result;
+   }
+   result = *position.getBitmap(symbol);
+   if (position.isSymbolFlipped(symbol)) {
+      result.flip(0, partition.sequence_count);
+   }
+   return result;
+}
+
+const std::vector<Nucleotide::Symbol> REFERENCE =
+   Nucleotide::stringToSymbolVector("ACGT").value();
+
+const std::vector<std::optional<std::string>> GENOMES{"ACGT", "ACTT", std::nullopt, "NCG-"};
+
+void assertContainsGenomes(const SequenceStorePartition<Nucleotide>& partition) {
+   ASSERT_EQ(partition.sequence_count, 4);
+   EXPECT_EQ(sequencesWithSymbol(partition, 0, Nucleotide::Symbol::A), roaring::Roaring({0, 1}));
+   EXPECT_EQ(sequencesWithSymbol(partition, 0, Nucleotide::Symbol::N), roaring::Roaring({2, 3}));
+   EXPECT_EQ(
+      sequencesWithSymbol(partition, 1, Nucleotide::Symbol::C), roaring::Roaring({0, 1, 3})
+   );
+   EXPECT_EQ(sequencesWithSymbol(partition, 2, Nucleotide::Symbol::G), roaring::Roaring({0, 3}));
+   EXPECT_EQ(sequencesWithSymbol(partition, 2, Nucleotide::Symbol::T), roaring::Roaring({1}));
+   EXPECT_EQ(sequencesWithSymbol(partition, 3, Nucleotide::Symbol::T), roaring::Roaring({0, 1}));
+   EXPECT_EQ(sequencesWithSymbol(partition, 3, Nucleotide::Symbol::GAP), roaring::Roaring({3}));
+}
+
+}  // namespace
+
+TEST(SequenceStore, denseLayoutContainsInterpretedGenomes) {
+   SequenceStore<Nucleotide> store(REFERENCE, SequenceStoreLayout::DENSE);
+   auto& partition = store.createPartition();
+
+   partition.interpret(GENOMES);
+
+   assertContainsGenomes(partition);
+   EXPECT_EQ(partition.getMaterializedPositionCount(), REFERENCE.size());
+}
+
+TEST(SequenceStore, denseLayoutContainsInterpretedGenomesForAnyTileSize) {
+   for (const size_t tile_size : {1, 3, 4, 64}) {
+      SequenceStore<Nucleotide> store(REFERENCE, SequenceStoreLayout::DENSE);
+      auto& partition = store.createPartition();
+
+      partition.interpret(GENOMES, {.buffer_size = GENOMES.size(), .tile_size = tile_size});
+
+      assertContainsGenomes(partition);
+   }
+}
+
+TEST(SequenceStore, rejectsIllegalCharactersAndGenomesOfWrongLength) {
+   SequenceStore<Nucleotide> store(REFERENCE, SequenceStoreLayout::DENSE);
+   auto& partition = store.createPartition();
+
+   EXPECT_THROW(partition.interpret({"ACGT", "AC?T"}), silo::preprocessing::PreprocessingException);
+   EXPECT_THROW(partition.interpret({"ACG"}), silo::preprocessing::PreprocessingException);
+}
+
+TEST(SequenceStore, fillsFromZstdFastaTableInOrderOfTheInput) {
+   silo::FastaReader file_reader("testBaseData/fastaFiles/test.fasta");
+   duckdb::DuckDB duck_db(nullptr);
+   duckdb::Connection connection(duck_db);
+   silo::ZstdFastaTable::generate(connection, "test", file_reader, "ACGT");
+
+   SequenceStore<Nucleotide> store(REFERENCE, SequenceStoreLayout::DENSE);
+   auto& partition = store.createPartition();
+   silo::ZstdFastaTableReader sequence_input(connection, "test", "ACGT", "sequence", "true", "");
+
+   EXPECT_EQ(partition.fill(sequence_input, {.buffer_size = 1, .tile_size = 2}), 2);
+
+   ASSERT_EQ(partition.sequence_count, 2);
+   EXPECT_EQ(sequencesWithSymbol(partition, 0, Nucleotide::Symbol::A), roaring::Roaring({0}));
+   EXPECT_EQ(sequencesWithSymbol(partition, 0, Nucleotide::Symbol::C), roaring::Roaring({1}));
+   EXPECT_EQ(sequencesWithSymbol(partition, 3, Nucleotide::Symbol::A), roaring::Roaring({1}));
+}
+
+TEST(SequenceStore, sparseLayoutOnlyMaterializesPositionsWithVariation) {
+   SequenceStore<Nucleotide> store(REFERENCE, SequenceStoreLayout::SPARSE);
+   auto& partition = store.createPartition();
+
+   partition.interpret(GENOMES);
+
+   assertContainsGenomes(partition);
+   EXPECT_EQ(partition.getMaterializedPositionCount(), 2);
+}
+
+TEST(SequenceStore, interpretsDifferencesInBothLayouts) {
+   const std::vector<std::optional<SequenceDifferences<Nucleotide>>> sequences{
+      SequenceDifferences<Nucleotide>{},
+      SequenceDifferences<Nucleotide>{{{2, Nucleotide::Symbol::T}}, {}},
+      std::nullopt,
+      SequenceDifferences<Nucleotide>{{{3, Nucleotide::Symbol::GAP}}, {{0, 1}}}
+   };
+
+   for (const auto layout : {SequenceStoreLayout::DENSE, SequenceStoreLayout::SPARSE}) {
+      SequenceStore<Nucleotide> store(REFERENCE, layout);
+      auto& partition = store.createPartition();
+
+      partition.interpretDifferences(sequences);
+
+      assertContainsGenomes(partition);
+   }
+}
+
+TEST(SequenceStore, sparseLayoutAppendsPartitions) {
+   SequenceStore<Nucleotide> store(REFERENCE, SequenceStoreLayout::SPARSE);
+   auto& partition = store.createPartition();
+   auto& other_partition = store.createPartition();
+
+   partition.interpret({GENOMES[0], GENOMES[1]});
+   other_partition.interpret({GENOMES[2], GENOMES[3]});
+   partition.append(other_partition);
+
+   assertContainsGenomes(partition);
+}
+
+TEST(SequenceStore, keepsTheSerializedLayoutWhenLoading) {
+   SequenceStore<Nucleotide> store(REFERENCE, SequenceStoreLayout::SPARSE);
+   auto& partition = store.createPartition();
+   partition.interpret(GENOMES);
+
+   std::stringstream buffer;
+   {
+      ::boost::archive::binary_oarchive output_archive(buffer);
+      output_archive << partition;
+   }
+
+   // The default layout of the short reference is DENSE
+   SequenceStore<Nucleotide> loaded_store(REFERENCE);
+   ASSERT_EQ(loaded_store.layout, SequenceStoreLayout::DENSE);
+   auto& loaded_partition = loaded_store.createPartition();
+   {
+      ::boost::archive::binary_iarchive input_archive(buffer);
+      input_archive >> loaded_partition;
+   }
+
+   EXPECT_EQ(loaded_partition.getLayout(), SequenceStoreLayout::SPARSE);
+   EXPECT_EQ(loaded_partition.getMaterializedPositionCount(), 2);
+   assertContainsGenomes(loaded_partition);
+}
+
+TEST(SequenceStore, rejectsDifferencesOutsideOfTheReference) {
+   SequenceStore<Nucleotide> store(REFERENCE, SequenceStoreLayout::SPARSE);
+   auto& partition = store.createPartition();
+
+   const std::vector<std::optional<SequenceDifferences<Nucleotide>>> sequences{
+      SequenceDifferences<Nucleotide>{{{4, Nucleotide::Symbol::A}}, {}}
+   };
+
+   EXPECT_THROW(
+      partition.interpretDifferences(sequences), silo::preprocessing::PreprocessingException
+   );
+}
@@ -1,7 +1,9 @@
 #include "silo/storage/unaligned_sequence_store.h"
 
 #include <array>
+#include <filesystem>
 #include <string>
+#include <system_error>
 #include <utility>
 #include <vector>
 
@@ -18,6 +20,37 @@
 #include "silo/preprocessing/preprocessing_exception.h"
 #include "silo/zstdfasta/zstdfasta_table_reader.h"
 
+namespace {
+
+std::string readSQL(const std::filesystem::path& folder_path, size_t partition_id) {
+   return fmt::format(
+      "SELECT * FROM read_parquet('{}/*/*.parquet', hive_partitioning = 1) "
+      "WHERE partition_id = {}",
+      folder_path.string(),
+      partition_id
+   );
+}
+
+/// Falls back to copying the files that cannot be hard linked, e.g. across file systems
+void linkOrCopyFolder(const std::filesystem::path& source, const std::filesystem::path& target) {
+   std::filesystem::create_directories(target);
+   for (const auto& entry : std::filesystem::recursive_directory_iterator(source)) {
+      const std::filesystem::path target_path =
+         target / std::filesystem::relative(entry.path(), source);
+      if (entry.is_directory()) {
+         std::filesystem::create_directories(target_path);
+         continue;
+      }
+      std::error_code error;
+      std::filesystem::create_hard_link(entry.path(), target_path, error);
+      if (error) {
+         std::filesystem::copy_file(entry.path(), target_path);
+      }
+   }
+}
+
+}  // namespace
+
 silo::UnalignedSequenceStorePartition::UnalignedSequenceStorePartition(
    std::string sql_for_reading_file,
    const std::string& compression_dictionary
@@ -38,15 +71,47 @@ silo::UnalignedSequenceStore::UnalignedSequenceStore(
 
 silo::UnalignedSequenceStorePartition& silo::UnalignedSequenceStore::createPartition() {
    const size_t partition_id = partitions.size();
-   return partitions.emplace_back(
-      fmt::format(
-         "SELECT * FROM read_parquet('{}/*/*.parquet', hive_partitioning = 1) "
-         "WHERE partition_id = {}",
-         folder_path.string(),
-         partition_id
-      ),
-      compression_dictionary
-   );
+   return partitions.emplace_back(readSQL(folder_path, partition_id), compression_dictionary);
+}
+
+std::filesystem::path silo::UnalignedSequenceStore::partitionFilename(size_t partition_id) const {
+   return folder_path / fmt::format("partition_id={}", partition_id);
+}
+
+void silo::UnalignedSequenceStore::relocateFolder(const std::filesystem::path& new_folder_path) {
+   if (folder_path.lexically_normal() == new_folder_path.lexically_normal()) {
+      return;
+   }
+   if (std::filesystem::exists(new_folder_path)) {
+      std::filesystem::remove_all(new_folder_path);
+   }
+   if (std::filesystem::exists(folder_path)) {
+      linkOrCopyFolder(folder_path, new_folder_path);
+   } else {
+      std::filesystem::create_directories(new_folder_path);
+   }
+   folder_path = new_folder_path;
+   for (size_t partition_id = 0; partition_id < partitions.size(); ++partition_id) {
+      partitions[partition_id].sql_for_reading_file = readSQL(folder_path, partition_id);
+   }
+}
+
+void silo::UnalignedSequenceStore::mergeLastPartitionInto(size_t target_partition_id) {
+   const size_t partition_id = partitions.size() - 1;
+   const std::filesystem::path partition_folder = partitionFilename(partition_id);
+   if (std::filesystem::exists(partition_folder)) {
+      const std::filesystem::path target_folder = partitionFilename(target_partition_id);
+      std::filesystem::create_directories(target_folder);
+      for (const auto& file : std::filesystem::directory_iterator(partition_folder)) {
+         std::filesystem::rename(
+            file.path(),
+            target_folder /
+               fmt::format("merged_{}_{}", partition_id, file.path().filename().string())
+         );
+      }
+      std::filesystem::remove_all(partition_folder);
+   }
+   partitions.pop_back();
 }
 
 void silo::UnalignedSequenceStore::saveFolder(const std::filesystem::path& save_location) const {
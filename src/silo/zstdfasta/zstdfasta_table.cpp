@@ -1,8 +1,16 @@
 #include "silo/zstdfasta/zstdfasta_table.h"
 
+#include <memory>
+#include <string>
+#include <vector>
+
 #include <fmt/format.h>
+#include <oneapi/tbb/enumerable_thread_specific.h>
+#include <oneapi/tbb/parallel_pipeline.h>
+#include <oneapi/tbb/task_arena.h>
 #include <duckdb.hpp>
 
+#include "silo/common/fasta_block_reader.h"
 #include "silo/common/fasta_reader.h"
 #include "silo/preprocessing/preprocessing_exception.h"
 #include "silo/zstdfasta/zstd_compressor.h"
@@ -94,6 +102,72 @@ ZstdFastaTable ZstdFastaTable::generate(
    return {connection, table_name, reference_sequence};
 }
 
+ZstdFastaTable ZstdFastaTable::generate(
+   duckdb::Connection& connection,
+   const std::string& table_name,
+   FastaBlockReader& file_reader,
+   std::string_view reference_sequence
+) {
+   struct CompressedBlock {
+      std::vector<std::string> keys;
+      std::vector<std::string> sequences;
+   };
+   const auto max_live_blocks = static_cast<size_t>(2 * tbb::this_task_arena::max_concurrency());
+
+   initializeTable(connection, table_name);
+   tbb::enumerable_thread_specific<ZstdCompressor> compressors(
+      [&]() { return ZstdCompressor(reference_sequence); }
+   );
+   duckdb::Appender appender(connection, table_name);
+
+   const auto read_blocks = tbb::make_filter<void, std::shared_ptr<FastaBlock>>(
+      tbb::filter_mode::serial_in_order,
+      [&](tbb::flow_control& control) {
+         auto block = std::make_shared<FastaBlock>();
+         if (!file_reader.next(*block)) {
+            control.stop();
+         }
+         return block;
+      }
+   );
+   const auto compress_blocks = tbb::make_filter<std::shared_ptr<FastaBlock>, CompressedBlock>(
+      tbb::filter_mode::parallel,
+      [&](const std::shared_ptr<FastaBlock>& block) {
+         std::vector<FastaRecord> records;
+         FastaBlockReader::parse(block->text, records);
+         auto& compressor = compressors.local();
+         CompressedBlock compressed_block;
+         compressed_block.keys.reserve(records.size());
+         compressed_block.sequences.reserve(records.size());
+         for (const auto& record : records) {
+            compressed_block.keys.emplace_back(record.key);
+            compressed_block.sequences.emplace_back(
+               compressor.compress(record.genome.data(), record.genome.size())
+            );
+         }
+         return compressed_block;
+      }
+   );
+   const auto append_blocks = tbb::make_filter<CompressedBlock, void>(
+      tbb::filter_mode::serial_in_order,
+      [&](const CompressedBlock& compressed_block) {
+         for (size_t index = 0; index < compressed_block.keys.size(); ++index) {
+            const std::string& compressed = compressed_block.sequences[index];
+            const auto* compressed_data = reinterpret_cast<const unsigned char*>(compressed.data());
+            const duckdb::string_t key_value = compressed_block.keys[index];
+            appender.BeginRow();
+            appender.Append(key_value);
+            appender.Append(duckdb::Value::BLOB(compressed_data, compressed.size()));
+            appender.EndRow();
+         }
+      }
+   );
+   tbb::parallel_pipeline(max_live_blocks, read_blocks & compress_blocks & append_blocks);
+
+   appender.Close();
+   return {connection, table_name, reference_sequence};
+}
+
 ZstdFastaTableReader ZstdFastaTable::getReader(
    std::string_view where_clause,
    std::string_view order_by_clause
@@ -24,6 +24,7 @@ silo::ZstdFastaTableReader::ZstdFastaTableReader(
       sequence_column(sequence_column),
       where_clause(where_clause),
       order_by_clause(order_by_clause),
+      compression_dict(compression_dict),
       decompressor(std::make_unique<ZstdDecompressor>(compression_dict)) {
    SPDLOG_TRACE("Initializing ZstdFastaTableReader for table {}", table_name);
 }
@@ -66,6 +67,10 @@ std::optional<std::string> silo::ZstdFastaTableReader::nextCompressed(
    return key;
 }
 
+const std::string& silo::ZstdFastaTableReader::getCompressionDict() const {
+   return compression_dict;
+}
+
 std::optional<std::string> silo::ZstdFastaTableReader::next(std::optional<std::string>& genome) {
    std::optional<std::string> compressed_buffer;
    auto key = nextCompressed(compressed_buffer);
@@ -1,3 +1,4 @@
+#include <cstdint>
 #include <filesystem>
 #include <iostream>
 #include <optional>
@@ -9,6 +10,7 @@
 #include <Poco/Net/HTTPServer.h>
 #include <Poco/Net/HTTPServerParams.h>
 #include <Poco/Net/ServerSocket.h>
+#include <Poco/ThreadPool.h>
 #include <Poco/Util/AbstractConfiguration.h>
 #include <Poco/Util/Application.h>
 #include <Poco/Util/HelpFormatter.h>
@@ -19,16 +21,20 @@
 #include <spdlog/spdlog.h>
 #include <boost/algorithm/string/join.hpp>
 
+#include "silo/common/perf_counters.h"
 #include "silo/config/config_repository.h"
 #include "silo/config/database_config.h"
 #include "silo/preprocessing/preprocessing_config.h"
 #include "silo/preprocessing/preprocessing_config_reader.h"
 #include "silo/preprocessing/preprocessor.h"
 #include "silo/preprocessing/sql_function.h"
+#include "silo/roaring/roaring_allocator.h"
 #include "silo/storage/reference_genomes.h"
 #include "silo_api/database_directory_watcher.h"
 #include "silo_api/database_mutex.h"
+#include "silo_api/hot_queries.h"
 #include "silo_api/logging.h"
+#include "silo_api/query_scheduler.h"
 #include "silo_api/request_handler_factory.h"
 #include "silo_api/runtime_config.h"
 
@@ -95,6 +101,8 @@ std::filesystem::path dataDirectory(
 }
 
 class SiloServer : public Poco::Util::ServerApplication {
+   static constexpr uint32_t ADDITIONAL_SERVER_THREADS = 4;
+
   protected:
    [[maybe_unused]] void defineOptions(Poco::Util::OptionSet& options) override {
       ServerApplication::defineOptions(options);
@@ -128,6 +136,16 @@ class SiloServer : public Poco::Util::ServerApplication {
                            .argument("PATH")
                            .binding("dataDirectory"));
 
+      options.addOption(Poco::Util::Option(
+                           "performanceCounters",
+                           "pf",
+                           "record hardware performance counters of query phases and build "
+                           "stages in the performance log"
+      )
+                           .required(false)
+                           .repeatable(false)
+                           .binding("performanceCounters"));
+
       options.addOption(
          Poco::Util::Option("api", "a", "Execution mode: start the SILO web interface")
             .required(false)
@@ -156,6 +174,10 @@ class SiloServer : public Poco::Util::ServerApplication {
          return Application::EXIT_USAGE;
       }
 
+      if (config().hasProperty("performanceCounters")) {
+         silo::PerfCounters::enable();
+      }
+
       if (config().hasProperty("api")) {
          return handleApi();
       }
@@ -173,7 +195,6 @@ class SiloServer : public Poco::Util::ServerApplication {
   private:
    int handleApi() {
       SPDLOG_INFO("Starting SILO API");
-      const int port = 8081;
 
       silo_api::RuntimeConfig runtime_config;
       if (std::filesystem::exists("./runtime_config.yaml")) {
@@ -183,18 +204,33 @@ class SiloServer : public Poco::Util::ServerApplication {
       const auto data_directory = dataDirectory(config(), runtime_config);
 
       silo_api::DatabaseMutex database_mutex;
+      silo_api::HotQueries hot_queries;
+      silo_api::QueryScheduler query_scheduler(runtime_config.query_scheduler);
 
-      const Poco::Net::ServerSocket server_socket(port);
+      const Poco::Net::ServerSocket server_socket(runtime_config.port);
 
-      const silo_api::DatabaseDirectoryWatcher watcher(data_directory, database_mutex);
+      const silo_api::DatabaseDirectoryWatcher watcher(data_directory, database_mutex, hot_queries);
+
+      // Queued queries wait on their connection thread, so there must be a thread for every query
+      // that the scheduler admits or queues, plus some for cheap requests such as /info
+      const auto& scheduler_config = runtime_config.query_scheduler;
+      const int max_threads = static_cast<int>(
+         scheduler_config.max_concurrent_queries + scheduler_config.max_queued_queries +
+         ADDITIONAL_SERVER_THREADS
+      );
+      Poco::ThreadPool thread_pool(2, max_threads);
+      auto* server_params = new Poco::Net::HTTPServerParams;
+      server_params->setMaxThreads(max_threads);
+      server_params->setMaxQueued(static_cast<int>(scheduler_config.max_queued_queries));
 
       Poco::Net::HTTPServer server(
-         new silo_api::SiloRequestHandlerFactory(database_mutex),
+         new silo_api::SiloRequestHandlerFactory(database_mutex, hot_queries, query_scheduler),
+         thread_pool,
          server_socket,
-         new Poco::Net::HTTPServerParams
+         server_params
       );
 
-      SPDLOG_INFO("Listening on port {}", port);
+      SPDLOG_INFO("Listening on port {}", runtime_config.port);
 
       server.start();
       waitForTerminationRequest();
@@ -258,6 +294,7 @@ class SiloServer : public Poco::Util::ServerApplication {
 };
 
 int main(int argc, char** argv) {
+   silo::installRoaringAllocator();
    setupLogger();
 
    SPDLOG_INFO("Starting SILO");
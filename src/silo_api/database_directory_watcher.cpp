@@ -1,5 +1,6 @@
 #include "silo_api/database_directory_watcher.h"
 
+#include <chrono>
 #include <cxxabi.h>
 #include <fstream>
 #include <optional>
@@ -9,16 +10,21 @@
 
 #include <spdlog/spdlog.h>
 
+#include "silo/common/block_timer.h"
 #include "silo/common/data_version.h"
+#include "silo/common/metrics.h"
 #include "silo/database.h"
 #include "silo_api/database_mutex.h"
+#include "silo_api/hot_queries.h"
 
 silo_api::DatabaseDirectoryWatcher::DatabaseDirectoryWatcher(
    std::filesystem::path path,
-   DatabaseMutex& database_mutex
+   DatabaseMutex& database_mutex,
+   const HotQueries& hot_queries
 )
     : path(std::move(path)),
       database_mutex(database_mutex),
+      hot_queries(hot_queries),
       timer(0, 2000) {
    timer.start(Poco::TimerCallback<DatabaseDirectoryWatcher>(
       *this, &DatabaseDirectoryWatcher::checkDirectoryForData
@@ -110,9 +116,60 @@ std::optional<std::pair<std::filesystem::path, silo::DataVersion>> getMostRecent
    return *max_element;
 }
 
+constexpr size_t WARM_UP_QUERY_COUNT = 50;
+/// The new data version is only published after the warm-up, so it must not delay it for long
+constexpr std::chrono::seconds WARM_UP_TIME_BUDGET{10};
+
 }  // namespace
 
+void silo_api::DatabaseDirectoryWatcher::warmUp(silo::Database& database) const {
+   const auto queries = hot_queries.getMostFrequent(WARM_UP_QUERY_COUNT);
+   if (queries.empty()) {
+      return;
+   }
+   const auto deadline = std::chrono::steady_clock::now() + WARM_UP_TIME_BUDGET;
+   size_t executed_count = 0;
+   size_t skipped_count = 0;
+   int64_t warm_up_time;
+   {
+      const BlockTimer timer(warm_up_time);
+      for (const auto& query : queries) {
+         if (std::chrono::steady_clock::now() >= deadline) {
+            SPDLOG_INFO(
+               "Warm-up of the new database exceeded its budget of {} seconds",
+               WARM_UP_TIME_BUDGET.count()
+            );
+            break;
+         }
+         try {
+            if (database.warmUpQuery(query)) {
+               ++executed_count;
+            } else {
+               ++skipped_count;
+            }
+         } catch (const std::exception& ex) {
+            SPDLOG_WARN("Warm-up query failed on the new database: {}", ex.what());
+         }
+      }
+   }
+   SPDLOG_INFO(
+      "Warmed up new database with {} of {} queries in {} microseconds, skipped {} exports",
+      executed_count,
+      queries.size(),
+      warm_up_time,
+      skipped_count
+   );
+   database.setWarmUpTime(warm_up_time);
+}
+
 void silo_api::DatabaseDirectoryWatcher::checkDirectoryForData(Poco::Timer& /*timer*/) {
+   const size_t retired_databases_in_use = database_mutex.releaseRetiredDatabases();
+   if (retired_databases_in_use > 0) {
+      SPDLOG_DEBUG(
+         "{} replaced database(s) are still in use by running queries", retired_databases_in_use
+      );
+   }
+
    auto most_recent_database_state = getMostRecentDataDirectory(path);
 
    if (most_recent_database_state == std::nullopt) {
@@ -135,8 +192,33 @@ void silo_api::DatabaseDirectoryWatcher::checkDirectoryForData(Poco::Timer& /*ti
 
    SPDLOG_INFO("New data version detected: {}", most_recent_database_state->first.string());
    try {
-      database_mutex.setDatabase(silo::Database::loadDatabaseState(most_recent_database_state->first
-      ));
+      int64_t load_time;
+      int64_t swap_time;
+      {
+         const BlockTimer timer(load_time);
+         const auto previous_database = database_mutex.getDatabase();
+         auto database = silo::Database::loadDatabaseState(
+            most_recent_database_state->first, &previous_database.database
+         );
+         warmUp(database);
+         const BlockTimer swap_timer(swap_time);
+         database_mutex.setDatabase(std::move(database));
+      }
+      auto& registry = silo::MetricRegistry::get();
+      registry
+         .histogram(
+            "silo_database_load_duration_seconds",
+            "Time to load, warm up and publish a new data version",
+            {},
+            silo::DATABASE_LOAD_DURATION_BUCKETS
+         )
+         .observe(silo::microsecondsToSeconds(load_time));
+      registry
+         .histogram(
+            "silo_database_swap_duration_seconds",
+            "Time to replace the served database by a loaded one"
+         )
+         .observe(silo::microsecondsToSeconds(swap_time));
    } catch (const std::exception& ex) {
       SPDLOG_ERROR(ex.what());
    } catch (const std::string& ex) {
@@ -1,23 +1,50 @@
 #include "silo_api/database_mutex.h"
 
+#include <algorithm>
+#include <memory>
 #include <mutex>
 #include <utility>
 
+#include <spdlog/spdlog.h>
+
 #include "silo/database.h"
 
-silo_api::FixedDatabase::FixedDatabase(
-   const silo::Database& database,
-   std::shared_lock<std::shared_mutex>&& mutex
-)
-    : lock(std::move(mutex)),
-      database(database) {}
+silo_api::FixedDatabase::FixedDatabase(std::shared_ptr<const silo::Database> snapshot)
+    : snapshot(std::move(snapshot)),
+      database(*this->snapshot) {}
+
+silo_api::DatabaseMutex::DatabaseMutex()
+    : database(std::make_shared<const silo::Database>()) {}
 
 void silo_api::DatabaseMutex::setDatabase(silo::Database&& new_database) {
-   const std::unique_lock lock(mutex);
-   database = std::move(new_database);
+   auto old_database =
+      database.exchange(std::make_shared<const silo::Database>(std::move(new_database)));
+
+   const std::lock_guard lock(retired_databases_mutex);
+   retired_databases.emplace_back(std::move(old_database));
+}
+
+size_t silo_api::DatabaseMutex::releaseRetiredDatabases() {
+   // Destroying a database can take a while, therefore do it outside of the lock
+   std::vector<std::shared_ptr<const silo::Database>> unused_databases;
+   size_t databases_in_use;
+   {
+      const std::lock_guard lock(retired_databases_mutex);
+      auto still_in_use = std::partition(
+         retired_databases.begin(),
+         retired_databases.end(),
+         [](const auto& retired_database) { return retired_database.use_count() > 1; }
+      );
+      std::move(still_in_use, retired_databases.end(), std::back_inserter(unused_databases));
+      retired_databases.erase(still_in_use, retired_databases.end());
+      databases_in_use = retired_databases.size();
+   }
+   if (!unused_databases.empty()) {
+      SPDLOG_INFO("Freeing {} retired database(s)", unused_databases.size());
+   }
+   return databases_in_use;
 }
 
 silo_api::FixedDatabase silo_api::DatabaseMutex::getDatabase() {
-   std::shared_lock<std::shared_mutex> lock(mutex);
-   return {database, std::move(lock)};
+   return FixedDatabase{database.load()};
 }
@@ -0,0 +1,43 @@
+#include "silo_api/database_mutex.h"
+
+#include <gtest/gtest.h>
+
+#include "silo/common/data_version.h"
+#include "silo/database.h"
+
+// NOLINTBEGIN(bugprone-unchecked-optional-access)
+
+namespace {
+silo::Database databaseWithVersion(const std::string& version) {
+   silo::Database database;
+   database.setDataVersion(silo::DataVersion::fromString(version).value());
+   return database;
+}
+}  // namespace
+
+TEST(DatabaseMutex, pinnedSnapshotSurvivesReplacement) {
+   silo_api::DatabaseMutex under_test;
+   under_test.setDatabase(databaseWithVersion("1"));
+
+   const auto snapshot = under_test.getDatabase();
+   under_test.setDatabase(databaseWithVersion("2"));
+
+   EXPECT_EQ(snapshot.database.getDataVersion().toString(), "1");
+   EXPECT_EQ(under_test.getDatabase().database.getDataVersion().toString(), "2");
+}
+
+TEST(DatabaseMutex, releasesRetiredDatabaseOnlyAfterLastReaderFinished) {
+   silo_api::DatabaseMutex under_test;
+   under_test.setDatabase(databaseWithVersion("1"));
+   EXPECT_EQ(under_test.releaseRetiredDatabases(), 0);
+
+   {
+      const auto snapshot = under_test.getDatabase();
+      under_test.setDatabase(databaseWithVersion("2"));
+      EXPECT_EQ(under_test.releaseRetiredDatabases(), 1);
+   }
+
+   EXPECT_EQ(under_test.releaseRetiredDatabases(), 0);
+}
+
+// NOLINTEND(bugprone-unchecked-optional-access)
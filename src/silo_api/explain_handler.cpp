@@ -0,0 +1,99 @@
+#include "silo_api/explain_handler.h"
+
+#include <cxxabi.h>
+#include <string>
+
+#include <Poco/Net/HTTPResponse.h>
+#include <Poco/Net/HTTPServerRequest.h>
+#include <Poco/Net/HTTPServerResponse.h>
+#include <Poco/StreamCopier.h>
+#include <spdlog/spdlog.h>
+#include <nlohmann/json.hpp>
+
+#include "silo/query_engine/query_cancelled_exception.h"
+#include "silo/query_engine/query_parse_exception.h"
+#include "silo/query_engine/query_profile.h"
+#include "silo_api/database_mutex.h"
+#include "silo_api/error_request_handler.h"
+#include "silo_api/query_scheduler.h"
+#include "silo_api/request_query_context.h"
+
+namespace silo_api {
+
+ExplainHandler::ExplainHandler(
+   silo_api::DatabaseMutex& database_mutex,
+   silo_api::QueryScheduler& query_scheduler
+)
+    : database_mutex(database_mutex),
+      query_scheduler(query_scheduler) {}
+
+void ExplainHandler::post(
+   Poco::Net::HTTPServerRequest& request,
+   Poco::Net::HTTPServerResponse& response
+) {
+   std::string query;
+   std::istream& istream = request.stream();
+   Poco::StreamCopier::copyToString(istream, query);
+
+   SPDLOG_INFO("received query to explain: {}", query);
+
+   response.setContentType("application/json");
+   try {
+      const auto query_context =
+         createQueryContext(request, query_scheduler.getDefaultQueryTimeout());
+      const auto fixed_database = database_mutex.getDatabase();
+
+      const auto cost_class = QueryScheduler::estimateCostClass(query);
+      const auto query_profile = query_scheduler.run(cost_class, *query_context, [&]() {
+         return fixed_database.database.explainQuery(query);
+      });
+
+      response.set("data-version", fixed_database.database.getDataVersion().toString());
+
+      std::ostream& out_stream = response.send();
+      out_stream << nlohmann::json{{"queryProfile", query_profile}};
+   } catch (const silo::QueryParseException& ex) {
+      SPDLOG_INFO("Query to explain is invalid: " + query);
+      response.setStatus(Poco::Net::HTTPResponse::HTTP_BAD_REQUEST);
+      std::ostream& out_stream = response.send();
+      out_stream << nlohmann::json(ErrorResponse{"Bad request", ex.what()});
+   } catch (const silo::QueryCancelledException& ex) {
+      SPDLOG_INFO("Query to explain was cancelled: {}", ex.what());
+      response.setStatus(Poco::Net::HTTPResponse::HTTP_REQUEST_TIMEOUT);
+      std::ostream& out_stream = response.send();
+      out_stream << nlohmann::json(ErrorResponse{"Request Timeout", ex.what()});
+   } catch (const QueryQueueFullException& ex) {
+      SPDLOG_WARN(ex.what());
+      response.setStatus(Poco::Net::HTTPResponse::HTTP_SERVICE_UNAVAILABLE);
+      std::ostream& out_stream = response.send();
+      out_stream << nlohmann::json(ErrorResponse{"Service Unavailable", ex.what()});
+   } catch (const std::exception& ex) {
+      SPDLOG_ERROR(ex.what());
+      response.setStatus(Poco::Net::HTTPResponse::HTTP_INTERNAL_SERVER_ERROR);
+      std::ostream& out_stream = response.send();
+      out_stream << nlohmann::json(ErrorResponse{"Internal Server Error", ex.what()});
+   } catch (const std::string& ex) {
+      SPDLOG_ERROR(ex);
+      response.setStatus(Poco::Net::HTTPResponse::HTTP_INTERNAL_SERVER_ERROR);
+      std::ostream& out_stream = response.send();
+      out_stream << nlohmann::json(ErrorResponse{"Internal Server Error", ex});
+   } catch (...) {
+      SPDLOG_ERROR("Query to explain cancelled with uncatchable (...) exception");
+      const auto exception = std::current_exception();
+      if (exception) {
+         const auto* message = abi::__cxa_current_exception_type()->name();
+         SPDLOG_ERROR("current_exception: {}", message);
+         response.setStatus(Poco::Net::HTTPResponse::HTTP_INTERNAL_SERVER_ERROR);
+         std::ostream& out_stream = response.send();
+         out_stream << nlohmann::json(ErrorResponse{"Internal Server Error", message});
+      } else {
+         response.setStatus(Poco::Net::HTTPResponse::HTTP_INTERNAL_SERVER_ERROR);
+         std::ostream& out_stream = response.send();
+         out_stream << nlohmann::json(
+            ErrorResponse{"Internal Server Error", "non recoverable error message"}
+         );
+      }
+   }
+}
+
+}  // namespace silo_api
\ No newline at end of file
@@ -0,0 +1,65 @@
+#include "silo_api/hot_queries.h"
+
+#include <algorithm>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace silo_api {
+
+void HotQueries::decay() {
+   for (auto it = frequencies.begin(); it != frequencies.end();) {
+      it->second /= 2;
+      if (it->second == 0) {
+         it = frequencies.erase(it);
+      } else {
+         ++it;
+      }
+   }
+   recorded_since_decay = 0;
+}
+
+void HotQueries::evictLeastFrequent() {
+   const auto least_frequent = std::min_element(
+      frequencies.begin(),
+      frequencies.end(),
+      [](const auto& left, const auto& right) { return left.second < right.second; }
+   );
+   frequencies.erase(least_frequent);
+}
+
+void HotQueries::record(const std::string& query) {
+   const std::lock_guard lock(mutex);
+   if (++recorded_since_decay >= DECAY_INTERVAL) {
+      decay();
+   }
+   auto existing = frequencies.find(query);
+   if (existing != frequencies.end()) {
+      ++existing->second;
+      return;
+   }
+   if (frequencies.size() >= MAX_DISTINCT_QUERIES) {
+      evictLeastFrequent();
+   }
+   frequencies.emplace(query, 1);
+}
+
+std::vector<std::string> HotQueries::getMostFrequent(size_t count) const {
+   std::vector<std::pair<std::string, uint64_t>> sorted_queries;
+   {
+      const std::lock_guard lock(mutex);
+      sorted_queries.assign(frequencies.begin(), frequencies.end());
+   }
+   std::sort(sorted_queries.begin(), sorted_queries.end(), [](const auto& left, const auto& right) {
+      return left.second > right.second;
+   });
+
+   std::vector<std::string> result;
+   for (size_t i = 0; i < std::min(count, sorted_queries.size()); ++i) {
+      result.emplace_back(std::move(sorted_queries[i].first));
+   }
+   return result;
+}
+
+}  // namespace silo_api
@@ -0,0 +1,44 @@
+#include "silo_api/hot_queries.h"
+
+#include <gtest/gtest.h>
+
+TEST(HotQueries, returnsMostFrequentQueriesFirst) {
+   silo_api::HotQueries under_test;
+   under_test.record("rare");
+   under_test.record("frequent");
+   under_test.record("medium");
+   under_test.record("frequent");
+   under_test.record("medium");
+   under_test.record("frequent");
+
+   const std::vector<std::string> expected{"frequent", "medium"};
+   EXPECT_EQ(under_test.getMostFrequent(2), expected);
+   EXPECT_EQ(under_test.getMostFrequent(10).size(), 3);
+}
+
+TEST(HotQueries, forgetsQueriesThatWereOnlyRecordedLongAgo) {
+   silo_api::HotQueries under_test;
+   under_test.record("old");
+   for (int i = 0; i < 20000; ++i) {
+      under_test.record("new");
+   }
+
+   const std::vector<std::string> expected{"new"};
+   EXPECT_EQ(under_test.getMostFrequent(10), expected);
+}
+
+TEST(HotQueries, replacesTheLeastFrequentQueryWhenFull) {
+   silo_api::HotQueries under_test;
+   for (int query = 0; query < 1000; ++query) {
+      under_test.record("old_" + std::to_string(query));
+      under_test.record("old_" + std::to_string(query));
+   }
+   under_test.record("old_0");
+   for (int i = 0; i < 4; ++i) {
+      under_test.record("new");
+   }
+
+   EXPECT_EQ(under_test.getMostFrequent(1000).size(), 1000);
+   const std::vector<std::string> expected{"new", "old_0"};
+   EXPECT_EQ(under_test.getMostFrequent(2), expected);
+}
@@ -11,9 +11,19 @@
 #include "silo/common/nucleotide_symbols.h"
 #include "silo/database_info.h"
 #include "silo_api/database_mutex.h"
+#include "silo_api/query_scheduler.h"
 
 namespace silo {
 
+// NOLINTNEXTLINE(readability-identifier-naming)
+void to_json(nlohmann::json& json, const NumaNodeInfo& numaNodeInfo) {
+   json = nlohmann::json{
+      {"partitionCount", numaNodeInfo.partition_count},
+      {"sequenceCount", numaNodeInfo.sequence_count},
+      {"totalSize", numaNodeInfo.total_size}
+   };
+}
+
 // NOLINTNEXTLINE(readability-identifier-naming)
 void to_json(nlohmann::json& json, const DatabaseInfo& databaseInfo) {
    json = nlohmann::json{
@@ -21,6 +31,12 @@ void to_json(nlohmann::json& json, const DatabaseInfo& databaseInfo) {
       {"totalSize", databaseInfo.total_size},
       {"nBitmapsSize", databaseInfo.n_bitmaps_size}
    };
+   if (databaseInfo.warm_up_time_in_microseconds.has_value()) {
+      json["warmUpTimeInMicroseconds"] = databaseInfo.warm_up_time_in_microseconds.value();
+   }
+   if (!databaseInfo.numa_nodes.empty()) {
+      json["numaNodes"] = databaseInfo.numa_nodes;
+   }
 }
 
 // NOLINTNEXTLINE(readability-identifier-naming)
@@ -74,6 +90,42 @@ void to_json(nlohmann::json& json, const DetailedDatabaseInfo& databaseInfo) {
 
 namespace silo_api {
 
+// NOLINTNEXTLINE(readability-identifier-naming)
+void to_json(nlohmann::json& json, const QueryCostClassStatistics& statistics) {
+   json = nlohmann::json{
+      {"queuedQueries", statistics.queued_queries},
+      {"runningQueries", statistics.running_queries},
+      {"admittedQueries", statistics.admitted_queries},
+      {"rejectedQueries", statistics.rejected_queries},
+      {"cancelledQueries", statistics.cancelled_queries},
+      {"averageWaitTimeInMicroseconds",
+       statistics.admitted_queries == 0
+          ? 0
+          : statistics.total_wait_time_in_microseconds / statistics.admitted_queries},
+      {"maxWaitTimeInMicroseconds", statistics.max_wait_time_in_microseconds}
+   };
+}
+
+// NOLINTNEXTLINE(readability-identifier-naming)
+void to_json(nlohmann::json& json, const QuerySchedulerInfo& info) {
+   uint64_t queued_queries = 0;
+   uint64_t running_queries = 0;
+   nlohmann::json cost_classes;
+   for (size_t index = 0; index < QUERY_COST_CLASS_COUNT; ++index) {
+      const auto& statistics = info.cost_classes[index];
+      queued_queries += statistics.queued_queries;
+      running_queries += statistics.running_queries;
+      cost_classes[toString(static_cast<QueryCostClass>(index))] = statistics;
+   }
+   json = nlohmann::json{
+      {"maxConcurrentQueries", info.max_concurrent_queries},
+      {"maxQueuedQueries", info.max_queued_queries},
+      {"queuedQueries", queued_queries},
+      {"runningQueries", running_queries},
+      {"costClasses", cost_classes}
+   };
+}
+
 std::map<std::string, std::string> getQueryParameter(const Poco::Net::HTTPServerRequest& request) {
    std::map<std::string, std::string> map;
    const Poco::URI uri(request.getURI());
@@ -85,8 +137,9 @@ std::map<std::string, std::string> getQueryParameter(const Poco::Net::HTTPServer
    return map;
 }
 
-InfoHandler::InfoHandler(DatabaseMutex& database)
-    : database(database) {}
+InfoHandler::InfoHandler(DatabaseMutex& database, const QueryScheduler& query_scheduler)
+    : database(database),
+      query_scheduler(query_scheduler) {}
 
 void InfoHandler::get(
    Poco::Net::HTTPServerRequest& request,
@@ -100,9 +153,12 @@ void InfoHandler::get(
 
    const bool return_detailed_info = request_parameter.find("details") != request_parameter.end() &&
                                      request_parameter.at("details") == "true";
-   const nlohmann::json database_info =
-      return_detailed_info ? nlohmann::json(database.getDatabase().database.detailedDatabaseInfo())
-                           : nlohmann::json(database.getDatabase().database.getDatabaseInfo());
+   nlohmann::json database_info =
+      return_detailed_info ? nlohmann::json(fixed_database.database.detailedDatabaseInfo())
+                           : nlohmann::json(fixed_database.database.getDatabaseInfo());
+   if (!return_detailed_info) {
+      database_info["queryScheduler"] = query_scheduler.getInfo();
+   }
    response.setContentType("application/json");
    std::ostream& out_stream = response.send();
    out_stream << database_info;
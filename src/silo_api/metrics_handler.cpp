@@ -0,0 +1,152 @@
+#include "silo_api/metrics_handler.h"
+
+#include <sstream>
+#include <string>
+#include <string_view>
+
+#include <Poco/Net/HTTPServerRequest.h>
+#include <Poco/Net/HTTPServerResponse.h>
+
+#include "silo/common/metrics.h"
+#include "silo/database.h"
+#include "silo/database_info.h"
+#include "silo_api/database_mutex.h"
+#include "silo_api/query_scheduler.h"
+
+namespace silo_api {
+
+namespace {
+
+using silo::MetricLabels;
+using silo::PrometheusTextWriter;
+
+template <typename ValueOf>
+void writePerCostClass(
+   PrometheusTextWriter& writer,
+   const QuerySchedulerInfo& info,
+   std::string_view name,
+   std::string_view help,
+   std::string_view type,
+   ValueOf value_of
+) {
+   writer.writeFamily(name, help, type);
+   for (size_t index = 0; index < QUERY_COST_CLASS_COUNT; ++index) {
+      const MetricLabels labels{{"cost_class", toString(static_cast<QueryCostClass>(index))}};
+      writer.writeSample(name, labels, static_cast<double>(value_of(info.cost_classes[index])));
+   }
+}
+
+void writeSchedulerMetrics(PrometheusTextWriter& writer, const QuerySchedulerInfo& info) {
+   writePerCostClass(
+      writer,
+      info,
+      "silo_queries_running",
+      "Queries that are currently executed (in flight)",
+      "gauge",
+      [](const QueryCostClassStatistics& statistics) { return statistics.running_queries; }
+   );
+   writePerCostClass(
+      writer,
+      info,
+      "silo_queries_queued",
+      "Queries that are currently waiting for a free slot",
+      "gauge",
+      [](const QueryCostClassStatistics& statistics) { return statistics.queued_queries; }
+   );
+   writePerCostClass(
+      writer,
+      info,
+      "silo_queries_admitted_total",
+      "Queries that were admitted by the query scheduler",
+      "counter",
+      [](const QueryCostClassStatistics& statistics) { return statistics.admitted_queries; }
+   );
+   writePerCostClass(
+      writer,
+      info,
+      "silo_queries_rejected_total",
+      "Queries that were rejected because the queue was full",
+      "counter",
+      [](const QueryCostClassStatistics& statistics) { return statistics.rejected_queries; }
+   );
+   writePerCostClass(
+      writer,
+      info,
+      "silo_queries_cancelled_total",
+      "Queries that were cancelled at their deadline or because the client disconnected",
+      "counter",
+      [](const QueryCostClassStatistics& statistics) { return statistics.cancelled_queries; }
+   );
+
+   writer.writeFamily(
+      "silo_queries_max_concurrent", "Number of queries that may run at the same time", "gauge"
+   );
+   writer.writeSample("silo_queries_max_concurrent", {}, info.max_concurrent_queries);
+   writer.writeFamily(
+      "silo_queries_max_queued",
+      "Number of waiting queries above which queries are rejected",
+      "gauge"
+   );
+   writer.writeSample("silo_queries_max_queued", {}, info.max_queued_queries);
+}
+
+void writeDatabaseMetrics(PrometheusTextWriter& writer, const silo::Database& database) {
+   writer.writeFamily(
+      "silo_data_version_info", "The data version of the served database, as label", "gauge"
+   );
+   writer.writeSample(
+      "silo_data_version_info", {{"data_version", database.getDataVersion().toString()}}, 1
+   );
+
+   const auto memory_info = database.getMemoryInfo();
+   writer.writeFamily(
+      "silo_column_memory_bytes", "Memory held by the values of a metadata column", "gauge"
+   );
+   for (const auto& [name, size] : memory_info.column_sizes) {
+      writer.writeSample("silo_column_memory_bytes", {{"column", name}}, static_cast<double>(size));
+   }
+   writer.writeFamily(
+      "silo_sequence_store_memory_bytes",
+      "Memory held by the position bitmaps of a sequence store",
+      "gauge"
+   );
+   for (const auto& [name, size] : memory_info.nucleotide_sequence_sizes) {
+      writer.writeSample(
+         "silo_sequence_store_memory_bytes",
+         {{"sequence", name}, {"type", "nucleotide"}},
+         static_cast<double>(size)
+      );
+   }
+   for (const auto& [name, size] : memory_info.amino_acid_sequence_sizes) {
+      writer.writeSample(
+         "silo_sequence_store_memory_bytes",
+         {{"sequence", name}, {"type", "amino_acid"}},
+         static_cast<double>(size)
+      );
+   }
+}
+
+}  // namespace
+
+MetricsHandler::MetricsHandler(DatabaseMutex& database, const QueryScheduler& query_scheduler)
+    : database(database),
+      query_scheduler(query_scheduler) {}
+
+void MetricsHandler::get(
+   Poco::Net::HTTPServerRequest& /*request*/,
+   Poco::Net::HTTPServerResponse& response
+) {
+   const auto fixed_database = database.getDatabase();
+
+   std::ostringstream metrics;
+   PrometheusTextWriter writer(metrics);
+   silo::MetricRegistry::get().write(writer);
+   writeSchedulerMetrics(writer, query_scheduler.getInfo());
+   writeDatabaseMetrics(writer, fixed_database.database);
+
+   response.setContentType(std::string(PrometheusTextWriter::CONTENT_TYPE));
+   std::ostream& out_stream = response.send();
+   out_stream << metrics.str();
+}
+
+}  // namespace silo_api
@@ -10,14 +10,25 @@
 #include <spdlog/spdlog.h>
 #include <nlohmann/json.hpp>
 
+#include "silo/common/metrics.h"
+#include "silo/query_engine/query_cancelled_exception.h"
 #include "silo/query_engine/query_parse_exception.h"
 #include "silo_api/database_mutex.h"
 #include "silo_api/error_request_handler.h"
+#include "silo_api/hot_queries.h"
+#include "silo_api/query_scheduler.h"
+#include "silo_api/request_query_context.h"
 
 namespace silo_api {
 
-QueryHandler::QueryHandler(silo_api::DatabaseMutex& database_mutex)
-    : database_mutex(database_mutex) {}
+QueryHandler::QueryHandler(
+   silo_api::DatabaseMutex& database_mutex,
+   silo_api::HotQueries& hot_queries,
+   silo_api::QueryScheduler& query_scheduler
+)
+    : database_mutex(database_mutex),
+      hot_queries(hot_queries),
+      query_scheduler(query_scheduler) {}
 
 void QueryHandler::post(
    Poco::Net::HTTPServerRequest& request,
@@ -31,19 +42,43 @@ void QueryHandler::post(
 
    response.setContentType("application/json");
    try {
+      const auto query_context =
+         createQueryContext(request, query_scheduler.getDefaultQueryTimeout());
       const auto fixed_database = database_mutex.getDatabase();
 
-      const auto query_result = fixed_database.database.executeQuery(query);
+      const auto cost_class = QueryScheduler::estimateCostClass(query);
+      const auto query_result = query_scheduler.run(cost_class, *query_context, [&]() {
+         return fixed_database.database.executeQuery(query);
+      });
+      hot_queries.record(query);
 
       response.set("data-version", fixed_database.database.getDataVersion().toString());
 
       std::ostream& out_stream = response.send();
-      out_stream << nlohmann::json(query_result);
+      const std::string body = nlohmann::json(query_result).dump();
+      silo::MetricRegistry::get()
+         .counter(
+            "silo_query_result_bytes_total",
+            "Bytes of the query results sent to clients, by endpoint",
+            {{"endpoint", "/query"}}
+         )
+         .increment(static_cast<double>(body.size()));
+      out_stream << body;
    } catch (const silo::QueryParseException& ex) {
       SPDLOG_INFO("Query is invalid: " + query);
       response.setStatus(Poco::Net::HTTPResponse::HTTP_BAD_REQUEST);
       std::ostream& out_stream = response.send();
       out_stream << nlohmann::json(ErrorResponse{"Bad request", ex.what()});
+   } catch (const silo::QueryCancelledException& ex) {
+      SPDLOG_INFO("Query was cancelled: {}", ex.what());
+      response.setStatus(Poco::Net::HTTPResponse::HTTP_REQUEST_TIMEOUT);
+      std::ostream& out_stream = response.send();
+      out_stream << nlohmann::json(ErrorResponse{"Request Timeout", ex.what()});
+   } catch (const QueryQueueFullException& ex) {
+      SPDLOG_WARN(ex.what());
+      response.setStatus(Poco::Net::HTTPResponse::HTTP_SERVICE_UNAVAILABLE);
+      std::ostream& out_stream = response.send();
+      out_stream << nlohmann::json(ErrorResponse{"Service Unavailable", ex.what()});
    } catch (const std::exception& ex) {
       SPDLOG_ERROR(ex.what());
       response.setStatus(Poco::Net::HTTPResponse::HTTP_INTERNAL_SERVER_ERROR);
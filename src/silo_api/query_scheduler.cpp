@@ -0,0 +1,275 @@
+#include "silo_api/query_scheduler.h"
+
+#include <algorithm>
+#include <chrono>
+#include <thread>
+
+#include <fmt/format.h>
+#include <spdlog/spdlog.h>
+#include <nlohmann/json.hpp>
+
+#include "silo/common/metrics.h"
+
+namespace silo_api {
+
+namespace {
+
+/// Details and Fasta actions with a limit up to this size only return a few rows
+constexpr uint64_t SMALL_RESULT_LIMIT = 1000;
+
+/// Filters with this many expressions (e.g. long lists of mutations) are expensive to evaluate
+constexpr size_t LARGE_FILTER_EXPRESSION_COUNT = 64;
+
+size_t toIndex(QueryCostClass cost_class) {
+   return static_cast<size_t>(cost_class);
+}
+
+QueryCostClass moreExpensive(QueryCostClass cost_class) {
+   return cost_class == QueryCostClass::LIGHT ? QueryCostClass::MEDIUM : QueryCostClass::HEAVY;
+}
+
+size_t countExpressions(const nlohmann::json& json) {
+   size_t count = json.is_object() && json.contains("type") ? 1 : 0;
+   if (json.is_structured()) {
+      for (const auto& child : json) {
+         count += countExpressions(child);
+      }
+   }
+   return count;
+}
+
+QueryCostClass estimateActionCostClass(const nlohmann::json& action) {
+   if (!action.is_object() || !action.contains("type") || !action["type"].is_string()) {
+      return QueryCostClass::LIGHT;
+   }
+   const std::string type = action["type"];
+   if (type == "Details" || type == "Fasta" || type == "FastaAligned") {
+      const auto limit = action.find("limit");
+      if (limit != action.end() && limit->is_number_unsigned() &&
+          limit->get<uint64_t>() <= SMALL_RESULT_LIMIT) {
+         return QueryCostClass::MEDIUM;
+      }
+      return QueryCostClass::HEAVY;
+   }
+   if (type == "Mutations" || type == "AminoAcidMutations" || type == "Insertions" ||
+       type == "AminoAcidInsertions") {
+      return QueryCostClass::MEDIUM;
+   }
+   if (type == "Aggregated" && action.contains("groupByFields") &&
+       action["groupByFields"].is_array() && !action["groupByFields"].empty()) {
+      return QueryCostClass::MEDIUM;
+   }
+   return QueryCostClass::LIGHT;
+}
+
+}  // namespace
+
+std::string toString(QueryCostClass cost_class) {
+   switch (cost_class) {
+      case QueryCostClass::LIGHT:
+         return "light";
+      case QueryCostClass::MEDIUM:
+         return "medium";
+      case QueryCostClass::HEAVY:
+         return "heavy";
+   }
+   return "unknown";
+}
+
+QueryQueueFullException::QueryQueueFullException(const std::string& message)
+    : std::runtime_error(message) {}
+
+QueryScheduler::Admission::Admission(
+   QueryScheduler& scheduler,
+   QueryCostClass cost_class,
+   const silo::query_engine::QueryContext& context
+)
+    : scheduler(scheduler),
+      cost_class(cost_class) {
+   scheduler.admit(cost_class, context);
+}
+
+QueryScheduler::Admission::~Admission() {
+   scheduler.release(cost_class);
+}
+
+QueryScheduler::QueryScheduler(const QuerySchedulerConfig& config)
+    : config(config),
+      heavy_arena(
+         config.heavy_query_threads > 0
+            ? static_cast<int>(config.heavy_query_threads)
+            : static_cast<int>(std::max(1U, std::thread::hardware_concurrency() / 2)),
+         1,
+         tbb::task_arena::priority::low
+      ) {
+   SPDLOG_INFO(
+      "Query scheduler admits {} concurrent queries ({} heavy) and queues up to {}",
+      config.max_concurrent_queries,
+      config.max_concurrent_heavy_queries,
+      config.max_queued_queries
+   );
+}
+
+QueryCostClass QueryScheduler::estimateCostClass(const std::string& query) {
+   return estimateCostClass(nlohmann::json::parse(query, nullptr, false));
+}
+
+QueryCostClass QueryScheduler::estimateBatchCostClass(const std::string& batch_query) {
+   const auto json = nlohmann::json::parse(batch_query, nullptr, false);
+   auto cost_class = QueryCostClass::LIGHT;
+   if (json.is_object() && json.contains("queries") && json["queries"].is_array()) {
+      for (const auto& query : json["queries"]) {
+         cost_class = std::max(cost_class, estimateCostClass(query));
+      }
+   }
+   return cost_class;
+}
+
+QueryCostClass QueryScheduler::estimateCostClass(const nlohmann::json& query) {
+   if (!query.is_object()) {
+      return QueryCostClass::LIGHT;
+   }
+   auto cost_class = QueryCostClass::LIGHT;
+   if (query.contains("action")) {
+      cost_class = estimateActionCostClass(query["action"]);
+   }
+   if (query.contains("actions") && query["actions"].is_array()) {
+      for (const auto& action : query["actions"]) {
+         cost_class = std::max(cost_class, estimateActionCostClass(action));
+      }
+   }
+   if (query.contains("filterExpression") &&
+       countExpressions(query["filterExpression"]) >= LARGE_FILTER_EXPRESSION_COUNT) {
+      cost_class = moreExpensive(cost_class);
+   }
+   return cost_class;
+}
+
+size_t QueryScheduler::waitingQueries() const {
+   size_t count = 0;
+   for (const auto& queue : waiting) {
+      count += queue.size();
+   }
+   return count;
+}
+
+void QueryScheduler::dispatch() {
+   bool admitted_any = false;
+   while (running_queries < config.max_concurrent_queries) {
+      std::deque<Ticket*>* next_queue = nullptr;
+      QueryCostClass next_class = QueryCostClass::LIGHT;
+      for (const auto cost_class :
+           {QueryCostClass::LIGHT, QueryCostClass::MEDIUM, QueryCostClass::HEAVY}) {
+         auto& queue = waiting[toIndex(cost_class)];
+         if (queue.empty()) {
+            continue;
+         }
+         if (cost_class == QueryCostClass::HEAVY &&
+             statistics[toIndex(cost_class)].running_queries >=
+                config.max_concurrent_heavy_queries) {
+            continue;
+         }
+         next_queue = &queue;
+         next_class = cost_class;
+         break;
+      }
+      if (next_queue == nullptr) {
+         break;
+      }
+      next_queue->front()->admitted = true;
+      next_queue->pop_front();
+      auto& class_statistics = statistics[toIndex(next_class)];
+      --class_statistics.queued_queries;
+      ++class_statistics.running_queries;
+      ++running_queries;
+      admitted_any = true;
+   }
+   if (admitted_any) {
+      admitted_condition.notify_all();
+   }
+}
+
+std::optional<std::chrono::milliseconds> QueryScheduler::getDefaultQueryTimeout() const {
+   return config.default_query_timeout;
+}
+
+void QueryScheduler::admit(
+   QueryCostClass cost_class,
+   const silo::query_engine::QueryContext& context
+) {
+   const auto enqueued_at = std::chrono::steady_clock::now();
+   std::unique_lock lock(mutex);
+   auto& class_statistics = statistics[toIndex(cost_class)];
+   auto& queue = waiting[toIndex(cost_class)];
+
+   Ticket ticket;
+   queue.push_back(&ticket);
+   ++class_statistics.queued_queries;
+   dispatch();
+
+   if (!ticket.admitted && waitingQueries() > config.max_queued_queries) {
+      // Nothing was pushed to this queue since, so the ticket is still at its end
+      queue.pop_back();
+      --class_statistics.queued_queries;
+      ++class_statistics.rejected_queries;
+      throw QueryQueueFullException(fmt::format(
+         "The server is busy, {} queries are already waiting. Please retry later.",
+         config.max_queued_queries
+      ));
+   }
+
+   // Waiting queries are cancelled by their deadline or by the client going away, which is only
+   // noticed by polling the context
+   while (!admitted_condition.wait_for(
+      lock, silo::query_engine::QueryContext::DISCONNECT_CHECK_INTERVAL, [&]() {
+         return ticket.admitted;
+      }
+   )) {
+      if (context.isCancelled()) {
+         queue.erase(std::find(queue.begin(), queue.end(), &ticket));
+         --class_statistics.queued_queries;
+         ++class_statistics.cancelled_queries;
+         lock.unlock();
+         context.checkCancellation();
+      }
+   }
+
+   const auto wait_time = static_cast<uint64_t>(
+      std::chrono::duration_cast<std::chrono::microseconds>(
+         std::chrono::steady_clock::now() - enqueued_at
+      )
+         .count()
+   );
+   ++class_statistics.admitted_queries;
+   class_statistics.total_wait_time_in_microseconds += wait_time;
+   class_statistics.max_wait_time_in_microseconds =
+      std::max(class_statistics.max_wait_time_in_microseconds, wait_time);
+   lock.unlock();
+   SPDLOG_DEBUG("Admitted {} query after waiting {} microseconds", toString(cost_class), wait_time);
+   silo::MetricRegistry::get()
+      .histogram(
+         "silo_query_queue_wait_seconds",
+         "Time that admitted queries waited for a free slot, by cost class",
+         {{"cost_class", toString(cost_class)}}
+      )
+      .observe(silo::microsecondsToSeconds(static_cast<int64_t>(wait_time)));
+}
+
+void QueryScheduler::countCancellation(QueryCostClass cost_class) {
+   const std::lock_guard lock(mutex);
+   ++statistics[toIndex(cost_class)].cancelled_queries;
+}
+
+void QueryScheduler::release(QueryCostClass cost_class) {
+   const std::lock_guard lock(mutex);
+   --statistics[toIndex(cost_class)].running_queries;
+   --running_queries;
+   dispatch();
+}
+
+QuerySchedulerInfo QueryScheduler::getInfo() const {
+   const std::lock_guard lock(mutex);
+   return {config.max_concurrent_queries, config.max_queued_queries, statistics};
+}
+
+}  // namespace silo_api
@@ -0,0 +1,224 @@
+#include "silo_api/query_scheduler.h"
+
+#include <chrono>
+#include <future>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using silo::query_engine::QueryContext;
+using silo_api::QueryCostClass;
+using silo_api::QueryScheduler;
+using silo_api::QuerySchedulerConfig;
+
+namespace {
+
+/// Occupies the only slot of the scheduler until the returned promise is fulfilled
+std::thread occupySlot(QueryScheduler& scheduler, std::shared_future<void> release) {
+   std::promise<void> admitted;
+   auto admitted_future = admitted.get_future();
+   std::thread holder([&scheduler, admitted = std::move(admitted), release]() mutable {
+      const QueryContext context;
+      scheduler.run(QueryCostClass::LIGHT, context, [&]() {
+         admitted.set_value();
+         release.wait();
+      });
+   });
+   admitted_future.wait();
+   return holder;
+}
+
+void waitUntilQueued(const QueryScheduler& scheduler, uint64_t count) {
+   while (true) {
+      uint64_t queued = 0;
+      for (const auto& statistics : scheduler.getInfo().cost_classes) {
+         queued += statistics.queued_queries;
+      }
+      if (queued >= count) {
+         return;
+      }
+      std::this_thread::yield();
+   }
+}
+
+}  // namespace
+
+TEST(QueryScheduler, estimatesCostClassFromActionAndFilter) {
+   EXPECT_EQ(
+      QueryScheduler::estimateCostClass(
+         R"({"action":{"type":"Aggregated"},"filterExpression":{"type":"True"}})"
+      ),
+      QueryCostClass::LIGHT
+   );
+   EXPECT_EQ(
+      QueryScheduler::estimateCostClass(
+         R"({"action":{"type":"Mutations"},"filterExpression":{"type":"True"}})"
+      ),
+      QueryCostClass::MEDIUM
+   );
+   EXPECT_EQ(
+      QueryScheduler::estimateCostClass(
+         R"({"action":{"type":"Details"},"filterExpression":{"type":"True"}})"
+      ),
+      QueryCostClass::HEAVY
+   );
+   EXPECT_EQ(
+      QueryScheduler::estimateCostClass(
+         R"({"action":{"type":"Fasta","limit":10},"filterExpression":{"type":"True"}})"
+      ),
+      QueryCostClass::MEDIUM
+   );
+   EXPECT_EQ(
+      QueryScheduler::estimateCostClass(
+         R"({"actions":[{"type":"Aggregated"},{"type":"FastaAligned"}],)"
+         R"("filterExpression":{"type":"True"}})"
+      ),
+      QueryCostClass::HEAVY
+   );
+   EXPECT_EQ(QueryScheduler::estimateCostClass("not json"), QueryCostClass::LIGHT);
+}
+
+TEST(QueryScheduler, estimatesLargeFiltersAsMoreExpensive) {
+   std::string children;
+   for (int position = 1; position <= 100; ++position) {
+      if (position > 1) {
+         children += ",";
+      }
+      children +=
+         R"({"type":"HasNucleotideMutation","position":)" + std::to_string(position) + "}";
+   }
+   const std::string query = R"({"action":{"type":"Aggregated"},"filterExpression":)"
+                             R"({"type":"Or","children":[)" +
+                             children + "]}}";
+
+   EXPECT_EQ(QueryScheduler::estimateCostClass(query), QueryCostClass::MEDIUM);
+}
+
+TEST(QueryScheduler, estimatesBatchQueryAsItsMostExpensiveQuery) {
+   EXPECT_EQ(
+      QueryScheduler::estimateBatchCostClass(
+         R"({"queries":[{"action":{"type":"Aggregated"},"filterExpression":{"type":"True"}},)"
+         R"({"action":{"type":"Insertions"},"filterExpression":{"type":"True"}}]})"
+      ),
+      QueryCostClass::MEDIUM
+   );
+}
+
+TEST(QueryScheduler, returnsTheResultOfTheQuery) {
+   QueryScheduler under_test(QuerySchedulerConfig{});
+   const QueryContext context;
+
+   EXPECT_EQ(under_test.run(QueryCostClass::LIGHT, context, []() { return 1; }), 1);
+   EXPECT_EQ(under_test.run(QueryCostClass::HEAVY, context, []() { return 2; }), 2);
+   EXPECT_THROW(
+      under_test.run(
+         QueryCostClass::HEAVY, context, []() -> int { throw std::runtime_error("failure"); }
+      ),
+      std::runtime_error
+   );
+
+   const auto info = under_test.getInfo();
+   EXPECT_EQ(info.cost_classes[static_cast<size_t>(QueryCostClass::LIGHT)].admitted_queries, 1);
+   EXPECT_EQ(info.cost_classes[static_cast<size_t>(QueryCostClass::HEAVY)].admitted_queries, 2);
+   EXPECT_EQ(info.cost_classes[static_cast<size_t>(QueryCostClass::HEAVY)].running_queries, 0);
+}
+
+TEST(QueryScheduler, rejectsQueriesWhenTheQueueIsFull) {
+   QueryScheduler under_test(QuerySchedulerConfig{1, 1, 0, 1});
+   std::promise<void> release;
+   auto holder = occupySlot(under_test, release.get_future().share());
+   const QueryContext context;
+
+   EXPECT_THROW(
+      under_test.run(QueryCostClass::LIGHT, context, []() {}), silo_api::QueryQueueFullException
+   );
+
+   release.set_value();
+   holder.join();
+   const auto info = under_test.getInfo();
+   const auto& light_statistics = info.cost_classes[static_cast<size_t>(QueryCostClass::LIGHT)];
+   EXPECT_EQ(light_statistics.rejected_queries, 1);
+   EXPECT_EQ(light_statistics.queued_queries, 0);
+}
+
+TEST(QueryScheduler, admitsCheaperQueriesFirst) {
+   QueryScheduler under_test(QuerySchedulerConfig{1, 1, 10, 1});
+   std::promise<void> release;
+   auto holder = occupySlot(under_test, release.get_future().share());
+
+   std::mutex order_mutex;
+   std::vector<QueryCostClass> order;
+   const auto record = [&](QueryCostClass cost_class) {
+      const std::lock_guard lock(order_mutex);
+      order.push_back(cost_class);
+   };
+   const QueryContext context;
+   std::thread heavy([&]() {
+      under_test.run(QueryCostClass::HEAVY, context, [&]() { record(QueryCostClass::HEAVY); });
+   });
+   waitUntilQueued(under_test, 1);
+   std::thread light([&]() {
+      under_test.run(QueryCostClass::LIGHT, context, [&]() { record(QueryCostClass::LIGHT); });
+   });
+   waitUntilQueued(under_test, 2);
+
+   release.set_value();
+   holder.join();
+   heavy.join();
+   light.join();
+
+   EXPECT_EQ(order, std::vector<QueryCostClass>({QueryCostClass::LIGHT, QueryCostClass::HEAVY}));
+   const auto info = under_test.getInfo();
+   EXPECT_GT(
+      info.cost_classes[static_cast<size_t>(QueryCostClass::HEAVY)].max_wait_time_in_microseconds,
+      0
+   );
+}
+
+TEST(QueryScheduler, cancelsWaitingQueriesAtTheirDeadline) {
+   QueryScheduler under_test(QuerySchedulerConfig{1, 1, 10, 1});
+   std::promise<void> release;
+   auto holder = occupySlot(under_test, release.get_future().share());
+   const QueryContext context(std::chrono::milliseconds{10});
+
+   bool ran = false;
+   EXPECT_THROW(
+      under_test.run(QueryCostClass::LIGHT, context, [&]() { ran = true; }),
+      silo::QueryCancelledException
+   );
+
+   release.set_value();
+   holder.join();
+   EXPECT_FALSE(ran);
+   const auto info = under_test.getInfo();
+   const auto& light_statistics = info.cost_classes[static_cast<size_t>(QueryCostClass::LIGHT)];
+   EXPECT_EQ(light_statistics.cancelled_queries, 1);
+   EXPECT_EQ(light_statistics.queued_queries, 0);
+}
+
+TEST(QueryScheduler, countsQueriesThatAreCancelledWhileRunning) {
+   QueryScheduler under_test(QuerySchedulerConfig{});
+   const QueryContext context;
+
+   EXPECT_THROW(
+      under_test.run(
+         QueryCostClass::HEAVY,
+         context,
+         [&]() {
+            context.cancel();
+            QueryContext::checkCurrent();
+         }
+      ),
+      silo::QueryCancelledException
+   );
+
+   const auto info = under_test.getInfo();
+   const auto& heavy_statistics = info.cost_classes[static_cast<size_t>(QueryCostClass::HEAVY)];
+   EXPECT_EQ(heavy_statistics.cancelled_queries, 1);
+   EXPECT_EQ(heavy_statistics.running_queries, 0);
+}
@@ -6,16 +6,25 @@
 #include <Poco/Net/HTTPServerRequest.h>
 #include <Poco/URI.h>
 
+#include "silo_api/batch_query_handler.h"
 #include "silo_api/error_request_handler.h"
+#include "silo_api/explain_handler.h"
 #include "silo_api/info_handler.h"
 #include "silo_api/logging_request_handler.h"
+#include "silo_api/metrics_handler.h"
 #include "silo_api/not_found_handler.h"
 #include "silo_api/query_handler.h"
 
 namespace silo_api {
 
-SiloRequestHandlerFactory::SiloRequestHandlerFactory(silo_api::DatabaseMutex& database)
-    : database(database) {}
+SiloRequestHandlerFactory::SiloRequestHandlerFactory(
+   silo_api::DatabaseMutex& database,
+   silo_api::HotQueries& hot_queries,
+   silo_api::QueryScheduler& query_scheduler
+)
+    : database(database),
+      hot_queries(hot_queries),
+      query_scheduler(query_scheduler) {}
 
 Poco::Net::HTTPRequestHandler* SiloRequestHandlerFactory::createRequestHandler(
    const Poco::Net::HTTPServerRequest& request
@@ -30,10 +39,19 @@ Poco::Net::HTTPRequestHandler* SiloRequestHandlerFactory::routeRequest(
    const auto& uri = Poco::URI(request.getURI());
    const auto path = uri.getPath();
    if (path == "/info") {
-      return new silo_api::InfoHandler(database);
+      return new silo_api::InfoHandler(database, query_scheduler);
    }
    if (path == "/query") {
-      return new silo_api::QueryHandler(database);
+      return new silo_api::QueryHandler(database, hot_queries, query_scheduler);
+   }
+   if (path == "/batchQuery") {
+      return new silo_api::BatchQueryHandler(database, query_scheduler);
+   }
+   if (path == "/explain") {
+      return new silo_api::ExplainHandler(database, query_scheduler);
+   }
+   if (path == "/metrics") {
+      return new silo_api::MetricsHandler(database, query_scheduler);
    }
    return new silo_api::NotFoundHandler;
 }
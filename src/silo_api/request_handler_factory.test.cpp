@@ -1,3 +1,5 @@
+#include <string>
+
 #include <Poco/Net/HTTPResponse.h>
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
@@ -5,44 +7,74 @@
 #include "silo/common/data_version.h"
 #include "silo/database.h"
 #include "silo/database_info.h"
+#include "silo/query_engine/query_profile.h"
 #include "silo/query_engine/query_result.h"
 #include "silo_api/database_mutex.h"
+#include "silo_api/hot_queries.h"
 #include "silo_api/manual_poco_mocks.test.h"
+#include "silo_api/query_scheduler.h"
 #include "silo_api/request_handler_factory.h"
+#include "silo_api/request_query_context.h"
 
 // NOLINTBEGIN(bugprone-unchecked-optional-access)
 
+namespace {
+
+const std::string IDLE_COST_CLASS =
+   R"({"admittedQueries":0,"averageWaitTimeInMicroseconds":0,"cancelledQueries":0,)"
+   R"("maxWaitTimeInMicroseconds":0,"queuedQueries":0,"rejectedQueries":0,"runningQueries":0})";
+
+const std::string IDLE_QUERY_SCHEDULER =
+   R"("queryScheduler":{"costClasses":{"heavy":)" + IDLE_COST_CLASS + R"(,"light":)" +
+   IDLE_COST_CLASS + R"(,"medium":)" + IDLE_COST_CLASS +
+   R"(},"maxConcurrentQueries":8,"maxQueuedQueries":64,"queuedQueries":0,"runningQueries":0})";
+
+}  // namespace
+
 class MockDatabase : public silo::Database {
   public:
    MOCK_METHOD(silo::DatabaseInfo, getDatabaseInfo, (), (const));
    MOCK_METHOD(silo::DetailedDatabaseInfo, detailedDatabaseInfo, (), (const));
+   MOCK_METHOD(silo::DatabaseMemoryInfo, getMemoryInfo, (), (const));
    MOCK_METHOD(silo::DataVersion, getDataVersion, (), (const));
 
    MOCK_METHOD(silo::query_engine::QueryResult, executeQuery, (const std::string&), (const));
+   MOCK_METHOD(
+      std::vector<silo::query_engine::QueryResult>,
+      executeBatchQuery,
+      (const std::string&),
+      (const)
+   );
+   MOCK_METHOD(silo::query_engine::QueryProfile, explainQuery, (const std::string&), (const));
 };
 
 class MockDatabaseMutex : public silo_api::DatabaseMutex {
   public:
-   std::shared_mutex mutex;
    MockDatabase mock_database;
 
    silo_api::FixedDatabase getDatabase() override {
-      std::shared_lock<std::shared_mutex> lock(mutex);
-      return {mock_database, std::move(lock)};
+      // Non-owning snapshot, the mock database is owned by this object
+      return silo_api::FixedDatabase{
+         std::shared_ptr<const silo::Database>(std::shared_ptr<void>(), &mock_database)
+      };
    }
 };
 
 class RequestHandlerTestFixture : public ::testing::Test {
   protected:
    MockDatabaseMutex database_mutex;
+   silo_api::HotQueries hot_queries;
+   silo_api::QueryScheduler query_scheduler;
    silo_api::test::MockResponse response;
    silo_api::test::MockRequest request;
    silo_api::SiloRequestHandlerFactory under_test;
 
    RequestHandlerTestFixture()
        : database_mutex(),
+         hot_queries(),
+         query_scheduler(silo_api::QuerySchedulerConfig{}),
          request(silo_api::test::MockRequest(response)),
-         under_test(database_mutex) {}
+         under_test(database_mutex, hot_queries, query_scheduler) {}
 
    void processRequest() {
       std::unique_ptr<Poco::Net::HTTPRequestHandler> request_handler(
@@ -63,10 +95,51 @@ TEST_F(RequestHandlerTestFixture, handlesGetInfoRequest) {
    processRequest();
 
    EXPECT_EQ(response.getStatus(), Poco::Net::HTTPResponse::HTTP_OK);
-   EXPECT_EQ(response.out_stream.str(), R"({"nBitmapsSize":3,"sequenceCount":1,"totalSize":2})");
+   EXPECT_EQ(
+      response.out_stream.str(),
+      R"({"nBitmapsSize":3,)" + IDLE_QUERY_SCHEDULER + R"(,"sequenceCount":1,"totalSize":2})"
+   );
    EXPECT_EQ(response.get("data-version"), "1234");
 }
 
+TEST_F(RequestHandlerTestFixture, handlesGetInfoRequestWithWarmUpTime) {
+   EXPECT_CALL(database_mutex.mock_database, getDatabaseInfo)
+      .WillRepeatedly(testing::Return(silo::DatabaseInfo{1, 2, 3, 456}));
+   EXPECT_CALL(database_mutex.mock_database, getDataVersion)
+      .WillRepeatedly(testing::Return(silo::DataVersion::fromString("1234").value()));
+
+   request.setURI("/info");
+
+   processRequest();
+
+   EXPECT_EQ(response.getStatus(), Poco::Net::HTTPResponse::HTTP_OK);
+   EXPECT_EQ(
+      response.out_stream.str(),
+      R"({"nBitmapsSize":3,)" + IDLE_QUERY_SCHEDULER +
+         R"(,"sequenceCount":1,"totalSize":2,"warmUpTimeInMicroseconds":456})"
+   );
+}
+
+TEST_F(RequestHandlerTestFixture, handlesGetInfoRequestWithNumaNodes) {
+   const silo::DatabaseInfo database_info{3, 7, 0, std::nullopt, {{1, 1, 2}, {2, 2, 5}}};
+   EXPECT_CALL(database_mutex.mock_database, getDatabaseInfo)
+      .WillRepeatedly(testing::Return(database_info));
+   EXPECT_CALL(database_mutex.mock_database, getDataVersion)
+      .WillRepeatedly(testing::Return(silo::DataVersion::fromString("1234").value()));
+
+   request.setURI("/info");
+
+   processRequest();
+
+   EXPECT_EQ(response.getStatus(), Poco::Net::HTTPResponse::HTTP_OK);
+   EXPECT_EQ(
+      response.out_stream.str(),
+      R"({"nBitmapsSize":0,"numaNodes":[{"partitionCount":1,"sequenceCount":1,"totalSize":2},)"
+      R"({"partitionCount":2,"sequenceCount":2,"totalSize":5}],)" +
+         IDLE_QUERY_SCHEDULER + R"(,"sequenceCount":3,"totalSize":7})"
+   );
+}
+
 TEST_F(RequestHandlerTestFixture, handlesGetInfoRequestDetails) {
    silo::BitmapSizePerSymbol bitmap_size_per_symbol;
    bitmap_size_per_symbol.size_in_bytes[silo::Nucleotide::Symbol::A] =
@@ -132,6 +205,124 @@ TEST_F(RequestHandlerTestFixture, handlesPostQueryRequest) {
    EXPECT_EQ(response.get("data-version"), "1234");
 }
 
+TEST_F(RequestHandlerTestFixture, handlesPostBatchQueryRequest) {
+   std::map<std::string, std::optional<std::variant<std::string, int32_t, double>>> fields{
+      // NOLINTNEXTLINE(readability-magic-numbers)
+      {"count", 5}
+   };
+   const std::vector<silo::query_engine::QueryResultEntry> tmp{{fields}};
+   const std::vector<silo::query_engine::QueryResult> query_results{{tmp}, {{}}};
+   EXPECT_CALL(database_mutex.mock_database, executeBatchQuery)
+      .WillRepeatedly(testing::Return(query_results));
+   EXPECT_CALL(database_mutex.mock_database, getDataVersion)
+      .WillRepeatedly(testing::Return(silo::DataVersion::fromString("1234").value()));
+
+   request.setMethod("POST");
+   request.setURI("/batchQuery");
+
+   processRequest();
+
+   EXPECT_EQ(response.getStatus(), Poco::Net::HTTPResponse::HTTP_OK);
+   EXPECT_EQ(
+      response.out_stream.str(),
+      R"({"batchResults":[{"queryResult":[{"count":5}]},{"queryResult":[]}]})"
+   );
+   EXPECT_EQ(response.get("data-version"), "1234");
+}
+
+TEST_F(RequestHandlerTestFixture, handlesPostExplainRequest) {
+   silo::query_engine::QueryProfile query_profile;
+   query_profile.filter = "True";
+   query_profile.partitions.push_back({0, 5, 1, {"Full", "Full", 2, 5, true, {}}});
+   query_profile.actions.push_back({"Aggregated", 3, {{"execute", 3}, {"sort", 0}}, 1});
+   EXPECT_CALL(database_mutex.mock_database, explainQuery)
+      .WillRepeatedly(testing::Return(query_profile));
+   EXPECT_CALL(database_mutex.mock_database, getDataVersion)
+      .WillRepeatedly(testing::Return(silo::DataVersion::fromString("1234").value()));
+
+   request.setMethod("POST");
+   request.setURI("/explain");
+   request.in_stream << R"({"action":{"type":"Aggregated"},"filterExpression":{"type":"True"}})";
+
+   processRequest();
+
+   EXPECT_EQ(response.getStatus(), Poco::Net::HTTPResponse::HTTP_OK);
+   EXPECT_EQ(
+      response.out_stream.str(),
+      R"({"queryProfile":{"actionTimeInMicroseconds":0,"actions":[{"phases":[)"
+      R"({"name":"execute","timeInMicroseconds":3},{"name":"sort","timeInMicroseconds":0}],)"
+      R"("resultRowCount":1,"timeInMicroseconds":3,"type":"Aggregated"}],"filter":"True",)"
+      R"("filterTimeInMicroseconds":0,"partitions":[{"compilationTimeInMicroseconds":1,)"
+      R"("filter":{"cardinality":5,"evaluationTimeInMicroseconds":2,"expression":"Full",)"
+      R"("isMutable":true,"type":"Full"},"partition":0,"sequenceCount":5}]}})"
+   );
+   EXPECT_EQ(response.get("data-version"), "1234");
+}
+
+TEST_F(RequestHandlerTestFixture, handlesGetMetricsRequest) {
+   const silo::DatabaseMemoryInfo memory_info{{{"country", 40}}, {{"main", 1000}}, {{"S", 20}}};
+   EXPECT_CALL(database_mutex.mock_database, getMemoryInfo)
+      .WillRepeatedly(testing::Return(memory_info));
+   EXPECT_CALL(database_mutex.mock_database, getDataVersion)
+      .WillRepeatedly(testing::Return(silo::DataVersion::fromString("1234").value()));
+
+   request.setURI("/metrics");
+
+   processRequest();
+
+   EXPECT_EQ(response.getStatus(), Poco::Net::HTTPResponse::HTTP_OK);
+   EXPECT_EQ(response.getContentType(), "text/plain; version=0.0.4; charset=utf-8");
+   const auto metrics = response.out_stream.str();
+   EXPECT_THAT(metrics, testing::HasSubstr("# TYPE silo_queries_running gauge\n"));
+   EXPECT_THAT(metrics, testing::HasSubstr("silo_queries_running{cost_class=\"heavy\"} 0\n"));
+   EXPECT_THAT(metrics, testing::HasSubstr("silo_data_version_info{data_version=\"1234\"} 1\n"));
+   EXPECT_THAT(metrics, testing::HasSubstr("silo_column_memory_bytes{column=\"country\"} 40\n"));
+   EXPECT_THAT(
+      metrics,
+      testing::HasSubstr(
+         "silo_sequence_store_memory_bytes{sequence=\"main\",type=\"nucleotide\"} 1000\n"
+         "silo_sequence_store_memory_bytes{sequence=\"S\",type=\"amino_acid\"} 20\n"
+      )
+   );
+}
+
+TEST_F(RequestHandlerTestFixture, runsQueriesThroughTheQueryScheduler) {
+   EXPECT_CALL(database_mutex.mock_database, executeQuery)
+      .WillRepeatedly(testing::Return(silo::query_engine::QueryResult{}));
+   EXPECT_CALL(database_mutex.mock_database, getDataVersion)
+      .WillRepeatedly(testing::Return(silo::DataVersion::fromString("1234").value()));
+
+   request.setMethod("POST");
+   request.setURI("/query");
+   request.in_stream << R"({"action":{"type":"Fasta"},"filterExpression":{"type":"True"}})";
+
+   processRequest();
+
+   EXPECT_EQ(response.getStatus(), Poco::Net::HTTPResponse::HTTP_OK);
+   const auto info = query_scheduler.getInfo();
+   const auto& heavy_statistics =
+      info.cost_classes[static_cast<size_t>(silo_api::QueryCostClass::HEAVY)];
+   EXPECT_EQ(heavy_statistics.admitted_queries, 1);
+   EXPECT_EQ(heavy_statistics.running_queries, 0);
+   EXPECT_EQ(heavy_statistics.queued_queries, 0);
+}
+
+TEST_F(RequestHandlerTestFixture, returnsBadRequestForInvalidQueryTimeout) {
+   request.setMethod("POST");
+   request.setURI("/query");
+   request.set(silo_api::QUERY_TIMEOUT_HEADER, "soon");
+   request.in_stream << R"({"action":{"type":"Aggregated"},"filterExpression":{"type":"True"}})";
+
+   processRequest();
+
+   EXPECT_EQ(response.getStatus(), Poco::Net::HTTPResponse::HTTP_BAD_REQUEST);
+   EXPECT_EQ(
+      response.out_stream.str(),
+      R"({"error":"Bad request","message":"The header query-timeout must be a positive number of )"
+      R"(milliseconds, but is: soon"})"
+   );
+}
+
 TEST_F(RequestHandlerTestFixture, returnsMethodNotAllowedOnGetQuery) {
    request.setMethod("GET");
    request.setURI("/query");
@@ -146,7 +337,8 @@ TEST_F(RequestHandlerTestFixture, returnsMethodNotAllowedOnGetQuery) {
 }
 
 TEST_F(RequestHandlerTestFixture, givenRequestToUnknownUrl_thenReturnsNotFound) {
-   auto under_test = silo_api::SiloRequestHandlerFactory(database_mutex);
+   auto under_test =
+      silo_api::SiloRequestHandlerFactory(database_mutex, hot_queries, query_scheduler);
 
    request.setURI("/doesNotExist");
 
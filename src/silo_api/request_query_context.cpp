@@ -0,0 +1,68 @@
+#include "silo_api/request_query_context.h"
+
+#include <charconv>
+#include <cstdint>
+#include <string>
+
+#include <Poco/Exception.h>
+#include <Poco/Net/HTTPServerRequestImpl.h>
+#include <Poco/Net/Socket.h>
+#include <Poco/Net/StreamSocket.h>
+#include <Poco/Timespan.h>
+
+#include "silo/query_engine/query_parse_exception.h"
+
+namespace {
+
+std::optional<std::chrono::milliseconds> requestedTimeout(
+   const Poco::Net::HTTPServerRequest& request
+) {
+   if (!request.has(silo_api::QUERY_TIMEOUT_HEADER)) {
+      return std::nullopt;
+   }
+   const std::string& value = request.get(silo_api::QUERY_TIMEOUT_HEADER);
+   uint32_t milliseconds = 0;
+   const char* value_end = value.data() + value.size();
+   const auto [end, error] = std::from_chars(value.data(), value_end, milliseconds);
+   if (error != std::errc{} || end != value_end || milliseconds == 0) {
+      throw silo::QueryParseException(
+         std::string("The header ") + silo_api::QUERY_TIMEOUT_HEADER +
+         " must be a positive number of milliseconds, but is: " + value
+      );
+   }
+   return std::chrono::milliseconds(milliseconds);
+}
+
+/// A connection that the client closed is readable, but has no data
+bool isClosedByClient(const Poco::Net::StreamSocket& socket) {
+   try {
+      return socket.poll(Poco::Timespan(0), Poco::Net::Socket::SELECT_READ) &&
+             socket.available() == 0;
+   } catch (const Poco::Exception&) {
+      return true;
+   }
+}
+
+}  // namespace
+
+namespace silo_api {
+
+std::unique_ptr<silo::query_engine::QueryContext> createQueryContext(
+   Poco::Net::HTTPServerRequest& request,
+   std::optional<std::chrono::milliseconds> default_timeout
+) {
+   const auto timeout = requestedTimeout(request);
+   auto context = std::make_unique<silo::query_engine::QueryContext>(
+      timeout.has_value() ? timeout : default_timeout
+   );
+   // Requests that are not read from a socket, e.g. in tests, cannot be disconnected
+   auto* server_request = dynamic_cast<Poco::Net::HTTPServerRequestImpl*>(&request);
+   if (server_request != nullptr) {
+      context->setClientDisconnectCheck([socket = server_request->socket()]() {
+         return isClosedByClient(socket);
+      });
+   }
+   return context;
+}
+
+}  // namespace silo_api
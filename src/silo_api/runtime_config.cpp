@@ -1,5 +1,7 @@
 #include "silo_api/runtime_config.h"
 
+#include <chrono>
+#include <cstdint>
 #include <stdexcept>
 #include <string>
 
@@ -8,6 +10,37 @@
 
 namespace YAML {
 
+template <>
+struct convert<silo_api::QuerySchedulerConfig> {
+   static bool decode(const Node& node, silo_api::QuerySchedulerConfig& config) {
+      if (!node.IsMap()) {
+         return false;
+      }
+      if (node["maxConcurrentQueries"]) {
+         config.max_concurrent_queries = node["maxConcurrentQueries"].as<uint32_t>();
+      }
+      if (node["maxConcurrentHeavyQueries"]) {
+         config.max_concurrent_heavy_queries = node["maxConcurrentHeavyQueries"].as<uint32_t>();
+      }
+      if (node["maxQueuedQueries"]) {
+         config.max_queued_queries = node["maxQueuedQueries"].as<uint32_t>();
+      }
+      if (node["heavyQueryThreads"]) {
+         config.heavy_query_threads = node["heavyQueryThreads"].as<uint32_t>();
+      }
+      if (node["defaultTimeoutInMilliseconds"]) {
+         config.default_query_timeout =
+            std::chrono::milliseconds(node["defaultTimeoutInMilliseconds"].as<uint32_t>());
+      }
+      if (config.max_concurrent_queries == 0 || config.max_concurrent_heavy_queries == 0) {
+         throw std::runtime_error(
+            "maxConcurrentQueries and maxConcurrentHeavyQueries must be at least 1"
+         );
+      }
+      return true;
+   }
+};
+
 template <>
 struct convert<silo_api::RuntimeConfig> {
    static bool decode(const Node& node, silo_api::RuntimeConfig& config) {
@@ -16,6 +49,12 @@ struct convert<silo_api::RuntimeConfig> {
             ? std::optional<std::filesystem::path>(node["dataDirectory"].as<std::string>())
             : std::nullopt
       };
+      if (node["port"]) {
+         config.port = node["port"].as<uint16_t>();
+      }
+      if (node["queryScheduler"]) {
+         config.query_scheduler = node["queryScheduler"].as<silo_api::QuerySchedulerConfig>();
+      }
 
       return true;
    }
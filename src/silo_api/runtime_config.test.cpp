@@ -8,3 +8,18 @@ TEST(RuntimeConfig, shouldReadConfig) {
 
    ASSERT_EQ(result.data_directory, std::filesystem::path("test/directory"));
 }
+
+TEST(RuntimeConfig, shouldReadServerAndQuerySchedulerSettings) {
+   const auto result =
+      silo_api::RuntimeConfig::readFromFile("./testBaseData/test_runtime_config.yaml");
+
+   EXPECT_EQ(result.port, 8082);
+   EXPECT_EQ(result.query_scheduler.max_concurrent_queries, 4);
+   EXPECT_EQ(result.query_scheduler.max_queued_queries, 10);
+   EXPECT_EQ(result.query_scheduler.heavy_query_threads, 2);
+   EXPECT_EQ(result.query_scheduler.default_query_timeout, std::chrono::milliseconds(30000));
+   EXPECT_EQ(
+      result.query_scheduler.max_concurrent_heavy_queries,
+      silo_api::QuerySchedulerConfig{}.max_concurrent_heavy_queries
+   );
+}